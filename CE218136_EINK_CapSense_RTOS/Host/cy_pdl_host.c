@@ -0,0 +1,623 @@
+/******************************************************************************
+* File Name: cy_pdl_host.c
+*
+* Version: 1.00
+*
+* Description: This file contains the emulation of the Peripheral Driver
+*              Library functions used by the E-INK interface
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* See cy_pdl_host.h header for the description of the emulation.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cy_pdl_host.h"
+#include "eink_panel_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Size of the TX and RX FIFOs of the SCB in bytes */
+#define HOST_SCB_FIFO_SIZE          (128u)
+
+/* Largest bulk transfer */
+#define HOST_SCB_TRANSFER_SIZE      (256u)
+
+/* Port of the E-INK pins */
+GPIO_PRT_Type HOST_EINK_PORT;
+
+/* SCB of the E-INK display, and its configuration */
+CySCB_Type HOST_EINK_SCB;
+const cy_stc_scb_spi_config_t CY_EINK_SPIM_config = {0u};
+
+/* Interrupt handler of the SCB, and its state in the NVIC */
+cy_israddress static scbIsr;
+bool static          scbIrqEnabled;
+
+/* Bytes received over SPI, and the RX FIFO status */
+uint8_t static  rxFifo[HOST_SCB_FIFO_SIZE];
+uint32_t static rxCount;
+uint32_t static rxStatus;
+
+/* Copy of the data of the bulk transfer at the start of the transfer */
+uint8_t static  transferCopy[HOST_SCB_TRANSFER_SIZE];
+
+/* Transfers between the rejected transfers, 0 if none are rejected */
+uint32_t static rejectInterval;
+
+/* Log of the SPI bytes and the chip select */
+uint16_t static* spiLog;
+uint32_t static spiLogSize;
+uint32_t static spiLogLength;
+
+/* Activity counters */
+host_pdl_stats_t static pdlStats;
+
+/* Context of the SCB, defined by the E-INK interface */
+extern cy_stc_scb_spi_context_t CY_EINK_SPIM_context;
+
+/* These static functions are not available outside this file.
+   See the respective function definitions for more details */
+void static    HostPdl_Fail(char const* message);
+void static    HostPdl_Log(uint16_t entry);
+uint8_t static HostPdl_SendByte(uint8_t data);
+
+/*******************************************************************************
+* Function Name: void Cy_GPIO_Set(GPIO_PRT_Type* base, uint32_t pinNum)
+********************************************************************************
+*
+* Summary: Drives a pin HIGH. Pushing the chip select HIGH ends a command.
+*
+*******************************************************************************/
+void Cy_GPIO_Set(GPIO_PRT_Type* base, uint32_t pinNum)
+{
+    base->OUT |= (1u << pinNum);
+    if ((base == CY_EINK_Ssel_PORT) && (pinNum == CY_EINK_Ssel_PIN))
+    {
+        HostPdl_Log(HOST_PDL_LOG_DESELECT);
+        EinkModel_SelectDriver(false);
+    }
+}
+
+/*******************************************************************************
+* Function Name: void Cy_GPIO_Clr(GPIO_PRT_Type* base, uint32_t pinNum)
+********************************************************************************
+*
+* Summary: Drives a pin LOW. Pulling the chip select LOW starts a command.
+*
+*******************************************************************************/
+void Cy_GPIO_Clr(GPIO_PRT_Type* base, uint32_t pinNum)
+{
+    base->OUT &= ~(1u << pinNum);
+    if ((base == CY_EINK_Ssel_PORT) && (pinNum == CY_EINK_Ssel_PIN))
+    {
+        HostPdl_Log(HOST_PDL_LOG_SELECT);
+        EinkModel_SelectDriver(true);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uint32_t Cy_GPIO_Read(GPIO_PRT_Type* base, uint32_t pinNum)
+********************************************************************************
+*
+* Summary: Reads a pin. The busy pin of the E-INK driver is never set.
+*
+*******************************************************************************/
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type* base, uint32_t pinNum)
+{
+    return (base->OUT >> pinNum) & 1u;
+}
+
+/*******************************************************************************
+* Function Name: cy_en_sysint_status_t Cy_SysInt_Init(
+*                   cy_stc_sysint_t const* config, cy_israddress userIsr)
+********************************************************************************
+*
+* Summary: Hooks the interrupt handler of the SCB
+*
+*******************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(cy_stc_sysint_t const* config,
+                                     cy_israddress userIsr)
+{
+    if ((config == NULL) || (config->intrSrc != CY_EINK_SPIM_IRQ))
+    {
+        return CY_SYSINT_BAD_PARAM;
+    }
+    scbIsr = userIsr;
+
+    return CY_SYSINT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: void NVIC_EnableIRQ(IRQn_Type irqn),
+*                void NVIC_ClearPendingIRQ(IRQn_Type irqn)
+********************************************************************************
+*
+* Summary: Enables the interrupt of the SCB. No interrupt is pending before
+*  the first transfer.
+*
+*******************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    if (irqn == CY_EINK_SPIM_IRQ)
+    {
+        scbIrqEnabled = true;
+    }
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irqn)
+{
+    (void)irqn;
+}
+
+/*******************************************************************************
+* Function Name: cy_en_scb_spi_status_t Cy_SCB_SPI_Init(CySCB_Type* base,
+*                   cy_stc_scb_spi_config_t const* config,
+*                   cy_stc_scb_spi_context_t* context)
+********************************************************************************
+*
+* Summary: Initializes the SCB and its context
+*
+*******************************************************************************/
+cy_en_scb_spi_status_t Cy_SCB_SPI_Init(CySCB_Type* base,
+                                       cy_stc_scb_spi_config_t const* config,
+                                       cy_stc_scb_spi_context_t* context)
+{
+    if ((base == NULL) || (config == NULL) || (context == NULL))
+    {
+        return CY_SCB_SPI_BAD_PARAM;
+    }
+    memset(context, 0, sizeof(*context));
+    base->enabled = 0u;
+    rxCount  = 0u;
+    rxStatus = 0u;
+
+    return CY_SCB_SPI_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: void Cy_SCB_SPI_RegisterCallback(CySCB_Type const* base,
+*                   cy_cb_scb_spi_handle_events_t callback,
+*                   cy_stc_scb_spi_context_t* context)
+********************************************************************************
+*
+* Summary: Registers the event callback of the transfers
+*
+*******************************************************************************/
+void Cy_SCB_SPI_RegisterCallback(CySCB_Type const* base,
+                                 cy_cb_scb_spi_handle_events_t callback,
+                                 cy_stc_scb_spi_context_t* context)
+{
+    (void)base;
+    context->cbEvents = callback;
+}
+
+/*******************************************************************************
+* Function Name: void Cy_SCB_SPI_Enable(CySCB_Type* base),
+*                void Cy_SCB_SPI_Disable(CySCB_Type* base,
+*                                        cy_stc_scb_spi_context_t* context)
+********************************************************************************
+*
+* Summary: Enables or disables the SCB. Disabling the SCB aborts the transfer
+*  in progress.
+*
+*******************************************************************************/
+void Cy_SCB_SPI_Enable(CySCB_Type* base)
+{
+    base->enabled = 1u;
+}
+
+void Cy_SCB_SPI_Disable(CySCB_Type* base, cy_stc_scb_spi_context_t* context)
+{
+    base->enabled = 0u;
+    if (context != NULL)
+    {
+        context->status = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: uint32_t Cy_SCB_SPI_Write(CySCB_Type* base, uint32_t data)
+********************************************************************************
+*
+* Summary: Sends a byte, and places the byte received in the RX FIFO
+*
+*******************************************************************************/
+uint32_t Cy_SCB_SPI_Write(CySCB_Type* base, uint32_t data)
+{
+    uint8_t response;
+
+    if (base->enabled == 0u)
+    {
+        HostPdl_Fail("SPI write with the SCB disabled");
+    }
+    if ((CY_EINK_SPIM_context.status & CY_SCB_SPI_TRANSFER_ACTIVE) != 0u)
+    {
+        HostPdl_Fail("SPI write during a bulk transfer");
+    }
+
+    response = HostPdl_SendByte((uint8_t)data);
+    if (rxCount < HOST_SCB_FIFO_SIZE)
+    {
+        rxFifo[rxCount++] = response;
+    }
+    rxStatus |= CY_SCB_SPI_RX_NOT_EMPTY;
+
+    return 1u;
+}
+
+/*******************************************************************************
+* Function Name: uint32_t Cy_SCB_SPI_Read(CySCB_Type const* base)
+********************************************************************************
+*
+* Summary: Reads the oldest byte of the RX FIFO
+*
+*******************************************************************************/
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const* base)
+{
+    uint32_t data;
+
+    (void)base;
+    if (rxCount == 0u)
+    {
+        HostPdl_Fail("SPI read of an empty RX FIFO");
+    }
+    data = rxFifo[0];
+    rxCount--;
+    memmove(rxFifo, &rxFifo[1], rxCount);
+
+    return data;
+}
+
+/*******************************************************************************
+* Function Name: uint32_t Cy_SCB_SPI_GetRxFifoStatus(CySCB_Type const* base),
+*                void Cy_SCB_SPI_ClearRxFifoStatus(CySCB_Type* base,
+*                                                  uint32_t clearMask)
+********************************************************************************
+*
+* Summary: Reads and clears the RX FIFO status
+*
+*******************************************************************************/
+uint32_t Cy_SCB_SPI_GetRxFifoStatus(CySCB_Type const* base)
+{
+    (void)base;
+    return rxStatus;
+}
+
+void Cy_SCB_SPI_ClearRxFifoStatus(CySCB_Type* base, uint32_t clearMask)
+{
+    (void)base;
+    rxStatus &= ~clearMask;
+}
+
+/*******************************************************************************
+* Function Name: void Cy_SCB_SPI_ClearTxFifo(CySCB_Type* base),
+*                void Cy_SCB_SPI_ClearRxFifo(CySCB_Type* base)
+********************************************************************************
+*
+* Summary: Clears the FIFOs. The bytes written are sent immediately, so the TX
+*  FIFO is always empty.
+*
+*******************************************************************************/
+void Cy_SCB_SPI_ClearTxFifo(CySCB_Type* base)
+{
+    (void)base;
+}
+
+void Cy_SCB_SPI_ClearRxFifo(CySCB_Type* base)
+{
+    (void)base;
+    rxCount = 0u;
+}
+
+/*******************************************************************************
+* Function Name: cy_en_scb_spi_status_t Cy_SCB_SPI_Transfer(CySCB_Type* base,
+*                   void* txBuffer, void* rxBuffer, uint32_t size,
+*                   cy_stc_scb_spi_context_t* context)
+********************************************************************************
+*
+* Summary: Starts a bulk transfer, which is serviced by the SCB interrupt. The
+*  transfer is rejected if another transfer is active, or on purpose at the
+*  interval set by HostPdl_RejectTransfers.
+*
+*******************************************************************************/
+cy_en_scb_spi_status_t Cy_SCB_SPI_Transfer(CySCB_Type* base, void* txBuffer,
+                                           void* rxBuffer, uint32_t size,
+                                           cy_stc_scb_spi_context_t* context)
+{
+    if ((txBuffer == NULL) || (rxBuffer != NULL) || (size == 0u) ||
+        (size > HOST_SCB_TRANSFER_SIZE) || (base->enabled == 0u))
+    {
+        return CY_SCB_SPI_BAD_PARAM;
+    }
+    if ((context->status & CY_SCB_SPI_TRANSFER_ACTIVE) != 0u)
+    {
+        pdlStats.rejectedTransfers++;
+        return CY_SCB_SPI_TRANSFER_BUSY;
+    }
+    if ((rejectInterval != 0u) &&
+        (((pdlStats.transfers + pdlStats.rejectedTransfers + 1u) %
+          rejectInterval) == 0u))
+    {
+        pdlStats.rejectedTransfers++;
+        return CY_SCB_SPI_TRANSFER_BUSY;
+    }
+
+    pdlStats.transfers++;
+    memcpy(transferCopy, txBuffer, size);
+    context->txBuf     = txBuffer;
+    context->txBufSize = size;
+    context->txBufIdx  = 0u;
+    context->status    = CY_SCB_SPI_TRANSFER_ACTIVE;
+
+    return CY_SCB_SPI_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: uint32_t Cy_SCB_SPI_GetTransferStatus(CySCB_Type const* base,
+*                   cy_stc_scb_spi_context_t const* context)
+********************************************************************************
+*
+* Summary: Reads the transfer status. The SCB interrupt of an active transfer
+*  is raised first, as the hardware makes progress while the caller polls.
+*
+*******************************************************************************/
+uint32_t Cy_SCB_SPI_GetTransferStatus(CySCB_Type const* base,
+                                      cy_stc_scb_spi_context_t const* context)
+{
+    (void)base;
+    if ((context->status & CY_SCB_SPI_TRANSFER_ACTIVE) != 0u)
+    {
+        if (!scbIrqEnabled || (scbIsr == NULL))
+        {
+            HostPdl_Fail("bulk transfer without an SCB interrupt");
+        }
+        scbIsr();
+    }
+
+    return context->status;
+}
+
+/*******************************************************************************
+* Function Name: void Cy_SCB_SPI_Interrupt(CySCB_Type* base,
+*                   cy_stc_scb_spi_context_t* context)
+********************************************************************************
+*
+* Summary: Services the SCB interrupt of a bulk transfer: refills the TX FIFO,
+*  and reports the transfer complete event once all bytes have been sent.
+*
+*******************************************************************************/
+void Cy_SCB_SPI_Interrupt(CySCB_Type* base, cy_stc_scb_spi_context_t* context)
+{
+    uint8_t const* txData = (uint8_t const*)context->txBuf;
+    uint32_t fifoBytes = 0u;
+
+    (void)base;
+    pdlStats.interrupts++;
+    if ((context->status & CY_SCB_SPI_TRANSFER_ACTIVE) == 0u)
+    {
+        return;
+    }
+
+    while ((context->txBufIdx < context->txBufSize) &&
+           (fifoBytes < HOST_SCB_FIFO_SIZE))
+    {
+        if (txData[context->txBufIdx] != transferCopy[context->txBufIdx])
+        {
+            EinkModel_BufferError();
+        }
+        (void)HostPdl_SendByte(txData[context->txBufIdx]);
+        context->txBufIdx++;
+        fifoBytes++;
+    }
+
+    if (context->txBufIdx == context->txBufSize)
+    {
+        context->status = 0u;
+        if (context->cbEvents != NULL)
+        {
+            pdlStats.completeEvents++;
+            context->cbEvents(CY_SCB_SPI_TRANSFER_CMPLT_EVENT);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: void HostPdl_RejectTransfers(uint32_t interval)
+********************************************************************************
+*
+* Summary: Rejects every interval-th bulk transfer with
+*  CY_SCB_SPI_TRANSFER_BUSY, so that the E-INK interface sends its data byte
+*  by byte
+*
+* Parameters:
+*  uint32_t interval : Interval of the rejected transfers, 0 to reject none
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HostPdl_RejectTransfers(uint32_t interval)
+{
+    rejectInterval = interval;
+}
+
+/*******************************************************************************
+* Function Name: void HostPdl_RunInterrupts(void)
+********************************************************************************
+*
+* Summary: Raises the SCB interrupt until the active bulk transfer has
+*  finished. Used by the wait functions of the host programs, which block
+*  until the transfer complete event.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HostPdl_RunInterrupts(void)
+{
+    while ((Cy_SCB_SPI_GetTransferStatus(CY_EINK_SPIM_HW,
+                                         &CY_EINK_SPIM_context) &
+            CY_SCB_SPI_TRANSFER_ACTIVE) != 0u)
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: void HostPdl_StartLog(uint16_t* log, uint32_t size)
+********************************************************************************
+*
+* Summary: Starts logging the bytes sent over SPI and the chip select edges
+*
+* Parameters:
+*  uint16_t* log : Receives the bytes, HOST_PDL_LOG_SELECT and
+*                  HOST_PDL_LOG_DESELECT
+*  uint32_t size : Number of entries of the log
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HostPdl_StartLog(uint16_t* log, uint32_t size)
+{
+    spiLog       = log;
+    spiLogSize   = size;
+    spiLogLength = 0u;
+}
+
+/*******************************************************************************
+* Function Name: uint32_t HostPdl_StopLog(void)
+********************************************************************************
+*
+* Summary: Stops logging the SPI bytes
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t : Number of entries logged
+*
+*******************************************************************************/
+uint32_t HostPdl_StopLog(void)
+{
+    spiLog = NULL;
+    if (spiLogLength > spiLogSize)
+    {
+        HostPdl_Fail("SPI log overflow");
+    }
+
+    return spiLogLength;
+}
+
+/*******************************************************************************
+* Function Name: void HostPdl_GetStats(host_pdl_stats_t* stats, bool reset)
+********************************************************************************
+*
+* Summary: Reads the activity counters, and optionally clears them
+*
+* Parameters:
+*  host_pdl_stats_t* stats : Receives the counters, or NULL
+*  bool reset              : "true" to clear the counters
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HostPdl_GetStats(host_pdl_stats_t* stats, bool reset)
+{
+    if (stats != NULL)
+    {
+        *stats = pdlStats;
+    }
+    if (reset)
+    {
+        memset(&pdlStats, 0, sizeof(pdlStats));
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static HostPdl_Fail(char const* message)
+********************************************************************************
+*
+* Summary: Stops the program on a use of the PDL that would hang or corrupt
+*  the SPI data on the hardware
+*
+*******************************************************************************/
+void static HostPdl_Fail(char const* message)
+{
+    printf("FAIL: %s\n", message);
+    exit(EXIT_FAILURE);
+}
+
+/*******************************************************************************
+* Function Name: void static HostPdl_Log(uint16_t entry)
+********************************************************************************
+*
+* Summary: Adds an entry to the SPI log, if it is started
+*
+*******************************************************************************/
+void static HostPdl_Log(uint16_t entry)
+{
+    if (spiLog != NULL)
+    {
+        if (spiLogLength < spiLogSize)
+        {
+            spiLog[spiLogLength] = entry;
+        }
+        spiLogLength++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: uint8_t static HostPdl_SendByte(uint8_t data)
+********************************************************************************
+*
+* Summary: Exchanges a byte with the panel model
+*
+*******************************************************************************/
+uint8_t static HostPdl_SendByte(uint8_t data)
+{
+    HostPdl_Log(data);
+    return EinkModel_TransferByte(data);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name: cy_pdl_host.h
+*
+* Version: 1.00
+*
+* Description: This file is the public interface of cy_pdl_host.c source file
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* This file contains the emulation of the Peripheral Driver Library functions
+* used by the E-INK interface (cy_eink_psoc_interface.c): the GPIO pins, the
+* SCB SPI driver and the interrupts. The SPI bytes and the chip select are
+* passed to the panel model (eink_panel_model.c).
+*
+* A bulk transfer is serviced by the SCB interrupt handler registered by the
+* E-INK interface, which sends up to a FIFO of bytes at a time. The interrupt
+* is raised while the caller polls the transfer status, or waits with
+* HostPdl_RunInterrupts. A byte changed after the transfer has started is
+* counted as a buffer error of the panel model, as it would send corrupted
+* lines on the hardware. Transfers can be rejected on purpose to test the
+* per-byte fallback of the E-INK interface.
+*******************************************************************************/
+
+/* Include Guard */
+#ifndef CY_PDL_HOST_H
+#define CY_PDL_HOST_H
+
+/* Header file includes */
+#include "cycfg.h"
+
+/* Entries of the SPI log other than the bytes sent: the chip select is 
+   pulled LOW or pushed HIGH */
+#define HOST_PDL_LOG_SELECT     (uint16_t)(0x100u)
+#define HOST_PDL_LOG_DESELECT   (uint16_t)(0x200u)
+
+/* Data-type of the activity counters of the emulated SCB */
+typedef struct
+{
+    uint32_t    transfers;          /* Bulk transfers started */
+    uint32_t    rejectedTransfers;  /* Bulk transfers rejected */
+    uint32_t    interrupts;         /* SCB interrupts serviced */
+    uint32_t    completeEvents;     /* Transfer complete events reported */
+}   host_pdl_stats_t;
+
+/* Functions used by the host programs */
+void     HostPdl_RejectTransfers(uint32_t interval);
+void     HostPdl_RunInterrupts(void);
+void     HostPdl_StartLog(uint16_t* log, uint32_t size);
+uint32_t HostPdl_StopLog(void);
+void     HostPdl_GetStats(host_pdl_stats_t* stats, bool reset);
+
+#endif /* CY_PDL_HOST_H */
+/* [] END OF FILE */
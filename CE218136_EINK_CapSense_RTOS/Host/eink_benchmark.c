@@ -0,0 +1,476 @@
+/******************************************************************************
+* File Name: eink_benchmark.c
+*
+* Version: 1.00
+*
+* Description: This file contains the refresh-cost benchmark of the E-INK
+*              library, run against the panel model on the host
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* The benchmark shows a sequence of screens with Cy_EINK_ShowFrame, one per
+* update type, and the compressed startup logo with Cy_EINK_ShowCompressedImage.
+* It reports for each refresh the bytes sent, the lines latched, the scan lines
+* driven and the simulated time, and checks that each update stage is driven
+* for the stage time of the panel. After each refresh the pixel state of the
+* panel model is compared with the new frame, and written as a PBM snapshot to
+* the output directory (the first argument, if any). The time taken to decode
+* the compressed image on the host is reported last.
+*
+* The program returns a non-zero exit code if the panel does not show a frame,
+* if the driver sends malformed commands or changes bulk data while it is
+* being sent, or if the driver counters disagree with the model.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h"
+#include "eink_panel_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Ambient temperature used for the stage time, in degree Celsius */
+#define BENCHMARK_TEMPERATURE   (int8_t)(25)
+
+/* Geometry of the screens drawn by the benchmark */
+#define SCREEN_WIDTH            (PV_EINK_PANEL_WIDTH)
+#define SCREEN_HEIGHT           (PV_EINK_PANEL_HEIGHT)
+#define HEADER_HEIGHT           (20u)
+#define ITEM_HEIGHT             (24u)
+#define TEXT_LINE_HEIGHT        (12u)
+
+/* Number of times the compressed image is decoded to measure the decoder */
+#define DECODE_REPETITIONS      (2000u)
+
+/* Frames are aligned to words like the frame buffers of the application */
+#define BENCHMARK_FRAME(name)   cy_eink_frame_t name[CY_EINK_FRAME_SIZE]       \
+                                __attribute__((aligned(4)))
+
+/* Data-type of a refresh of the benchmark */
+typedef struct
+{
+    char const*         name;
+    cy_eink_frame_t*    prevFrame;
+    cy_eink_frame_t*    newFrame;
+    cy_eink_update_t    updateType;
+}   benchmark_refresh_t;
+
+/* Screens shown by the benchmark */
+BENCHMARK_FRAME(static menuFrame);
+BENCHMARK_FRAME(static cursorFrame);
+BENCHMARK_FRAME(static textFrame);
+BENCHMARK_FRAME(static editedTextFrame);
+BENCHMARK_FRAME(static logoFrame);
+BENCHMARK_FRAME(static expectedImage);
+
+/* Compressed startup logo of the application (Startup_Logo_Compressed.c) */
+extern cy_eink_compressed_image_t const startupLogoImage;
+
+/* Names of the update types, in the order of cy_eink_update_t */
+char const static * const updateName[] =
+{
+    "partial", "full 4 stage", "full 2 stage", "auto"
+};
+
+/*******************************************************************************
+* Function Name: void static DrawScreens(void)
+********************************************************************************
+*
+* Summary: Draws the screens of the benchmark: a menu, the menu with the cursor
+*  moved, a text page and the text page with one line changed
+*
+*******************************************************************************/
+void static DrawScreens(void)
+{
+    uint16_t y;
+    uint16_t x;
+    uint16_t item;
+
+    /* Menu: a header, four items and the cursor on the first item */
+    memset(menuFrame, PV_EINK_WHITE_PIXEL_BYTE, CY_EINK_FRAME_SIZE);
+    Cy_EINK_RasterFill(menuFrame, 0u, 0u, SCREEN_WIDTH - 1u, HEADER_HEIGHT - 1u,
+                       false);
+    for (item = 0u; item < 4u; item++)
+    {
+        y = HEADER_HEIGHT + 8u + (item * ITEM_HEIGHT);
+        Cy_EINK_RasterFill(menuFrame, 30u, y, 30u + 60u + (item * 25u),
+                           y + 9u, false);
+    }
+    Cy_EINK_RasterFill(menuFrame, 8u, HEADER_HEIGHT + 8u, 19u,
+                       HEADER_HEIGHT + 17u, false);
+
+    /* Cursor moved to the second item */
+    memcpy(cursorFrame, menuFrame, CY_EINK_FRAME_SIZE);
+    Cy_EINK_RasterFill(cursorFrame, 8u, HEADER_HEIGHT + 8u, 19u,
+                       HEADER_HEIGHT + 17u, true);
+    Cy_EINK_RasterFill(cursorFrame, 8u, HEADER_HEIGHT + 8u + ITEM_HEIGHT, 19u,
+                       HEADER_HEIGHT + 17u + ITEM_HEIGHT, false);
+
+    /* Text page: words of pseudo-random length on each text line */
+    srand(1u);
+    memset(textFrame, PV_EINK_WHITE_PIXEL_BYTE, CY_EINK_FRAME_SIZE);
+    Cy_EINK_RasterFill(textFrame, 0u, 0u, SCREEN_WIDTH - 1u, HEADER_HEIGHT - 1u,
+                       false);
+    for (y = HEADER_HEIGHT + 4u; (y + TEXT_LINE_HEIGHT) < SCREEN_HEIGHT;
+         y += TEXT_LINE_HEIGHT)
+    {
+        for (x = 4u; (x + 40u) < SCREEN_WIDTH; x += (uint16_t)(rand() % 40) + 8u)
+        {
+            Cy_EINK_RasterFill(textFrame, x, y, x + (uint16_t)(rand() % 32),
+                               y + 7u, false);
+        }
+    }
+
+    /* Text page with the second text line erased */
+    memcpy(editedTextFrame, textFrame, CY_EINK_FRAME_SIZE);
+    Cy_EINK_RasterFill(editedTextFrame, 0u,
+                       HEADER_HEIGHT + 4u + TEXT_LINE_HEIGHT, SCREEN_WIDTH - 1u,
+                       HEADER_HEIGHT + 3u + (2u * TEXT_LINE_HEIGHT), true);
+}
+
+/*******************************************************************************
+* Function Name: void static ExpectedImage(cy_eink_frame_t const* frame,
+*                                          cy_eink_frame_t* image)
+********************************************************************************
+*
+* Summary: Returns the image shown by a frame, which is all white or all black
+*  for the white and black frame addresses
+*
+*******************************************************************************/
+void static ExpectedImage(cy_eink_frame_t const* frame, cy_eink_frame_t* image)
+{
+    if (frame == PV_EINK_WHITE_FRAME_ADDRESS)
+    {
+        memset(image, PV_EINK_WHITE_PIXEL_BYTE, CY_EINK_FRAME_SIZE);
+    }
+    else if (frame == PV_EINK_BLACK_FRAME_ADDRESS)
+    {
+        memset(image, PV_EINK_BLACK_PIXEL_BYTE, CY_EINK_FRAME_SIZE);
+    }
+    else
+    {
+        memcpy(image, frame, CY_EINK_FRAME_SIZE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bool static CheckStats(char const* name)
+********************************************************************************
+*
+* Summary: Prints the cost of the last operation, and checks the model errors
+*  and the driver counters
+*
+*******************************************************************************/
+bool static CheckStats(char const* name, char const* typeName,
+                       cy_eink_refresh_stats_t const* refreshStats)
+{
+    eink_model_stats_t modelStats;
+    bool passed = true;
+
+    EinkModel_GetStats(&modelStats, true);
+    printf("%-24s %-13s %8u %8u %8u %8u\n", name, typeName,
+           (unsigned)modelStats.spiBytes, (unsigned)modelStats.linesLatched,
+           (unsigned)modelStats.scanLinesDriven,
+           (unsigned)(modelStats.delayTime + (modelStats.spiTime / 1000u)));
+
+    if ((modelStats.protocolErrors != 0u) || (modelStats.bufferErrors != 0u))
+    {
+        printf("  FAIL: %u malformed commands, %u changed bulk transfers\n",
+               (unsigned)modelStats.protocolErrors,
+               (unsigned)modelStats.bufferErrors);
+        passed = false;
+    }
+    if ((refreshStats != NULL) &&
+        ((refreshStats->spiBytes != modelStats.spiBytes) ||
+         (refreshStats->linesLatched != modelStats.linesLatched)))
+    {
+        printf("  FAIL: driver counted %u bytes and %u lines\n",
+               (unsigned)refreshStats->spiBytes,
+               (unsigned)refreshStats->linesLatched);
+        passed = false;
+    }
+
+    return passed;
+}
+
+/*******************************************************************************
+* Function Name: bool static CheckStageTime(
+*                   cy_eink_refresh_stats_t const* refreshStats)
+********************************************************************************
+*
+* Summary: Checks that each stage of the last update has been driven for the
+*  stage time of the panel, and for at most one extra frame. At the benchmark
+*  temperature the balanced policy drives each stage for the stage time
+*
+*******************************************************************************/
+bool static CheckStageTime(cy_eink_refresh_stats_t const* refreshStats)
+{
+    uint32_t stages;
+    uint32_t stageTime = Cy_EINK_GetPanel()->stageTime;
+
+    if (refreshStats->updateType == CY_EINK_FULL_4STAGE)
+    {
+        stages = 4u;
+    }
+    else if (refreshStats->updateType == CY_EINK_FULL_2STAGE)
+    {
+        stages = 2u;
+    }
+    else
+    {
+        stages = 1u;
+    }
+
+    if ((refreshStats->refreshTime < (stages * stageTime)) ||
+        (refreshStats->refreshTime >
+         (stages * (stageTime + (2u * PV_EINK_FRAME_TIME_ESTIMATE)))))
+    {
+        printf("  FAIL: %u ms for %u stages of %u ms\n",
+               (unsigned)refreshStats->refreshTime, (unsigned)stages,
+               (unsigned)stageTime);
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bool static DecodeImage(
+*                   cy_eink_compressed_image_t const* image,
+*                   cy_eink_frame_t* frame)
+********************************************************************************
+*
+* Summary: Decodes a compressed image into a frame
+*
+*******************************************************************************/
+bool static DecodeImage(cy_eink_compressed_image_t const* image,
+                        cy_eink_frame_t* frame)
+{
+    cy_eink_image_decoder_t decoder;
+    uint16_t line;
+    bool     decoded = true;
+
+    Cy_EINK_StartImageDecoder(&decoder, image);
+    for (line = 0u; line < CY_EINK_LINE_COUNT; line++)
+    {
+        decoded = (Cy_EINK_DecodeImageLine(&decoder,
+                                           &frame[line * CY_EINK_LINE_SIZE]) ==
+                   CY_EINK_SUCCESS) && decoded;
+    }
+
+    return decoded;
+}
+
+/*******************************************************************************
+* Function Name: bool static CheckPanel(cy_eink_frame_t const* image,
+*                   char const* snapshotDir, uint32_t refresh)
+********************************************************************************
+*
+* Summary: Checks that the panel shows an image, and writes the snapshot of the
+*  panel
+*
+*******************************************************************************/
+bool static CheckPanel(cy_eink_frame_t const* image, char const* snapshotDir,
+                       uint32_t refresh)
+{
+    char fileName[256];
+    bool passed = true;
+
+    if (memcmp(EinkModel_GetImage(), image, CY_EINK_FRAME_SIZE) != 0)
+    {
+        printf("  FAIL: the panel does not show the new frame\n");
+        passed = false;
+    }
+
+    snprintf(fileName, sizeof(fileName), "%s/refresh_%02u.pbm", snapshotDir,
+             (unsigned)refresh);
+    if (!EinkModel_WritePbm(fileName, EinkModel_GetImage()))
+    {
+        printf("  FAIL: snapshot %s\n", fileName);
+        passed = false;
+    }
+
+    return passed;
+}
+
+/*******************************************************************************
+* Function Name: void static MeasureDecoder(
+*                   cy_eink_compressed_image_t const* image)
+********************************************************************************
+*
+* Summary: Prints the host time taken to decode a compressed image, and its
+*  size
+*
+*******************************************************************************/
+void static MeasureDecoder(cy_eink_compressed_image_t const* image)
+{
+    struct timespec startTime;
+    struct timespec endTime;
+    double   decodeTime;
+    uint32_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (i = 0u; i < DECODE_REPETITIONS; i++)
+    {
+        (void)DecodeImage(image, expectedImage);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    decodeTime = ((double)(endTime.tv_sec - startTime.tv_sec) * 1e9) +
+                 (double)(endTime.tv_nsec - startTime.tv_nsec);
+    printf("\nCompressed image: %u bytes (%u%% of a frame), decoded in "
+           "%.1f us on the host\n", (unsigned)image->dataSize,
+           (unsigned)((image->dataSize * 100u) / CY_EINK_FRAME_SIZE),
+           decodeTime / (DECODE_REPETITIONS * 1e3));
+}
+
+/*******************************************************************************
+* Function Name: int main(int argc, char** argv)
+********************************************************************************
+*
+* Summary: Runs the refreshes of the benchmark
+*
+* Parameters:
+*  argv[1] : Directory of the PBM snapshots (optional, default: current)
+*
+* Return:
+*  int : 0 if all refreshes have passed
+*
+*******************************************************************************/
+int main(int argc, char** argv)
+{
+    char const* snapshotDir = (argc > 1) ? argv[1] : ".";
+    bool        passed = true;
+    uint32_t    i;
+    cy_eink_refresh_stats_t refreshStats;
+
+    /* Refreshes of the benchmark: one per update type, and the updates from
+       and to the white and black frames */
+    benchmark_refresh_t const refreshes[] =
+    {
+        {"startup",       PV_EINK_WHITE_FRAME_ADDRESS, menuFrame,
+                          CY_EINK_FULL_4STAGE},
+        {"cursor move",   menuFrame,       cursorFrame,     CY_EINK_PARTIAL},
+        {"page",          cursorFrame,     textFrame,       CY_EINK_FULL_2STAGE},
+        {"page edit",     textFrame,       editedTextFrame, CY_EINK_AUTO},
+        {"page undo",     editedTextFrame, textFrame,       CY_EINK_PARTIAL},
+        {"clear",         textFrame,       PV_EINK_WHITE_FRAME_ADDRESS,
+                          CY_EINK_AUTO},
+        {"black",         PV_EINK_WHITE_FRAME_ADDRESS,
+                          PV_EINK_BLACK_FRAME_ADDRESS, CY_EINK_PARTIAL},
+        {"menu",          PV_EINK_BLACK_FRAME_ADDRESS, menuFrame,
+                          CY_EINK_FULL_4STAGE}
+    };
+    
+    /* The compressed startup logo is shown over the last frame, which is
+       described by an image without data */
+    cy_eink_compressed_image_t const lastImage = {NULL, 0u, menuFrame};
+
+    DrawScreens();
+    if (!DecodeImage(&startupLogoImage, logoFrame))
+    {
+        printf("FAIL: the compressed image is truncated\n");
+        return EXIT_FAILURE;
+    }
+
+    /* The panel starts white, and is refreshed without delays */
+    EinkModel_Reset(PV_EINK_WHITE_PIXEL_BYTE);
+    Cy_EINK_RegisterTimeFunction(EinkModel_GetTime);
+    if (Cy_EINK_Start(BENCHMARK_TEMPERATURE, EinkModel_Delay) !=
+        CY_EINK_SUCCESS)
+    {
+        printf("FAIL: E-INK start\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Panel %s, %u x %u, line streaming %u\n\n", Cy_EINK_GetPanel()->name,
+           (unsigned)PV_EINK_PANEL_WIDTH, (unsigned)PV_EINK_PANEL_HEIGHT,
+           (unsigned)PV_EINK_LINE_STREAMING);
+    printf("%-24s %-13s %8s %8s %8s %8s\n", "refresh", "update", "bytes",
+           "latched", "driven", "ms");
+
+    EinkModel_GetStats(NULL, true);
+    if (Cy_EINK_Power(CY_EINK_ON) != CY_EINK_SUCCESS)
+    {
+        printf("FAIL: E-INK power on\n");
+        passed = false;
+    }
+    passed = CheckStats("power on", "", NULL) && passed;
+
+    for (i = 0u; i < (sizeof(refreshes) / sizeof(refreshes[0])); i++)
+    {
+        Cy_EINK_ShowFrame(refreshes[i].prevFrame, refreshes[i].newFrame,
+                          refreshes[i].updateType, false);
+        Cy_EINK_GetRefreshStats(&refreshStats);
+        passed = CheckStats(refreshes[i].name,
+                            updateName[refreshStats.updateType],
+                            &refreshStats) && passed;
+        passed = CheckStageTime(&refreshStats) && passed;
+
+        /* The panel must show the new frame */
+        ExpectedImage(refreshes[i].newFrame, expectedImage);
+        passed = CheckPanel(expectedImage, snapshotDir, i) && passed;
+    }
+
+    if (Cy_EINK_ShowCompressedImage(&lastImage, &startupLogoImage,
+                                    CY_EINK_AUTO, false) != CY_EINK_SUCCESS)
+    {
+        printf("FAIL: compressed image\n");
+        passed = false;
+    }
+    Cy_EINK_GetRefreshStats(&refreshStats);
+    passed = CheckStats("compressed logo", updateName[refreshStats.updateType],
+                        &refreshStats) && passed;
+    passed = CheckStageTime(&refreshStats) && passed;
+    passed = CheckPanel(logoFrame, snapshotDir, i) && passed;
+
+    if (Cy_EINK_Power(CY_EINK_OFF) != CY_EINK_SUCCESS)
+    {
+        printf("FAIL: E-INK power off\n");
+        passed = false;
+    }
+    passed = CheckStats("power off", "", NULL) && passed;
+
+    MeasureDecoder(&startupLogoImage);
+
+    printf("\n%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,471 @@
+/******************************************************************************
+* File Name: eink_encoder_test.c
+*
+* Version: 1.00
+*
+* Description: This file contains the tests and the benchmark of the encoding
+*              tables of pervasive_eink_hardware_driver.c
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* The stages of a refresh encode each image byte into an Odd and an Even driver
+* byte with the lookup tables of pervasive_eink_hardware_driver.c. The tests
+* compare every entry of the tables with the conditional encoder that the
+* driver used before, for the four full update stages and for the partial
+* update of every pair of previous and new image bytes. The benchmark then
+* compares the time taken by both encoders to encode a frame.
+*
+* The program returns a non-zero exit code if any test fails.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cy_cy8ckit_028_epd/pervasive_eink_hardware_driver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Number of repetitions of the benchmark */
+#define BENCHMARK_REPETITIONS   (2000u)
+
+/* Number of image byte values, which is the size of an encoding table */
+#define ENCODE_TABLE_SIZE       (256u)
+
+/* Number of full update stages */
+#define STAGE_COUNT             (4u)
+
+/* Encoding tables of pervasive_eink_hardware_driver.c */
+extern uint8_t const stageOddTable[STAGE_COUNT][ENCODE_TABLE_SIZE];
+extern uint8_t const stageEvenTable[STAGE_COUNT][ENCODE_TABLE_SIZE];
+extern uint8_t const changedOddTable[ENCODE_TABLE_SIZE];
+extern uint8_t const changedEvenTable[ENCODE_TABLE_SIZE];
+
+/* Image frames and the Odd and Even bytes of an encoded frame */
+uint8_t static previousFrame[PV_EINK_IMAGE_SIZE];
+uint8_t static newFrame[PV_EINK_IMAGE_SIZE];
+uint8_t static oddBytes[PV_EINK_IMAGE_SIZE];
+uint8_t static evenBytes[PV_EINK_IMAGE_SIZE];
+
+/*******************************************************************************
+* Function Name: void static EncodeConditional(uint8_t tempByte,
+*                   pv_eink_stage_t stageNumber, uint8_t* odd, uint8_t* even)
+********************************************************************************
+*
+* Summary: Reference encoder of a full update stage, the conditional code that
+*  Pv_EINK_FullStageHandler used before the encoding tables
+*
+*******************************************************************************/
+void static EncodeConditional(uint8_t tempByte, pv_eink_stage_t stageNumber,
+                              uint8_t* odd, uint8_t* even)
+{
+    switch (stageNumber)
+    {
+    /* Stage 1: Calculate the inverted Even and Odd bytes of the previous 
+       image data */
+    case PV_EINK_STAGE1:
+        *odd   = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
+                  PV_EINK_BLACK3 : PV_EINK_WHITE3);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_B)  ? 
+                  PV_EINK_BLACK2 : PV_EINK_WHITE2);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_C)  ? 
+                  PV_EINK_BLACK1 : PV_EINK_WHITE1);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_D)  ? 
+                  PV_EINK_BLACK0 : PV_EINK_WHITE0);
+        *even  = ((tempByte & PV_EINK_EVEN_MASK_A) ? 
+                  PV_EINK_BLACK0 : PV_EINK_WHITE0);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
+                  PV_EINK_BLACK1 : PV_EINK_WHITE1);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_C) ? 
+                  PV_EINK_BLACK2 : PV_EINK_WHITE2);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
+                  PV_EINK_BLACK3 : PV_EINK_WHITE3);
+        break;
+    /* Stage 2: Calculate the Even and Odd bytes of an all-white frame */
+    case PV_EINK_STAGE2:
+        *odd   = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
+                  PV_EINK_WHITE3 : PV_EINK_NOTHING3);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_B)  ? 
+                  PV_EINK_WHITE2 : PV_EINK_NOTHING2);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_C)  ? 
+                  PV_EINK_WHITE1 : PV_EINK_NOTHING1);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_D)  ? 
+                  PV_EINK_WHITE0 : PV_EINK_NOTHING0);
+        *even  = ((tempByte & PV_EINK_EVEN_MASK_A) ?
+                  PV_EINK_WHITE0 : PV_EINK_NOTHING0);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
+                  PV_EINK_WHITE1 : PV_EINK_NOTHING1);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_C) ? 
+                  PV_EINK_WHITE2 : PV_EINK_NOTHING2);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
+                  PV_EINK_WHITE3 : PV_EINK_NOTHING3);
+        break;
+    /* Stage 3: Calculate the inverted Even and Odd bytes of the new image 
+       data */
+    case PV_EINK_STAGE3:
+        *odd   = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
+                  PV_EINK_BLACK3 : PV_EINK_NOTHING3);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_B)  ? 
+                  PV_EINK_BLACK2 : PV_EINK_NOTHING2);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_C)  ?
+                  PV_EINK_BLACK1 : PV_EINK_NOTHING1);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_D)  ?
+                  PV_EINK_BLACK0 : PV_EINK_NOTHING0);
+        *even  = ((tempByte & PV_EINK_EVEN_MASK_A) ?
+                  PV_EINK_BLACK0 : PV_EINK_NOTHING0);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
+                  PV_EINK_BLACK1 : PV_EINK_NOTHING1);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_C) ? 
+                  PV_EINK_BLACK2 : PV_EINK_NOTHING2);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
+                  PV_EINK_BLACK3 : PV_EINK_NOTHING3);
+        break;
+    /* Stage 4: Calculate the Even and Odd bytes of new image data */
+    case PV_EINK_STAGE4:
+        *odd   = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
+                  PV_EINK_WHITE3 : PV_EINK_BLACK3);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_B)  ?
+                  PV_EINK_WHITE2 : PV_EINK_BLACK2);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_C)  ? 
+                  PV_EINK_WHITE1 : PV_EINK_BLACK1);
+        *odd  |= ((tempByte & PV_EINK_ODD_MASK_D)  ? 
+                  PV_EINK_WHITE0 : PV_EINK_BLACK0);
+        *even  = ((tempByte & PV_EINK_EVEN_MASK_A) ? 
+                  PV_EINK_WHITE0 : PV_EINK_BLACK0);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
+                  PV_EINK_WHITE1 : PV_EINK_BLACK1);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_C) ?
+                  PV_EINK_WHITE2 : PV_EINK_BLACK2);
+        *even |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
+                  PV_EINK_WHITE3 : PV_EINK_BLACK3);
+        break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static EncodePartialConditional(uint8_t oldByte,
+*                   uint8_t newByte, uint8_t* odd, uint8_t* even)
+********************************************************************************
+*
+* Summary: Reference encoder of the partial update, the conditional code that 
+*  Pv_EINK_PartialStageHandler used before the encoding tables
+*
+*******************************************************************************/
+void static EncodePartialConditional(uint8_t oldByte, uint8_t newByte,
+                                     uint8_t* odd, uint8_t* even)
+{
+    *odd   = ((oldByte ^ newByte) & PV_EINK_ODD_MASK_A)
+             ?((newByte & PV_EINK_ODD_MASK_A)
+             ? PV_EINK_WHITE3
+             : PV_EINK_BLACK3) : PV_EINK_NOTHING3;
+    *odd  |= ((oldByte ^ newByte) & PV_EINK_ODD_MASK_B)
+             ?((newByte & PV_EINK_ODD_MASK_B) 
+             ? PV_EINK_WHITE2 
+             : PV_EINK_BLACK2) : PV_EINK_NOTHING2;
+    *odd  |= ((oldByte ^ newByte) & PV_EINK_ODD_MASK_C)
+             ?((newByte & PV_EINK_ODD_MASK_C) 
+             ? PV_EINK_WHITE1
+             : PV_EINK_BLACK1) : PV_EINK_NOTHING1;
+    *odd  |= ((oldByte ^ newByte) & PV_EINK_ODD_MASK_D)
+             ?((newByte & PV_EINK_ODD_MASK_D) 
+             ? PV_EINK_WHITE0 
+             : PV_EINK_BLACK0) : PV_EINK_NOTHING0;
+    *even  = ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_A)
+             ?((newByte & PV_EINK_EVEN_MASK_A) 
+             ? PV_EINK_WHITE0
+             : PV_EINK_BLACK0) : PV_EINK_NOTHING0;
+    *even |= ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_B) 
+             ?((newByte & PV_EINK_EVEN_MASK_B) 
+             ? PV_EINK_WHITE1
+             : PV_EINK_BLACK1) : PV_EINK_NOTHING1;
+    *even |= ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_C)
+             ?((newByte & PV_EINK_EVEN_MASK_C) 
+             ? PV_EINK_WHITE2 
+             : PV_EINK_BLACK2) : PV_EINK_NOTHING2;
+    *even |= ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_D)
+             ?((newByte & PV_EINK_EVEN_MASK_D) 
+             ? PV_EINK_WHITE3 
+             : PV_EINK_BLACK3) : PV_EINK_NOTHING3;
+}
+
+/*******************************************************************************
+* Function Name: void static EncodePartialTable(uint8_t oldByte, 
+*                   uint8_t newByte, uint8_t* odd, uint8_t* even)
+********************************************************************************
+*
+* Summary: Table encoder of the partial update, as in 
+*  Pv_EINK_EncodePartialLine: the stage 4 bytes of the changed pixels and 
+*  "nothing" pixels elsewhere
+*
+*******************************************************************************/
+void static EncodePartialTable(uint8_t oldByte, uint8_t newByte, uint8_t* odd,
+                               uint8_t* even)
+{
+    uint8_t changedMask;
+
+    changedMask = changedOddTable[oldByte ^ newByte];
+    *odd  = (stageOddTable[PV_EINK_STAGE4][newByte] & changedMask) |
+            (PV_EINK_NOTHING & (uint8_t)~changedMask);
+    changedMask = changedEvenTable[oldByte ^ newByte];
+    *even = (stageEvenTable[PV_EINK_STAGE4][newByte] & changedMask) |
+            (PV_EINK_NOTHING & (uint8_t)~changedMask);
+}
+
+/*******************************************************************************
+* Function Name: uint32_t static TestTables(void)
+********************************************************************************
+*
+* Summary: Compares every entry of the stage tables and every combination of 
+*  the partial update with the conditional encoders, and returns the number 
+*  of mismatches
+*
+*******************************************************************************/
+uint32_t static TestTables(void)
+{
+    uint32_t failures = 0u;
+    uint32_t stage;
+    uint32_t oldByte;
+    uint32_t newByte;
+    uint8_t  odd;
+    uint8_t  even;
+    uint8_t  tableOdd;
+    uint8_t  tableEven;
+
+    for (stage = 0u; stage < STAGE_COUNT; stage++)
+    {
+        for (newByte = 0u; newByte < ENCODE_TABLE_SIZE; newByte++)
+        {
+            EncodeConditional((uint8_t)newByte, (pv_eink_stage_t)stage, &odd,
+                              &even);
+            if ((stageOddTable[stage][newByte] != odd) ||
+                (stageEvenTable[stage][newByte] != even))
+            {
+                printf("FAIL: stage %u byte 0x%02X: table %02X %02X, "
+                       "conditional %02X %02X\n", (unsigned)(stage + 1u),
+                       (unsigned)newByte, stageOddTable[stage][newByte],
+                       stageEvenTable[stage][newByte], odd, even);
+                failures++;
+            }
+        }
+    }
+
+    for (oldByte = 0u; oldByte < ENCODE_TABLE_SIZE; oldByte++)
+    {
+        for (newByte = 0u; newByte < ENCODE_TABLE_SIZE; newByte++)
+        {
+            EncodePartialConditional((uint8_t)oldByte, (uint8_t)newByte, &odd,
+                                     &even);
+            EncodePartialTable((uint8_t)oldByte, (uint8_t)newByte, &tableOdd,
+                               &tableEven);
+            if ((tableOdd != odd) || (tableEven != even))
+            {
+                printf("FAIL: partial 0x%02X -> 0x%02X: table %02X %02X, "
+                       "conditional %02X %02X\n", (unsigned)oldByte,
+                       (unsigned)newByte, tableOdd, tableEven, odd, even);
+                failures++;
+            }
+        }
+    }
+
+    return failures;
+}
+
+/*******************************************************************************
+* Function Name: void static EncodeFrame(pv_eink_stage_t stageNumber, 
+*                                        bool tables)
+********************************************************************************
+*
+* Summary: Encodes the new frame for a full update stage, with the tables or
+*  with the conditional encoder
+*
+*******************************************************************************/
+void static __attribute__((noinline)) EncodeFrame(pv_eink_stage_t stageNumber,
+                                                  bool tables)
+{
+    uint8_t const* oddTable  = stageOddTable[stageNumber];
+    uint8_t const* evenTable = stageEvenTable[stageNumber];
+    uint32_t i;
+
+    for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+    {
+        if (tables)
+        {
+            oddBytes[i]  = oddTable[newFrame[i]];
+            evenBytes[i] = evenTable[newFrame[i]];
+        }
+        else
+        {
+            EncodeConditional(newFrame[i], stageNumber, &oddBytes[i],
+                              &evenBytes[i]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static EncodePartialFrame(bool tables)
+********************************************************************************
+*
+* Summary: Encodes the change from the previous to the new frame for a partial
+*  update, with the tables or with the conditional encoder
+*
+*******************************************************************************/
+void static __attribute__((noinline)) EncodePartialFrame(bool tables)
+{
+    uint32_t i;
+
+    for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+    {
+        if (tables)
+        {
+            EncodePartialTable(previousFrame[i], newFrame[i], &oddBytes[i],
+                               &evenBytes[i]);
+        }
+        else
+        {
+            EncodePartialConditional(previousFrame[i], newFrame[i],
+                                     &oddBytes[i], &evenBytes[i]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: double static ElapsedTime(struct timespec const* startTime)
+********************************************************************************
+*
+* Summary: Returns the time since startTime per benchmark repetition, in ns
+*
+*******************************************************************************/
+double static ElapsedTime(struct timespec const* startTime)
+{
+    struct timespec endTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+    return (((double)(endTime.tv_sec - startTime->tv_sec) * 1e9) +
+            (double)(endTime.tv_nsec - startTime->tv_nsec)) /
+           BENCHMARK_REPETITIONS;
+}
+
+/*******************************************************************************
+* Function Name: void static Benchmark(void)
+********************************************************************************
+*
+* Summary: Prints the time taken to encode a frame of random pixels with the
+*  tables and with the conditional encoders, for each update stage
+*
+*******************************************************************************/
+void static Benchmark(void)
+{
+    struct timespec startTime;
+    uint32_t repetition;
+    uint32_t stage;
+    uint32_t i;
+    bool     tables;
+
+    for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+    {
+        previousFrame[i] = (uint8_t)rand();
+        newFrame[i] = (uint8_t)rand();
+    }
+
+    printf("\n%-20s %12s %12s\n", "frame encoding", "table (ns)",
+           "branch (ns)");
+
+    for (stage = 0u; stage <= STAGE_COUNT; stage++)
+    {
+        if (stage < STAGE_COUNT)
+        {
+            printf("%-14s %-5u", "full stage", (unsigned)(stage + 1u));
+        }
+        else
+        {
+            printf("%-20s", "partial");
+        }
+
+        for (tables = true; ; tables = false)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &startTime);
+            for (repetition = 0u; repetition < BENCHMARK_REPETITIONS;
+                 repetition++)
+            {
+                if (stage < STAGE_COUNT)
+                {
+                    EncodeFrame((pv_eink_stage_t)stage, tables);
+                }
+                else
+                {
+                    EncodePartialFrame(tables);
+                }
+                /* Keep the compiler from merging the repetitions */
+                __asm__ volatile("" : : "r"(oddBytes), "r"(evenBytes) :
+                                 "memory");
+            }
+            printf(" %12.0f", ElapsedTime(&startTime));
+            if (!tables)
+            {
+                break;
+            }
+        }
+        printf("\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: int main(void)
+********************************************************************************
+*
+* Summary: Runs the tests and the benchmark of the encoding tables
+*
+* Return:
+*  int : 0 if all tests have passed
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t failures = TestTables();
+
+    printf("Encoder tests: %u stage entries, %u partial combinations, "
+           "%u failures\n", (unsigned)(STAGE_COUNT * ENCODE_TABLE_SIZE),
+           (unsigned)(ENCODE_TABLE_SIZE * ENCODE_TABLE_SIZE),
+           (unsigned)failures);
+
+    srand(1u);
+    Benchmark();
+
+    printf("\n%s\n", (failures == 0u) ? "PASSED" : "FAILED");
+    return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
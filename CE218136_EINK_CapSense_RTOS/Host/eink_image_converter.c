@@ -0,0 +1,371 @@
+/******************************************************************************
+* File Name: eink_image_converter.c
+*
+* Version: 1.00
+*
+* Description: This file contains the converter of PBM images to compressed
+*              E-INK images, which are shown with Cy_EINK_ShowCompressedImage
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* Usage: eink_image_converter <image.pbm> <image.c> <name>
+*
+* The converter reads a PBM image (P1 or P4) of the size of the panel, and
+* writes a C source file that defines the compressed image "name" of type
+* cy_eink_compressed_image_t. The frame bytes are stored as runs and literal
+* packets (see CY_EINK_RLE_REPEAT_FLAG). The output is decoded again with the
+* decoder of the E-INK library and compared with the input before it is
+* written.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Largest size of a compressed image: one literal packet per 128 bytes */
+#define CONVERTER_MAX_DATA_SIZE     (CY_EINK_FRAME_SIZE +                      \
+                                     (CY_EINK_FRAME_SIZE / 128u) + 1u)
+
+/* Maximum number of bytes of a packet, and the shortest run that is stored
+   as a run packet */
+#define CONVERTER_PACKET_SIZE       (CY_EINK_RLE_LENGTH_MASK + 1u)
+#define CONVERTER_MIN_RUN           (3u)
+
+/* Number of data bytes per line of the output file */
+#define CONVERTER_BYTES_PER_LINE    (10u)
+
+/* Frame read from the PBM image, the compressed data, and the decoded frame */
+cy_eink_frame_t static inputFrame[CY_EINK_FRAME_SIZE];
+uint8_t static         compressedData[CONVERTER_MAX_DATA_SIZE];
+cy_eink_frame_t static decodedFrame[CY_EINK_FRAME_SIZE];
+
+/*******************************************************************************
+* Function Name: int static ReadPbmNumber(FILE* file)
+********************************************************************************
+*
+* Summary: Reads a decimal number of a PBM header, skipping white space and
+*  comments
+*
+* Return:
+*  int : Number, or -1 if the header is malformed
+*
+*******************************************************************************/
+int static ReadPbmNumber(FILE* file)
+{
+    int character = fgetc(file);
+    int number = -1;
+
+    /* Skip white space and comments */
+    while ((character == ' ') || (character == '\t') || (character == '\r') ||
+           (character == '\n') || (character == '#'))
+    {
+        if (character == '#')
+        {
+            while ((character != '\n') && (character != EOF))
+            {
+                character = fgetc(file);
+            }
+        }
+        character = fgetc(file);
+    }
+
+    while ((character >= '0') && (character <= '9'))
+    {
+        number = ((number < 0) ? 0 : (number * 10)) + (character - '0');
+        character = fgetc(file);
+    }
+
+    return number;
+}
+
+/*******************************************************************************
+* Function Name: bool static ReadPbm(char const* fileName,
+*                                    cy_eink_frame_t* frame)
+********************************************************************************
+*
+* Summary: Reads a PBM image of the size of the panel into a frame. PBM uses 1
+*  for black, and the frame 1 for white.
+*
+*******************************************************************************/
+bool static ReadPbm(char const* fileName, cy_eink_frame_t* frame)
+{
+    FILE*    file = fopen(fileName, "rb");
+    bool     valid = false;
+    int      format;
+    int      pixel;
+    uint32_t i;
+
+    if (file == NULL)
+    {
+        printf("Error: can't open %s\n", fileName);
+        return false;
+    }
+
+    format = (fgetc(file) == 'P') ? fgetc(file) : EOF;
+    if (((format == '1') || (format == '4')) &&
+        (ReadPbmNumber(file) == (int)PV_EINK_PANEL_WIDTH) &&
+        (ReadPbmNumber(file) == (int)PV_EINK_PANEL_HEIGHT))
+    {
+        valid = true;
+        for (i = 0u; (i < (CY_EINK_FRAME_SIZE * 8u)) && valid; i++)
+        {
+            /* P4 stores 8 pixels per byte, P1 one digit per pixel */
+            if (format == '4')
+            {
+                pixel = fgetc(file);
+                if (pixel != EOF)
+                {
+                    frame[i / 8u] = (cy_eink_frame_t)~pixel;
+                }
+                i += 7u;
+            }
+            else
+            {
+                do
+                {
+                    pixel = fgetc(file);
+                }
+                while ((pixel == ' ') || (pixel == '\t') || (pixel == '\r') ||
+                       (pixel == '\n'));
+                if (pixel == '0')
+                {
+                    frame[i / 8u] |= (cy_eink_frame_t)(0x80u >> (i % 8u));
+                }
+                else
+                {
+                    frame[i / 8u] &= (cy_eink_frame_t)~(0x80u >> (i % 8u));
+                }
+                pixel = ((pixel == '0') || (pixel == '1')) ? pixel : EOF;
+            }
+            valid = (pixel != EOF);
+        }
+    }
+
+    if (!valid)
+    {
+        printf("Error: %s is not a %u x %u PBM image\n", fileName,
+               (unsigned)PV_EINK_PANEL_WIDTH, (unsigned)PV_EINK_PANEL_HEIGHT);
+    }
+    fclose(file);
+
+    return valid;
+}
+
+/*******************************************************************************
+* Function Name: uint16_t static CompressFrame(cy_eink_frame_t const* frame,
+*                                              uint8_t* data)
+********************************************************************************
+*
+* Summary: Compresses a frame into run and literal packets. Runs of at least
+*  CONVERTER_MIN_RUN bytes are stored as run packets.
+*
+* Return:
+*  uint16_t : Size of the compressed data in bytes
+*
+*******************************************************************************/
+uint16_t static CompressFrame(cy_eink_frame_t const* frame, uint8_t* data)
+{
+    uint16_t dataSize = 0u;
+    uint32_t index = 0u;
+    uint32_t literalStart;
+    uint32_t run;
+
+    while (index < CY_EINK_FRAME_SIZE)
+    {
+        /* Measure the run at the current byte */
+        run = 1u;
+        while (((index + run) < CY_EINK_FRAME_SIZE) &&
+               (run < CONVERTER_PACKET_SIZE) &&
+               (frame[index + run] == frame[index]))
+        {
+            run++;
+        }
+
+        if (run >= CONVERTER_MIN_RUN)
+        {
+            data[dataSize++] = CY_EINK_RLE_REPEAT_FLAG | (uint8_t)(run - 1u);
+            data[dataSize++] = frame[index];
+            index += run;
+        }
+        else
+        {
+            /* Collect literal bytes up to the next run */
+            literalStart = index;
+            while ((index < CY_EINK_FRAME_SIZE) &&
+                   ((index - literalStart) < CONVERTER_PACKET_SIZE) &&
+                   !(((index + 2u) < CY_EINK_FRAME_SIZE) &&
+                     (frame[index + 1u] == frame[index]) &&
+                     (frame[index + 2u] == frame[index])))
+            {
+                index++;
+            }
+            data[dataSize++] = (uint8_t)(index - literalStart - 1u);
+            memcpy(&data[dataSize], &frame[literalStart],
+                   index - literalStart);
+            dataSize += (uint16_t)(index - literalStart);
+        }
+    }
+
+    return dataSize;
+}
+
+/*******************************************************************************
+* Function Name: bool static WriteSource(char const* fileName,
+*                   char const* imageName, char const* inputName,
+*                   uint8_t const* data, uint16_t dataSize)
+********************************************************************************
+*
+* Summary: Writes the C source file of a compressed image
+*
+*******************************************************************************/
+bool static WriteSource(char const* fileName, char const* imageName,
+                        char const* inputName, uint8_t const* data,
+                        uint16_t dataSize)
+{
+    FILE*    file = fopen(fileName, "w");
+    uint16_t i;
+
+    if (file == NULL)
+    {
+        printf("Error: can't create %s\n", fileName);
+        return false;
+    }
+
+    fprintf(file,
+        "/******************************************************************"
+        "************\n"
+        "* Compressed E-INK image %s, %u x %u pixels, %u bytes\n"
+        "*\n"
+        "* This file has been generated by the E-INK image converter "
+        "(Host/) from\n"
+        "* %s. Do not edit.\n"
+        "*******************************************************************"
+        "***********/\n\n"
+        "/* Header file includes */\n"
+        "#include \"./cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h\"\n\n"
+        "/* Packets of the image */\n"
+        "uint8_t static const %sData[] =\n{",
+        imageName, (unsigned)PV_EINK_PANEL_WIDTH,
+        (unsigned)PV_EINK_PANEL_HEIGHT, (unsigned)dataSize, inputName,
+        imageName);
+
+    for (i = 0u; i < dataSize; i++)
+    {
+        fprintf(file, "%s0x%02Xu%s",
+                ((i % CONVERTER_BYTES_PER_LINE) == 0u) ? "\n    " : " ",
+                (unsigned)data[i], (i < (dataSize - 1u)) ? "," : "");
+    }
+
+    fprintf(file,
+        "\n};\n\n"
+        "/* Compressed image */\n"
+        "cy_eink_compressed_image_t const %s =\n"
+        "{\n"
+        "    %sData, (uint16_t)sizeof(%sData), NULL\n"
+        "};\n\n"
+        "/* [] END OF FILE */\n",
+        imageName, imageName, imageName);
+
+    return (fclose(file) == 0);
+}
+
+/*******************************************************************************
+* Function Name: int main(int argc, char** argv)
+********************************************************************************
+*
+* Summary: Converts a PBM image to a compressed image
+*
+* Parameters:
+*  argv[1] : PBM image
+*  argv[2] : C source file to be written
+*  argv[3] : Name of the compressed image
+*
+* Return:
+*  int : 0 if the image has been converted
+*
+*******************************************************************************/
+int main(int argc, char** argv)
+{
+    cy_eink_compressed_image_t image;
+    cy_eink_image_decoder_t    decoder;
+    uint16_t line;
+    bool     decoded = true;
+
+    if (argc != 4)
+    {
+        printf("Usage: %s <image.pbm> <image.c> <name>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!ReadPbm(argv[1], inputFrame))
+    {
+        return EXIT_FAILURE;
+    }
+
+    image.data      = compressedData;
+    image.dataSize  = CompressFrame(inputFrame, compressedData);
+    image.reference = NULL;
+
+    /* Check the image with the decoder of the library */
+    Cy_EINK_StartImageDecoder(&decoder, &image);
+    for (line = 0u; line < CY_EINK_LINE_COUNT; line++)
+    {
+        decoded = (Cy_EINK_DecodeImageLine(&decoder,
+                                &decodedFrame[line * CY_EINK_LINE_SIZE]) ==
+                   CY_EINK_SUCCESS) && decoded;
+    }
+    if (!decoded || (decoder.dataIndex != image.dataSize) ||
+        (memcmp(decodedFrame, inputFrame, CY_EINK_FRAME_SIZE) != 0))
+    {
+        printf("Error: the compressed image does not decode to %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    if (!WriteSource(argv[2], argv[3], argv[1], compressedData,
+                     image.dataSize))
+    {
+        return EXIT_FAILURE;
+    }
+    printf("%s: %u bytes (frame: %u bytes)\n", argv[3],
+           (unsigned)image.dataSize, (unsigned)CY_EINK_FRAME_SIZE);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
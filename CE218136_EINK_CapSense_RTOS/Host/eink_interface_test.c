@@ -0,0 +1,517 @@
+/******************************************************************************
+* File Name: eink_interface_test.c
+*
+* Version: 1.00
+*
+* Description: This file contains the tests of the E-INK interface of
+*              cy_eink_psoc_interface.c on the emulated SCB
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* The test drives the E-INK interface (cy_eink_psoc_interface.c) over the
+* emulated SCB of cy_pdl_host.c, and compares the bytes and the chip select
+* edges seen on the SPI bus with the expected sequences:
+* - single bytes, register reads and bulk transfers, polled or waited for with
+*   the registered wait and complete functions
+* - bulk transfers rejected by the SCB driver, which are sent byte by byte
+* - bulk data changed while it is being sent, which must be detected
+*
+* A power on, a full update, a partial update and a power off are then sent
+* with each transfer mode, and the SPI log of every mode must be identical to
+* the log of the polled bulk transfers.
+*
+* The program returns a non-zero exit code if a test fails.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h"
+#include "cy_pdl_host.h"
+#include "eink_panel_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Entries of the SPI log of the direct interface tests, and of a display
+   sequence */
+#define TEST_LOG_SIZE           (1024u)
+#define SEQUENCE_LOG_SIZE       (1u << 21)
+
+/* Ambient temperature of the display sequence, in degree Celsius. The stage
+   time is short at high temperatures, which keeps the SPI logs short */
+#define SEQUENCE_TEMPERATURE    (int8_t)(45)
+
+/* Bulk transfer longer than the FIFO of the SCB */
+#define LONG_TRANSFER_SIZE      (200u)
+
+/* Data-type of a transfer mode of the display sequence */
+typedef struct
+{
+    char const* name;
+    bool        waitFunctions;      /* Wait and complete functions registered */
+    uint32_t    rejectInterval;     /* Interval of the rejected transfers */
+}   test_mode_t;
+
+/* Frames of the display sequence */
+cy_eink_frame_t static patternFrame[CY_EINK_FRAME_SIZE]
+                __attribute__((aligned(4)));
+cy_eink_frame_t static editedFrame[CY_EINK_FRAME_SIZE]
+                __attribute__((aligned(4)));
+
+/* SPI logs */
+uint16_t static testLog[TEST_LOG_SIZE];
+uint16_t static referenceLog[SEQUENCE_LOG_SIZE];
+uint16_t static sequenceLog[SEQUENCE_LOG_SIZE];
+
+/* Calls of the wait and complete functions */
+uint32_t static waitCalls;
+uint32_t static completeCalls;
+bool static     waitFailed;
+
+/*******************************************************************************
+* Function Name: void static WaitForTransfer(void)
+********************************************************************************
+*
+* Summary: Wait function of the bulk transfers: runs the SCB interrupt until
+*  the transfer complete function has been called
+*
+*******************************************************************************/
+void static WaitForTransfer(void)
+{
+    HostPdl_RunInterrupts();
+    waitCalls++;
+    if (completeCalls != waitCalls)
+    {
+        waitFailed = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static TransferComplete(void)
+********************************************************************************
+*
+* Summary: Complete function of the bulk transfers, called from the SCB
+*  interrupt
+*
+*******************************************************************************/
+void static TransferComplete(void)
+{
+    completeCalls++;
+}
+
+/*******************************************************************************
+* Function Name: void static SetTransferFunctions(bool registered)
+********************************************************************************
+*
+* Summary: Registers the wait and complete functions, or polls the transfers
+*
+*******************************************************************************/
+void static SetTransferFunctions(bool registered)
+{
+    waitCalls     = 0u;
+    completeCalls = 0u;
+    waitFailed    = false;
+    if (registered)
+    {
+        Cy_EINK_RegisterTransferFunctions(WaitForTransfer, TransferComplete);
+    }
+    else
+    {
+        Cy_EINK_RegisterTransferFunctions(NULL, NULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bool static CheckLog(char const* name,
+*                   uint16_t const* expected, uint32_t expectedLength)
+********************************************************************************
+*
+* Summary: Stops the SPI log and compares it with the expected sequence
+*
+*******************************************************************************/
+bool static CheckLog(char const* name, uint16_t const* expected,
+                     uint32_t expectedLength)
+{
+    uint32_t length = HostPdl_StopLog();
+    uint32_t i;
+
+    for (i = 0u; (i < length) && (i < expectedLength); i++)
+    {
+        if (testLog[i] != expected[i])
+        {
+            printf("FAIL: %s: entry %u is 0x%03x instead of 0x%03x\n", name,
+                   (unsigned)i, (unsigned)testLog[i], (unsigned)expected[i]);
+            return false;
+        }
+    }
+    if (length != expectedLength)
+    {
+        printf("FAIL: %s: %u entries instead of %u\n", name, (unsigned)length,
+               (unsigned)expectedLength);
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uint32_t static ExpectedCommand(uint16_t* expected,
+*                   uint8_t regAddr, uint8_t const* data, uint16_t dataLength)
+********************************************************************************
+*
+* Summary: Writes the SPI log of a driver register write to expected, and
+*  returns its number of entries
+*
+*******************************************************************************/
+uint32_t static ExpectedCommand(uint16_t* expected, uint8_t regAddr,
+                                uint8_t const* data, uint16_t dataLength)
+{
+    uint32_t length = 0u;
+    uint16_t i;
+
+    expected[length++] = HOST_PDL_LOG_SELECT;
+    expected[length++] = PV_EINK_REG_INDEX_HEADER;
+    expected[length++] = regAddr;
+    expected[length++] = HOST_PDL_LOG_DESELECT;
+    expected[length++] = HOST_PDL_LOG_SELECT;
+    expected[length++] = PV_EINK_REG_DATA_WRITE;
+    for (i = 0u; i < dataLength; i++)
+    {
+        expected[length++] = data[i];
+    }
+    expected[length++] = HOST_PDL_LOG_DESELECT;
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: void static SendCommand(uint8_t regAddr, uint8_t* data,
+*                   uint16_t dataLength, bool started)
+********************************************************************************
+*
+* Summary: Writes a driver register through the E-INK interface, with a bulk
+*  transfer that is waited for at once, or started and waited for later
+*
+*******************************************************************************/
+void static SendCommand(uint8_t regAddr, uint8_t* data, uint16_t dataLength,
+                        bool started)
+{
+    CY_EINK_CsLow;
+    Cy_EINK_WriteSPI(PV_EINK_REG_INDEX_HEADER);
+    Cy_EINK_WriteSPI(regAddr);
+    CY_EINK_CsHigh;
+    CY_EINK_CsLow;
+    Cy_EINK_WriteSPI(PV_EINK_REG_DATA_WRITE);
+    if (started)
+    {
+        Cy_EINK_StartWriteArraySPI(data, dataLength);
+        Cy_EINK_WaitWriteArraySPI();
+    }
+    else
+    {
+        Cy_EINK_WriteArraySPI(data, dataLength);
+    }
+    CY_EINK_CsHigh;
+}
+
+/*******************************************************************************
+* Function Name: bool static TestTransfers(void)
+********************************************************************************
+*
+* Summary: Tests the single bytes, the register reads and the bulk transfers
+*  of the E-INK interface in each transfer mode
+*
+*******************************************************************************/
+bool static TestTransfers(void)
+{
+    uint8_t  data[LONG_TRANSFER_SIZE];
+    uint16_t expected[TEST_LOG_SIZE];
+    uint32_t expectedLength;
+    uint32_t mode;
+    uint32_t i;
+    uint8_t  driverId;
+    bool     passed = true;
+    host_pdl_stats_t   pdlStats;
+    eink_model_stats_t modelStats;
+
+    for (i = 0u; i < LONG_TRANSFER_SIZE; i++)
+    {
+        data[i] = (uint8_t)((i * 37u) + 11u);
+    }
+
+    /* Register read: the driver ID is returned by the byte that follows the
+       data read header */
+    HostPdl_StartLog(testLog, TEST_LOG_SIZE);
+    CY_EINK_CsLow;
+    Cy_EINK_WriteSPI(PV_EINK_REG_INDEX_HEADER);
+    Cy_EINK_WriteSPI(PV_EINK_DRIVER_ID_COMMAND_INDEX);
+    CY_EINK_CsHigh;
+    CY_EINK_CsLow;
+    Cy_EINK_WriteSPI(PV_EINK_REG_DATA_READ);
+    driverId = Cy_EINK_ReadSPI(PV_EINK_DRIVER_ID_COMMAND_DATA);
+    CY_EINK_CsHigh;
+    expectedLength = ExpectedCommand(expected, PV_EINK_DRIVER_ID_COMMAND_INDEX,
+                                     NULL, 0u);
+    expected[expectedLength - 2u] = PV_EINK_REG_DATA_READ;
+    expected[expectedLength - 1u] = PV_EINK_DRIVER_ID_COMMAND_DATA;
+    expected[expectedLength++]    = HOST_PDL_LOG_DESELECT;
+    passed = CheckLog("register read", expected, expectedLength) && passed;
+    if ((driverId & PV_EINK_DRIVER_ID_MASK) != PV_EINK_DRIVER_ID_CHECK)
+    {
+        printf("FAIL: register read returned 0x%02x\n", (unsigned)driverId);
+        passed = false;
+    }
+
+    /* Bulk transfers of a line, and of more than a FIFO of bytes: polled,
+       waited for, and rejected by the SCB driver every time */
+    for (mode = 0u; mode < 4u; mode++)
+    {
+        SetTransferFunctions((mode & 1u) != 0u);
+        HostPdl_RejectTransfers((mode >= 2u) ? 1u : 0u);
+        HostPdl_GetStats(NULL, true);
+
+        HostPdl_StartLog(testLog, TEST_LOG_SIZE);
+        SendCommand(PV_EINK_PIXEL_DATA_COMMAND_INDEX, data,
+                    PV_EINK_DATA_LINE_SIZE, false);
+        SendCommand(PV_EINK_PIXEL_DATA_COMMAND_INDEX, data,
+                    LONG_TRANSFER_SIZE, true);
+        expectedLength  = ExpectedCommand(expected,
+                                          PV_EINK_PIXEL_DATA_COMMAND_INDEX,
+                                          data, PV_EINK_DATA_LINE_SIZE);
+        expectedLength += ExpectedCommand(&expected[expectedLength],
+                                          PV_EINK_PIXEL_DATA_COMMAND_INDEX,
+                                          data, LONG_TRANSFER_SIZE);
+        passed = CheckLog("bulk transfers", expected, expectedLength) && passed;
+
+        /* Each accepted transfer is sent by one interrupt per FIFO of bytes,
+           and waited for once */
+        HostPdl_GetStats(&pdlStats, true);
+        if ((mode < 2u) &&
+            ((pdlStats.transfers != 2u) || (pdlStats.interrupts != 3u) ||
+             (pdlStats.completeEvents != 2u)))
+        {
+            printf("FAIL: mode %u: %u transfers, %u interrupts, %u events\n",
+                   (unsigned)mode, (unsigned)pdlStats.transfers,
+                   (unsigned)pdlStats.interrupts,
+                   (unsigned)pdlStats.completeEvents);
+            passed = false;
+        }
+        if ((mode >= 2u) &&
+            ((pdlStats.transfers != 0u) || (pdlStats.rejectedTransfers != 2u)))
+        {
+            printf("FAIL: mode %u: %u transfers were not rejected\n",
+                   (unsigned)mode, (unsigned)pdlStats.transfers);
+            passed = false;
+        }
+        if (waitFailed || (waitCalls != (((mode == 1u)) ? 2u : 0u)))
+        {
+            printf("FAIL: mode %u: %u waits, %u complete calls\n",
+                   (unsigned)mode, (unsigned)waitCalls,
+                   (unsigned)completeCalls);
+            passed = false;
+        }
+    }
+    SetTransferFunctions(false);
+    HostPdl_RejectTransfers(0u);
+
+    /* Data changed while it is being sent would corrupt the line */
+    EinkModel_GetStats(NULL, true);
+    CY_EINK_CsLow;
+    Cy_EINK_WriteSPI(PV_EINK_REG_DATA_WRITE);
+    Cy_EINK_StartWriteArraySPI(data, PV_EINK_DATA_LINE_SIZE);
+    data[PV_EINK_DATA_LINE_SIZE - 1u]++;
+    Cy_EINK_WaitWriteArraySPI();
+    CY_EINK_CsHigh;
+    EinkModel_GetStats(&modelStats, true);
+    if (modelStats.bufferErrors != 1u)
+    {
+        printf("FAIL: changed bulk data was not detected\n");
+        passed = false;
+    }
+
+    return passed;
+}
+
+/*******************************************************************************
+* Function Name: void static DrawFrames(void)
+********************************************************************************
+*
+* Summary: Draws the frames of the display sequence: a pattern, and the pattern
+*  with a block of lines inverted
+*
+*******************************************************************************/
+void static DrawFrames(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < CY_EINK_FRAME_SIZE; i++)
+    {
+        patternFrame[i] = (cy_eink_frame_t)((i * 131u) ^ (i >> 5));
+    }
+    memcpy(editedFrame, patternFrame, CY_EINK_FRAME_SIZE);
+    for (i = (40u * CY_EINK_LINE_SIZE); i < (48u * CY_EINK_LINE_SIZE); i++)
+    {
+        editedFrame[i] = (cy_eink_frame_t)~editedFrame[i];
+    }
+}
+
+/*******************************************************************************
+* Function Name: uint32_t static RunSequence(test_mode_t const* mode,
+*                                            uint16_t* log)
+********************************************************************************
+*
+* Summary: Sends the display sequence in a transfer mode, and returns the
+*  number of entries of its SPI log, or 0 if the sequence has failed
+*
+*******************************************************************************/
+uint32_t static RunSequence(test_mode_t const* mode, uint16_t* log)
+{
+    uint32_t length;
+    bool     passed = true;
+    host_pdl_stats_t   pdlStats;
+    eink_model_stats_t modelStats;
+
+    SetTransferFunctions(mode->waitFunctions);
+    HostPdl_RejectTransfers(mode->rejectInterval);
+    HostPdl_GetStats(NULL, true);
+    EinkModel_Reset(PV_EINK_WHITE_PIXEL_BYTE);
+
+    HostPdl_StartLog(log, SEQUENCE_LOG_SIZE);
+    passed = (Cy_EINK_Power(CY_EINK_ON) == CY_EINK_SUCCESS);
+    Cy_EINK_ShowFrame(PV_EINK_WHITE_FRAME_ADDRESS, patternFrame,
+                      CY_EINK_FULL_2STAGE, false);
+    Cy_EINK_ShowFrame(patternFrame, editedFrame, CY_EINK_PARTIAL, false);
+    passed = (Cy_EINK_Power(CY_EINK_OFF) == CY_EINK_SUCCESS) && passed;
+    length = HostPdl_StopLog();
+
+    HostPdl_GetStats(&pdlStats, true);
+    EinkModel_GetStats(&modelStats, true);
+    printf("%-32s %8u %8u %8u %10u\n", mode->name, (unsigned)length,
+           (unsigned)pdlStats.transfers, (unsigned)pdlStats.rejectedTransfers,
+           (unsigned)pdlStats.interrupts);
+
+    if ((modelStats.protocolErrors != 0u) || (modelStats.bufferErrors != 0u))
+    {
+        printf("  FAIL: %u malformed commands, %u changed bulk transfers\n",
+               (unsigned)modelStats.protocolErrors,
+               (unsigned)modelStats.bufferErrors);
+        passed = false;
+    }
+    if (memcmp(EinkModel_GetImage(), editedFrame, CY_EINK_FRAME_SIZE) != 0)
+    {
+        printf("  FAIL: the panel does not show the new frame\n");
+        passed = false;
+    }
+    if (waitFailed || (mode->waitFunctions &&
+                       (waitCalls != pdlStats.transfers)))
+    {
+        printf("  FAIL: %u waits for %u transfers\n", (unsigned)waitCalls,
+               (unsigned)pdlStats.transfers);
+        passed = false;
+    }
+    if ((mode->rejectInterval != 0u) && (pdlStats.rejectedTransfers == 0u))
+    {
+        printf("  FAIL: no transfer was rejected\n");
+        passed = false;
+    }
+
+    return passed ? length : 0u;
+}
+
+/*******************************************************************************
+* Function Name: int main(void)
+********************************************************************************
+*
+* Summary: Runs the tests of the E-INK interface
+*
+* Return:
+*  int : 0 if all tests have passed
+*
+*******************************************************************************/
+int main(void)
+{
+    bool     passed = true;
+    uint32_t referenceLength;
+    uint32_t length;
+    uint32_t i;
+
+    /* Transfer modes of the display sequence. The first mode is the
+       reference */
+    test_mode_t const modes[] =
+    {
+        {"polled",                        false, 0u},
+        {"wait functions",                true,  0u},
+        {"polled, 1 in 3 rejected",       false, 3u},
+        {"wait functions, 1 in 2 rejected", true, 2u},
+        {"all rejected",                  false, 1u}
+    };
+
+    /* The interface is used as by the application; the stage time is
+       converted to frames without a time function */
+    if (Cy_EINK_Start(SEQUENCE_TEMPERATURE, EinkModel_Delay) !=
+        CY_EINK_SUCCESS)
+    {
+        printf("FAIL: E-INK start\n");
+        return EXIT_FAILURE;
+    }
+    Cy_EINK_SetPolicy(CY_EINK_POLICY_FAST);
+
+    passed = TestTransfers();
+    printf("Interface tests: %s\n\n", passed ? "passed" : "failed");
+
+    printf("%-32s %8s %8s %8s %10s\n", "transfer mode", "log", "bulk",
+           "rejected", "interrupts");
+    DrawFrames();
+    referenceLength = RunSequence(&modes[0], referenceLog);
+    passed = (referenceLength != 0u) && passed;
+    for (i = 1u; i < (sizeof(modes) / sizeof(modes[0])); i++)
+    {
+        length = RunSequence(&modes[i], sequenceLog);
+        if ((length != referenceLength) ||
+            (memcmp(sequenceLog, referenceLog,
+                    length * sizeof(sequenceLog[0])) != 0))
+        {
+            printf("  FAIL: the SPI log differs from the polled transfers\n");
+            passed = false;
+        }
+    }
+
+    printf("\n%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
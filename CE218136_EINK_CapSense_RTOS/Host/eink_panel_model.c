@@ -0,0 +1,544 @@
+/******************************************************************************
+* File Name: eink_panel_model.c
+*
+* Version: 1.00
+*
+* Description: This file contains the model of the E-INK panel used by the
+*              host build
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* See eink_panel_model.h header for the description of the model.
+*
+* A driver command is sent as two chip select periods: the register index
+* header and the register, then the data write header and the data (or the
+* data read header and one byte read back). The model applies the data line of
+* the pixel data register when Output Enable is turned on. For each pixel of
+* the line, a black code drives the pixel black, a white code drives it white
+* and the other codes leave it unchanged.
+*******************************************************************************/
+
+/* Header file includes */
+#include "eink_panel_model.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Largest data of a driver command */
+#define EINK_MODEL_DATA_SIZE    (256u)
+
+/* Responses of the registers that are read by the driver: the driver ID, and
+   no breakage with the DC level in range */
+#define EINK_MODEL_DRIVER_ID    (uint8_t)(0x12u)
+#define EINK_MODEL_STATUS       (uint8_t)(0xC0u)
+
+/* Pixel codes of the data bytes */
+#define EINK_MODEL_CODE_MASK    (uint8_t)(0x03u)
+#define EINK_MODEL_CODE_BLACK   (uint8_t)(0x03u)
+#define EINK_MODEL_CODE_WHITE   (uint8_t)(0x02u)
+
+/* State of the command being received */
+bool static     driverSelected;
+uint16_t static byteIndex;
+uint8_t static  header;
+uint8_t static  registerIndex;
+uint8_t static  commandData[EINK_MODEL_DATA_SIZE];
+uint16_t static commandLength;
+
+/* Data line sent last, and the pixel state of the panel */
+uint8_t static  lineData[EINK_MODEL_DATA_SIZE];
+bool static     lineValid;
+pv_eink_frame_data_t static panelImage[PV_EINK_IMAGE_SIZE];
+
+/* Activity counters, and the totals used as the simulated time */
+eink_model_stats_t static modelStats;
+uint64_t static totalSpiBytes;
+uint32_t static totalDelay;
+
+/* These static functions are not available outside this file.
+   See the respective function definitions for more details */
+void static EinkModel_WriteByte(uint8_t data);
+uint8_t static EinkModel_ReadByte(void);
+void static EinkModel_EndCommand(void);
+void static EinkModel_LatchLine(void);
+void static EinkModel_DrivePixel(pv_eink_frame_data_t* pixelByte, uint8_t bit,
+                                 uint8_t code);
+
+/*******************************************************************************
+* Function Name: void EinkModel_SelectDriver(bool selected)
+********************************************************************************
+*
+* Summary: Starts or ends a chip select period
+*
+* Parameters:
+*  bool selected : "true" when the chip select is pulled LOW
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void EinkModel_SelectDriver(bool selected)
+{
+    if (selected && !driverSelected)
+    {
+        byteIndex     = 0u;
+        commandLength = 0u;
+    }
+    else if (!selected && driverSelected)
+    {
+        EinkModel_EndCommand();
+    }
+    else
+    {
+    }
+    driverSelected = selected;
+}
+
+/*******************************************************************************
+* Function Name: uint8_t EinkModel_TransferByte(uint8_t data)
+********************************************************************************
+*
+* Summary: Exchanges a byte over SPI. The driver receives the byte sent, and
+*  responds with the value of the register selected last to the byte that
+*  follows a data read header
+*
+* Parameters:
+*  uint8_t data : Byte sent
+*
+* Return:
+*  uint8_t      : Byte received
+*
+*******************************************************************************/
+uint8_t EinkModel_TransferByte(uint8_t data)
+{
+    uint8_t response = 0u;
+
+    if (driverSelected && (header == PV_EINK_REG_DATA_READ) &&
+        (byteIndex == 1u))
+    {
+        response = EinkModel_ReadByte();
+    }
+    else
+    {
+        EinkModel_WriteByte(data);
+    }
+
+    return response;
+}
+
+/*******************************************************************************
+* Function Name: void static EinkModel_WriteByte(uint8_t data)
+********************************************************************************
+*
+* Summary: Receives a byte sent over SPI
+*
+* Parameters:
+*  uint8_t data : Byte sent
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void static EinkModel_WriteByte(uint8_t data)
+{
+    modelStats.spiBytes++;
+    totalSpiBytes++;
+
+    if (!driverSelected)
+    {
+        modelStats.protocolErrors++;
+    }
+    else if (byteIndex == 0u)
+    {
+        header = data;
+    }
+    else if ((header == PV_EINK_REG_INDEX_HEADER) && (byteIndex == 1u))
+    {
+        registerIndex = data;
+    }
+    else if ((header == PV_EINK_REG_DATA_WRITE) &&
+             (commandLength < EINK_MODEL_DATA_SIZE))
+    {
+        commandData[commandLength++] = data;
+    }
+    else
+    {
+        modelStats.protocolErrors++;
+    }
+    byteIndex++;
+}
+
+/*******************************************************************************
+* Function Name: uint8_t static EinkModel_ReadByte(void)
+********************************************************************************
+*
+* Summary: Returns the byte received after a data read header, which is the
+*  value of the register selected last
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t      : Byte received
+*
+*******************************************************************************/
+uint8_t static EinkModel_ReadByte(void)
+{
+    uint8_t response = 0u;
+
+    modelStats.spiBytes++;
+    totalSpiBytes++;
+
+    if (registerIndex == PV_EINK_DRIVER_ID_COMMAND_INDEX)
+    {
+        response = EINK_MODEL_DRIVER_ID;
+    }
+    else if (registerIndex == PV_EINK_DC_LEVEL_READ_COMMAND_INDEX)
+    {
+        response = EINK_MODEL_STATUS;
+    }
+    else
+    {
+    }
+    byteIndex++;
+
+    return response;
+}
+
+/*******************************************************************************
+* Function Name: void EinkModel_Delay(uint32_t delayMs)
+********************************************************************************
+*
+* Summary: Adds a delay of the driver to the simulated time
+*
+* Parameters:
+*  uint32_t delayMs : Delay in milliseconds
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void EinkModel_Delay(uint32_t delayMs)
+{
+    modelStats.delayTime += delayMs;
+    totalDelay += delayMs;
+}
+
+/*******************************************************************************
+* Function Name: void EinkModel_BufferError(void)
+********************************************************************************
+*
+* Summary: Counts a bulk transfer whose data was changed before the transfer
+*  had finished
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void EinkModel_BufferError(void)
+{
+    modelStats.bufferErrors++;
+}
+
+/*******************************************************************************
+* Function Name: void EinkModel_Reset(uint8_t pixelByte)
+********************************************************************************
+*
+* Summary: Sets all pixels of the panel and clears the counters
+*
+* Parameters:
+*  uint8_t pixelByte : PV_EINK_WHITE_PIXEL_BYTE or PV_EINK_BLACK_PIXEL_BYTE
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void EinkModel_Reset(uint8_t pixelByte)
+{
+    memset(panelImage, pixelByte, sizeof(panelImage));
+    memset(&modelStats, 0, sizeof(modelStats));
+    lineValid = false;
+}
+
+/*******************************************************************************
+* Function Name: void EinkModel_GetStats(eink_model_stats_t* stats, bool reset)
+********************************************************************************
+*
+* Summary: Reads the activity counters, and optionally clears them
+*
+* Parameters:
+*  eink_model_stats_t* stats : Receives the counters, or NULL
+*  bool reset                : "true" to clear the counters
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void EinkModel_GetStats(eink_model_stats_t* stats, bool reset)
+{
+    if (stats != NULL)
+    {
+        *stats = modelStats;
+        stats->spiTime = ((uint64_t)modelStats.spiBytes * CY_EINK_BYTE_SIZE *
+                          1000000u) / EINK_MODEL_SPI_RATE;
+    }
+    if (reset)
+    {
+        memset(&modelStats, 0, sizeof(modelStats));
+    }
+}
+
+/*******************************************************************************
+* Function Name: uint32_t EinkModel_GetTime(void)
+********************************************************************************
+*
+* Summary: Returns the simulated time: the delays and the SPI transfers since
+*  the start of the program
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t : Simulated time in milliseconds
+*
+*******************************************************************************/
+uint32_t EinkModel_GetTime(void)
+{
+    return totalDelay + (uint32_t)((totalSpiBytes * CY_EINK_BYTE_SIZE * 1000u) /
+                                   EINK_MODEL_SPI_RATE);
+}
+
+/*******************************************************************************
+* Function Name: pv_eink_frame_data_t const* EinkModel_GetImage(void)
+********************************************************************************
+*
+* Summary: Returns the pixel state of the panel
+*
+* Parameters:
+*  None
+*
+* Return:
+*  pv_eink_frame_data_t const* : Image of PV_EINK_IMAGE_SIZE bytes
+*
+*******************************************************************************/
+pv_eink_frame_data_t const* EinkModel_GetImage(void)
+{
+    return panelImage;
+}
+
+/*******************************************************************************
+* Function Name: bool EinkModel_WritePbm(char const* fileName,
+*                                        pv_eink_frame_data_t const* image)
+********************************************************************************
+*
+* Summary: Writes an image as a binary PBM (P4) file
+*
+* Parameters:
+*  char const* fileName              : Name of the file
+*  pv_eink_frame_data_t const* image : Image in the frame format
+*
+* Return:
+*  bool : "true" if the file has been written
+*
+*******************************************************************************/
+bool EinkModel_WritePbm(char const* fileName, pv_eink_frame_data_t const* image)
+{
+    FILE*    file = fopen(fileName, "wb");
+    bool     written = false;
+    uint32_t i;
+
+    if (file != NULL)
+    {
+        /* The line size is a whole number of bytes for all panels. PBM uses 1
+           for black */
+        fprintf(file, "P4\n%u %u\n", (unsigned)PV_EINK_PANEL_WIDTH,
+                (unsigned)PV_EINK_PANEL_HEIGHT);
+        for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+        {
+            fputc((uint8_t)~image[i], file);
+        }
+        written = (fclose(file) == 0);
+    }
+
+    return written;
+}
+
+/*******************************************************************************
+* Function Name: void static EinkModel_EndCommand(void)
+********************************************************************************
+*
+* Summary: Executes the data received in a chip select period
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void static EinkModel_EndCommand(void)
+{
+    pv_eink_panel_t const* panel = Pv_EINK_GetPanel();
+
+    if ((header != PV_EINK_REG_DATA_WRITE) || (commandLength == 0u))
+    {
+        return;
+    }
+
+    if (registerIndex == PV_EINK_PIXEL_DATA_COMMAND_INDEX)
+    {
+        if (commandLength == panel->dataLineSize)
+        {
+            memcpy(lineData, commandData, commandLength);
+            lineValid = true;
+        }
+        else
+        {
+            modelStats.protocolErrors++;
+        }
+    }
+    else if ((registerIndex == PV_EINK_ENABLE_OE_COMMAND_INDEX) &&
+             (commandData[0] == PV_EINK_ENABLE_OE_COMMAND_DATA))
+    {
+        EinkModel_LatchLine();
+    }
+    else
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static EinkModel_LatchLine(void)
+********************************************************************************
+*
+* Summary: Drives the pixels of the lines selected by the scan bytes of the
+*  data line sent last
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void static EinkModel_LatchLine(void)
+{
+    pv_eink_panel_t const* panel = Pv_EINK_GetPanel();
+    uint8_t const* even;
+    uint8_t const* scan;
+    uint8_t const* odd;
+    pv_eink_frame_data_t* line;
+    uint16_t scanLine;
+    uint16_t x;
+    uint8_t  bit;
+
+    modelStats.linesLatched++;
+    if (!lineValid)
+    {
+        return;
+    }
+
+    /* Layout of the data line: the border byte is first on the 2.7" panel */
+    even = &lineData[panel->borderFirst ? 1u : 0u];
+    scan = &even[panel->lineSize];
+    odd  = &scan[panel->scanLineSize];
+
+    for (scanLine = 0u; scanLine < panel->height; scanLine++)
+    {
+        /* Scan line n is selected by the code at bits (7 - 2*(n % 4)) and
+           (6 - 2*(n % 4)) of scan byte n / 4. Scan line n drives line
+           (height - 1 - n) of the image */
+        if ((scan[scanLine / 4u] & panel->scanTable[scanLine % 4u]) == 0u)
+        {
+            continue;
+        }
+        modelStats.scanLinesDriven++;
+        line = &panelImage[(panel->height - 1u - scanLine) * panel->lineSize];
+
+        /* Odd bytes hold bits 6, 4, 2 and 0 of the image bytes, in order.
+           Even bytes hold bits 7, 5, 3 and 1 in reverse byte order */
+        for (x = 0u; x < panel->lineSize; x++)
+        {
+            for (bit = 0u; bit < CY_EINK_BYTE_SIZE; bit += 2u)
+            {
+                EinkModel_DrivePixel(&line[x], bit,
+                                     (uint8_t)(odd[x] >> bit));
+                EinkModel_DrivePixel(&line[x], bit + 1u,
+                    (uint8_t)(even[panel->lineSize - 1u - x] >> (6u - bit)));
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static EinkModel_DrivePixel(
+*                   pv_eink_frame_data_t* pixelByte, uint8_t bit, uint8_t code)
+********************************************************************************
+*
+* Summary: Drives a pixel with the code of a data byte
+*
+* Parameters:
+*  pv_eink_frame_data_t* pixelByte : Image byte of the pixel
+*  uint8_t bit                     : Bit of the pixel in the byte
+*  uint8_t code                    : Pixel code in the two lowest bits
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void static EinkModel_DrivePixel(pv_eink_frame_data_t* pixelByte, uint8_t bit,
+                                 uint8_t code)
+{
+    code &= EINK_MODEL_CODE_MASK;
+
+    if (code == EINK_MODEL_CODE_BLACK)
+    {
+        *pixelByte &= (pv_eink_frame_data_t)~(1u << bit);
+    }
+    else if (code == EINK_MODEL_CODE_WHITE)
+    {
+        *pixelByte |= (pv_eink_frame_data_t)(1u << bit);
+    }
+    else
+    {
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name: eink_panel_model.h
+*
+* Version: 1.00
+*
+* Description: This file is the public interface of eink_panel_model.c source
+*              file
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* This file contains the model of the E-INK panel used by the host build. The
+* model decodes the driver commands sent over the emulated SPI, keeps the pixel
+* state of the panel from the latched data lines, and reports the cost of the
+* updates: bytes sent, lines latched and simulated time.
+*
+* The pixel state uses the frame format of the E-INK library: one bit per
+* pixel, 1 for white, and the leftmost pixel of a byte in its most significant
+* bit.
+*******************************************************************************/
+
+/* Include Guard */
+#ifndef EINK_PANEL_MODEL_H
+#define EINK_PANEL_MODEL_H
+
+/* Header file includes */
+#include "pervasive_eink_hardware_driver.h"
+
+/* SPI bit rate of the E-INK interface (CY_EINK_SPIM) in bits per second */
+#define EINK_MODEL_SPI_RATE     (12000000u)
+
+/* Data-type of the activity counters of the model */
+typedef struct
+{
+    uint32_t    spiBytes;           /* Bytes sent and received over SPI */
+    uint32_t    linesLatched;       /* Data lines latched by Output Enable */
+    uint32_t    scanLinesDriven;    /* Latched data lines that select a line */
+    uint32_t    delayTime;          /* Time spent in delays, in ms */
+    uint64_t    spiTime;            /* Time spent on SPI transfers, in us */
+    uint32_t    protocolErrors;     /* Malformed commands */
+    uint32_t    bufferErrors;       /* Bulk data changed while being sent */
+}   eink_model_stats_t;
+
+/* Functions called by the emulated Peripheral Driver Library (cy_pdl_host.c) */
+void    EinkModel_SelectDriver(bool selected);
+uint8_t EinkModel_TransferByte(uint8_t data);
+void    EinkModel_Delay(uint32_t delayMs);
+void    EinkModel_BufferError(void);
+
+/* Functions used by the host programs */
+void     EinkModel_Reset(uint8_t pixelByte);
+void     EinkModel_GetStats(eink_model_stats_t* stats, bool reset);
+uint32_t EinkModel_GetTime(void);
+pv_eink_frame_data_t const* EinkModel_GetImage(void);
+bool     EinkModel_WritePbm(char const* fileName,
+                            pv_eink_frame_data_t const* image);
+
+#endif /* EINK_PANEL_MODEL_H */
+/* [] END OF FILE */
@@ -0,0 +1,500 @@
+/******************************************************************************
+* File Name: eink_raster_test.c
+*
+* Version: 1.00
+*
+* Description: This file contains the unit tests and the benchmark of the
+*              raster operations of cy_eink_raster.c
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* The raster operations work on spans of bytes as a byte head, a run of words
+* and a byte tail. The tests compare them with pixel by pixel and byte by byte
+* references on random frames and bitmaps, at every alignment of the frames,
+* and random rectangles that may extend past the frame. The benchmark then
+* compares the time taken by the word-wise operations with byte by byte loops.
+*
+* The program returns a non-zero exit code if any test fails.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cy_cy8ckit_028_epd/cy_eink_raster.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Number of random test cases, and of repetitions of the benchmark */
+#define TEST_CASES              (20000u)
+#define BENCHMARK_REPETITIONS   (20000u)
+
+/* Largest number of bits flipped between the frames of a difference test */
+#define TEST_MAX_FLIPS          (50)
+
+/* Frames with room for every alignment */
+#define TEST_BUFFER_SIZE        (PV_EINK_IMAGE_SIZE + CY_EINK_BYTE_SIZE)
+#define TEST_BUFFER(name)       uint8_t name[TEST_BUFFER_SIZE]                 \
+                                __attribute__((aligned(8)))
+
+TEST_BUFFER(static bufferA);
+TEST_BUFFER(static bufferB);
+TEST_BUFFER(static bufferDiff);
+TEST_BUFFER(static bufferReference);
+
+/* Bitmaps of a copy test: up to a frame with TEST_MAX_PADDING bytes of padding
+   per line, at every alignment */
+#define TEST_MAX_PADDING        (4u)
+uint8_t static bufferBitmap[PV_EINK_IMAGE_SIZE + (CY_EINK_RASTER_LINE_COUNT *
+                            TEST_MAX_PADDING) + CY_EINK_BYTE_SIZE]
+                            __attribute__((aligned(8)));
+
+/*******************************************************************************
+* Function Name: void static SetPixel(uint8_t* frame, uint16_t x, uint16_t y,
+*                                     bool white)
+********************************************************************************
+*
+* Summary: Reference pixel write
+*
+*******************************************************************************/
+void static SetPixel(uint8_t* frame, uint16_t x, uint16_t y, bool white)
+{
+    uint8_t mask = (uint8_t)(0x80u >> (x % CY_EINK_BYTE_SIZE));
+
+    if (white)
+    {
+        frame[(y * CY_EINK_RASTER_LINE_SIZE) + (x / CY_EINK_BYTE_SIZE)] |= mask;
+    }
+    else
+    {
+        frame[(y * CY_EINK_RASTER_LINE_SIZE) + (x / CY_EINK_BYTE_SIZE)] &=
+            (uint8_t)~mask;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bool static GetPixel(uint8_t const* bytes, uint16_t x)
+********************************************************************************
+*
+* Summary: Reference pixel read, at column x of a line
+*
+*******************************************************************************/
+bool static GetPixel(uint8_t const* bytes, uint16_t x)
+{
+    return (bytes[x / CY_EINK_BYTE_SIZE] &
+            (0x80u >> (x % CY_EINK_BYTE_SIZE))) != 0u;
+}
+
+/*******************************************************************************
+* Function Name: void static RandomFrame(uint8_t* frame)
+********************************************************************************
+*
+* Summary: Fills a frame with random pixels
+*
+*******************************************************************************/
+void static RandomFrame(uint8_t* frame)
+{
+    uint32_t i;
+
+    for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+    {
+        frame[i] = (uint8_t)rand();
+    }
+}
+
+/*******************************************************************************
+* Function Name: bool static TestFill(void)
+********************************************************************************
+*
+* Summary: Compares Cy_EINK_RasterFill with pixel writes
+*
+*******************************************************************************/
+bool static TestFill(void)
+{
+    uint8_t* frame = &bufferA[rand() % CY_EINK_BYTE_SIZE];
+    uint8_t* reference = bufferReference;
+    uint16_t x0 = (uint16_t)(rand() % (CY_EINK_RASTER_LINE_PIXELS + 40u));
+    uint16_t x1 = (uint16_t)(rand() % (CY_EINK_RASTER_LINE_PIXELS + 40u));
+    uint16_t y0 = (uint16_t)(rand() % (CY_EINK_RASTER_LINE_COUNT + 20u));
+    uint16_t y1 = (uint16_t)(rand() % (CY_EINK_RASTER_LINE_COUNT + 20u));
+    bool     white = ((rand() & 1) != 0);
+    uint16_t x;
+    uint16_t y;
+
+    RandomFrame(frame);
+    memcpy(reference, frame, PV_EINK_IMAGE_SIZE);
+
+    Cy_EINK_RasterFill(frame, x0, y0, x1, y1, white);
+    for (y = y0; (y <= y1) && (y < CY_EINK_RASTER_LINE_COUNT); y++)
+    {
+        for (x = x0; (x <= x1) && (x < CY_EINK_RASTER_LINE_PIXELS); x++)
+        {
+            SetPixel(reference, x, y, white);
+        }
+    }
+
+    if (memcmp(frame, reference, PV_EINK_IMAGE_SIZE) != 0)
+    {
+        printf("FAIL: fill (%u, %u) - (%u, %u)\n", (unsigned)x0, (unsigned)y0,
+               (unsigned)x1, (unsigned)y1);
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bool static TestCopy(void)
+********************************************************************************
+*
+* Summary: Compares Cy_EINK_RasterCopy with pixel writes. Half of the cases copy
+*  a rectangle of another frame to the same position, and the others copy a 
+*  bitmap with a random line size
+*
+*******************************************************************************/
+bool static TestCopy(void)
+{
+    uint8_t* frame = &bufferA[rand() % CY_EINK_BYTE_SIZE];
+    uint8_t* source = &bufferB[rand() % CY_EINK_BYTE_SIZE];
+    uint8_t* reference = bufferReference;
+    uint8_t const* bitmap;
+    uint16_t x0 = (uint16_t)(rand() % CY_EINK_RASTER_LINE_PIXELS);
+    uint16_t x1 = (uint16_t)(rand() % (CY_EINK_RASTER_LINE_PIXELS + 40u));
+    uint16_t y0 = (uint16_t)(rand() % CY_EINK_RASTER_LINE_COUNT);
+    uint16_t y1 = (uint16_t)(rand() % (CY_EINK_RASTER_LINE_COUNT + 20u));
+    uint16_t lineSize;
+    uint16_t x;
+    uint16_t y;
+
+    RandomFrame(frame);
+    memcpy(reference, frame, PV_EINK_IMAGE_SIZE);
+
+    if ((rand() & 1) != 0)
+    {
+        RandomFrame(source);
+        bitmap = &source[(y0 * CY_EINK_RASTER_LINE_SIZE) +
+                         (x0 / CY_EINK_BYTE_SIZE)];
+        lineSize = CY_EINK_RASTER_LINE_SIZE;
+    }
+    else
+    {
+        lineSize = (uint16_t)(CY_EINK_RASTER_LINE_SIZE - 
+                              (x0 / CY_EINK_BYTE_SIZE) +
+                              (rand() % (TEST_MAX_PADDING + 1u)));
+        bitmap = &bufferBitmap[rand() % CY_EINK_BYTE_SIZE];
+        for (x = 0u; x < (CY_EINK_RASTER_LINE_COUNT * lineSize); x++)
+        {
+            ((uint8_t*)bitmap)[x] = (uint8_t)rand();
+        }
+    }
+
+    Cy_EINK_RasterCopy(frame, bitmap, lineSize, x0, y0, x1, y1);
+    for (y = y0; (y <= y1) && (y < CY_EINK_RASTER_LINE_COUNT); y++)
+    {
+        for (x = x0; (x <= x1) && (x < CY_EINK_RASTER_LINE_PIXELS); x++)
+        {
+            SetPixel(reference, x, y, 
+                     GetPixel(&bitmap[(y - y0) * lineSize],
+                              (uint16_t)(x - ((x0 / CY_EINK_BYTE_SIZE) *
+                                              CY_EINK_BYTE_SIZE))));
+        }
+    }
+
+    if (memcmp(frame, reference, PV_EINK_IMAGE_SIZE) != 0)
+    {
+        printf("FAIL: copy (%u, %u) - (%u, %u), line size %u\n", 
+               (unsigned)x0, (unsigned)y0, (unsigned)x1, (unsigned)y1,
+               (unsigned)lineSize);
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bool static TestDiff(void)
+********************************************************************************
+*
+* Summary: Compares Cy_EINK_RasterXorDiff and Cy_EINK_RasterChangedRows with
+*  byte by byte references, on frames that differ by a few bits
+*
+*******************************************************************************/
+bool static TestDiff(void)
+{
+    uint8_t* frameA = &bufferA[rand() % CY_EINK_BYTE_SIZE];
+    uint8_t* frameB = &bufferB[rand() % CY_EINK_BYTE_SIZE];
+    uint8_t* diff = &bufferDiff[rand() % CY_EINK_BYTE_SIZE];
+    uint8_t  rowBitmap[CY_EINK_RASTER_ROW_BITMAP_SIZE];
+    uint8_t  referenceBitmap[CY_EINK_RASTER_ROW_BITMAP_SIZE] = {0u};
+    uint32_t changedPixels = 0u;
+    uint16_t changedRows = 0u;
+    uint32_t i;
+    int      flips = rand() % TEST_MAX_FLIPS;
+    bool     passed = true;
+
+    RandomFrame(frameA);
+    memcpy(frameB, frameA, PV_EINK_IMAGE_SIZE);
+    for (; flips > 0; flips--)
+    {
+        frameB[rand() % PV_EINK_IMAGE_SIZE] ^= (uint8_t)(1u << (rand() % 8));
+    }
+
+    for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+    {
+        changedPixels += (uint32_t)__builtin_popcount(frameA[i] ^ frameB[i]);
+    }
+    for (i = 0u; i < CY_EINK_RASTER_LINE_COUNT; i++)
+    {
+        if (memcmp(&frameA[i * CY_EINK_RASTER_LINE_SIZE],
+                   &frameB[i * CY_EINK_RASTER_LINE_SIZE],
+                   CY_EINK_RASTER_LINE_SIZE) != 0)
+        {
+            referenceBitmap[i / CY_EINK_BYTE_SIZE] |=
+                (uint8_t)(1u << (i % CY_EINK_BYTE_SIZE));
+            changedRows++;
+        }
+    }
+
+    if (Cy_EINK_RasterXorDiff(NULL, frameA, frameB) != changedPixels)
+    {
+        printf("FAIL: changed pixel count\n");
+        passed = false;
+    }
+    if (Cy_EINK_RasterXorDiff(diff, frameA, frameB) != changedPixels)
+    {
+        printf("FAIL: changed pixel count with the XOR frame\n");
+        passed = false;
+    }
+    for (i = 0u; (i < PV_EINK_IMAGE_SIZE) && passed; i++)
+    {
+        if (diff[i] != (frameA[i] ^ frameB[i]))
+        {
+            printf("FAIL: XOR frame byte %u\n", (unsigned)i);
+            passed = false;
+        }
+    }
+    if ((Cy_EINK_RasterChangedRows(frameA, frameB, rowBitmap) != changedRows) ||
+        (memcmp(rowBitmap, referenceBitmap, sizeof(rowBitmap)) != 0))
+    {
+        printf("FAIL: changed rows\n");
+        passed = false;
+    }
+
+    return passed;
+}
+
+/*******************************************************************************
+* Function Name: double static ElapsedTime(struct timespec const* startTime)
+********************************************************************************
+*
+* Summary: Returns the time since startTime per benchmark repetition, in us
+*
+*******************************************************************************/
+double static ElapsedTime(struct timespec const* startTime)
+{
+    struct timespec endTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+    return (((double)(endTime.tv_sec - startTime->tv_sec) * 1e9) +
+            (double)(endTime.tv_nsec - startTime->tv_nsec)) /
+           (BENCHMARK_REPETITIONS * 1e3);
+}
+
+/*******************************************************************************
+* Function Name: void static Benchmark(void)
+********************************************************************************
+*
+* Summary: Prints the time taken by the word-wise operations and by byte by
+*  byte loops, on two aligned frames that differ by one pixel
+*
+*******************************************************************************/
+void static Benchmark(void)
+{
+    uint8_t const volatile* frameA = bufferA;
+    uint8_t const volatile* frameB = bufferB;
+    uint8_t volatile* frameCopy = bufferDiff;
+    uint8_t  rowBitmap[CY_EINK_RASTER_ROW_BITMAP_SIZE];
+    uint32_t volatile result = 0u;
+    struct timespec startTime;
+    uint32_t repetition;
+    uint32_t count;
+    uint32_t i;
+    uint16_t y;
+    uint16_t x;
+    uint8_t  diff;
+
+    memset(bufferA, 0x55, PV_EINK_IMAGE_SIZE);
+    memcpy(bufferB, bufferA, PV_EINK_IMAGE_SIZE);
+    bufferB[PV_EINK_IMAGE_SIZE - 800u] ^= 0x01u;
+
+    printf("\n%-20s %10s %10s\n", "operation", "word (us)", "byte (us)");
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        result += Cy_EINK_RasterChangedRows(bufferA, bufferB, rowBitmap);
+    }
+    printf("%-20s %10.2f", "changed rows", ElapsedTime(&startTime));
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        count = 0u;
+        for (y = 0u; y < CY_EINK_RASTER_LINE_COUNT; y++)
+        {
+            for (i = y * CY_EINK_RASTER_LINE_SIZE;
+                 i < ((y + 1u) * CY_EINK_RASTER_LINE_SIZE); i++)
+            {
+                if (frameA[i] != frameB[i])
+                {
+                    count++;
+                    break;
+                }
+            }
+        }
+        result += count;
+    }
+    printf(" %10.2f\n", ElapsedTime(&startTime));
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        result += Cy_EINK_RasterXorDiff(NULL, bufferA, bufferB);
+    }
+    printf("%-20s %10.2f", "changed pixels", ElapsedTime(&startTime));
+
+    /* The byte loop is the pixel count that Cy_EINK_SelectUpdate used */
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        count = 0u;
+        for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+        {
+            if (frameA[i] != frameB[i])
+            {
+                for (diff = frameA[i] ^ frameB[i]; diff != 0u;
+                     diff &= (uint8_t)(diff - 1u))
+                {
+                    count++;
+                }
+            }
+        }
+        result += count;
+    }
+    printf(" %10.2f\n", ElapsedTime(&startTime));
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        Cy_EINK_RasterCopy(bufferDiff, bufferA, CY_EINK_RASTER_LINE_SIZE, 0u,
+                           0u, CY_EINK_RASTER_LINE_PIXELS - 1u,
+                           CY_EINK_RASTER_LINE_COUNT - 1u);
+    }
+    printf("%-20s %10.2f", "copy frame", ElapsedTime(&startTime));
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        for (i = 0u; i < PV_EINK_IMAGE_SIZE; i++)
+        {
+            frameCopy[i] = frameA[i];
+        }
+    }
+    printf(" %10.2f\n", ElapsedTime(&startTime));
+
+    /* A rectangle that starts and ends within a byte, with a byte reference 
+       that masks the first and the last bytes of each line */
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        Cy_EINK_RasterCopy(bufferDiff, &bufferA[(10u * CY_EINK_RASTER_LINE_SIZE)
+                           + 1u], CY_EINK_RASTER_LINE_SIZE, 13u, 10u, 250u,
+                           165u);
+    }
+    printf("%-20s %10.2f", "copy rectangle", ElapsedTime(&startTime));
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    for (repetition = 0u; repetition < BENCHMARK_REPETITIONS; repetition++)
+    {
+        for (y = 10u; y <= 165u; y++)
+        {
+            i = y * CY_EINK_RASTER_LINE_SIZE;
+            frameCopy[i + 1u] = (frameCopy[i + 1u] & 0xF8u) |
+                                (frameA[i + 1u] & 0x07u);
+            for (x = 2u; x < 31u; x++)
+            {
+                frameCopy[i + x] = frameA[i + x];
+            }
+            frameCopy[i + 31u] = (frameCopy[i + 31u] & 0x1Fu) |
+                                 (frameA[i + 31u] & 0xE0u);
+        }
+    }
+    printf(" %10.2f\n", ElapsedTime(&startTime));
+}
+
+/*******************************************************************************
+* Function Name: int main(void)
+********************************************************************************
+*
+* Summary: Runs the tests and the benchmark of the raster operations
+*
+* Return:
+*  int : 0 if all tests have passed
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t failures = 0u;
+    uint32_t i;
+
+    srand(1u);
+    for (i = 0u; i < TEST_CASES; i++)
+    {
+        failures += TestFill() ? 0u : 1u;
+        failures += TestCopy() ? 0u : 1u;
+        failures += TestDiff() ? 0u : 1u;
+    }
+    printf("Raster tests: %u cases, %u failures\n", (unsigned)(3u * TEST_CASES),
+           (unsigned)failures);
+
+    Benchmark();
+
+    printf("\n%s\n", (failures == 0u) ? "PASSED" : "FAILED");
+    return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name: cy_scb_spi.h
+*
+* Version: 1.00
+*
+* Description: Host replacement of the SCB SPI driver of the Peripheral Driver
+*              Library. It declares the subset of the driver used by the
+*              E-INK interface, which is emulated by cy_pdl_host.c
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Include Guard */
+#ifndef CY_SCB_SPI_H
+#define CY_SCB_SPI_H
+
+/* Header file includes */
+#include "cy_syslib.h"
+
+/* Data-type of an emulated SCB */
+typedef struct
+{
+    uint32_t    enabled;
+}   CySCB_Type;
+
+/* Data-type of the SPI configuration. The emulated SPI has no settings */
+typedef struct
+{
+    uint32_t    spiMode;
+}   cy_stc_scb_spi_config_t;
+
+/* SPI driver results */
+typedef enum
+{
+    CY_SCB_SPI_SUCCESS,
+    CY_SCB_SPI_BAD_PARAM,
+    CY_SCB_SPI_TRANSFER_TIMEOUT,
+    CY_SCB_SPI_TRANSFER_BUSY
+}   cy_en_scb_spi_status_t;
+
+/* SPI event callback */
+typedef void (* cy_cb_scb_spi_handle_events_t) (uint32_t event);
+
+/* Data-type of the SPI driver context: the transfer in progress */
+typedef struct
+{
+    uint32_t volatile   status;
+    void const*         txBuf;
+    uint32_t            txBufSize;
+    uint32_t            txBufIdx;
+    cy_cb_scb_spi_handle_events_t cbEvents;
+}   cy_stc_scb_spi_context_t;
+
+/* RX FIFO status, transfer status and events, with the values of the 
+   Peripheral Driver Library */
+#define CY_SCB_SPI_RX_NOT_EMPTY             (0x04UL)
+#define CY_SCB_SPI_TRANSFER_ACTIVE          (0x01UL)
+#define CY_SCB_SPI_TRANSFER_CMPLT_EVENT     (0x02UL)
+
+/* SPI functions used by the E-INK interface */
+cy_en_scb_spi_status_t Cy_SCB_SPI_Init(CySCB_Type* base,
+                                       cy_stc_scb_spi_config_t const* config,
+                                       cy_stc_scb_spi_context_t* context);
+void     Cy_SCB_SPI_RegisterCallback(CySCB_Type const* base,
+                                     cy_cb_scb_spi_handle_events_t callback,
+                                     cy_stc_scb_spi_context_t* context);
+void     Cy_SCB_SPI_Enable(CySCB_Type* base);
+void     Cy_SCB_SPI_Disable(CySCB_Type* base,
+                            cy_stc_scb_spi_context_t* context);
+uint32_t Cy_SCB_SPI_Write(CySCB_Type* base, uint32_t data);
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const* base);
+uint32_t Cy_SCB_SPI_GetRxFifoStatus(CySCB_Type const* base);
+void     Cy_SCB_SPI_ClearRxFifoStatus(CySCB_Type* base, uint32_t clearMask);
+void     Cy_SCB_SPI_ClearTxFifo(CySCB_Type* base);
+void     Cy_SCB_SPI_ClearRxFifo(CySCB_Type* base);
+cy_en_scb_spi_status_t Cy_SCB_SPI_Transfer(CySCB_Type* base, void* txBuffer,
+                                           void* rxBuffer, uint32_t size,
+                                        cy_stc_scb_spi_context_t* context);
+uint32_t Cy_SCB_SPI_GetTransferStatus(CySCB_Type const* base,
+                                      cy_stc_scb_spi_context_t const* context);
+void     Cy_SCB_SPI_Interrupt(CySCB_Type* base,
+                              cy_stc_scb_spi_context_t* context);
+
+#endif /* CY_SCB_SPI_H */
+/* [] END OF FILE */
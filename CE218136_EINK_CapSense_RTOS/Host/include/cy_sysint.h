@@ -0,0 +1,81 @@
+/******************************************************************************
+* File Name: cy_sysint.h
+*
+* Version: 1.00
+*
+* Description: Host replacement of the Peripheral Driver Library header used
+*              by the E-INK library. The interrupt handlers are called by the
+*              emulated peripherals of cy_pdl_host.c.
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Include Guard */
+#ifndef CY_SYSINT_H
+#define CY_SYSINT_H
+
+/* Header file includes */
+#include "cy_syslib.h"
+
+/* Data-type of an interrupt source */
+typedef int32_t     IRQn_Type;
+
+/* Data-type of an interrupt handler */
+typedef void (* cy_israddress) (void);
+
+/* Interrupt configuration */
+typedef struct
+{
+    IRQn_Type   intrSrc;
+    uint32_t    intrPriority;
+}   cy_stc_sysint_t;
+
+/* Interrupt driver results */
+typedef enum
+{
+    CY_SYSINT_SUCCESS,
+    CY_SYSINT_BAD_PARAM
+}   cy_en_sysint_status_t;
+
+/* Interrupt functions used by the E-INK interface */
+cy_en_sysint_status_t Cy_SysInt_Init(cy_stc_sysint_t const* config,
+                                     cy_israddress userIsr);
+void NVIC_EnableIRQ(IRQn_Type irqn);
+void NVIC_ClearPendingIRQ(IRQn_Type irqn);
+
+#endif /* CY_SYSINT_H */
+/* [] END OF FILE */
@@ -0,0 +1,65 @@
+/******************************************************************************
+* File Name: cycfg_peripherals.h
+*
+* Version: 1.00
+*
+* Description: Host replacement of the generated peripheral configuration. It
+*              declares the SCB used by the E-INK display, which is emulated
+*              by cy_pdl_host.c
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Include Guard */
+#ifndef CYCFG_PERIPHERALS_H
+#define CYCFG_PERIPHERALS_H
+
+/* Header file includes */
+#include "cy_scb_spi.h"
+#include "cy_sysint.h"
+
+/* Emulated SCB of the E-INK display */
+extern CySCB_Type HOST_EINK_SCB;
+
+/* SPI master of the E-INK display, in the form of the generated peripheral
+   configuration */
+#define CY_EINK_SPIM_HW         (&HOST_EINK_SCB)
+#define CY_EINK_SPIM_IRQ        ((IRQn_Type)6)
+extern const cy_stc_scb_spi_config_t CY_EINK_SPIM_config;
+
+#endif /* CYCFG_PERIPHERALS_H */
+/* [] END OF FILE */
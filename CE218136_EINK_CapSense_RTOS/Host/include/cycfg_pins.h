@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name: cycfg_pins.h
+*
+* Version: 1.00
+*
+* Description: Host replacement of the generated pin configuration. It declares
+*              the E-INK pins, which are emulated by cy_pdl_host.c
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: None (host build)
+*
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Include Guard */
+#ifndef CYCFG_PINS_H
+#define CYCFG_PINS_H
+
+/* Header file includes */
+#include "cy_syslib.h"
+
+/* Data-type of an emulated GPIO port: the output level of each pin */
+typedef struct
+{
+    uint32_t    OUT;
+}   GPIO_PRT_Type;
+
+/* Port of all E-INK pins */
+extern GPIO_PRT_Type HOST_EINK_PORT;
+
+/* E-INK pins, in the form of the generated pin configuration */
+#define CY_EINK_Ssel_PORT       (&HOST_EINK_PORT)
+#define CY_EINK_Ssel_PIN        (0u)
+#define CY_EINK_DispRst_PORT    (&HOST_EINK_PORT)
+#define CY_EINK_DispRst_PIN     (1u)
+#define CY_EINK_Discharge_PORT  (&HOST_EINK_PORT)
+#define CY_EINK_Discharge_PIN   (2u)
+#define CY_EINK_DispEn_PORT     (&HOST_EINK_PORT)
+#define CY_EINK_DispEn_PIN      (3u)
+#define CY_EINK_Border_PORT     (&HOST_EINK_PORT)
+#define CY_EINK_Border_PIN      (4u)
+#define CY_EINK_DispIoEn_PORT   (&HOST_EINK_PORT)
+#define CY_EINK_DispIoEn_PIN    (5u)
+#define CY_EINK_DispBusy_PORT   (&HOST_EINK_PORT)
+#define CY_EINK_DispBusy_PIN    (6u)
+
+/* GPIO functions used by the E-INK library */
+void     Cy_GPIO_Set(GPIO_PRT_Type* base, uint32_t pinNum);
+void     Cy_GPIO_Clr(GPIO_PRT_Type* base, uint32_t pinNum);
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type* base, uint32_t pinNum);
+
+#endif /* CYCFG_PINS_H */
+/* [] END OF FILE */
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# Latency histograms of the trace printed by latency_trace.c. The script reads
+# a UART log captured with LATENCY_TRACE_ENABLE set to (true), groups the
+# "Trace :" lines per touch, from the scan that detected the touch to the end
+# of the E-INK refresh (Cy_EINK_ShowFrame) that shows it, and prints a
+# histogram of each stage and of the whole latency.
+#
+# python3 trace_histogram.py [--bins N] [--width N] [log ...]
+#
+# The log is read from the standard input when no file is given. Other UART
+# output can be mixed with the trace lines.
+#
+
+import argparse
+import re
+import sys
+
+# Events of trace_event_t, in the order a touch goes through them
+EVENTS = [
+    "scan complete",
+    "gesture decoded",
+    "touch sent",
+    "touch received",
+    "render done",
+    "refresh start",
+    "refresh end",
+]
+
+# "Trace    : <event> <time> us +<time since the previous event> us"
+EVENT_LINE = re.compile(r"Trace\s*:\s*(?P<event>[a-z ]+?)\s+(?P<time>\d+) us \+\s*(?P<delta>\d+) us")
+LOST_LINE = re.compile(r"Trace\s*:\s*(?P<count>\d+) events lost")
+
+
+def read_touches(lines):
+    """Groups the trace events per touch.
+
+    The time of each event is the sum of the times since the previous event,
+    which does not wrap around like the time stamps. A touch starts at its
+    scan complete event. The inputs go through the queue in order, so the
+    gesture, sent and received events go to the oldest touch waiting for them.
+    The display task renders each input before it receives the next one: a
+    touch that is not rendered when the next one is received caused no screen
+    change and is dropped. A refresh shows all the touches rendered before it
+    starts, so a refresh already running when a touch is rendered is not
+    counted. The touches that are open when events are lost are dropped too.
+
+    Returns the complete touches, as lists of event times in the order of
+    EVENTS, and the number of touches that were not complete.
+    """
+    received = EVENTS.index("touch received")
+    rendered = EVENTS.index("render done")
+    complete = []
+    open_touches = []
+    dropped = 0
+    now = 0
+
+    for line in lines:
+        lost = LOST_LINE.search(line)
+        if lost:
+            dropped += len(open_touches)
+            open_touches = []
+            continue
+
+        match = EVENT_LINE.search(line)
+        if not match or match.group("event") not in EVENTS:
+            continue
+
+        now += int(match.group("delta"))
+        stage = EVENTS.index(match.group("event"))
+
+        if stage == 0:
+            open_touches.append([now])
+            continue
+
+        if stage == received:
+            dropped += sum(1 for touch in open_touches if len(touch) == rendered)
+            open_touches = [touch for touch in open_touches if len(touch) != rendered]
+
+        for touch in open_touches:
+            if len(touch) == stage:
+                touch.append(now)
+                if stage <= received:
+                    break
+
+        complete += [touch for touch in open_touches if len(touch) == len(EVENTS)]
+        open_touches = [touch for touch in open_touches if len(touch) < len(EVENTS)]
+
+    return complete, dropped + len(open_touches)
+
+
+def percentile(values, fraction):
+    """Returns the value below which the given fraction of the sorted values lie."""
+    return values[min(len(values) - 1, int(fraction * len(values)))]
+
+
+def print_histogram(name, values, bins, width):
+    """Prints the statistics and a histogram of equal-width bins of a stage."""
+    values = sorted(values)
+    low = values[0]
+    high = values[-1]
+    size = max(1, -(-(high - low + 1) // bins))
+    counts = [0] * bins
+
+    for value in values:
+        counts[(value - low) // size] += 1
+
+    print("%s: %d touches, min %d us, median %d us, 90%% %d us, max %d us, mean %d us"
+          % (name, len(values), low, percentile(values, 0.5), percentile(values, 0.9), high,
+             sum(values) // len(values)))
+
+    last = max(index for index, count in enumerate(counts) if count != 0)
+    for index, count in enumerate(counts[:last + 1]):
+        start = low + index * size
+        bar = "#" * (-(-count * width // max(counts)))
+        print("  %10d - %10d us %6d %s" % (start, start + size - 1, count, bar))
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Latency histograms of the E-INK latency trace")
+    parser.add_argument("logs", nargs="*", help="UART logs, standard input if none")
+    parser.add_argument("--bins", type=int, default=10, help="bins of each histogram (default 10)")
+    parser.add_argument("--width", type=int, default=50, help="width of the longest bar (default 50)")
+    args = parser.parse_args()
+
+    if args.bins < 1 or args.width < 1:
+        parser.error("--bins and --width must be at least 1")
+
+    lines = []
+    if args.logs:
+        for log in args.logs:
+            with open(log, errors="replace") as file:
+                lines += file.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    touches, dropped = read_touches(lines)
+    print("%d touches from scan to the end of the refresh, %d incomplete\n" % (len(touches), dropped))
+
+    if not touches:
+        return 1
+
+    for stage in range(1, len(EVENTS)):
+        print_histogram("%s -> %s" % (EVENTS[stage - 1], EVENTS[stage]),
+                        [touch[stage] - touch[stage - 1] for touch in touches], args.bins, args.width)
+    print_histogram("total", [touch[-1] - touch[0] for touch in touches], args.bins, args.width)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -52,6 +52,37 @@
 
 /* Header file includes */
 #include "./cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h"
+#include <string.h>
+
+/* Number of pixels in a frame */
+#define CY_EINK_FRAME_PIXELS       ((uint32_t)CY_EINK_FRAME_SIZE * 8u)
+
+/* Maximum value of the update counts used for the ghosting estimate */
+#define CY_EINK_MAX_UPDATE_COUNT  (uint8_t)(0xFFu)
+
+/* Number of partial updates received by each group of 8 pixels (one frame 
+   byte) since the last full update. Used to estimate the ghosting */
+uint8_t static partialUpdateCount[CY_EINK_FRAME_SIZE];
+
+/* Number of 2 stage full updates since the last 4 stage full update */
+uint8_t static full2StageCount = 0u;
+
+/* Counters of the update types performed */
+cy_eink_update_counters_t static updateCounters;
+
+/* Cost of the last update */
+cy_eink_refresh_stats_t static lastRefreshStats;
+
+/*  These static functions are not available outside this file. 
+    See the respective function definitions for more details */
+cy_eink_update_t static Cy_EINK_SelectUpdate(cy_eink_frame_t const* prevFrame,
+                                             cy_eink_frame_t const* newFrame);
+void static Cy_EINK_TrackUpdate(cy_eink_frame_t const* prevFrame,
+                                cy_eink_frame_t const* newFrame,
+                                cy_eink_update_t updateType);
+void static Cy_EINK_StoreRefreshStats(cy_eink_update_t updateType);
+uint8_t static Cy_EINK_ReadImageByte(cy_eink_image_decoder_t* decoder);
+pv_eink_frame_data_t static * Cy_EINK_GetImageLine(void* image, uint16 y);
 
 
 /*******************************************************************************
@@ -157,6 +188,55 @@ cy_eink_api_result Cy_EINK_Power(bool powerCtrl)
     return (returnValue);
 }
 
+/*******************************************************************************
+* Function Name: void Cy_EINK_SetTemperature(int8_t temperature)
+********************************************************************************
+*
+* Summary: Performs temperature compensation of E-INK parameters with a new
+*  ambient temperature reading. Call this function periodically so that the
+*  refresh time tracks the ambient conditions.
+*
+* Parameters:
+*  int8_t temperature       : Ambient temperature in degree Celsius
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  Lower ambient temperature results in higher refresh times. If the display
+*  is being updated, the new refresh time is used from the next update stage
+*
+*******************************************************************************/
+void Cy_EINK_SetTemperature(int8_t temperature)
+{
+    Pv_EINK_SetTempFactor(temperature);
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_SetPolicy(cy_eink_policy_t policy)
+********************************************************************************
+*
+* Summary: Selects the speed-contrast trade-off of the display updates. 
+*  CY_EINK_POLICY_FAST halves the refresh time of the ambient temperature, 
+*  CY_EINK_POLICY_BALANCED (default) uses it as is, and 
+*  CY_EINK_POLICY_HIGH_CONTRAST increases it for a higher contrast.
+*
+* Parameters:
+*  cy_eink_policy_t policy  : Refresh policy
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  If the display is being updated, the new refresh time is used from the 
+*  next update stage
+*
+*******************************************************************************/
+void Cy_EINK_SetPolicy(cy_eink_policy_t policy)
+{
+    Pv_EINK_SetPolicy(policy);
+}
+
 /*******************************************************************************
 * Function Name: void Cy_EINK_ShowFrame(cy_eink_frame_t* prevFrame, 
 *      cy_eink_frame_t* newFrame,CY_EINK_UpdateType updateType, bool powerCycle)
@@ -178,7 +258,10 @@ cy_eink_api_result Cy_EINK_Power(bool powerCtrl)
 *                                  display
 *  cy_eink_frame_t* newFrame     : Pointer to the new frame that need to be
 *                                  written
-*  cy_eink_update_t              : Full update (2/4 stages) or  Partial update
+*  cy_eink_update_t              : Full update (2/4 stages), partial update, or
+*                                  automatic selection (CY_EINK_AUTO). A full 
+*                                  update is performed if either frame is the
+*                                  white or the black frame
 *  bool powerCycle               : "true" for automatic power cycle, "false" 
 *                                  for manual
 *  
@@ -192,6 +275,50 @@ cy_eink_api_result Cy_EINK_Power(bool powerCtrl)
 void Cy_EINK_ShowFrame(cy_eink_frame_t* prevFrame, cy_eink_frame_t* newFrame,
                        cy_eink_update_t updateType, bool powerCycle)
 {
+    /* The white and black frames are not stored in memory, so they can't be 
+       compared with the other frame */
+    bool basicFrame = (prevFrame == PV_EINK_WHITE_FRAME_ADDRESS) ||
+                      (prevFrame == PV_EINK_BLACK_FRAME_ADDRESS) ||
+                      (newFrame  == PV_EINK_WHITE_FRAME_ADDRESS) ||
+                      (newFrame  == PV_EINK_BLACK_FRAME_ADDRESS);
+    
+    /* Select a full update for the white and black frames. The partial update
+       requires the pixels of both frames */
+    if (basicFrame)
+    {
+        if (updateType == CY_EINK_AUTO)
+        {
+            updateType = (full2StageCount >= CY_EINK_AUTO_2STAGE_LIMIT) ?
+                          CY_EINK_FULL_4STAGE : CY_EINK_FULL_2STAGE;
+            updateCounters.autoUpdates++;
+        }
+        else if (updateType == CY_EINK_PARTIAL)
+        {
+            updateType = CY_EINK_FULL_2STAGE;
+        }
+        else
+        {
+        }
+    }
+    /* Select the update type per the changed pixels and the ghosting */
+    else if (updateType == CY_EINK_AUTO)
+    {
+        updateType = Cy_EINK_SelectUpdate(prevFrame, newFrame);
+        updateCounters.autoUpdates++;
+    }
+    else
+    {
+    }
+    
+    /* Keep track of the ghosting caused by this update. A full update does 
+       not compare the frames */
+    Cy_EINK_TrackUpdate(prevFrame, newFrame, updateType);
+    
+    /* Start measuring the cost of the update */
+    Pv_EINK_GetStatistics(NULL, true);
+    lastRefreshStats.refreshTime = (Cy_EINK_GetTime != NULL) ?
+                                    Cy_EINK_GetTime() : 0u;
+    
     /* If power cycle operation requested, turn on E-INK power */
     if (powerCycle)
     {
@@ -208,31 +335,597 @@ void Cy_EINK_ShowFrame(cy_eink_frame_t* prevFrame, cy_eink_frame_t* newFrame,
              (updateType == CY_EINK_FULL_2STAGE))
     {
         /* Stage 1: update the display with the inverted version of the previous 
-           frame */
-        Pv_EINK_FullStageHandler(prevFrame, PV_EINK_STAGE1);
+           frame. A 4 stage update reduces ghosting with two additional stages;
+           stage 2: update the display with an all white frame, and stage 3: 
+           update the display with the inverted version of the new frame.
+           Stage 4: update the display with the new frame. Each stage is 
+           prepared while the previous stage is being written */
+        Pv_EINK_FullUpdate(prevFrame, newFrame,
+                           (updateType == CY_EINK_FULL_4STAGE));
+    }
+    else
+    {
+    }
+    
+    /* If power cycle operation requested, turn off E-INK power */
+    if (powerCycle)
+    {
+        Cy_EINK_Power(CY_EINK_OFF);
+    }
+    
+    /* Store the cost of the update */
+    Cy_EINK_StoreRefreshStats(updateType);
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_StartImageDecoder(cy_eink_image_decoder_t* decoder,
+*                                   cy_eink_compressed_image_t const* image)
+********************************************************************************
+*
+* Summary: Prepares a decoder to read a compressed image from the first line
+*
+* Parameters:
+*  cy_eink_image_decoder_t* decoder         : Decoder state
+*  cy_eink_compressed_image_t const* image  : Compressed image to be decoded
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void Cy_EINK_StartImageDecoder(cy_eink_image_decoder_t* decoder,
+                               cy_eink_compressed_image_t const* image)
+{
+    decoder->image        = image;
+    decoder->dataIndex    = 0u;
+    decoder->packetLength = 0u;
+    decoder->repeatPacket = false;
+    decoder->line         = 0u;
+    decoder->dataError    = false;
+}
+
+/*******************************************************************************
+* Function Name: cy_eink_api_result Cy_EINK_DecodeImageLine(
+*                       cy_eink_image_decoder_t* decoder, uint8_t* lineData)
+********************************************************************************
+*
+* Summary: Decodes the next line of a compressed image. The lines are decoded
+*  from top to bottom; only the packets of the line are read, so an image can
+*  be written to the display without a frame buffer.
+*
+* Parameters:
+*  cy_eink_image_decoder_t* decoder : Decoder state
+*  uint8_t* lineData                : Returns the CY_EINK_LINE_SIZE bytes of 
+*                                     the line
+*  
+* Return:
+*  cy_eink_api_result               : CY_EINK_FAILURE if all lines have been 
+*                                     decoded, or if the packets ended before
+*                                     the end of the line
+*
+* Side Effects:
+*  The bytes that are missing from the packets are decoded as zeros
+*
+*******************************************************************************/
+cy_eink_api_result Cy_EINK_DecodeImageLine(cy_eink_image_decoder_t* decoder,
+                                           uint8_t* lineData)
+{
+    /* Bytes of the reference frame at the start of the line */
+    uint8_t const* reference = NULL;
+    /* Counter variable for the horizontal byte loop */
+    uint8_t  x;
+    
+    /* Variable to store the return value */
+    cy_eink_api_result returnValue = CY_EINK_FAILURE;
+    
+    if (decoder->line < CY_EINK_LINE_COUNT)
+    {
+        if (decoder->image->reference != NULL)
+        {
+            reference = &decoder->image->reference[decoder->line * 
+                                                   CY_EINK_LINE_SIZE];
+        }
+        
+        for (x = 0u; x < CY_EINK_LINE_SIZE; x++)
+        {
+            lineData[x] = Cy_EINK_ReadImageByte(decoder);
+            
+            /* A delta image stores the changes from the reference frame */
+            if (reference != NULL)
+            {
+                lineData[x] ^= reference[x];
+            }
+        }
+        decoder->line++;
+        
+        if (!decoder->dataError)
+        {
+            returnValue = CY_EINK_SUCCESS;
+        }
+    }
+    
+    return returnValue;
+}
+
+/*******************************************************************************
+* Function Name: cy_eink_api_result Cy_EINK_ShowCompressedImage(
+*                           cy_eink_compressed_image_t const* prevImage,
+*                           cy_eink_compressed_image_t const* newImage,
+*                           cy_eink_update_t updateType, bool powerCycle)
+********************************************************************************
+*
+* Summary: Updates the E-INK display with a compressed image. The images are
+*  decoded line by line while the update stages are written, so no frame 
+*  buffer is required.
+*
+*  Notes: A partial update compares the previous and the new frame, so a 
+*  compressed image is always written with a full update; CY_EINK_PARTIAL 
+*  selects a 2 stage update, and CY_EINK_AUTO selects a 2 or 4 stage update 
+*  per the number of consecutive 2 stage updates. A frame in flash or RAM can 
+*  be used as the previous image by describing it with a compressed image 
+*  without data that has the frame as reference.
+*
+*  The E-INK display should be powered on (using Cy_EINK_Power function) before 
+*  calling this function, if "powerCycle" parameter is false. Otherwise the 
+*  display won't be updated.
+*
+* Parameters:
+*  cy_eink_compressed_image_t const* prevImage : Previous image written on the
+*                                                display
+*  cy_eink_compressed_image_t const* newImage  : New image that need to be
+*                                                written
+*  cy_eink_update_t              : Full update (2/4 stages), or automatic 
+*                                  selection (CY_EINK_AUTO)
+*  bool powerCycle               : "true" for automatic power cycle, "false" 
+*                                  for manual
+*  
+* Return:
+*  cy_eink_api_result            : CY_EINK_FAILURE if an image is NULL or its
+*                                  packets end before the end of the frame
+*
+* Side Effects:
+*  This is a blocking function that can take as many as 2 seconds 
+*
+*******************************************************************************/
+cy_eink_api_result Cy_EINK_ShowCompressedImage(
+                                cy_eink_compressed_image_t const* prevImage,
+                                cy_eink_compressed_image_t const* newImage,
+                                cy_eink_update_t updateType, bool powerCycle)
+{
+    /* Decoders of the images, and the line functions used by the driver */
+    cy_eink_image_decoder_t prevDecoder;
+    cy_eink_image_decoder_t newDecoder;
+    pv_eink_line_source_t   prevLines = {Cy_EINK_GetImageLine, &prevDecoder};
+    pv_eink_line_source_t   newLines  = {Cy_EINK_GetImageLine, &newDecoder};
+    
+    /* Variable to store the return value */
+    cy_eink_api_result returnValue = CY_EINK_FAILURE;
+    
+    if ((prevImage != NULL) && (newImage != NULL))
+    {
+        Cy_EINK_StartImageDecoder(&prevDecoder, prevImage);
+        Cy_EINK_StartImageDecoder(&newDecoder, newImage);
+        
+        /* Select a full update type */
+        if (updateType == CY_EINK_AUTO)
+        {
+            updateType = (full2StageCount >= CY_EINK_AUTO_2STAGE_LIMIT) ?
+                          CY_EINK_FULL_4STAGE : CY_EINK_FULL_2STAGE;
+            updateCounters.autoUpdates++;
+        }
+        else if (updateType != CY_EINK_FULL_4STAGE)
+        {
+            updateType = CY_EINK_FULL_2STAGE;
+        }
+        else
+        {
+        }
+        
+        /* Keep track of the ghosting removed by this update */
+        Cy_EINK_TrackUpdate(NULL, NULL, updateType);
+        
+        /* Start measuring the cost of the update */
+        Pv_EINK_GetStatistics(NULL, true);
+        lastRefreshStats.refreshTime = (Cy_EINK_GetTime != NULL) ?
+                                        Cy_EINK_GetTime() : 0u;
         
-        /* Additional stages that reduce ghosting for a 4 stage full update */
-        if (updateType == CY_EINK_FULL_4STAGE)
+        /* If power cycle operation requested, turn on E-INK power */
+        if (powerCycle)
         {
-            /* Stage 2: update the display with an all white frame */
-            Pv_EINK_FullStageHandler(prevFrame, PV_EINK_STAGE2);
-            /* Stage 3: update the display with the inverted version of the new 
-               frame */
-            Pv_EINK_FullStageHandler(newFrame, PV_EINK_STAGE3);
+            Cy_EINK_Power(CY_EINK_ON);
         }
         
-        /* Stage 4: update the display with the new frame */
-        Pv_EINK_FullStageHandler(newFrame, PV_EINK_STAGE4);
+        /* Write the full update stages while decoding the images */
+        Pv_EINK_FullUpdateLines(&prevLines, &newLines,
+                                (updateType == CY_EINK_FULL_4STAGE));
+        
+        /* If power cycle operation requested, turn off E-INK power */
+        if (powerCycle)
+        {
+            Cy_EINK_Power(CY_EINK_OFF);
+        }
+        
+        /* Store the cost of the update */
+        Cy_EINK_StoreRefreshStats(updateType);
+        
+        if (!prevDecoder.dataError && !newDecoder.dataError)
+        {
+            returnValue = CY_EINK_SUCCESS;
+        }
+    }
+    
+    return returnValue;
+}
+
+/*******************************************************************************
+* Function Name: uint16_t Cy_EINK_GetChangedRows(uint8_t const** rowBitmap)
+********************************************************************************
+*
+* Summary: Reports how much work the last Cy_EINK_ShowFrame call did. A partial
+*  update only sends the scan lines that differ between the previous and the new
+*  frame; a full update sends all lines.
+*
+* Parameters:
+*  uint8_t const** rowBitmap    : Returns a pointer to the bitmap of the lines
+*                                 sent, one bit per line (bit y % 8 of byte 
+*                                 y / 8). Can be NULL.
+*  
+* Return:
+*  uint16_t                     : Number of lines sent by the last update
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+uint16_t Cy_EINK_GetChangedRows(uint8_t const** rowBitmap)
+{
+    return (Pv_EINK_GetChangedRows(rowBitmap));
+}
+
+/*******************************************************************************
+* Function Name: cy_eink_panel_t const* Cy_EINK_GetPanel(void)
+********************************************************************************
+*
+* Summary: Returns the description of the panel selected by PV_EINK_PANEL at 
+*  build time: its name, resolution, frame geometry and driving parameters.
+*
+* Parameters:
+*  None
+*  
+* Return:
+*  cy_eink_panel_t const*       : Pointer to the constant panel descriptor
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+cy_eink_panel_t const* Cy_EINK_GetPanel(void)
+{
+    return (Pv_EINK_GetPanel());
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_GetUpdateCounters(
+*                                       cy_eink_update_counters_t* counters)
+********************************************************************************
+*
+* Summary: Reports how many display updates of each type have been performed
+*  since startup. Updates requested with CY_EINK_AUTO are counted both as 
+*  automatic updates and as the update type that was selected.
+*
+* Parameters:
+*  cy_eink_update_counters_t* counters : Returns the update counters
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void Cy_EINK_GetUpdateCounters(cy_eink_update_counters_t* counters)
+{
+    *counters = updateCounters;
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_GetRefreshStats(cy_eink_refresh_stats_t* stats)
+********************************************************************************
+*
+* Summary: Reports the cost of the last Cy_EINK_ShowFrame call: the update type
+*  that was performed, the bytes sent to the E-INK driver, the data lines 
+*  latched and the duration, including the power cycle if requested. Use it 
+*  as a baseline when changing the display update functions.
+*
+* Parameters:
+*  cy_eink_refresh_stats_t* stats : Returns the cost of the last update
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void Cy_EINK_GetRefreshStats(cy_eink_refresh_stats_t* stats)
+{
+    *stats = lastRefreshStats;
+}
+
+/*******************************************************************************
+* Function Name: void static Cy_EINK_StoreRefreshStats(
+*                                       cy_eink_update_t updateType)
+********************************************************************************
+*
+* Summary: Stores the cost of the update that has just been performed
+*
+* Parameters:
+*  cy_eink_update_t updateType : Update type performed
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static Cy_EINK_StoreRefreshStats(cy_eink_update_t updateType)
+{
+    pv_eink_statistics_t driverStatistics;
+    
+    Pv_EINK_GetStatistics(&driverStatistics, false);
+    
+    lastRefreshStats.updateType   = updateType;
+    lastRefreshStats.spiBytes     = driverStatistics.spiBytes;
+    lastRefreshStats.linesLatched = driverStatistics.linesLatched;
+    if (Cy_EINK_GetTime != NULL)
+    {
+        lastRefreshStats.refreshTime = Cy_EINK_GetTime() - 
+                                       lastRefreshStats.refreshTime;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cy_eink_update_t static Cy_EINK_SelectUpdate(
+*       cy_eink_frame_t const* prevFrame, cy_eink_frame_t const* newFrame)
+********************************************************************************
+*
+* Summary: Selects the cheapest update type that keeps the ghosting within 
+*  limits:
+*   - A partial update if few pixels have changed, and none of the changed
+*     pixels have received CY_EINK_AUTO_PARTIAL_LIMIT partial updates since
+*     the last full update
+*   - A 2 stage full update if many pixels have changed
+*   - A 4 stage full update if the changed pixels have reached the partial
+*     update limit, or after CY_EINK_AUTO_2STAGE_LIMIT 2 stage full updates
+*
+* Parameters:
+*  cy_eink_frame_t const* prevFrame : Pointer to the previous frame 
+*  cy_eink_frame_t const* newFrame  : Pointer to the new frame
+*  
+* Return:
+*  cy_eink_update_t                 : Selected update type
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+cy_eink_update_t static Cy_EINK_SelectUpdate(cy_eink_frame_t const* prevFrame,
+                                             cy_eink_frame_t const* newFrame)
+{
+    /* Variables used to count the changed pixels and check the ghosting */
+    uint32_t changedPixels;
+    bool     partialLimitReached = false;
+    uint16_t i;
+    cy_eink_update_t updateType;
+    
+    /* Count the changed pixels a word at a time */
+    changedPixels = Cy_EINK_RasterXorDiff(NULL, prevFrame, newFrame);
+    
+    /* Check if any of the changed pixels can't receive more partial 
+       updates */
+    for (i = 0u; (i < CY_EINK_FRAME_SIZE) && (changedPixels != 0u) &&
+                 !partialLimitReached; i++)
+    {
+        if ((prevFrame[i] != newFrame[i]) &&
+            (partialUpdateCount[i] >= CY_EINK_AUTO_PARTIAL_LIMIT))
+        {
+            partialLimitReached = true;
+        }
+    }
+    
+    /* Many pixels have changed: use a full update, and clean the display with
+       a 4 stage update if there was ghosting or after several 2 stage 
+       updates */
+    if ((changedPixels * 100u) >= 
+        (CY_EINK_FRAME_PIXELS * CY_EINK_AUTO_FULL_PERCENT))
+    {
+        if (partialLimitReached || 
+            (full2StageCount >= CY_EINK_AUTO_2STAGE_LIMIT))
+        {
+            updateType = CY_EINK_FULL_4STAGE;
+        }
+        else
+        {
+            updateType = CY_EINK_FULL_2STAGE;
+        }
+    }
+    /* Few pixels have changed, but the ghosting has to be removed */
+    else if (partialLimitReached)
+    {
+        updateType = CY_EINK_FULL_4STAGE;
     }
     else
     {
+        updateType = CY_EINK_PARTIAL;
     }
     
-    /* If power cycle operation requested, turn off E-INK power */
-    if (powerCycle)
+    return updateType;
+}
+
+/*******************************************************************************
+* Function Name: void static Cy_EINK_TrackUpdate(
+*                   cy_eink_frame_t const* prevFrame, 
+*                   cy_eink_frame_t const* newFrame, 
+*                   cy_eink_update_t updateType)
+********************************************************************************
+*
+* Summary: Updates the ghosting estimate and the update counters with an update
+*  that is about to be performed. A partial update increments the partial 
+*  update count of the changed pixels, and a full update clears all counts.
+*
+* Parameters:
+*  cy_eink_frame_t const* prevFrame : Pointer to the previous frame 
+*  cy_eink_frame_t const* newFrame  : Pointer to the new frame
+*  cy_eink_update_t updateType      : Update type performed
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static Cy_EINK_TrackUpdate(cy_eink_frame_t const* prevFrame,
+                                cy_eink_frame_t const* newFrame,
+                                cy_eink_update_t updateType)
+{
+    uint16_t i;
+    
+    if (updateType == CY_EINK_PARTIAL)
     {
-        Cy_EINK_Power(CY_EINK_OFF);
+        for (i = 0u; i < CY_EINK_FRAME_SIZE; i++)
+        {
+            if ((prevFrame[i] != newFrame[i]) && 
+                (partialUpdateCount[i] < CY_EINK_MAX_UPDATE_COUNT))
+            {
+                partialUpdateCount[i]++;
+            }
+        }
+        updateCounters.partialUpdates++;
+    }
+    else if (updateType == CY_EINK_FULL_2STAGE)
+    {
+        memset(partialUpdateCount, 0, sizeof(partialUpdateCount));
+        if (full2StageCount < CY_EINK_MAX_UPDATE_COUNT)
+        {
+            full2StageCount++;
+        }
+        updateCounters.full2StageUpdates++;
+    }
+    else if (updateType == CY_EINK_FULL_4STAGE)
+    {
+        memset(partialUpdateCount, 0, sizeof(partialUpdateCount));
+        full2StageCount = 0u;
+        updateCounters.full4StageUpdates++;
     }
+    else
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: uint8_t static Cy_EINK_ReadImageByte(
+*                                       cy_eink_image_decoder_t* decoder)
+********************************************************************************
+*
+* Summary: Reads the next byte of a compressed image, before the XOR with the 
+*  reference frame
+*
+* Parameters:
+*  cy_eink_image_decoder_t* decoder : Decoder state
+*  
+* Return:
+*  uint8_t                          : Image byte, or zero if the packets have 
+*                                     ended
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+uint8_t static Cy_EINK_ReadImageByte(cy_eink_image_decoder_t* decoder)
+{
+    cy_eink_compressed_image_t const* image = decoder->image;
+    uint8_t control;
+    uint8_t imageByte = 0u;
+    
+    /* Read the control byte of the next packet */
+    if (decoder->packetLength == 0u)
+    {
+        if (decoder->dataIndex < image->dataSize)
+        {
+            control = image->data[decoder->dataIndex++];
+            decoder->packetLength = (control & CY_EINK_RLE_LENGTH_MASK) + 1u;
+            decoder->repeatPacket = 
+                            ((control & CY_EINK_RLE_REPEAT_FLAG) != 0u);
+        }
+        /* An image without data is all zeros */
+        else if (image->data != NULL)
+        {
+            decoder->dataError = true;
+        }
+        else
+        {
+        }
+    }
+    
+    if (decoder->packetLength != 0u)
+    {
+        if (decoder->dataIndex < image->dataSize)
+        {
+            imageByte = image->data[decoder->dataIndex];
+            decoder->packetLength--;
+            
+            /* A literal packet moves to the next data byte after each image
+               byte, and a run after the last image byte */
+            if ((!decoder->repeatPacket) || (decoder->packetLength == 0u))
+            {
+                decoder->dataIndex++;
+            }
+        }
+        else
+        {
+            decoder->packetLength = 0u;
+            decoder->dataError = true;
+        }
+    }
+    
+    return imageByte;
+}
+
+/*******************************************************************************
+* Function Name: pv_eink_frame_data_t static * Cy_EINK_GetImageLine(
+*                                                   void* image, uint16 y)
+********************************************************************************
+*
+* Summary: Line function used by the driver to read a compressed image. Each
+*  update stage reads the lines in ascending order, starting from line 0.
+*
+* Parameters:
+*  void* image                      : Decoder of the compressed image
+*  uint16 y                         : Line number
+*  
+* Return:
+*  pv_eink_frame_data_t*            : Pointer to the decoded line
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+pv_eink_frame_data_t static * Cy_EINK_GetImageLine(void* image, uint16 y)
+{
+    cy_eink_image_decoder_t* decoder = (cy_eink_image_decoder_t*) image;
+    
+    /* Decode the image again from the first line at each stage */
+    if (y == 0u)
+    {
+        Cy_EINK_StartImageDecoder(decoder, decoder->image);
+    }
+    (void) Cy_EINK_DecodeImageLine(decoder, decoder->lineData);
+    
+    return (decoder->lineData);
 }
 
 /* [] END OF FILE */
@@ -57,6 +57,7 @@
 
 /* Header file includes */
 #include "pervasive_eink_hardware_driver.h"
+#include "cy_eink_raster.h"
 #include <stdio.h>
 
 /* Macros used for E-INK power control */
@@ -67,7 +68,8 @@
 #define CY_EINK_POWER_AUTO         (true)
 #define CY_EINK_POWER_MANUAL       (false)
 
-/* Size of an E-INK frame = size of an E-INK image = (264*176)/8 = 5808 bytes */
+/* Size of an E-INK frame = size of an E-INK image = (width*height)/8 bytes, 
+   5808 bytes for the 2.7" panel */
 #define CY_EINK_FRAME_SIZE         PV_EINK_IMAGE_SIZE
 #define CY_EINK_IMAGE_SIZE         PV_EINK_IMAGE_SIZE
     
@@ -75,14 +77,92 @@
 typedef pv_eink_frame_data_t       cy_eink_frame_t;
 typedef pv_eink_frame_data_t       cy_eink_image_t;
 
-/* Data type of E-INK update types */
+/* Description of the panel the driver is built for */
+typedef pv_eink_panel_t            cy_eink_panel_t;
+
+/* Size of an E-INK line = width/8 bytes (33 for the 2.7" panel), and number of
+   lines of a frame */
+#define CY_EINK_LINE_SIZE          PV_EINK_HORIZONTAL_SIZE
+#define CY_EINK_LINE_COUNT         PV_EINK_VERTICAL_SIZE
+
+/* Compressed E-INK images. The frame bytes, line after line, are stored as a 
+   sequence of packets that start with a control byte:
+     0x00 - 0x7F : (control + 1) literal bytes follow
+     0x80 - 0xFF : the following byte is repeated ((control & 0x7F) + 1) times
+   Packets can continue on the next line. If the image has a reference frame,
+   the decoded bytes are XORed with the bytes of the reference frame (delta 
+   image), so that the bytes that are unchanged from the reference are stored
+   as runs of zeros. An image without data is all zeros before the XOR: with a
+   reference frame, it describes the uncompressed reference frame */
+#define CY_EINK_RLE_REPEAT_FLAG    (uint8_t)(0x80u)
+#define CY_EINK_RLE_LENGTH_MASK    (uint8_t)(0x7Fu)
+
+/* Data type of a compressed E-INK image */
+typedef struct
+{
+    uint8_t const*          data;       /* Packets, or NULL */
+    uint16_t                dataSize;   /* Size of the packets in bytes */
+    cy_eink_image_t const*  reference;  /* Reference frame, or NULL */
+}   cy_eink_compressed_image_t;
+
+/* Data type of the state of a compressed image decoder */
+typedef struct
+{
+    cy_eink_compressed_image_t const* image;
+    uint16_t    dataIndex;      /* Next control or data byte */
+    uint8_t     packetLength;   /* Bytes left in the current packet */
+    bool        repeatPacket;   /* "true" if the current packet is a run */
+    uint16_t    line;           /* Next line to be decoded */
+    bool        dataError;      /* "true" if the packets ended too early */
+    uint8_t     lineData[CY_EINK_LINE_SIZE]; /* Line used by the driver */
+}   cy_eink_image_decoder_t;
+
+/* Parameters of the automatic update type selection (CY_EINK_AUTO) */
+/* Percentage of changed pixels above which a full update is used */
+#define CY_EINK_AUTO_FULL_PERCENT      (uint8_t)(20u)
+/* Number of partial updates a group of 8 pixels can receive before a 4 stage
+   full update is used to remove the ghosting */
+#define CY_EINK_AUTO_PARTIAL_LIMIT     (uint8_t)(8u)
+/* Number of consecutive 2 stage full updates before a 4 stage full update is
+   used */
+#define CY_EINK_AUTO_2STAGE_LIMIT      (uint8_t)(3u)
+
+/* Data type of E-INK update types. CY_EINK_AUTO selects a partial, 2 stage 
+   or 4 stage update per the changed pixels and the accumulated ghosting */
 typedef enum
 { 
     CY_EINK_PARTIAL,
     CY_EINK_FULL_4STAGE,
-    CY_EINK_FULL_2STAGE 
+    CY_EINK_FULL_2STAGE,
+    CY_EINK_AUTO
 }   cy_eink_update_t;
 
+/* Data type of the counters of the update types performed */
+typedef struct
+{
+    uint32_t    partialUpdates;
+    uint32_t    full2StageUpdates;
+    uint32_t    full4StageUpdates;
+    uint32_t    autoUpdates;
+}   cy_eink_update_counters_t;
+
+/* Data type of E-INK refresh policies: speed-contrast trade-off of the 
+   refresh time */
+typedef pv_eink_policy_t           cy_eink_policy_t;
+#define CY_EINK_POLICY_FAST            PV_EINK_POLICY_FAST
+#define CY_EINK_POLICY_BALANCED        PV_EINK_POLICY_BALANCED
+#define CY_EINK_POLICY_HIGH_CONTRAST   PV_EINK_POLICY_HIGH_CONTRAST
+
+/* Data type of the cost of a display update */
+typedef struct
+{
+    cy_eink_update_t updateType;    /* Update type performed */
+    uint32_t    spiBytes;           /* Bytes sent to the E-INK driver */
+    uint32_t    linesLatched;       /* Data lines latched by the driver */
+    uint32_t    refreshTime;        /* Duration in milliseconds, or 0 if no
+                                       time function is registered */
+}   cy_eink_refresh_stats_t;
+
 /* Data type for E-INK API results */
 typedef enum
 {   CY_EINK_SUCCESS,
@@ -98,9 +178,36 @@ cy_eink_api_result  Cy_EINK_Start(int8_t temperature,
                                   cy_eink_delay_function_t delayFunction);
 cy_eink_api_result  Cy_EINK_Power(bool powerCtrl);
 
+/* Refresh time functions */
+void Cy_EINK_SetTemperature(int8_t temperature);
+void Cy_EINK_SetPolicy(cy_eink_policy_t policy);
+
 /* Display update function */
 void Cy_EINK_ShowFrame(cy_eink_frame_t* prevFrame, cy_eink_frame_t* newFrame,
                        cy_eink_update_t updateType, bool powerCycle);
 
+/* Compressed image functions */
+void Cy_EINK_StartImageDecoder(cy_eink_image_decoder_t* decoder,
+                               cy_eink_compressed_image_t const* image);
+cy_eink_api_result Cy_EINK_DecodeImageLine(cy_eink_image_decoder_t* decoder,
+                                           uint8_t* lineData);
+cy_eink_api_result Cy_EINK_ShowCompressedImage(
+                                cy_eink_compressed_image_t const* prevImage,
+                                cy_eink_compressed_image_t const* newImage,
+                                cy_eink_update_t updateType, bool powerCycle);
+
+/* Report the scan lines sent by the last display update */
+uint16_t Cy_EINK_GetChangedRows(uint8_t const** rowBitmap);
+
+/* Report the geometry and parameters of the panel the driver is built for */
+cy_eink_panel_t const* Cy_EINK_GetPanel(void);
+
+/* Report the number of display updates of each type */
+void Cy_EINK_GetUpdateCounters(cy_eink_update_counters_t* counters);
+
+/* Report the cost of the last display update. The time is measured with the
+   function registered by Cy_EINK_RegisterTimeFunction */
+void Cy_EINK_GetRefreshStats(cy_eink_refresh_stats_t* stats);
+
 #endif /* CY_CY8CKIT_028_EPD_H */
 /* [] END OF FILE */
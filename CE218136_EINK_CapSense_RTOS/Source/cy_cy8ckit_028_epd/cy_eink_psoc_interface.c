@@ -60,9 +60,31 @@
 /* Function pointer for EINK delay in milliseconds */
 cy_eink_delay_function_t Cy_EINK_Delay;
 
+/* Function pointer for the EINK time stamp in milliseconds */
+cy_eink_time_function_t Cy_EINK_GetTime;
+
+/* Function pointers for the bulk SPI transfer wait and completion callbacks */
+cy_eink_wait_function_t static      Cy_EINK_WaitForTransfer;
+cy_eink_complete_function_t static  Cy_EINK_TransferComplete;
+
+/* Flag that indicates if a bulk SPI transfer is in progress */
+bool static                         transferStarted;
+
 /* Context for SCB */
 cy_stc_scb_spi_context_t CY_EINK_SPIM_context;
 
+/* SCB interrupt configuration used for bulk data transfers */
+const cy_stc_sysint_t CY_EINK_SPIM_IRQ_cfg =
+{
+    .intrSrc      = CY_EINK_SPIM_IRQ,
+    .intrPriority = CY_EINK_SPI_INTR_PRIORITY
+};
+
+/* These static functions are not available outside this file. 
+   See the respective function definitions for more details */
+void static Cy_EINK_SPIInterrupt(void);
+void static Cy_EINK_SPICallback(uint32_t event);
+
 /*******************************************************************************
 * Function Name: void Cy_EINK_RegisterDelayFunction(cy_eink_delay_function_t 
 *                                                   delayFunction)
@@ -86,6 +108,63 @@ void Cy_EINK_RegisterDelayFunction(cy_eink_delay_function_t delayFunction)
     Cy_EINK_Delay = delayFunction;
 }
 
+/*******************************************************************************
+* Function Name: void Cy_EINK_RegisterTimeFunction(
+*                                       cy_eink_time_function_t timeFunction)
+********************************************************************************
+*
+* Summary:
+*  Registers the function that returns a time stamp in milliseconds. The driver
+*  uses it to drive each update stage for the stage time, and to measure the
+*  duration of the display updates
+*
+* Parameters:
+*  cy_eink_time_function_t:    Function pointer to a time function, or NULL
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  Without a time function, the stage time is converted to a number of frames
+*  using an estimate of the frame time
+*******************************************************************************/
+void Cy_EINK_RegisterTimeFunction(cy_eink_time_function_t timeFunction)
+{
+    /* Register the time function */
+    Cy_EINK_GetTime = timeFunction;
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_RegisterTransferFunctions(
+*                               cy_eink_wait_function_t waitFunction,
+*                               cy_eink_complete_function_t completeFunction)
+********************************************************************************
+*
+* Summary:
+*  Registers the callback functions used by the bulk SPI transfers. The wait
+*  function is called after a transfer has been started and should block until
+*  the complete function has been called from the SCB interrupt. If either 
+*  function is NULL, Cy_EINK_WriteArraySPI polls the transfer status instead.
+*
+* Parameters:
+*  cy_eink_wait_function_t     : Function pointer that blocks the caller
+*  cy_eink_complete_function_t : Function pointer that releases the caller, 
+*                                called from the interrupt context
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void Cy_EINK_RegisterTransferFunctions(cy_eink_wait_function_t waitFunction,
+                                   cy_eink_complete_function_t completeFunction)
+{
+    /* Register the transfer functions */
+    Cy_EINK_WaitForTransfer = waitFunction;
+    Cy_EINK_TransferComplete = completeFunction;
+}
+
 /*******************************************************************************
 * Function Name: void Cy_EINK_InitSPI(void)
 ********************************************************************************
@@ -107,8 +186,15 @@ void Cy_EINK_InitSPI(void)
     /* Start the SPI master */
     Cy_SCB_SPI_Init(CY_EINK_SPIM_HW, &CY_EINK_SPIM_config,
                     &CY_EINK_SPIM_context);
+    Cy_SCB_SPI_RegisterCallback(CY_EINK_SPIM_HW, &Cy_EINK_SPICallback,
+                                &CY_EINK_SPIM_context);
     Cy_SCB_SPI_Enable(CY_EINK_SPIM_HW);
     
+    /* Hook the interrupt service routine used by the bulk transfers */
+    Cy_SysInt_Init(&CY_EINK_SPIM_IRQ_cfg, &Cy_EINK_SPIInterrupt);
+    NVIC_ClearPendingIRQ(CY_EINK_SPIM_IRQ_cfg.intrSrc);
+    NVIC_EnableIRQ(CY_EINK_SPIM_IRQ_cfg.intrSrc);
+    
     /* Make the chip select HIGH */
     CY_EINK_CsHigh;
 }
@@ -192,6 +278,129 @@ void Cy_EINK_WriteSPI(uint8_t data)
     Cy_SCB_SPI_ClearRxFifoStatus(CY_EINK_SPIM_HW, CY_SCB_SPI_RX_NOT_EMPTY);
 }
 
+/*******************************************************************************
+* Function Name: void Cy_EINK_WriteArraySPI(uint8_t* data, uint16_t dataLength)
+********************************************************************************
+*
+* Summary:
+*  Send an array of data to the E-INK display driver via SPI. The transfer is
+*  serviced by the SCB interrupt, which keeps the TX FIFO filled so that the
+*  bytes are sent back-to-back. The caller is blocked by the registered wait 
+*  function (or polls the transfer status) until all bytes have been sent.
+*
+* Parameters:
+*  uint8_t* data       : Pointer to the data array that need to be transmitted
+*  uint16_t dataLength : Number of bytes in the data array
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void Cy_EINK_WriteArraySPI(uint8_t* data, uint16_t dataLength)
+{
+    /* Start the transfer and wait until it has finished */
+    Cy_EINK_StartWriteArraySPI(data, dataLength);
+    Cy_EINK_WaitWriteArraySPI();
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_StartWriteArraySPI(uint8_t* data, 
+*                                                uint16_t dataLength)
+********************************************************************************
+*
+* Summary:
+*  Start sending an array of data to the E-INK display driver via SPI and 
+*  return without waiting. The caller can do other work while the data is
+*  being sent, but must call Cy_EINK_WaitWriteArraySPI before the next SPI
+*  operation. If the SCB driver does not accept the transfer, the data is sent
+*  byte by byte before this function returns, so that it is never dropped.
+*
+* Parameters:
+*  uint8_t* data       : Pointer to the data array that need to be transmitted.
+*                        The array must not be modified until the transfer has
+*                        finished.
+*  uint16_t dataLength : Number of bytes in the data array
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void Cy_EINK_StartWriteArraySPI(uint8_t* data, uint16_t dataLength)
+{
+    /* Index of the byte sent by the fallback path */
+    uint16_t dataIndex;
+    
+    /* Start the transfer; received dummy data from the E-INK driver is
+       discarded */
+    transferStarted = (CY_SCB_SPI_SUCCESS == Cy_SCB_SPI_Transfer(
+                                                CY_EINK_SPIM_HW, data, NULL,
+                                                dataLength,
+                                                &CY_EINK_SPIM_context));
+    
+    /* The transfer was rejected: let a transfer that is still active finish,
+       then send the data with the per-byte path */
+    if (!transferStarted)
+    {
+        while (0UL != (Cy_SCB_SPI_GetTransferStatus(CY_EINK_SPIM_HW,
+                       &CY_EINK_SPIM_context) & CY_SCB_SPI_TRANSFER_ACTIVE))
+        {
+        }
+        
+        for (dataIndex = 0u; dataIndex < dataLength; dataIndex++)
+        {
+            Cy_EINK_WriteSPI(data[dataIndex]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_WaitWriteArraySPI(void)
+********************************************************************************
+*
+* Summary:
+*  Wait until the transfer started by Cy_EINK_StartWriteArraySPI has finished.
+*  The caller is blocked by the registered wait function, or polls the transfer
+*  status if no wait function is registered.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void Cy_EINK_WaitWriteArraySPI(void)
+{
+    if (transferStarted)
+    {
+        /* Block until the transfer complete event, if callbacks are 
+           registered */
+        if ((Cy_EINK_WaitForTransfer != NULL) &&
+            (Cy_EINK_TransferComplete != NULL))
+        {
+            Cy_EINK_WaitForTransfer();
+        }
+        
+        /* Make sure that the transfer has finished */
+        while (0UL != (Cy_SCB_SPI_GetTransferStatus(CY_EINK_SPIM_HW,
+                       &CY_EINK_SPIM_context) & CY_SCB_SPI_TRANSFER_ACTIVE))
+        {
+        }
+        transferStarted = false;
+    }
+    
+    /* Clear the TX and RX buffers */
+    Cy_SCB_SPI_ClearTxFifo(CY_EINK_SPIM_HW);
+    Cy_SCB_SPI_ClearRxFifo(CY_EINK_SPIM_HW);
+    Cy_SCB_SPI_ClearRxFifoStatus(CY_EINK_SPIM_HW, CY_SCB_SPI_RX_NOT_EMPTY);
+}
+
 /*******************************************************************************
 * Function Name: Cy_EINK_ReadSPI(uint8_t data)
 ********************************************************************************
@@ -262,4 +471,53 @@ bool Cy_EINK_IsBusy(void)
     }
 }
 
+/*******************************************************************************
+* Function Name: void static Cy_EINK_SPIInterrupt(void)
+********************************************************************************
+*
+* Summary:
+*  SCB interrupt service routine used by the bulk data transfers.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void static Cy_EINK_SPIInterrupt(void)
+{
+    Cy_SCB_SPI_Interrupt(CY_EINK_SPIM_HW, &CY_EINK_SPIM_context);
+}
+
+/*******************************************************************************
+* Function Name: void static Cy_EINK_SPICallback(uint32_t event)
+********************************************************************************
+*
+* Summary:
+*  SCB event callback. Releases the caller of Cy_EINK_WriteArraySPI once the
+*  bulk transfer has finished.
+*
+* Parameters:
+*  uint32_t event : SPI event reported by the SCB driver
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  This function is called from the interrupt context
+*******************************************************************************/
+void static Cy_EINK_SPICallback(uint32_t event)
+{
+    /* Call the registered completion function at the end of the transfer */
+    if ((0UL != (event & CY_SCB_SPI_TRANSFER_CMPLT_EVENT)) &&
+        (Cy_EINK_TransferComplete != NULL) &&
+        (Cy_EINK_WaitForTransfer != NULL))
+    {
+        Cy_EINK_TransferComplete();
+    }
+}
+
 /* [] END OF FILE */
@@ -118,17 +118,45 @@ typedef void (* cy_eink_delay_function_t) (uint32_t delayMs);
 
 /* Function pointer for EINK delay in milliseconds */
 extern cy_eink_delay_function_t Cy_EINK_Delay;
+
+/* Callback function prototype that returns a time stamp in milliseconds */
+typedef uint32_t (* cy_eink_time_function_t) (void);
+
+/* Function pointer for the EINK time stamp, or NULL if none is registered */
+extern cy_eink_time_function_t Cy_EINK_GetTime;
+
+/* Interrupt priority of the SCB used for bulk E-INK data transfers */
+#define CY_EINK_SPI_INTR_PRIORITY   (7u)
+
+/* Callback function prototype that blocks the caller until a bulk SPI
+   transfer has finished */
+typedef void (* cy_eink_wait_function_t) (void);
+
+/* Callback function prototype that is called from the SCB interrupt when a
+   bulk SPI transfer has finished */
+typedef void (* cy_eink_complete_function_t) (void);
    
 /* Functions used for E-INK driver communication */
 void    Cy_EINK_InitSPI(void);
 void    Cy_EINK_AttachSPI(void);
 void    Cy_EINK_DetachSPI(void);
 void    Cy_EINK_WriteSPI(uint8_t data);
+void    Cy_EINK_WriteArraySPI(uint8_t* data, uint16_t dataLength);
+void    Cy_EINK_StartWriteArraySPI(uint8_t* data, uint16_t dataLength);
+void    Cy_EINK_WaitWriteArraySPI(void);
 uint8_t Cy_EINK_ReadSPI(uint8_t data);
 bool    Cy_EINK_IsBusy(void);
 
 /* Function used to register the EINK delay function */
 void    Cy_EINK_RegisterDelayFunction(cy_eink_delay_function_t delayFunction);
 
+/* Function used to register the EINK time function */
+void    Cy_EINK_RegisterTimeFunction(cy_eink_time_function_t timeFunction);
+
+/* Function used to register the bulk SPI transfer wait and completion 
+   callbacks */
+void    Cy_EINK_RegisterTransferFunctions(cy_eink_wait_function_t waitFunction,
+                                  cy_eink_complete_function_t completeFunction);
+
 #endif /* CY_EINK_PSOC_INTERFACE_H */  
 /* [] END OF FILE */
@@ -0,0 +1,593 @@
+/******************************************************************************
+* File Name: cy_eink_raster.c
+*
+* Version: 1.00
+*
+* Description: This file contains the raster operations on E-INK frames
+*
+* Hardware Dependency: CY8CKIT-028-EPD E-INK Display Shield
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* This file contains raster operations on 1 bit per pixel frames: rectangle 
+* fill, bitmap copy, XOR difference of two frames and the bitmap of the changed
+* rows. A frame line is 33 bytes long on the 2.7" panel, so the lines are not
+* word aligned. Each span of bytes is processed as a byte head up to the next
+* word boundary, a run of 32-bit words and a byte tail. Spans of two frames are
+* only processed word by word if both frames have the same word alignment,
+* which is the case for frames that are word aligned.
+*
+* For the details of the E-INK display and library functions, see the code  
+* example document of CE218136 - PSoC 6 MCU E-INK Display with CapSense (RTOS)
+*******************************************************************************/
+
+/* Header file includes */
+#include "cy_eink_raster.h"
+
+/* Data-type used to access the frame data one word at a time. The type may 
+   alias the frame bytes */
+typedef uint32_t __attribute__((__may_alias__)) cy_eink_raster_word_t;
+
+/* Macros used for word level operations */
+#define CY_EINK_RASTER_WORD_SIZE    (uint8_t)(sizeof(cy_eink_raster_word_t))
+#define CY_EINK_RASTER_WORD_MASK    (uintptr_t)(CY_EINK_RASTER_WORD_SIZE - 1u)
+#define CY_EINK_RASTER_BYTE_TO_WORD (uint32_t)(0x01010101u)
+
+/* Number of bytes before the next word boundary */
+#define CY_EINK_RASTER_HEAD_SIZE(ptr)   (uint16_t)((CY_EINK_RASTER_WORD_SIZE - \
+                                         ((uintptr_t)(ptr) &                   \
+                                          CY_EINK_RASTER_WORD_MASK)) &         \
+                                         CY_EINK_RASTER_WORD_MASK)
+
+/* Masks of the pixels of a byte starting at, or ending at a pixel column */
+#define CY_EINK_RASTER_LEFT_MASK(x)     (uint8_t)(0xFFu >> ((x) %              \
+                                                  CY_EINK_BYTE_SIZE))
+#define CY_EINK_RASTER_RIGHT_MASK(x)    (uint8_t)(0xFFu << ((CY_EINK_BYTE_SIZE \
+                                                  - 1u) - ((x) %               \
+                                                  CY_EINK_BYTE_SIZE)))
+
+/* Data-type of the column range of a rectangle: the masks of the first and the
+   last bytes, and the bytes in between that are completely covered */
+typedef struct
+{
+    uint16_t    firstByte;
+    uint16_t    middleSize;
+    uint16_t    lastByte;
+    uint8_t     firstMask;
+    uint8_t     lastMask;
+}   cy_eink_raster_span_t;
+
+/* Declarations of functions that are only accessed by raster functions */
+bool static     Cy_EINK_RasterClip(uint16_t x0, uint16_t* y0, uint16_t* x1,
+                                   uint16_t* y1, cy_eink_raster_span_t* span);
+void static     Cy_EINK_RasterSet(pv_eink_frame_data_t* dst, uint8_t value,
+                                  uint16_t size);
+void static     Cy_EINK_RasterMove(pv_eink_frame_data_t* dst,
+                                   pv_eink_frame_data_t const* src,
+                                   uint16_t size);
+bool static     Cy_EINK_RasterEqual(pv_eink_frame_data_t const* bytesA,
+                                    pv_eink_frame_data_t const* bytesB,
+                                    uint16_t size);
+uint8_t static  Cy_EINK_RasterCountPixels(uint32_t pixels);
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_RasterFill(pv_eink_frame_data_t* frame, 
+*                   uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, 
+*                   bool white)
+********************************************************************************
+*
+* Summary: Fills a rectangle of a frame with white or black pixels. The 
+*  rectangle is clipped to the frame.
+*
+* Parameters:
+*  pv_eink_frame_data_t* frame  : Frame to fill
+*  uint16_t x0, y0              : Top left pixel of the rectangle
+*  uint16_t x1, y1              : Bottom right pixel of the rectangle, included
+*  bool white                   : true for white pixels, false for black pixels
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void Cy_EINK_RasterFill(pv_eink_frame_data_t* frame, uint16_t x0, uint16_t y0,
+                        uint16_t x1, uint16_t y1, bool white)
+{
+    cy_eink_raster_span_t   span;
+    pv_eink_frame_data_t*   line;
+    uint8_t                 fillByte = white ? PV_EINK_WHITE_PIXEL_BYTE :
+                                               PV_EINK_BLACK_PIXEL_BYTE;
+    
+    if (Cy_EINK_RasterClip(x0, &y0, &x1, &y1, &span))
+    {
+        for (; y0 <= y1; y0++)
+        {
+            line = &frame[y0 * CY_EINK_RASTER_LINE_SIZE];
+            
+            /* Keep the pixels outside the rectangle in the first and the last
+               bytes */
+            line[span.firstByte] = (line[span.firstByte] & 
+                                    (uint8_t)~span.firstMask) |
+                                   (fillByte & span.firstMask);
+            Cy_EINK_RasterSet(&line[span.firstByte + 1u], fillByte,
+                              span.middleSize);
+            line[span.lastByte] = (line[span.lastByte] & 
+                                   (uint8_t)~span.lastMask) |
+                                  (fillByte & span.lastMask);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: void Cy_EINK_RasterCopy(pv_eink_frame_data_t* dstFrame,
+*                   pv_eink_frame_data_t const* srcBitmap, uint16_t srcLineSize,
+*                   uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+********************************************************************************
+*
+* Summary: Copies a bitmap to a rectangle of a frame. The rectangle is clipped 
+*  to the frame. The bitmap has the pixel format of the frame and is aligned to
+*  its bytes: the first byte of each bitmap line holds the pixels of the frame
+*  byte that contains column x0, and line n of the bitmap is copied to line 
+*  y0 + n. A rectangle of another frame is copied to the same position with 
+*  the bitmap &srcFrame[y0 * CY_EINK_RASTER_LINE_SIZE + x0 / 8] and a line 
+*  size of CY_EINK_RASTER_LINE_SIZE.
+*
+* Parameters:
+*  pv_eink_frame_data_t* dstFrame        : Frame to copy to
+*  pv_eink_frame_data_t const* srcBitmap : Bitmap to copy from
+*  uint16_t srcLineSize                  : Bytes per line of the bitmap
+*  uint16_t x0, y0                       : Top left pixel of the rectangle
+*  uint16_t x1, y1                       : Bottom right pixel of the rectangle,
+*                                          included
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void Cy_EINK_RasterCopy(pv_eink_frame_data_t* dstFrame,
+                        pv_eink_frame_data_t const* srcBitmap,
+                        uint16_t srcLineSize, uint16_t x0, uint16_t y0,
+                        uint16_t x1, uint16_t y1)
+{
+    cy_eink_raster_span_t       span;
+    pv_eink_frame_data_t*       dstLine;
+    pv_eink_frame_data_t const* srcLine;
+    uint16_t                    srcLast;
+    
+    if (Cy_EINK_RasterClip(x0, &y0, &x1, &y1, &span))
+    {
+        /* Offset of the last byte in a bitmap line */
+        srcLast = span.lastByte - span.firstByte;
+        
+        for (; y0 <= y1; y0++)
+        {
+            dstLine = &dstFrame[y0 * CY_EINK_RASTER_LINE_SIZE];
+            srcLine = srcBitmap;
+            srcBitmap += srcLineSize;
+            
+            /* Keep the pixels outside the rectangle in the first and the last
+               bytes */
+            dstLine[span.firstByte] = (dstLine[span.firstByte] & 
+                                       (uint8_t)~span.firstMask) |
+                                      (srcLine[0u] & span.firstMask);
+            Cy_EINK_RasterMove(&dstLine[span.firstByte + 1u], &srcLine[1u],
+                               span.middleSize);
+            dstLine[span.lastByte] = (dstLine[span.lastByte] & 
+                                      (uint8_t)~span.lastMask) |
+                                     (srcLine[srcLast] & span.lastMask);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: uint32_t Cy_EINK_RasterXorDiff(
+*                   pv_eink_frame_data_t* diffFrame,
+*                   pv_eink_frame_data_t const* frameA,
+*                   pv_eink_frame_data_t const* frameB)
+********************************************************************************
+*
+* Summary: Computes the XOR of two frames, which has the changed pixels set, 
+*  and counts the changed pixels
+*
+* Parameters:
+*  pv_eink_frame_data_t* diffFrame    : Frame that receives the XOR, or NULL 
+*                                       to only count the changed pixels
+*  pv_eink_frame_data_t const* frameA : First frame
+*  pv_eink_frame_data_t const* frameB : Second frame
+*  
+* Return:
+*  uint32_t                           : Number of changed pixels
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+uint32_t Cy_EINK_RasterXorDiff(pv_eink_frame_data_t* diffFrame,
+                               pv_eink_frame_data_t const* frameA,
+                               pv_eink_frame_data_t const* frameB)
+{
+    uint32_t    changedPixels = 0u;
+    uint32_t    diffWord;
+    uint16_t    i = 0u;
+    uint16_t    headSize = CY_EINK_RASTER_HEAD_SIZE(frameA);
+    
+    /* Words can be used if the frames (and the XOR frame) are aligned 
+       alike */
+    if ((headSize != CY_EINK_RASTER_HEAD_SIZE(frameB)) || 
+        ((diffFrame != NULL) && 
+         (headSize != CY_EINK_RASTER_HEAD_SIZE(diffFrame))))
+    {
+        headSize = PV_EINK_IMAGE_SIZE;
+    }
+    
+    /* Byte head */
+    for (; i < headSize; i++)
+    {
+        diffWord = frameA[i] ^ frameB[i];
+        if (diffFrame != NULL)
+        {
+            diffFrame[i] = (pv_eink_frame_data_t)diffWord;
+        }
+        changedPixels += Cy_EINK_RasterCountPixels(diffWord);
+    }
+    
+    /* Words */
+    for (; (i + CY_EINK_RASTER_WORD_SIZE) <= PV_EINK_IMAGE_SIZE; 
+         i += CY_EINK_RASTER_WORD_SIZE)
+    {
+        diffWord = *(cy_eink_raster_word_t const*)&frameA[i] ^
+                   *(cy_eink_raster_word_t const*)&frameB[i];
+        if (diffFrame != NULL)
+        {
+            *(cy_eink_raster_word_t*)&diffFrame[i] = diffWord;
+        }
+        if (diffWord != 0u)
+        {
+            changedPixels += Cy_EINK_RasterCountPixels(diffWord);
+        }
+    }
+    
+    /* Byte tail */
+    for (; i < PV_EINK_IMAGE_SIZE; i++)
+    {
+        diffWord = frameA[i] ^ frameB[i];
+        if (diffFrame != NULL)
+        {
+            diffFrame[i] = (pv_eink_frame_data_t)diffWord;
+        }
+        changedPixels += Cy_EINK_RasterCountPixels(diffWord);
+    }
+    
+    return changedPixels;
+}
+
+/*******************************************************************************
+* Function Name: uint16_t Cy_EINK_RasterChangedRows(
+*                   pv_eink_frame_data_t const* frameA,
+*                   pv_eink_frame_data_t const* frameB, uint8_t* rowBitmap)
+********************************************************************************
+*
+* Summary: Finds the rows that differ between two frames
+*
+* Parameters:
+*  pv_eink_frame_data_t const* frameA : First frame
+*  pv_eink_frame_data_t const* frameB : Second frame
+*  uint8_t* rowBitmap                 : Bitmap of CY_EINK_RASTER_ROW_BITMAP_SIZE
+*                                       bytes that receives the changed rows
+*  
+* Return:
+*  uint16_t                           : Number of changed rows
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+uint16_t Cy_EINK_RasterChangedRows(pv_eink_frame_data_t const* frameA,
+                                   pv_eink_frame_data_t const* frameB,
+                                   uint8_t* rowBitmap)
+{
+    uint16_t    changedRows = 0u;
+    uint16_t    y;
+    uint16_t    offset;
+    
+    Cy_EINK_RasterSet(rowBitmap, 0u, CY_EINK_RASTER_ROW_BITMAP_SIZE);
+    
+    for (y = 0u; y < CY_EINK_RASTER_LINE_COUNT; y++)
+    {
+        offset = y * CY_EINK_RASTER_LINE_SIZE;
+        if (!Cy_EINK_RasterEqual(&frameA[offset], &frameB[offset],
+                                 CY_EINK_RASTER_LINE_SIZE))
+        {
+            rowBitmap[y / CY_EINK_BYTE_SIZE] |= 
+                (uint8_t)(0x01u << (y % CY_EINK_BYTE_SIZE));
+            changedRows++;
+        }
+    }
+    
+    return changedRows;
+}
+
+/*******************************************************************************
+* Function Name: bool static Cy_EINK_RasterClip(uint16_t x0, uint16_t* y0,
+*                   uint16_t* x1, uint16_t* y1, cy_eink_raster_span_t* span)
+********************************************************************************
+*
+* Summary: Clips a rectangle to the frame and calculates the bytes and the 
+*  masks of its column range
+*
+* Parameters:
+*  uint16_t x0                  : Left pixel of the rectangle
+*  uint16_t* y0, x1, y1         : Top, right and bottom pixels of the 
+*                                 rectangle, clipped to the frame
+*  cy_eink_raster_span_t* span  : Column range of the rectangle
+*  
+* Return:
+*  bool                         : false if the rectangle is outside the frame
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+bool static Cy_EINK_RasterClip(uint16_t x0, uint16_t* y0, uint16_t* x1,
+                               uint16_t* y1, cy_eink_raster_span_t* span)
+{
+    bool inFrame = false;
+    
+    if (*x1 >= CY_EINK_RASTER_LINE_PIXELS)
+    {
+        *x1 = CY_EINK_RASTER_LINE_PIXELS - 1u;
+    }
+    if (*y1 >= CY_EINK_RASTER_LINE_COUNT)
+    {
+        *y1 = CY_EINK_RASTER_LINE_COUNT - 1u;
+    }
+    
+    if ((x0 <= *x1) && (*y0 <= *y1))
+    {
+        span->firstByte = x0 / CY_EINK_BYTE_SIZE;
+        span->lastByte  = *x1 / CY_EINK_BYTE_SIZE;
+        span->firstMask = CY_EINK_RASTER_LEFT_MASK(x0);
+        span->lastMask  = CY_EINK_RASTER_RIGHT_MASK(*x1);
+        
+        /* A rectangle within a byte only has a first byte. The last byte is
+           then written again with the same data */
+        if (span->firstByte == span->lastByte)
+        {
+            span->firstMask &= span->lastMask;
+            span->lastMask   = span->firstMask;
+            span->middleSize = 0u;
+        }
+        else
+        {
+            span->middleSize = span->lastByte - span->firstByte - 1u;
+        }
+        inFrame = true;
+    }
+    
+    return inFrame;
+}
+
+/*******************************************************************************
+* Function Name: void static Cy_EINK_RasterSet(pv_eink_frame_data_t* dst,
+*                   uint8_t value, uint16_t size)
+********************************************************************************
+*
+* Summary: Sets a span of bytes to a value
+*
+* Parameters:
+*  pv_eink_frame_data_t* dst : First byte of the span
+*  uint8_t value             : Value of the bytes
+*  uint16_t size             : Number of bytes
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static Cy_EINK_RasterSet(pv_eink_frame_data_t* dst, uint8_t value,
+                              uint16_t size)
+{
+    uint32_t    valueWord = value * CY_EINK_RASTER_BYTE_TO_WORD;
+    uint16_t    i = CY_EINK_RASTER_HEAD_SIZE(dst);
+    
+    if (i > size)
+    {
+        i = size;
+    }
+    size -= i;
+    
+    /* Byte head */
+    for (; i > 0u; i--)
+    {
+        *dst++ = value;
+    }
+    
+    /* Words */
+    for (; size >= CY_EINK_RASTER_WORD_SIZE; size -= CY_EINK_RASTER_WORD_SIZE)
+    {
+        *(cy_eink_raster_word_t*)dst = valueWord;
+        dst += CY_EINK_RASTER_WORD_SIZE;
+    }
+    
+    /* Byte tail */
+    for (; size > 0u; size--)
+    {
+        *dst++ = value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static Cy_EINK_RasterMove(pv_eink_frame_data_t* dst,
+*                   pv_eink_frame_data_t const* src, uint16_t size)
+********************************************************************************
+*
+* Summary: Copies a span of bytes. The spans must not overlap.
+*
+* Parameters:
+*  pv_eink_frame_data_t* dst       : First byte of the destination span
+*  pv_eink_frame_data_t const* src : First byte of the source span
+*  uint16_t size                   : Number of bytes
+*  
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static Cy_EINK_RasterMove(pv_eink_frame_data_t* dst,
+                               pv_eink_frame_data_t const* src, uint16_t size)
+{
+    uint16_t    i = CY_EINK_RASTER_HEAD_SIZE(dst);
+    
+    /* Copy byte by byte if the spans are aligned differently */
+    if ((i != CY_EINK_RASTER_HEAD_SIZE(src)) || (i > size))
+    {
+        i = size;
+    }
+    size -= i;
+    
+    /* Byte head */
+    for (; i > 0u; i--)
+    {
+        *dst++ = *src++;
+    }
+    
+    /* Words */
+    for (; size >= CY_EINK_RASTER_WORD_SIZE; size -= CY_EINK_RASTER_WORD_SIZE)
+    {
+        *(cy_eink_raster_word_t*)dst = *(cy_eink_raster_word_t const*)src;
+        dst += CY_EINK_RASTER_WORD_SIZE;
+        src += CY_EINK_RASTER_WORD_SIZE;
+    }
+    
+    /* Byte tail */
+    for (; size > 0u; size--)
+    {
+        *dst++ = *src++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bool static Cy_EINK_RasterEqual(
+*                   pv_eink_frame_data_t const* bytesA,
+*                   pv_eink_frame_data_t const* bytesB, uint16_t size)
+********************************************************************************
+*
+* Summary: Compares two spans of bytes
+*
+* Parameters:
+*  pv_eink_frame_data_t const* bytesA : First byte of the first span
+*  pv_eink_frame_data_t const* bytesB : First byte of the second span
+*  uint16_t size                      : Number of bytes
+*  
+* Return:
+*  bool                               : true if the spans are equal
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+bool static Cy_EINK_RasterEqual(pv_eink_frame_data_t const* bytesA,
+                                pv_eink_frame_data_t const* bytesB,
+                                uint16_t size)
+{
+    uint16_t    i = CY_EINK_RASTER_HEAD_SIZE(bytesA);
+    bool        equal = true;
+    
+    /* Compare byte by byte if the spans are aligned differently */
+    if ((i != CY_EINK_RASTER_HEAD_SIZE(bytesB)) || (i > size))
+    {
+        i = size;
+    }
+    size -= i;
+    
+    /* Byte head */
+    for (; (i > 0u) && equal; i--)
+    {
+        equal = (*bytesA++ == *bytesB++);
+    }
+    
+    /* Words */
+    for (; (size >= CY_EINK_RASTER_WORD_SIZE) && equal; 
+         size -= CY_EINK_RASTER_WORD_SIZE)
+    {
+        equal = (*(cy_eink_raster_word_t const*)bytesA == 
+                 *(cy_eink_raster_word_t const*)bytesB);
+        bytesA += CY_EINK_RASTER_WORD_SIZE;
+        bytesB += CY_EINK_RASTER_WORD_SIZE;
+    }
+    
+    /* Byte tail */
+    for (; (size > 0u) && equal; size--)
+    {
+        equal = (*bytesA++ == *bytesB++);
+    }
+    
+    return equal;
+}
+
+/*******************************************************************************
+* Function Name: uint8_t static Cy_EINK_RasterCountPixels(uint32_t pixels)
+********************************************************************************
+*
+* Summary: Counts the pixels that are set in a word, adding the bits in pairs, 
+*  nibbles and bytes in parallel
+*
+* Parameters:
+*  uint32_t pixels : Frame word
+*  
+* Return:
+*  uint8_t         : Number of bits set
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+uint8_t static Cy_EINK_RasterCountPixels(uint32_t pixels)
+{
+    pixels = pixels - ((pixels >> 1u) & 0x55555555u);
+    pixels = (pixels & 0x33333333u) + ((pixels >> 2u) & 0x33333333u);
+    pixels = (pixels + (pixels >> 4u)) & 0x0F0F0F0Fu;
+    
+    return (uint8_t)((pixels * CY_EINK_RASTER_BYTE_TO_WORD) >> 24u);
+}
+
+/* [] END OF FILE */
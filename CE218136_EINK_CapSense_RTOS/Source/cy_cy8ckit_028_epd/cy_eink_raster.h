@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name: cy_eink_raster.h
+*
+* Version: 1.00
+*
+* Description: This file contains function declarations and macro definitions
+*              provided by the cy_eink_raster.c file.
+*
+* Hardware Dependency: CY8CKIT-028-EPD E-INK Display Shield
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* This file contains the function declarations and macros of the frame raster
+* operations. The operations work on frames in the format of the E-INK library
+* and the emWin display buffer: one bit per pixel, 1 for white, and the 
+* leftmost pixel of a byte in its most significant bit.
+*
+* For the details of the E-INK display and library functions, see the code  
+* example document of CE218136 - PSoC 6 MCU E-INK Display with CapSense (RTOS)
+*******************************************************************************/
+
+/* Include Guard */
+#ifndef CY_EINK_RASTER_H
+#define CY_EINK_RASTER_H
+
+/* Header file includes */
+#include "pervasive_eink_hardware_driver.h"
+
+/* Geometry of a frame: bytes per line, number of lines and line width in 
+   pixels */
+#define CY_EINK_RASTER_LINE_SIZE       PV_EINK_HORIZONTAL_SIZE
+#define CY_EINK_RASTER_LINE_COUNT      PV_EINK_VERTICAL_SIZE
+#define CY_EINK_RASTER_LINE_PIXELS     (uint16_t)(CY_EINK_RASTER_LINE_SIZE * \
+                                                  CY_EINK_BYTE_SIZE)
+
+/* Size of a changed row bitmap in bytes: bit (row % 8) of byte (row / 8) is 
+   set if the row has changed */
+#define CY_EINK_RASTER_ROW_BITMAP_SIZE (uint8_t)((CY_EINK_RASTER_LINE_COUNT +  \
+                                        CY_EINK_BYTE_SIZE - 1u) /              \
+                                        CY_EINK_BYTE_SIZE)
+
+/* Declarations of functions defined in cy_eink_raster.c */
+void     Cy_EINK_RasterFill(pv_eink_frame_data_t* frame, uint16_t x0, 
+                            uint16_t y0, uint16_t x1, uint16_t y1, bool white);
+void     Cy_EINK_RasterCopy(pv_eink_frame_data_t* dstFrame,
+                            pv_eink_frame_data_t const* srcBitmap,
+                            uint16_t srcLineSize, uint16_t x0, uint16_t y0,
+                            uint16_t x1, uint16_t y1);
+uint32_t Cy_EINK_RasterXorDiff(pv_eink_frame_data_t* diffFrame,
+                               pv_eink_frame_data_t const* frameA,
+                               pv_eink_frame_data_t const* frameB);
+uint16_t Cy_EINK_RasterChangedRows(pv_eink_frame_data_t const* frameA,
+                                   pv_eink_frame_data_t const* frameB,
+                                   uint8_t* rowBitmap);
+
+#endif  /* CY_EINK_RASTER_H */
+/* [] END OF FILE */
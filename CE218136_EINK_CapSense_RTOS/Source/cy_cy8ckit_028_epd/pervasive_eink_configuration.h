@@ -44,10 +44,40 @@
 #define PERVASIVE_EINK_CONFIGURATION_H
 
 /* Definitions of refresh time scaling factors for full update and partial 
-   update. This is a speed-contrast trade-off: Selecting a higher scaling factor
-   increases the contrast as well as the refresh time */
-#define PV_EINK_SCALING_FULL                (uint8_t)(0x01u)
-#define PV_EINK_SCALING_PARTIAL             (uint8_t)(0x01u)    
+   update of each refresh policy, in steps of 1/PV_EINK_SCALING_DIVIDER. This 
+   is a speed-contrast trade-off: a higher scaling factor increases the 
+   contrast as well as the refresh time */
+#define PV_EINK_SCALING_DIVIDER             (uint16)(2)
+#define PV_EINK_SCALING_FAST_FULL           (uint16)(1)
+#define PV_EINK_SCALING_FAST_PARTIAL        (uint16)(1)
+#define PV_EINK_SCALING_BALANCED_FULL       (uint16)(2)
+#define PV_EINK_SCALING_BALANCED_PARTIAL    (uint16)(2)
+#define PV_EINK_SCALING_CONTRAST_FULL       (uint16)(4)
+#define PV_EINK_SCALING_CONTRAST_PARTIAL    (uint16)(3)
+
+/* Supported G2 panels. Select the panel with PV_EINK_PANEL; the geometry 
+   below is specialised for it at compile time, so the stage encoders have no
+   run-time panel checks */
+#define PV_EINK_PANEL_1_44                  (1u)
+#define PV_EINK_PANEL_2_0                   (2u)
+#define PV_EINK_PANEL_2_7                   (3u)
+#ifndef PV_EINK_PANEL
+#define PV_EINK_PANEL                       PV_EINK_PANEL_2_7
+#endif
+
+/* Estimated time of a full frame in milliseconds: without a registered time
+   function, the stage time is converted to a number of frames with it. This 
+   is the frame time of the 2.7" panel with the bulk SPI transfers */
+#define PV_EINK_FRAME_TIME_ESTIMATE         (uint16)(14)
+
+/* Line streaming mode. When set to 1, each line is encoded while the previous
+   line is being sent, using PV_EINK_STREAMING_BUFFERS line packets instead of
+   the packets of the whole frame (about 19 KB of SRAM). The lines are then
+   encoded again at every frame, which takes more CPU time */
+#ifndef PV_EINK_LINE_STREAMING
+#define PV_EINK_LINE_STREAMING              (0u)
+#endif
+#define PV_EINK_STREAMING_BUFFERS           (2u)
     
 /* Display driver addresses and commands. Do not modify these values */
 #define PV_EINK_DRIVER_ID_COMMAND_INDEX     (uint8_t)(0x72u)
@@ -97,7 +127,6 @@
 #define PV_EINK_CH_PUMP_OFF_COMMAND_DATA    (uint8_t)(0x00u)
 #define PV_EINK_OSC_OFF_COMMAND_INDEX       (uint8_t)(0x07u)
 #define PV_EINK_OSC_OFF_COMMAND_DATA        (uint8_t)(0x01u)
-#define PV_EINK_VOLTAGE_LEVEL               (uint8_t)(0x00u)
 
 /* Definitions of black and white pixel data bytes */ 
 #define PV_EINK_BLACK_PIXEL_BYTE            (uint8_t)(0x00u)
@@ -136,6 +165,10 @@
 #define PV_EINK_BORDER_BYTE_B               (uint8_t)(0xFFu)
 #define PV_EINK_BORDER_BYTE_W               (uint8_t)(0xAAu)
 
+/* Number of bytes sent in addition to the data of a driver command: the index 
+   header, the register address and the data header */
+#define PV_EINK_COMMAND_OVERHEAD            (uint8_t)(0x03u)
+
 /* Header index, data and driver information */
 #define PV_EINK_REG_INDEX_HEADER            (uint8_t)(0x70u)
 #define PV_EINK_REG_DATA_READ               (uint8_t)(0x73u)
@@ -162,34 +195,75 @@
 #define PV_EINK_CHARGE_PUMP_MAX_WRITE       (uint8_t)(0x04u)
 #define PV_EINK_MAX_PV_EINK_BUSY_TIME       (uint32_t)(0x0000000Au)
 #define PV_EINK_SCAN_TABLE_DATA             {0xC0u,0x30u,0x0Cu,0x03u}
+
+/* Panel parameters: width in pixels, height in lines, the stage time in 
+   milliseconds at 20 to 40 degrees Celsius, the channel select data and the 
+   charge pump voltage level. The border byte of a data line is sent 
+   before the even bytes by the 2.7" panel, and after the odd bytes by the 
+   smaller panels */
+#if (PV_EINK_PANEL == PV_EINK_PANEL_1_44)
+#define PV_EINK_PANEL_NAME                  "1.44\""
+#define PV_EINK_STAGE_TIME                  (uint16)(480)
+#define PV_EINK_PANEL_WIDTH                 (128u)
+#define PV_EINK_PANEL_HEIGHT                (96u)
+#define PV_EINK_CHANNEL_SEL_DATA            {0x00u,0x00u,0x00u,0x00u,\
+                                             0x00u,0x0Fu,0xFFu,0x00u}
+#define PV_EINK_VOLTAGE_LEVEL               (uint8_t)(0x03u)
+#define PV_EINK_BORDER_FIRST                (0u)
+#elif (PV_EINK_PANEL == PV_EINK_PANEL_2_0)
+#define PV_EINK_PANEL_NAME                  "2.0\""
+#define PV_EINK_STAGE_TIME                  (uint16)(480)
+#define PV_EINK_PANEL_WIDTH                 (200u)
+#define PV_EINK_PANEL_HEIGHT                (96u)
+#define PV_EINK_CHANNEL_SEL_DATA            {0x00u,0x00u,0x00u,0x00u,\
+                                             0x01u,0xFFu,0xE0u,0x00u}
+#define PV_EINK_VOLTAGE_LEVEL               (uint8_t)(0x03u)
+#define PV_EINK_BORDER_FIRST                (0u)
+#elif (PV_EINK_PANEL == PV_EINK_PANEL_2_7)
+#define PV_EINK_PANEL_NAME                  "2.7\""
+#define PV_EINK_STAGE_TIME                  (uint16)(630)
+#define PV_EINK_PANEL_WIDTH                 (264u)
+#define PV_EINK_PANEL_HEIGHT                (176u)
 #define PV_EINK_CHANNEL_SEL_DATA            {0x00u,0x00u,0x00u,0x7Fu,\
                                              0xFFu,0xFEu,0x00u,0x00u}
+#define PV_EINK_VOLTAGE_LEVEL               (uint8_t)(0x00u)
+#define PV_EINK_BORDER_FIRST                (1u)
+#else
+#error "PV_EINK_PANEL: unsupported E-INK panel"
+#endif
 
-/* Definitions of 2.7" display parameters */
-/* Width of E-INK in bytes = 264/8 */
-#define PV_EINK_HORIZONTAL_SIZE             (uint16)(33)
-/* Height of E-INK in bytes */
-#define PV_EINK_VERTICAL_SIZE               (uint16)(176)
-/* Data line size = Data + Scan + Dummy bytes =
-   ((((264+176)*2)/8)+1) = 111 */
-#define PV_EINK_DATA_LINE_SIZE              (uint8_t) (111)
+/* Display geometry derived from the panel parameters */
+/* Width of E-INK in bytes = width/8 */
+#define PV_EINK_HORIZONTAL_SIZE             (uint16)(PV_EINK_PANEL_WIDTH / 8u)
+/* Height of E-INK in lines */
+#define PV_EINK_VERTICAL_SIZE               (uint16)(PV_EINK_PANEL_HEIGHT)
+/* Scan line size in bytes = 2*(height/8) */
+#define PV_EINK_SCAN_LINE_SIZE              (uint8_t)(PV_EINK_PANEL_HEIGHT / 4u)
+/* Data line size = Data + Scan + Border bytes = (((width+height)*2)/8)+1, 
+   which is 111 for the 2.7" panel */
+#define PV_EINK_DATA_LINE_SIZE              (uint8_t)((2u *                    \
+                                             PV_EINK_HORIZONTAL_SIZE) +        \
+                                             PV_EINK_SCAN_LINE_SIZE + 1u)
 /* The rest of frame time in a stage */
 #define PV_EINK_FRAME_TIME_OFFSET           (uint16)(0)
-/* Scan line size in bytes = 2*(176/8) = 44 */
-#define PV_EINK_SCAN_LINE_SIZE              (uint8_t) (44)
-
-/* Size of an image = (264*176)/8 bytes */
-#define PV_EINK_IMAGE_SIZE                  (uint16)(5808)
-
-/* Write cycle parameters used for temperature compensation of contrast */
-#define PV_EINK_TEMP_SEL0                   (uint16)(9)
-#define PV_EINK_TEMP_SEL1                   (uint16)(8)
-#define PV_EINK_TEMP_SEL2                   (uint16)(7)
-#define PV_EINK_TEMP_SEL3                   (uint16)(6)
-#define PV_EINK_TEMP_SEL4                   (uint16)(5)
-#define PV_EINK_TEMP_SEL5                   (uint16)(4)
-#define PV_EINK_TEMP_SEL6                   (uint16)(3)
-#define PV_EINK_TEMP_SEL7                   (uint16)(2)
+
+/* Size of an image = (width*height)/8 bytes, 5808 for the 2.7" panel */
+#define PV_EINK_IMAGE_SIZE                  (uint16)(PV_EINK_HORIZONTAL_SIZE * \
+                                                     PV_EINK_VERTICAL_SIZE)
+
+/* Stage time factors used for temperature compensation of contrast, in steps
+   of 1/PV_EINK_TEMP_FACTOR_DIVIDER (driver G2 document Section 5.4). Each 
+   update stage is driven for the stage time multiplied by the factor of the 
+   ambient temperature */
+#define PV_EINK_TEMP_FACTOR_DIVIDER         (uint16)(10)
+#define PV_EINK_TEMP_SEL0                   (uint16)(170)
+#define PV_EINK_TEMP_SEL1                   (uint16)(120)
+#define PV_EINK_TEMP_SEL2                   (uint16)(80)
+#define PV_EINK_TEMP_SEL3                   (uint16)(40)
+#define PV_EINK_TEMP_SEL4                   (uint16)(30)
+#define PV_EINK_TEMP_SEL5                   (uint16)(20)
+#define PV_EINK_TEMP_SEL6                   (uint16)(10)
+#define PV_EINK_TEMP_SEL7                   (uint16)(7)
 
 /* Definitions of temperature compensation stages */
 #define PV_EINK_TEMP_DEG_M10                (int8_t)(-10)
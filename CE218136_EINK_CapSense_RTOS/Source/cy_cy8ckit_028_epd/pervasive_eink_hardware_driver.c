@@ -36,6 +36,7 @@
 
 /* Header file includes */
 #include "pervasive_eink_hardware_driver.h"
+#include "cy_eink_raster.h"
 #include <string.h>
 
 /* Macro for the dummy byte used in the line data */
@@ -44,27 +45,132 @@
 /* Data used to initialize the scan bytes */
 #define PV_EINK_SCAN_BYTE_INIT (uint8_t)(0x00u)
 
-/* Line data structure of 2.7" display. Refer to driver document Section 5.1 
-   for details */
+/* Size of the changed row bitmap in bytes, one bit per scan line */
+#define PV_EINK_ROW_BITMAP_SIZE     CY_EINK_RASTER_ROW_BITMAP_SIZE
+
+/* Macros used to access the changed row bitmap */
+#define PV_EINK_ROW_ALL_CHANGED     (uint8_t)(0xFFu)
+#define PV_EINK_ROW_BYTE(row)       ((row) / CY_EINK_BYTE_SIZE)
+#define PV_EINK_ROW_MASK(row)       (uint8_t)(0x01u << ((row) % CY_EINK_BYTE_SIZE))
+#define PV_EINK_IS_ROW_CHANGED(row) (0u != (changedRows[PV_EINK_ROW_BYTE(row)] \
+                                            & PV_EINK_ROW_MASK(row)))
+
+/* Number of entries in the pixel encoding tables (one per image byte value) */
+#define PV_EINK_ENCODE_TABLE_SIZE   (256u)
+
+/* Number of full update stages, which is the number of encoding tables */
+#define PV_EINK_STAGE_COUNT         (4u)
+
+/* Number of line packets, and the packet used by a line */
+#if (PV_EINK_LINE_STREAMING != 0u)
+#define PV_EINK_PACKET_COUNT        PV_EINK_STREAMING_BUFFERS
+#define PV_EINK_PACKET_INDEX(y)     ((y) % PV_EINK_STREAMING_BUFFERS)
+#else
+#define PV_EINK_PACKET_COUNT        PV_EINK_VERTICAL_SIZE
+#define PV_EINK_PACKET_INDEX(y)     (y)
+#endif
+
+/* Two bit pixel codes used to build the encoding tables. These are the
+   unshifted forms of PV_EINK_BLACK0, PV_EINK_WHITE0 and PV_EINK_NOTHING0 */
+#define PV_EINK_CODE_BLACK          (0x03u)
+#define PV_EINK_CODE_WHITE          (0x02u)
+#define PV_EINK_CODE_NOTHING        (0x01u)
+#define PV_EINK_CODE_CHANGED        (0x03u)
+#define PV_EINK_CODE_UNCHANGED      (0x00u)
+
+/* Select the pixel code based on one bit of the image byte */
+#define PV_EINK_PIXEL_CODE(byte, bit, on, off)                                 \
+                            ((((byte) >> (bit)) & 0x01u) ? (on) : (off))
+
+/* Odd byte of an image byte: bits 6, 4, 2 and 0 (PV_EINK_ODD_MASK_A to D) are
+   placed in pixel positions 3, 2, 1 and 0 of the driver byte */
+#define PV_EINK_ODD_ENCODE(byte, on, off)                                      \
+            ((uint8_t)((PV_EINK_PIXEL_CODE(byte, 6u, on, off) << 6u) |         \
+                       (PV_EINK_PIXEL_CODE(byte, 4u, on, off) << 4u) |         \
+                       (PV_EINK_PIXEL_CODE(byte, 2u, on, off) << 2u) |         \
+                       (PV_EINK_PIXEL_CODE(byte, 0u, on, off))))
+
+/* Even byte of an image byte: bits 7, 5, 3 and 1 (PV_EINK_EVEN_MASK_A to D) 
+   are placed in pixel positions 0, 1, 2 and 3 of the driver byte */
+#define PV_EINK_EVEN_ENCODE(byte, on, off)                                     \
+            ((uint8_t)((PV_EINK_PIXEL_CODE(byte, 7u, on, off))       |         \
+                       (PV_EINK_PIXEL_CODE(byte, 5u, on, off) << 2u) |         \
+                       (PV_EINK_PIXEL_CODE(byte, 3u, on, off) << 4u) |         \
+                       (PV_EINK_PIXEL_CODE(byte, 1u, on, off) << 6u)))
+
+/* Encoders of each driving stage. Refer to Pv_EINK_FullStageHandler for the 
+   description of the stages */
+#define PV_EINK_STAGE1_ODD(byte)    PV_EINK_ODD_ENCODE(byte, PV_EINK_CODE_BLACK,\
+                                                       PV_EINK_CODE_WHITE)
+#define PV_EINK_STAGE1_EVEN(byte)   PV_EINK_EVEN_ENCODE(byte,PV_EINK_CODE_BLACK,\
+                                                       PV_EINK_CODE_WHITE)
+#define PV_EINK_STAGE2_ODD(byte)    PV_EINK_ODD_ENCODE(byte, PV_EINK_CODE_WHITE,\
+                                                       PV_EINK_CODE_NOTHING)
+#define PV_EINK_STAGE2_EVEN(byte)   PV_EINK_EVEN_ENCODE(byte,PV_EINK_CODE_WHITE,\
+                                                       PV_EINK_CODE_NOTHING)
+#define PV_EINK_STAGE3_ODD(byte)    PV_EINK_ODD_ENCODE(byte, PV_EINK_CODE_BLACK,\
+                                                       PV_EINK_CODE_NOTHING)
+#define PV_EINK_STAGE3_EVEN(byte)   PV_EINK_EVEN_ENCODE(byte,PV_EINK_CODE_BLACK,\
+                                                       PV_EINK_CODE_NOTHING)
+#define PV_EINK_STAGE4_ODD(byte)    PV_EINK_ODD_ENCODE(byte, PV_EINK_CODE_WHITE,\
+                                                       PV_EINK_CODE_BLACK)
+#define PV_EINK_STAGE4_EVEN(byte)   PV_EINK_EVEN_ENCODE(byte,PV_EINK_CODE_WHITE,\
+                                                       PV_EINK_CODE_BLACK)
+
+/* Masks of the changed pixels of a partial update, indexed by the XOR of the
+   previous and the new image bytes */
+#define PV_EINK_CHANGED_ODD(byte)   PV_EINK_ODD_ENCODE(byte,                    \
+                                                       PV_EINK_CODE_CHANGED,    \
+                                                       PV_EINK_CODE_UNCHANGED)
+#define PV_EINK_CHANGED_EVEN(byte)  PV_EINK_EVEN_ENCODE(byte,                   \
+                                                       PV_EINK_CODE_CHANGED,    \
+                                                       PV_EINK_CODE_UNCHANGED)
+
+/* Macros that expand an encoder over consecutive image byte values, used to
+   generate the encoding tables at compile time */
+#define PV_EINK_TABLE_4(encoder, n)     encoder((n)),        encoder((n) + 1u),\
+                                        encoder((n) + 2u),   encoder((n) + 3u)
+#define PV_EINK_TABLE_16(encoder, n)    PV_EINK_TABLE_4(encoder, (n)),          \
+                                        PV_EINK_TABLE_4(encoder, (n) + 4u),     \
+                                        PV_EINK_TABLE_4(encoder, (n) + 8u),     \
+                                        PV_EINK_TABLE_4(encoder, (n) + 12u)
+#define PV_EINK_TABLE_64(encoder, n)    PV_EINK_TABLE_16(encoder, (n)),         \
+                                        PV_EINK_TABLE_16(encoder, (n) + 16u),   \
+                                        PV_EINK_TABLE_16(encoder, (n) + 32u),   \
+                                        PV_EINK_TABLE_16(encoder, (n) + 48u)
+#define PV_EINK_TABLE_256(encoder)      PV_EINK_TABLE_64(encoder, 0u),          \
+                                        PV_EINK_TABLE_64(encoder, 64u),         \
+                                        PV_EINK_TABLE_64(encoder, 128u),        \
+                                        PV_EINK_TABLE_64(encoder, 192u)
+
+/* Line data structure of the selected panel. Refer to driver document 
+   Section 5.1 for details */
 struct eink_lineData
 {
+#if (PV_EINK_BORDER_FIRST != 0u)
     /*  Dummy byte (0x00) */
     uint8_t dummyData;
+#endif
 
-    /*  2.7" even byte array */
+    /*  Even byte array */
     uint8_t even[PV_EINK_HORIZONTAL_SIZE];
 
-    /*  2.7" scan byte array */
+    /*  Scan byte array */
     uint8_t scan[PV_EINK_SCAN_LINE_SIZE];
 
-    /*  2.7" odd byte array */
+    /*  Odd byte array */
     uint8_t odd[PV_EINK_HORIZONTAL_SIZE];
+
+#if (PV_EINK_BORDER_FIRST == 0u)
+    /*  Dummy byte (0x00) */
+    uint8_t dummyData;
+#endif
 };
 
 /* Packet structure of a line data */
 typedef union
 {
-    /* Line data structure of 2.7" E-INK display */
+    /* Line data structure of the E-INK display */
     struct eink_lineData    lineDataBySize;
 
     /* Line buffer equal to the data line size */
@@ -73,9 +179,20 @@ typedef union
     /* The maximum line buffer data size as length */
 }   driver_data_packet_t;
 
-/* Variable that stores the packets for one full drive frame. This variable
-   is used for full and partial updates */
-driver_data_packet_t        bulkDriverPacket[PV_EINK_VERTICAL_SIZE];
+/* Timing of the frames of an update stage, in milliseconds */
+typedef struct
+{
+    uint32_t    stageTime;      /* Time the stage is driven for */
+    uint32_t    startTime;      /* Time stamp of the start of the stage */
+    uint32_t    frameStart;     /* Time stamp of the start of the frame */
+    uint32_t    frameTime;      /* Duration of the previous frame */
+    uint16      frames;         /* Number of frames started */
+}   pv_eink_stage_timer_t;
+
+/* Variable that stores the packets for one full drive frame, or the ring of
+   line packets in line streaming mode. This variable is used for full and 
+   partial updates */
+driver_data_packet_t        bulkDriverPacket[PV_EINK_PACKET_COUNT];
 
 /* Variable that stores a single line data. This variable is used to prepare 
    dummy frames */
@@ -89,9 +206,66 @@ uint8_t const               scanTable[PV_EINK_SCAN_TABLE_SIZE] =
 uint8_t const               channelSelect[PV_EINK_CHANNEL_SEL_SIZE] =
                             PV_EINK_CHANNEL_SEL_DATA;
 
-/* Variables that store the driver timing information */
-uint16 static             fullUpdateCycles;
-uint16 static             partialUpdateCycles;
+/* Descriptor of the selected panel. The update stages use the geometry 
+   macros it is built from, which are specialised at compile time */
+pv_eink_panel_t const       panelDescriptor =
+{
+    .name            = PV_EINK_PANEL_NAME,
+    .width           = PV_EINK_PANEL_WIDTH,
+    .height          = PV_EINK_PANEL_HEIGHT,
+    .lineSize        = PV_EINK_HORIZONTAL_SIZE,
+    .imageSize       = PV_EINK_IMAGE_SIZE,
+    .scanLineSize    = PV_EINK_SCAN_LINE_SIZE,
+    .dataLineSize    = PV_EINK_DATA_LINE_SIZE,
+    .borderFirst     = (PV_EINK_BORDER_FIRST != 0u),
+    .voltageLevel    = PV_EINK_VOLTAGE_LEVEL,
+    .channelSelect   = channelSelect,
+    .scanTable       = scanTable,
+    .stageTime       = PV_EINK_STAGE_TIME,
+    .frameTimeOffset = PV_EINK_FRAME_TIME_OFFSET
+};
+
+/* Odd and even byte encoding tables of the four full update stages */
+uint8_t const               stageOddTable[PV_EINK_STAGE_COUNT]
+                                         [PV_EINK_ENCODE_TABLE_SIZE] =
+{
+    { PV_EINK_TABLE_256(PV_EINK_STAGE1_ODD) },
+    { PV_EINK_TABLE_256(PV_EINK_STAGE2_ODD) },
+    { PV_EINK_TABLE_256(PV_EINK_STAGE3_ODD) },
+    { PV_EINK_TABLE_256(PV_EINK_STAGE4_ODD) }
+};
+uint8_t const               stageEvenTable[PV_EINK_STAGE_COUNT]
+                                          [PV_EINK_ENCODE_TABLE_SIZE] =
+{
+    { PV_EINK_TABLE_256(PV_EINK_STAGE1_EVEN) },
+    { PV_EINK_TABLE_256(PV_EINK_STAGE2_EVEN) },
+    { PV_EINK_TABLE_256(PV_EINK_STAGE3_EVEN) },
+    { PV_EINK_TABLE_256(PV_EINK_STAGE4_EVEN) }
+};
+
+/* Changed pixel masks of the partial update. A table indexed by both the
+   previous and the new byte would need 64 KB per byte type, so the partial
+   update combines these masks with the stage 4 tables instead */
+uint8_t const               changedOddTable[PV_EINK_ENCODE_TABLE_SIZE] =
+                            { PV_EINK_TABLE_256(PV_EINK_CHANGED_ODD) };
+uint8_t const               changedEvenTable[PV_EINK_ENCODE_TABLE_SIZE] =
+                            { PV_EINK_TABLE_256(PV_EINK_CHANGED_EVEN) };
+
+/* Bitmap of the scan lines sent by the last display update (bit set = line
+   sent) and the number of lines that have been sent */
+uint8_t static              changedRows[PV_EINK_ROW_BITMAP_SIZE];
+uint16 static               changedRowCount;
+
+/* Variables that store the driver timing information: the stage time factor
+   of the ambient temperature, the refresh policy, and the resulting stage 
+   times of the full and partial updates in milliseconds */
+uint16 static             temperatureFactor = PV_EINK_TEMP_SEL5;
+pv_eink_policy_t static   refreshPolicy = PV_EINK_POLICY_BALANCED;
+uint32_t static           fullStageTime;
+uint32_t static           partialStageTime;
+
+/* Driver activity counters: bytes sent over SPI and data lines latched */
+pv_eink_statistics_t static driverStatistics;
 
 /* Pointers for the data structures used by the driver */
 uint8_t static*             dataLineEven;
@@ -99,11 +273,13 @@ uint8_t static*             dataLineOdd;
 uint8_t static*             dataLineScan;
 
 /*******************************************************************************
-* Function Name: void Pv_EINK_SendData(uint8_t regAddr, uint8_t* data, 
-*                                   uint16 dataLength)
+* Function Name: void Pv_EINK_StartData(uint8_t regAddr, uint8_t* data, 
+*                                       uint16 dataLength)
 ********************************************************************************
 *
-* Summary: Sends an array of data to the E-INK driver.
+* Summary: Starts sending an array of data to the E-INK driver. Arrays longer
+* than one byte are sent in the background; Pv_EINK_EndData must be called 
+* before the next communication with the driver.
 *
 * Parameters:
 *  uint8_t regAddr    : Display driver register address
@@ -117,8 +293,11 @@ uint8_t static*             dataLineScan;
 * Side Effects:
 *  None
 *******************************************************************************/
-void Pv_EINK_SendData(uint8_t regAddr, uint8_t* data, uint16 dataLength)
+void static Pv_EINK_StartData(uint8_t regAddr, uint8_t* data, uint16 dataLength)
 {
+    /* Count the headers, the register address and the data */
+    driverStatistics.spiBytes += PV_EINK_COMMAND_OVERHEAD + dataLength;
+    
     /* Pull the chip select line LOW to begin communication */
     CY_EINK_CsLow;
     /* Send the header of register address index */
@@ -133,15 +312,68 @@ void Pv_EINK_SendData(uint8_t regAddr, uint8_t* data, uint16 dataLength)
     /* Send the header of data write index */
     Cy_EINK_WriteSPI(PV_EINK_REG_DATA_WRITE);
     
-    /* Send the array of data */
-    while (dataLength--)
+    /* Send a single byte directly; longer arrays such as the line data are
+       streamed back-to-back by the interrupt driven bulk transfer */
+    if (dataLength == CY_EINK_SINGLE_BYTE)
+    {
+        Cy_EINK_WriteSPI(*data);
+    }
+    else
     {
-        Cy_EINK_WriteSPI(*data++);
+        Cy_EINK_StartWriteArraySPI(data, dataLength);
     }
+}
+
+/*******************************************************************************
+* Function Name: void Pv_EINK_EndData(void)
+********************************************************************************
+*
+* Summary: Waits until the data started by Pv_EINK_StartData has been sent and 
+* ends the communication.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void static Pv_EINK_EndData(void)
+{
+    /* Wait for the bulk transfer, if any */
+    Cy_EINK_WaitWriteArraySPI();
     /* Push the chip select line HIGH to end communication */
     CY_EINK_CsHigh;
 }
 
+/*******************************************************************************
+* Function Name: void Pv_EINK_SendData(uint8_t regAddr, uint8_t* data, 
+*                                   uint16 dataLength)
+********************************************************************************
+*
+* Summary: Sends an array of data to the E-INK driver.
+*
+* Parameters:
+*  uint8_t regAddr    : Display driver register address
+*  uint8_t* data      : Pointer to the data array that will be sent to the
+*                       driver
+*  uint16 dataLength: Length of the data array
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void Pv_EINK_SendData(uint8_t regAddr, uint8_t* data, uint16 dataLength)
+{
+    /* Send the data and wait until it has been sent */
+    Pv_EINK_StartData(regAddr, data, dataLength);
+    Pv_EINK_EndData();
+}
+
 /*******************************************************************************
 * Function Name: void Pv_EINK_SendByte(uint8_t regAddr, uint8_t data)
 ********************************************************************************
@@ -164,6 +396,29 @@ void Pv_EINK_SendByte(uint8_t regAddr, uint8_t data)
     Pv_EINK_SendData(regAddr, &data, CY_EINK_SINGLE_BYTE);
 }
 
+/*******************************************************************************
+* Function Name: void static Pv_EINK_LatchLine(void)
+********************************************************************************
+*
+* Summary: Turns on Output Enable to latch the data line that has been sent to
+* the E-INK driver.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void static Pv_EINK_LatchLine(void)
+{
+    Pv_EINK_SendByte(PV_EINK_ENABLE_OE_COMMAND_INDEX,
+                     PV_EINK_ENABLE_OE_COMMAND_DATA);
+    driverStatistics.linesLatched++;
+}
+
 /*******************************************************************************
 * Function Name: uint8_t Pv_EINK_ReadByte(uint8_t regAddr, uint8_t data)
 ********************************************************************************
@@ -186,6 +441,9 @@ uint8_t Pv_EINK_ReadByte(uint8_t regAddr, uint8_t data)
     /* Variable that stores received data */
     uint8_t dataRead;
     
+    /* Count the headers, the register address and the data command */
+    driverStatistics.spiBytes += PV_EINK_COMMAND_OVERHEAD + CY_EINK_SINGLE_BYTE;
+    
     /* Pull the chip select line LOW to begin communication */
     CY_EINK_CsLow;
     /* Send the header of register address index */
@@ -321,7 +579,7 @@ pv_eink_status_t Pv_EINK_InitDriver(void)
 
 		/* Channel Select */
 		Pv_EINK_SendData(PV_EINK_CHANNEL_SEL_COMMAND_INDEX,
-						(uint8_t*) &channelSelect,
+						(uint8_t*) panelDescriptor.channelSelect,
 						 PV_EINK_CHANNEL_SEL_SIZE);
 
 		/* High Power Mode Oscillator Setting */
@@ -389,11 +647,123 @@ pv_eink_status_t Pv_EINK_InitDriver(void)
     return(powerStatus);
 }
 
+/*******************************************************************************
+* Function Name: void static Pv_EINK_ScaleStageTime(void)
+********************************************************************************
+*
+* Summary: Calculates the stage times of the full and partial updates from the
+* stage time of the panel, the factor of the ambient temperature and the 
+* refresh policy
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void static Pv_EINK_ScaleStageTime(void)
+{
+    /* Variables used to store the scaling factors of the policy */
+    uint16    fullScaling;
+    uint16    partialScaling;
+    
+    /* Stage time of the ambient temperature, in steps of 1/(the divider of
+       the temperature factor times the divider of the policy scaling) */
+    uint32_t  stageTime = (uint32_t)PV_EINK_STAGE_TIME * temperatureFactor;
+    
+    if (refreshPolicy == PV_EINK_POLICY_FAST)
+    {
+        fullScaling    = PV_EINK_SCALING_FAST_FULL;
+        partialScaling = PV_EINK_SCALING_FAST_PARTIAL;
+    }
+    else if (refreshPolicy == PV_EINK_POLICY_HIGH_CONTRAST)
+    {
+        fullScaling    = PV_EINK_SCALING_CONTRAST_FULL;
+        partialScaling = PV_EINK_SCALING_CONTRAST_PARTIAL;
+    }
+    else
+    {
+        fullScaling    = PV_EINK_SCALING_BALANCED_FULL;
+        partialScaling = PV_EINK_SCALING_BALANCED_PARTIAL;
+    }
+    
+    /* Scale the stage times : this is a speed-contrast trade-off */
+    fullStageTime    = (stageTime * fullScaling) / 
+                       (PV_EINK_TEMP_FACTOR_DIVIDER * PV_EINK_SCALING_DIVIDER);
+    partialStageTime = (stageTime * partialScaling) / 
+                       (PV_EINK_TEMP_FACTOR_DIVIDER * PV_EINK_SCALING_DIVIDER);
+}
+
+/*******************************************************************************
+* Function Name: void static Pv_EINK_StartStage(pv_eink_stage_timer_t* timer,
+*                                               uint32_t stageTime)
+********************************************************************************
+*
+* Summary: Starts timing an update stage. The time is read from the registered
+* time function; without one, each frame is assumed to take 
+* PV_EINK_FRAME_TIME_ESTIMATE.
+*
+* Parameters:
+*  pv_eink_stage_timer_t* timer : Timing of the stage
+*  uint32_t stageTime           : Time the stage is driven for, in milliseconds
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void static Pv_EINK_StartStage(pv_eink_stage_timer_t* timer, uint32_t stageTime)
+{
+    timer->stageTime  = stageTime;
+    timer->frames     = 0u;
+    timer->frameTime  = 0u;
+    timer->startTime  = (Cy_EINK_GetTime != NULL) ? Cy_EINK_GetTime() : 0u;
+    timer->frameStart = timer->startTime;
+}
+
+/*******************************************************************************
+* Function Name: bool static Pv_EINK_StartFrame(pv_eink_stage_timer_t* timer)
+********************************************************************************
+*
+* Summary: Starts a frame of an update stage, and reports if it is the last 
+* frame. The frames are repeated until the stage time has elapsed: a frame is
+* the last one if the stage time elapses before it ends, assuming that it takes
+* as long as the previous frame.
+*
+* Parameters:
+*  pv_eink_stage_timer_t* timer : Timing of the stage
+*
+* Return:
+*  bool : "true" if this is the last frame of the stage
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+bool static Pv_EINK_StartFrame(pv_eink_stage_timer_t* timer)
+{
+    /* Time stamp of the start of the frame */
+    uint32_t    now = (Cy_EINK_GetTime != NULL) ? Cy_EINK_GetTime() : 
+                      (timer->frames * (uint32_t)PV_EINK_FRAME_TIME_ESTIMATE);
+    
+    if (timer->frames != 0u)
+    {
+        timer->frameTime = now - timer->frameStart;
+    }
+    timer->frameStart = now;
+    timer->frames++;
+    
+    return (((now - timer->startTime) + timer->frameTime) >= timer->stageTime);
+}
+
 /*******************************************************************************
 * Function Name: void Pv_EINK_SetTempFactor(int8_t temperature)
 ********************************************************************************
 *
-* Summary: Set the E-INK update cycles per the ambient temperature. For detailed
+* Summary: Set the E-INK stage time per the ambient temperature. For detailed
 * flow and description, please refer to the driver G2 document Section 5.4.
 *
 * Parameters:
@@ -403,59 +773,119 @@ pv_eink_status_t Pv_EINK_InitDriver(void)
 *  None
 *
 * Side Effects:
-*  None
+*  Can be called while the display is being updated; the new stage time is 
+*  used from the next update stage
 *******************************************************************************/
 void Pv_EINK_SetTempFactor(int8_t temperature)
 {
-    /* Variable used to store the update cycles */
-    uint16    updateCycles;
+    /* Variable used to store the stage time factor */
+    uint16    factor;
     
-    /* Set the update cycles per the temperature table */
+    /* Set the stage time factor per the temperature table */
     if (PV_EINK_TEMP_DEG_M10 >= temperature)
     {
-        updateCycles = PV_EINK_TEMP_SEL0;
+        factor = PV_EINK_TEMP_SEL0;
     }
     else if (PV_EINK_TEMP_DEG_M5 >= temperature)
     {
-        updateCycles = PV_EINK_TEMP_SEL1;
+        factor = PV_EINK_TEMP_SEL1;
     }
     else if (PV_EINK_TEMP_DEG_5 >= temperature)
     {
-        updateCycles = PV_EINK_TEMP_SEL2;
+        factor = PV_EINK_TEMP_SEL2;
     }
     else if (PV_EINK_TEMP_DEG_10 >= temperature)
     {
-        updateCycles = PV_EINK_TEMP_SEL3;
+        factor = PV_EINK_TEMP_SEL3;
     }
     else if (PV_EINK_TEMP_DEG_15 >= temperature)
     {
-        updateCycles = PV_EINK_TEMP_SEL4;
+        factor = PV_EINK_TEMP_SEL4;
     }
     else if (PV_EINK_TEMP_DEG_20 >= temperature)
     {
-        updateCycles = PV_EINK_TEMP_SEL5;
+        factor = PV_EINK_TEMP_SEL5;
     }
     else if (PV_EINK_TEMP_DEG_40 >= temperature)
     {
-        updateCycles = PV_EINK_TEMP_SEL6;
+        factor = PV_EINK_TEMP_SEL6;
     }
     else
     {
-        updateCycles = PV_EINK_TEMP_SEL7;
+        factor = PV_EINK_TEMP_SEL7;
     }
     
-    /* Scale the update cycles : this is a speed-contrast trade-off */
-    fullUpdateCycles = updateCycles * PV_EINK_SCALING_FULL;
-    partialUpdateCycles = updateCycles * PV_EINK_SCALING_PARTIAL;
+    /* Scale the stage time per the refresh policy */
+    temperatureFactor = factor;
+    Pv_EINK_ScaleStageTime();
 }
 
 /*******************************************************************************
-* Function Name: void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr,
-*                                              pv_eink_stage_t stageNumber)
+* Function Name: void Pv_EINK_SetPolicy(pv_eink_policy_t policy)
 ********************************************************************************
 *
-* Summary: The full update driving stages for getting Odd and Even bytes, and
-* then writing the data from memory array to E-INK driver.
+* Summary: Set the speed-contrast trade-off of the E-INK stage time. The
+* fast policy halves the stage time of the ambient temperature, and the high
+* contrast policy doubles it for full updates and adds half for partial 
+* updates.
+*
+* Parameters:
+* pv_eink_policy_t policy: Fast, balanced or high contrast refresh policy
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  Can be called while the display is being updated; the new stage time is 
+*  used from the next update stage
+*******************************************************************************/
+void Pv_EINK_SetPolicy(pv_eink_policy_t policy)
+{
+    refreshPolicy = policy;
+    Pv_EINK_ScaleStageTime();
+}
+
+/*******************************************************************************
+* Function Name: pv_eink_frame_data_t static * Pv_EINK_GetFrameLine(void* image,
+*                                                                  uint16 y)
+********************************************************************************
+*
+* Summary: Line function of a frame stored in flash or RAM
+*
+* Parameters:
+* void* image                       : The pointer to the memory that contains a
+*                                     frame, or the white/black frame address
+* uint16 y                          : Line number
+*
+* Return:
+* pv_eink_frame_data_t*             : The pointer to the line data, or the 
+*                                     white/black frame address
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+pv_eink_frame_data_t static * Pv_EINK_GetFrameLine(void* image, uint16 y)
+{
+    pv_eink_frame_data_t* imagePtr = (pv_eink_frame_data_t*) image;
+    
+    /* The white and black frames have the same address for all lines */
+    if ((imagePtr != PV_EINK_WHITE_FRAME_ADDRESS) && 
+        (imagePtr != PV_EINK_BLACK_FRAME_ADDRESS))
+    {
+        /* Move to the start of the line */
+        imagePtr += (y * PV_EINK_HORIZONTAL_SIZE);
+    }
+    
+    return (imagePtr);
+}
+
+/*******************************************************************************
+* Function Name: void static Pv_EINK_EncodeFullLine(uint16 y, 
+*                   pv_eink_line_source_t const* image, 
+*                   pv_eink_stage_t stageNumber)
+********************************************************************************
+*
+* Summary: Prepares the driver packet of one line of a full update stage.
 *
 * One dot/pixel is comprised of 2 bits that can be White(10), Black(11) or 
 * Nothing * (01 or 00). The image data bytes must be divided into Odd and Even 
@@ -465,39 +895,47 @@ void Pv_EINK_SetTempFactor(int8_t temperature)
 * G2 document Section 5.
 *
 * Parameters:
-* pv_eink_frame_data_t* imagePtr    : The pointer to the memory that contains a
-*                                     frame
+* uint16 y                          : Line number to be prepared
+* pv_eink_line_source_t const* image: The image that provides the line data
 * pv_eink_stage_t stageNumber       : The assigned stage number
 *
 * Return:
 *  None
 *
 * Side Effects:
-*  This is a blocking function. CPU will be busy during the entire operation,
-* which can be 1 to 2 seconds.
+*  None
 *******************************************************************************/
-void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr, 
-                              pv_eink_stage_t stageNumber)
+void static Pv_EINK_EncodeFullLine(uint16 y, pv_eink_line_source_t const* image,
+                                   pv_eink_stage_t stageNumber)
 {
+    /* Pointer to the data of the line */
+    pv_eink_frame_data_t* imagePtr = image->getLine(image->image, y);
+    
     /* Counter variable for the horizontal pixel loop */
     uint16    x;
-    /* Counter variable for the vertical pixel loop */
-    uint16    y;
     /* Counter variable for the horizontal byte loop */
     uint16    k;
-    
-    /* Counter variable for write cycles */
-    uint16    currentWriteCycle;
       
     /* Variable for storing the line number under scan */
     int16       scanlineNumber = 0;
     
     /* Temporary storage for image data byte */
-    uint8_t     tempByte = *imagePtr;
+    uint8_t     tempByte = PV_EINK_WHITE_PIXEL_BYTE;
     
     /* Flag to check if the current pointer is a macro of white/black frame */
     bool        blackOrWhiteFrame;
     
+    /* Encoding tables of the selected stage:
+       Stage 1: the inverted Even and Odd bytes of the previous image data
+       Stage 2: the Even and Odd bytes of an all-white frame
+       Stage 3: the inverted Even and Odd bytes of the new image data
+       Stage 4: the Even and Odd bytes of the new image data */
+    uint8_t const* oddTable  = stageOddTable[stageNumber];
+    uint8_t const* evenTable = stageEvenTable[stageNumber];
+    
+    /* Packet of the line */
+    driver_data_packet_t* packet = &bulkDriverPacket[PV_EINK_PACKET_INDEX(y)];
+    
     /* If the current pointer is a macro of the white frame */
     if (imagePtr == PV_EINK_WHITE_FRAME_ADDRESS)
     {
@@ -515,152 +953,463 @@ void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr,
         /* set the tempByte to black pixel byte */
         tempByte = PV_EINK_BLACK_PIXEL_BYTE;
     }
-    /* If the current pointer is of an image stored in flash */
+    /* If the current pointer is of line data stored in flash or RAM */
     else
     {
         /* Clear the white/black frame flag */
         blackOrWhiteFrame = false;
     }
 
-    /* Vertical pixel loop */
-    for (y = 0; y < PV_EINK_VERTICAL_SIZE; y++)
+    /* Clear the line buffer with all zeros */
+    memset(&packet->lineBuffer, 0, sizeof(packet->lineBuffer)) ;
+
+    /* Initialize the even data, odd data and scan data pointers */
+    dataLineEven = &packet->lineDataBySize.even[0];
+    dataLineOdd  = &packet->lineDataBySize.odd[0];
+    dataLineScan = &packet->lineDataBySize.scan[0];
+    
+    /* Horizontal bytes initialization */
+    k = PV_EINK_HORIZONTAL_SIZE;
+    k--;
+    
+    /* Horizontal pixel loop */
+    for (x = 0; x < PV_EINK_HORIZONTAL_SIZE; x++)
     {
-        /* Clear the line buffer with all zeros */
-        memset(&bulkDriverPacket[y].lineBuffer, 0, 
-               sizeof(bulkDriverPacket[y].lineBuffer)) ;
-
-        /* Initialize the even data, odd data and scan data pointers */
-        dataLineEven = &bulkDriverPacket[y].lineDataBySize.even[0];
-        dataLineOdd  = &bulkDriverPacket[y].lineDataBySize.odd[0];
-        dataLineScan = &bulkDriverPacket[y].lineDataBySize.scan[0];
-        
-        /* Horizontal bytes initialization */
-        k = PV_EINK_HORIZONTAL_SIZE;
-        k--;
+        /* If the current pointer is of an image stored in flash */
+        if(!blackOrWhiteFrame)
+        {
+            /* Fetch successive data bytes */
+            tempByte = *imagePtr++;
+        }
+        /* Look up the Even and Odd bytes of the selected stage */
+        dataLineOdd[x]   = oddTable[tempByte];
+        dataLineEven[k--] = evenTable[tempByte];
+    }
+    /* Move onto the next line */
+    scanlineNumber = PV_EINK_VERTICAL_SIZE - y;
+    scanlineNumber--;
+    
+    /* Shift Scan byte according to the data line */
+    dataLineScan[(scanlineNumber >> PV_EINK_PIXEL_SIZE)] = scanTable
+                        [(scanlineNumber % PV_EINK_SCAN_TABLE_SIZE)];
+}
+
+#if (PV_EINK_LINE_STREAMING == 0u)
+/*******************************************************************************
+* Function Name: void static Pv_EINK_DriveFullStage(
+*                                       pv_eink_line_source_t const* nextImage,
+*                                       pv_eink_stage_t nextStageNumber,
+*                                       bool encodeNextStage)
+********************************************************************************
+*
+* Summary: Writes the prepared line packets of a full update stage to the E-INK
+* driver, repeating the frame until the stage time calculated based on 
+* temperature has elapsed.
+*
+* If requested, the packets of the next stage are prepared during the last 
+* frame: each line is encoded while the following line is being sent over SPI,
+* so that the preparation of the next stage overlaps the current transmission.
+*
+* Parameters:
+* pv_eink_line_source_t const* nextImage : Image used by the next stage
+* pv_eink_stage_t nextStageNumber         : The next stage number
+* bool encodeNextStage                    : "true" to prepare the next stage
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  This is a blocking function.
+*******************************************************************************/
+void static Pv_EINK_DriveFullStage(pv_eink_line_source_t const* nextImage, 
+                                   pv_eink_stage_t nextStageNumber,
+                                   bool encodeNextStage)
+{
+    /* Counter variable for the vertical pixel loop */
+    uint16    y;
+    
+    /* Timing of this stage. The temperature can be updated while the stage
+       is being written */
+    pv_eink_stage_timer_t timer;
+    bool      lastFrame;
+    
+    /* Number of lines of the next stage that have been prepared */
+    uint16    encodedLines = 0u;
+    
+    /* Perform update operation until the stage time calculated based on 
+       temperature has elapsed */
+    Pv_EINK_StartStage(&timer, fullStageTime);
+    do
+    {
+        lastFrame = Pv_EINK_StartFrame(&timer);
         
-        /* Horizontal pixel loop */
-        for (x = 0; x < PV_EINK_HORIZONTAL_SIZE; x++)
+        /* Perform a line by line update */
+        for (y = 0; y < PV_EINK_VERTICAL_SIZE; y++)
         {
-            /* If the current pointer is of an image stored in flash */
-            if(!blackOrWhiteFrame)
-            {
-                /* Fetch successive data bytes */
-                tempByte = *imagePtr++;
-            }
-            /* Perform one of the four stage operations */
-            switch (stageNumber)
+            /* Start sending the prepared data to the E-INK display */
+            Pv_EINK_StartData(PV_EINK_PIXEL_DATA_COMMAND_INDEX,
+                              (uint8_t*) &bulkDriverPacket[y].lineBuffer,
+                              PV_EINK_DATA_LINE_SIZE);
+            
+            /* The previous line is no longer used by this stage; prepare it
+               for the next stage while the current line is being sent */
+            if (encodeNextStage && (y > 0u) && lastFrame)
             {
-            /* Stage 1: Calculate the inverted Even and Odd bytes of 
-               the previous image data */
-            case PV_EINK_STAGE1:
-                dataLineOdd[x]       = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
-                                        PV_EINK_BLACK3 : PV_EINK_WHITE3);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_B)  ? 
-                                        PV_EINK_BLACK2 : PV_EINK_WHITE2);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_C)  ? 
-                                        PV_EINK_BLACK1 : PV_EINK_WHITE1);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_D)  ? 
-                                        PV_EINK_BLACK0 : PV_EINK_WHITE0);
-                dataLineEven[k]      = ((tempByte & PV_EINK_EVEN_MASK_A) ? 
-                                        PV_EINK_BLACK0 : PV_EINK_WHITE0);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
-                                        PV_EINK_BLACK1 : PV_EINK_WHITE1);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_C) ? 
-                                        PV_EINK_BLACK2 : PV_EINK_WHITE2);
-                dataLineEven[k--]   |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
-                                        PV_EINK_BLACK3 : PV_EINK_WHITE3);
-                break;
-            /* Stage 2: Calculate the Even and Odd bytes of an all-white
-               frame */
-            case PV_EINK_STAGE2:
-                dataLineOdd[x]       = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
-                                        PV_EINK_WHITE3 : PV_EINK_NOTHING3);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_B)  ? 
-                                        PV_EINK_WHITE2 : PV_EINK_NOTHING2);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_C)  ? 
-                                        PV_EINK_WHITE1 : PV_EINK_NOTHING1);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_D)  ? 
-                                        PV_EINK_WHITE0 : PV_EINK_NOTHING0);
-                dataLineEven[k]      = ((tempByte & PV_EINK_EVEN_MASK_A) ?
-                                        PV_EINK_WHITE0 : PV_EINK_NOTHING0);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
-                                        PV_EINK_WHITE1 : PV_EINK_NOTHING1);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_C) ? 
-                                        PV_EINK_WHITE2 : PV_EINK_NOTHING2);
-                dataLineEven[k--]   |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
-                                        PV_EINK_WHITE3 : PV_EINK_NOTHING3);
-                break;
-            /* Stage 3: Calculate the inverted Even and Odd bytes of the
-               new image data */
-            case PV_EINK_STAGE3:
-                dataLineOdd[x]       = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
-                                        PV_EINK_BLACK3 : PV_EINK_NOTHING3);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_B)  ? 
-                                        PV_EINK_BLACK2 : PV_EINK_NOTHING2);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_C)  ?
-                                        PV_EINK_BLACK1 : PV_EINK_NOTHING1);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_D)  ?
-                                        PV_EINK_BLACK0 : PV_EINK_NOTHING0);
-                dataLineEven[k]      = ((tempByte & PV_EINK_EVEN_MASK_A) ?
-                                        PV_EINK_BLACK0 : PV_EINK_NOTHING0);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
-                                        PV_EINK_BLACK1 : PV_EINK_NOTHING1);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_C) ? 
-                                        PV_EINK_BLACK2 : PV_EINK_NOTHING2);
-                dataLineEven[k--]   |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
-                                        PV_EINK_BLACK3 : PV_EINK_NOTHING3);
-                break;
-            /* Stage 4: Calculate the Even and Odd bytes of new image 
-               data */
-            case PV_EINK_STAGE4:
-                dataLineOdd[x]       = ((tempByte & PV_EINK_ODD_MASK_A)  ? 
-                                        PV_EINK_WHITE3 : PV_EINK_BLACK3);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_B)  ?
-                                        PV_EINK_WHITE2 : PV_EINK_BLACK2);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_C)  ? 
-                                        PV_EINK_WHITE1 : PV_EINK_BLACK1);
-                dataLineOdd[x]      |= ((tempByte & PV_EINK_ODD_MASK_D)  ? 
-                                        PV_EINK_WHITE0 : PV_EINK_BLACK0);
-                dataLineEven[k]     = ((tempByte & PV_EINK_EVEN_MASK_A)  ? 
-                                        PV_EINK_WHITE0 : PV_EINK_BLACK0);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_B) ? 
-                                        PV_EINK_WHITE1 : PV_EINK_BLACK1);
-                dataLineEven[k]     |= ((tempByte & PV_EINK_EVEN_MASK_C) ?
-                                        PV_EINK_WHITE2 : PV_EINK_BLACK2);
-                dataLineEven[k--]   |= ((tempByte & PV_EINK_EVEN_MASK_D) ? 
-                                        PV_EINK_WHITE3 : PV_EINK_BLACK3);
-                break;
+                Pv_EINK_EncodeFullLine(y - 1u, nextImage, nextStageNumber);
+                encodedLines = y;
             }
-        }
-        /* Move onto the next line */
-        scanlineNumber = PV_EINK_VERTICAL_SIZE - y;
-        scanlineNumber--;
-        
-        /* Shift Scan byte according to the data line */
-        dataLineScan[(scanlineNumber >> PV_EINK_PIXEL_SIZE)] = scanTable
-                            [(scanlineNumber % PV_EINK_SCAN_TABLE_SIZE)];
             
+            /* Wait until the line has been sent */
+            Pv_EINK_EndData();
+                          
+            /* Turn on Output Enable to latch the frame */
+            Pv_EINK_LatchLine();
+        }
     }
-            
-    /* Perform update operation until the total number of write cycles equals 
-       the value calculated based on temperature */
-    for (currentWriteCycle = 0; currentWriteCycle < fullUpdateCycles;
-         currentWriteCycle++)
+    while (!lastFrame);
+    
+    /* Prepare the remaining lines of the next stage */
+    if (encodeNextStage)
     {
+        for (y = encodedLines; y < PV_EINK_VERTICAL_SIZE; y++)
+        {
+            Pv_EINK_EncodeFullLine(y, nextImage, nextStageNumber);
+        }
+    }
+}
+
+#else
+/*******************************************************************************
+* Function Name: void static Pv_EINK_StreamFullStage(
+*                                       pv_eink_line_source_t const* image,
+*                                       pv_eink_stage_t stageNumber)
+********************************************************************************
+*
+* Summary: Writes a full update stage to the E-INK driver until the stage time
+* calculated based on temperature has elapsed, in line streaming mode. Each 
+* line is encoded while the previous line is being sent over SPI, so that only
+* PV_EINK_STREAMING_BUFFERS line packets are required.
+*
+* Parameters:
+* pv_eink_line_source_t const* image : Image used by the stage
+* pv_eink_stage_t stageNumber        : The assigned stage number
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  This is a blocking function.
+*******************************************************************************/
+void static Pv_EINK_StreamFullStage(pv_eink_line_source_t const* image, 
+                                    pv_eink_stage_t stageNumber)
+{
+    /* Counter variable for the vertical pixel loop */
+    uint16    y;
+    
+    /* Timing of this stage. The temperature can be updated while the stage
+       is being written */
+    pv_eink_stage_timer_t timer;
+    bool      lastFrame;
+    
+    /* Perform update operation until the stage time calculated based on 
+       temperature has elapsed */
+    Pv_EINK_StartStage(&timer, fullStageTime);
+    do
+    {
+        lastFrame = Pv_EINK_StartFrame(&timer);
+        
+        /* Prepare the first line */
+        Pv_EINK_EncodeFullLine(0u, image, stageNumber);
+        
         /* Perform a line by line update */
         for (y = 0; y < PV_EINK_VERTICAL_SIZE; y++)
         {
-            /* Send the prepared data to the E-INK display */
-            Pv_EINK_SendData(PV_EINK_PIXEL_DATA_COMMAND_INDEX,
-                          (uint8_t*) &bulkDriverPacket[y].lineBuffer,
-                          PV_EINK_DATA_LINE_SIZE);
+            /* Start sending the prepared line to the E-INK display */
+            Pv_EINK_StartData(PV_EINK_PIXEL_DATA_COMMAND_INDEX,
+                (uint8_t*) &bulkDriverPacket[PV_EINK_PACKET_INDEX(y)].lineBuffer,
+                PV_EINK_DATA_LINE_SIZE);
+            
+            /* Prepare the next line while the current line is being sent */
+            if ((y + 1u) < PV_EINK_VERTICAL_SIZE)
+            {
+                Pv_EINK_EncodeFullLine(y + 1u, image, stageNumber);
+            }
+            
+            /* Wait until the line has been sent */
+            Pv_EINK_EndData();
                           
             /* Turn on Output Enable to latch the frame */
-            Pv_EINK_SendByte(PV_EINK_ENABLE_OE_COMMAND_INDEX,
-                          PV_EINK_ENABLE_OE_COMMAND_DATA);
+            Pv_EINK_LatchLine();
+        }
+    }
+    while (!lastFrame);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr,
+*                                              pv_eink_stage_t stageNumber)
+********************************************************************************
+*
+* Summary: The full update driving stages for getting Odd and Even bytes, and
+* then writing the data from memory array to E-INK driver. For more details on 
+* the driving stages, please refer to the driver G2 document Section 5.
+*
+* Parameters:
+* pv_eink_frame_data_t* imagePtr    : The pointer to the memory that contains a
+*                                     frame
+* pv_eink_stage_t stageNumber       : The assigned stage number
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  This is a blocking function. CPU will be busy during the entire operation,
+* which can be 1 to 2 seconds.
+*******************************************************************************/
+void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr, 
+                              pv_eink_stage_t stageNumber)
+{
+#if (PV_EINK_LINE_STREAMING == 0u)
+    /* Counter variable for the vertical pixel loop */
+    uint16    y;
+#endif
+    
+    /* The frame is read line by line */
+    pv_eink_line_source_t image = {Pv_EINK_GetFrameLine, imagePtr};
+    
+    /* A full update stage drives every scan line */
+    memset(changedRows, PV_EINK_ROW_ALL_CHANGED, sizeof(changedRows));
+    changedRowCount = PV_EINK_VERTICAL_SIZE;
+    
+#if (PV_EINK_LINE_STREAMING != 0u)
+    /* Write the stage to the display while encoding its lines */
+    Pv_EINK_StreamFullStage(&image, stageNumber);
+#else
+    /* Prepare all lines of the stage */
+    for (y = 0; y < PV_EINK_VERTICAL_SIZE; y++)
+    {
+        Pv_EINK_EncodeFullLine(y, &image, stageNumber);
+    }
+    
+    /* Write the stage to the display */
+    Pv_EINK_DriveFullStage(&image, stageNumber, false);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: void Pv_EINK_FullUpdate(pv_eink_frame_data_t* previousImagePtr,
+*                                        pv_eink_frame_data_t* newImagePtr,
+*                                        bool fourStage)
+********************************************************************************
+*
+* Summary: Performs all stages of a full update. The result is the same as 
+* calling Pv_EINK_FullStageHandler for each stage, but the line packets of a 
+* stage are prepared while the previous stage is being sent to the display.
+*
+* Parameters:
+* pv_eink_frame_data_t* previousImagePtr : Pointer to the memory that contains 
+*                                    previous frame written to the E-INK display
+* pv_eink_frame_data_t* newImagePtr      : Pointer to the memory that contains a 
+*                       new frame which needs to be written to the E-INK display
+* bool fourStage                         : "true" for a 4 stage update, "false"
+*                                          for a 2 stage update
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  This is a blocking function.
+*******************************************************************************/
+void Pv_EINK_FullUpdate(pv_eink_frame_data_t* previousImagePtr, 
+                        pv_eink_frame_data_t* newImagePtr, bool fourStage)
+{
+    /* The frames are read line by line */
+    pv_eink_line_source_t previousImage = {Pv_EINK_GetFrameLine, 
+                                           previousImagePtr};
+    pv_eink_line_source_t newImage      = {Pv_EINK_GetFrameLine, newImagePtr};
+    
+    Pv_EINK_FullUpdateLines(&previousImage, &newImage, fourStage);
+}
+
+/*******************************************************************************
+* Function Name: void Pv_EINK_FullUpdateLines(
+*                               pv_eink_line_source_t const* previousImage,
+*                               pv_eink_line_source_t const* newImage,
+*                               bool fourStage)
+********************************************************************************
+*
+* Summary: Performs all stages of a full update with images that are read line
+* by line, such as compressed images that are decoded while the update is in 
+* progress. Each stage reads all lines of its image once, in ascending order
+* (once per frame in line streaming mode); the line data is only used 
+* until the next line of the same image is read.
+*
+* Parameters:
+* pv_eink_line_source_t const* previousImage : Previous image written to the 
+*                                              E-INK display
+* pv_eink_line_source_t const* newImage      : New image which needs to be 
+*                                              written to the E-INK display
+* bool fourStage                             : "true" for a 4 stage update, 
+*                                              "false" for a 2 stage update
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  This is a blocking function.
+*******************************************************************************/
+void Pv_EINK_FullUpdateLines(pv_eink_line_source_t const* previousImage,
+                             pv_eink_line_source_t const* newImage, 
+                             bool fourStage)
+{
+#if (PV_EINK_LINE_STREAMING == 0u)
+    /* Counter variable for the vertical pixel loop */
+    uint16    y;
+#endif
+    
+    /* Counter variable for the stages */
+    uint8_t   stageIndex;
+    
+    /* Stages of a full update and the frames used by each of them. Stage 1: 
+       inverted previous frame, stage 2: white frame, stage 3: inverted new 
+       frame and stage 4: new frame. A 2 stage update uses stages 1 and 4 */
+    pv_eink_stage_t              stages[PV_EINK_STAGE_COUNT];
+    pv_eink_line_source_t const* images[PV_EINK_STAGE_COUNT];
+    uint8_t                      stageCount = 0u;
+    
+    stages[stageCount] = PV_EINK_STAGE1;
+    images[stageCount++] = previousImage;
+    if (fourStage)
+    {
+        stages[stageCount] = PV_EINK_STAGE2;
+        images[stageCount++] = previousImage;
+        stages[stageCount] = PV_EINK_STAGE3;
+        images[stageCount++] = newImage;
+    }
+    stages[stageCount] = PV_EINK_STAGE4;
+    images[stageCount++] = newImage;
+    
+    /* A full update drives every scan line */
+    memset(changedRows, PV_EINK_ROW_ALL_CHANGED, sizeof(changedRows));
+    changedRowCount = PV_EINK_VERTICAL_SIZE;
+    
+#if (PV_EINK_LINE_STREAMING != 0u)
+    /* Write each stage while encoding its lines */
+    for (stageIndex = 0u; stageIndex < stageCount; stageIndex++)
+    {
+        Pv_EINK_StreamFullStage(images[stageIndex], stages[stageIndex]);
+    }
+#else
+    /* Prepare the first stage */
+    for (y = 0; y < PV_EINK_VERTICAL_SIZE; y++)
+    {
+        Pv_EINK_EncodeFullLine(y, images[0], stages[0]);
+    }
+    
+    /* Write each stage while preparing the following one */
+    for (stageIndex = 0u; stageIndex < stageCount; stageIndex++)
+    {
+        if ((stageIndex + 1u) < stageCount)
+        {
+            Pv_EINK_DriveFullStage(images[stageIndex + 1u],
+                                   stages[stageIndex + 1u], true);
+        }
+        else
+        {
+            Pv_EINK_DriveFullStage(images[stageIndex], stages[stageIndex],
+                                   false);
         }
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: void static Pv_EINK_EncodePartialLine(uint16 y, 
+*                   pv_eink_frame_data_t* previousLinePtr,
+*                   pv_eink_frame_data_t* newLinePtr)
+********************************************************************************
+*
+* Summary: Prepares the driver packet of one line of a partial update. The 
+* changed pixels are driven the same way as the last stage of a full update, 
+* and the unchanged pixels are sent as "nothing" pixels.
+*
+* Parameters:
+* uint16 y                              : Line number to be prepared
+* pv_eink_frame_data_t* previousLinePtr : Line of the previous frame
+* pv_eink_frame_data_t* newLinePtr      : Line of the new frame
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void static Pv_EINK_EncodePartialLine(uint16 y, 
+                                      pv_eink_frame_data_t* previousLinePtr,
+                                      pv_eink_frame_data_t* newLinePtr)
+{
+    /* Counter variable for the horizontal pixel loop */
+    uint16    x;
+    /* Counter variable for the horizontal byte loop */
+    uint16    k;
+    
+    /* Temporary storage for image data bytes */
+    uint8_t     oldByte;
+    /* Temporary storage for image data bytes */
+    uint8_t     newByte;
+    /* Temporary storage for the changed pixel mask of a driver byte */
+    uint8_t     changedMask;
+    
+    /* The changed pixels are driven the same way as the last stage of a
+       full update */
+    uint8_t const* newOddTable  = stageOddTable[PV_EINK_STAGE4];
+    uint8_t const* newEvenTable = stageEvenTable[PV_EINK_STAGE4];
+    
+    /* Variable for storing the line number under scan */
+    int16       scanlineNumber = 0;
+    
+    /* Packet of the line */
+    driver_data_packet_t* packet = &bulkDriverPacket[PV_EINK_PACKET_INDEX(y)];
     
+    /* Clear the line buffer with all zeros */
+    memset(&packet->lineBuffer, 0, sizeof(packet->lineBuffer)) ;
+
+    /* Initialize the even data, odd data and scan data pointers */
+    dataLineEven = &packet->lineDataBySize.even[0];
+    dataLineOdd  = &packet->lineDataBySize.odd[0];
+    dataLineScan = &packet->lineDataBySize.scan[0];
+
+    /* Horizontal bytes initialization */
+    k = PV_EINK_HORIZONTAL_SIZE;
+    k--;
+    
+    /* Horizontal pixel loop */
+    for (x = 0; x < PV_EINK_HORIZONTAL_SIZE; x++)
+    {
+        /* Fetch successive data bytes */
+        oldByte = *previousLinePtr++;
+        newByte = *newLinePtr++;
+        
+        /* Calculate the Even and Odd bytes for partial update stage. Also, 
+           if the new data byte is same as the previous data byte, store a 
+           "nothing" pixel, so that the E-INK pixel won't be altered.
+           If the new data byte is different from the previous data byte, 
+           store the new data byte */
+        changedMask      = changedOddTable[oldByte ^ newByte];
+        dataLineOdd[x]   = (newOddTable[newByte] & changedMask) |
+                           (PV_EINK_NOTHING & (uint8_t)~changedMask);
+        changedMask      = changedEvenTable[oldByte ^ newByte];
+        dataLineEven[k--] = (newEvenTable[newByte] & changedMask) |
+                           (PV_EINK_NOTHING & (uint8_t)~changedMask);
     }
+    /* Move onto the next line */
+    scanlineNumber = PV_EINK_VERTICAL_SIZE - y;
+    scanlineNumber--;
+    
+    /* Shift Scan byte according to the data line */
+    dataLineScan[(scanlineNumber >> PV_EINK_PIXEL_SIZE)] = scanTable
+                        [(scanlineNumber % PV_EINK_SCAN_TABLE_SIZE)];
 }
 
 /*******************************************************************************
@@ -675,6 +1424,9 @@ void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr,
 * byte is same as previous data byte, send a "nothing" pixel, so that E-INK 
 * pixel won't be altered. If the new data byte is different from the previous 
 * data byte, send the new data byte.
+* Scan lines that are identical in both frames are not sent at all, so only the
+* lines that have changed are driven. Use Pv_EINK_GetChangedRows to read which 
+* lines were sent.
 * For more details on the driving stages, please refer to the driver G2 document
 * Section 5.
 *
@@ -694,20 +1446,20 @@ void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr,
 void Pv_EINK_PartialStageHandler(pv_eink_frame_data_t* previousImagePtr, 
                                  pv_eink_frame_data_t* newImagePtr)
 {
-    /* Counter variable for the horizontal pixel loop */
-    uint16    x;
     /* Counter variable for the vertical pixel loop */
     uint16    y;
-    /* Counter variable for the horizontal byte loop */
-    uint16    k;
     
-    /* Counter variable for write cycles */
-    uint16    currentWriteCycle;
+    /* Timing of this update. The temperature can be updated while the 
+       update is being written */
+    pv_eink_stage_timer_t timer;
+    bool      lastFrame;
     
-    /* Temporary storage for image data bytes */
-    uint8_t     oldByte;
-    /* Temporary storage for image data bytes */
-    uint8_t     newByte;
+    /* Lines of the previous and the new frames */
+    pv_eink_frame_data_t* previousLinePtr;
+    pv_eink_frame_data_t* newLinePtr;
+    
+    /* Packet of the line under scan */
+    driver_data_packet_t* packet;
     
     /* Variable for storing the line number under scan */
     int16       scanlineNumber = 0;
@@ -716,106 +1468,76 @@ void Pv_EINK_PartialStageHandler(pv_eink_frame_data_t* previousImagePtr,
     Pv_EINK_SendByte(PV_EINK_VCOM2_LEVEL_COMMAND_INDEX,
                      PV_EINK_VCOM2_LEVEL_COMMAND_DATA);
      
-    /* Vertical pixel loop */
+    /* Find the lines that differ between the frames, comparing a word at a
+       time */
+    changedRowCount = Cy_EINK_RasterChangedRows(previousImagePtr, newImagePtr,
+                                                changedRows);
+    
+#if (PV_EINK_LINE_STREAMING == 0u)
+    /* Prepare the changed lines */
     for (y = 0; y < PV_EINK_VERTICAL_SIZE; y++)
     {
-        /* Clear the line buffer with all zeros */
-        memset(&bulkDriverPacket[y].lineBuffer, 0, 
-               sizeof(bulkDriverPacket[y].lineBuffer)) ;
-
-        /* Initialize the even data, odd data and scan data pointers */
-        dataLineEven = &bulkDriverPacket[y].lineDataBySize.even[0];
-        dataLineOdd  = &bulkDriverPacket[y].lineDataBySize.odd[0];
-        dataLineScan = &bulkDriverPacket[y].lineDataBySize.scan[0];
-
-        /* Horizontal bytes initialization */
-        k = PV_EINK_HORIZONTAL_SIZE;
-        k--;
-        
-        /* Horizontal pixel loop */
-        for (x = 0; x < PV_EINK_HORIZONTAL_SIZE; x++)
+        if (PV_EINK_IS_ROW_CHANGED(y))
         {
-            /* Fetch successive data bytes */
-            oldByte = *previousImagePtr++;
-            newByte = *newImagePtr++;
-            
-            /* Calculate the Even and Odd bytes for partial update stage. Also, 
-               if the new data byte is same as the previous data byte, store a 
-               "nothing" pixel, so that the E-INK pixel won't be altered.
-               If the new data byte is different from the previous data byte, 
-               store the new data byte */
-            dataLineOdd[x]       = ((oldByte ^ newByte) & PV_EINK_ODD_MASK_A)
-                                    ?((newByte & PV_EINK_ODD_MASK_A)
-                                    ? PV_EINK_WHITE3
-                                    : PV_EINK_BLACK3) : PV_EINK_NOTHING3;
-            dataLineOdd[x]      |= ((oldByte ^ newByte) & PV_EINK_ODD_MASK_B)
-                                    ?((newByte & PV_EINK_ODD_MASK_B) 
-                                    ? PV_EINK_WHITE2 
-                                    : PV_EINK_BLACK2) : PV_EINK_NOTHING2;
-            dataLineOdd[x]      |= ((oldByte ^ newByte) & PV_EINK_ODD_MASK_C)
-                                    ?((newByte & PV_EINK_ODD_MASK_C) 
-                                    ? PV_EINK_WHITE1
-                                    : PV_EINK_BLACK1) : PV_EINK_NOTHING1;
-            dataLineOdd[x]      |= ((oldByte ^ newByte) & PV_EINK_ODD_MASK_D)
-                                    ?((newByte & PV_EINK_ODD_MASK_D) 
-                                    ? PV_EINK_WHITE0 
-                                    : PV_EINK_BLACK0) : PV_EINK_NOTHING0;
-            dataLineEven[k]      = ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_A)
-                                    ?((newByte & PV_EINK_EVEN_MASK_A) 
-                                    ? PV_EINK_WHITE0
-                                    : PV_EINK_BLACK0) : PV_EINK_NOTHING0;
-            dataLineEven[k]     |= ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_B) 
-                                    ?((newByte & PV_EINK_EVEN_MASK_B) 
-                                    ? PV_EINK_WHITE1
-                                    : PV_EINK_BLACK1) : PV_EINK_NOTHING1;
-            dataLineEven[k]     |= ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_C)
-                                    ?((newByte & PV_EINK_EVEN_MASK_C) 
-                                    ? PV_EINK_WHITE2 
-                                    : PV_EINK_BLACK2) : PV_EINK_NOTHING2;
-            dataLineEven[k--]   |= ((oldByte ^ newByte) & PV_EINK_EVEN_MASK_D)
-                                    ?((newByte & PV_EINK_EVEN_MASK_D) 
-                                    ? PV_EINK_WHITE3 
-                                    : PV_EINK_BLACK3) : PV_EINK_NOTHING3;
+            previousLinePtr = previousImagePtr + (y * PV_EINK_HORIZONTAL_SIZE);
+            newLinePtr      = newImagePtr + (y * PV_EINK_HORIZONTAL_SIZE);
+            Pv_EINK_EncodePartialLine(y, previousLinePtr, newLinePtr);
         }
-        /* Move onto the next line */
-        scanlineNumber = PV_EINK_VERTICAL_SIZE - y;
-        scanlineNumber--;
-        
-        /* Shift Scan byte according to the data line */
-        dataLineScan[(scanlineNumber >> PV_EINK_PIXEL_SIZE)] = scanTable
-                            [(scanlineNumber % PV_EINK_SCAN_TABLE_SIZE)];
     }
+#endif
     
-    /* Perform update operation until the total number of write cycles equals 
-       the value calculated based on temperature */
-    for (currentWriteCycle = 0; currentWriteCycle < partialUpdateCycles;
-         currentWriteCycle++)
+    /* Perform update operation until the stage time calculated based on 
+       temperature has elapsed. Nothing is driven if no line has changed */
+    Pv_EINK_StartStage(&timer, partialStageTime);
+    lastFrame = (changedRowCount == 0u);
+    while (!lastFrame)
     {
-        /* Perform a line by line update */
+        lastFrame = Pv_EINK_StartFrame(&timer);
+        
+        /* Perform a line by line update of the changed lines */
         for (y = 0; y < PV_EINK_VERTICAL_SIZE; y++)
         {
-            /* Send the prepared data to the E-INK display */
-            Pv_EINK_SendData(PV_EINK_PIXEL_DATA_COMMAND_INDEX,
-                            (uint8_t*) &bulkDriverPacket[y].lineBuffer,
-                             PV_EINK_DATA_LINE_SIZE);
-            /* Turn on Output Enable to latch the frame */
-            Pv_EINK_SendByte(PV_EINK_ENABLE_OE_COMMAND_INDEX,
-                             PV_EINK_ENABLE_OE_COMMAND_DATA);
+            if (!PV_EINK_IS_ROW_CHANGED(y))
+            {
+                continue;
+            }
+            
+            packet = &bulkDriverPacket[PV_EINK_PACKET_INDEX(y)];
             
             /* Calculate the current line under scan */
             scanlineNumber = PV_EINK_VERTICAL_SIZE - y;
             scanlineNumber--;
             
+#if (PV_EINK_LINE_STREAMING != 0u)
+            /* Prepare the line again, as its packet is shared with other 
+               lines. The scan byte of a prepared line is only sent in the
+               first frame */
+            previousLinePtr = previousImagePtr + (y * PV_EINK_HORIZONTAL_SIZE);
+            newLinePtr      = newImagePtr + (y * PV_EINK_HORIZONTAL_SIZE);
+            Pv_EINK_EncodePartialLine(y, previousLinePtr, newLinePtr);
+            if (timer.frames != 1u)
+            {
+                packet->lineDataBySize.scan[(scanlineNumber >> 
+                                             PV_EINK_PIXEL_SIZE)]
+                                             = PV_EINK_SCAN_BYTE_INIT;
+            }
+#endif
+            
+            /* Send the prepared data to the E-INK display */
+            Pv_EINK_SendData(PV_EINK_PIXEL_DATA_COMMAND_INDEX,
+                            (uint8_t*) &packet->lineBuffer,
+                             PV_EINK_DATA_LINE_SIZE);
+            /* Turn on Output Enable to latch the frame */
+            Pv_EINK_LatchLine();
+            
             /* Re-initialize the scan line (extra step for partial update) */
-            bulkDriverPacket[y].lineDataBySize.scan[(scanlineNumber 
-                                                     >> PV_EINK_PIXEL_SIZE)]
-                                                     = PV_EINK_SCAN_BYTE_INIT;
+            packet->lineDataBySize.scan[(scanlineNumber >> PV_EINK_PIXEL_SIZE)]
+                                        = PV_EINK_SCAN_BYTE_INIT;
 
             Pv_EINK_SendData(PV_EINK_PIXEL_DATA_COMMAND_INDEX,
-                            (uint8_t*) &bulkDriverPacket[y].lineBuffer,
+                            (uint8_t*) &packet->lineBuffer,
                              PV_EINK_DATA_LINE_SIZE);
-            Pv_EINK_SendByte(PV_EINK_ENABLE_OE_COMMAND_INDEX,
-                             PV_EINK_ENABLE_OE_COMMAND_DATA);
+            Pv_EINK_LatchLine();
         }
     }
  
@@ -824,6 +1546,65 @@ void Pv_EINK_PartialStageHandler(pv_eink_frame_data_t* previousImagePtr,
                      PV_EINK_VCOM1_LEVEL_COMMAND_DATA);
 }
 
+/*******************************************************************************
+* Function Name: uint16 Pv_EINK_GetChangedRows(uint8_t const** rowBitmap)
+********************************************************************************
+*
+* Summary: Reports the scan lines that were sent by the last display update.
+* A partial update only sends the lines that differ between the previous and
+* the new frame, while a full update sends every line.
+*
+* Parameters:
+* uint8_t const** rowBitmap : Returns a pointer to the bitmap of the sent lines.
+*                             Bit (y % 8) of byte (y / 8) is set if line y was
+*                             sent. Can be NULL if only the count is required.
+*
+* Return:
+*  uint16 : Number of scan lines sent by the last update
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+uint16 Pv_EINK_GetChangedRows(uint8_t const** rowBitmap)
+{
+    if (rowBitmap != NULL)
+    {
+        *rowBitmap = changedRows;
+    }
+    return(changedRowCount);
+}
+
+/*******************************************************************************
+* Function Name: void Pv_EINK_GetStatistics(pv_eink_statistics_t* statistics,
+*                                           bool reset)
+********************************************************************************
+*
+* Summary: Reads the number of bytes sent to the E-INK driver and the number of 
+* data lines latched
+*
+* Parameters:
+*  pv_eink_statistics_t* statistics : Returns the counters; can be NULL
+*  bool reset                       : "true" to clear the counters
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+void Pv_EINK_GetStatistics(pv_eink_statistics_t* statistics, bool reset)
+{
+    if (statistics != NULL)
+    {
+        *statistics = driverStatistics;
+    }
+    if (reset)
+    {
+        driverStatistics.spiBytes     = 0u;
+        driverStatistics.linesLatched = 0u;
+    }
+}
+
 /*******************************************************************************
 * Function Name:  void Pv_EINK_NothingFrame(void)
 ********************************************************************************
@@ -864,8 +1645,7 @@ void Pv_EINK_NothingFrame(void)
                         (uint8_t*) &driverPacket.lineBuffer,
                          PV_EINK_DATA_LINE_SIZE);
         /* Turn on Output Enable to latch the frame */
-        Pv_EINK_SendByte(PV_EINK_ENABLE_OE_COMMAND_INDEX, 
-                         PV_EINK_ENABLE_OE_COMMAND_DATA);
+        Pv_EINK_LatchLine();
         
         /* Initialize the next scan byte */
         dataLineScan[(byteCounter >> PV_EINK_PIXEL_SIZE)] = 0u;
@@ -903,14 +1683,13 @@ void Pv_EINK_DummyLine(void)
     
     /* Set charge pump voltage level to reduce voltage shift */
     Pv_EINK_SendByte(PV_EINK_PWR2_SETTING_COMMAND_INDEX, 
-                     PV_EINK_VOLTAGE_LEVEL);
+                     panelDescriptor.voltageLevel);
     /* Send the prepared data to the E-INK display */
     Pv_EINK_SendData(PV_EINK_PIXEL_DATA_COMMAND_INDEX,
                     (uint8_t*) &driverPacket.lineBuffer, 
                      PV_EINK_DATA_LINE_SIZE);
     /* Turn on Output Enable to latch the frame */
-    Pv_EINK_SendByte(PV_EINK_ENABLE_OE_COMMAND_INDEX, 
-                     PV_EINK_ENABLE_OE_COMMAND_DATA);
+    Pv_EINK_LatchLine();
 }
 
 /*******************************************************************************
@@ -1041,4 +1820,25 @@ pv_eink_status_t Pv_EINK_HardwarePowerOff(void)
     return(PV_EINK_RES_OK);
 }
 
+/*******************************************************************************
+* Function Name: pv_eink_panel_t const* Pv_EINK_GetPanel(void)
+********************************************************************************
+*
+* Summary: Reports the panel that the driver is built for (see PV_EINK_PANEL in
+* pervasive_eink_configuration.h)
+*
+* Parameters:
+*  None
+*
+* Return:
+*  pv_eink_panel_t const* : Panel descriptor
+*
+* Side Effects:
+*  None
+*******************************************************************************/
+pv_eink_panel_t const* Pv_EINK_GetPanel(void)
+{
+    return(&panelDescriptor);
+}
+
 /* [] END OF FILE */
@@ -72,20 +72,84 @@ typedef enum
     PV_EINK_STAGE4
 }   pv_eink_stage_t ;
 
+/* Data-type of refresh policies: speed-contrast trade-off of the stage time */
+typedef enum
+{
+    PV_EINK_POLICY_FAST,
+    PV_EINK_POLICY_BALANCED,
+    PV_EINK_POLICY_HIGH_CONTRAST
+}   pv_eink_policy_t;
+
+/* Data-type of the driver activity counters */
+typedef struct
+{
+    uint32_t    spiBytes;
+    uint32_t    linesLatched;
+}   pv_eink_statistics_t;
+
+/* Descriptor of the panel that the driver is built for: geometry, line data
+   layout, driver settings and the stage timing */
+typedef struct
+{
+    char const*     name;
+    uint16          width;
+    uint16          height;
+    uint16          lineSize;
+    uint16          imageSize;
+    uint8_t         scanLineSize;
+    uint8_t         dataLineSize;
+    bool            borderFirst;
+    uint8_t         voltageLevel;
+    uint8_t const*  channelSelect;
+    uint8_t const*  scanTable;
+    uint16          stageTime;
+    uint16          frameTimeOffset;
+}   pv_eink_panel_t;
+
+/* Function that returns the data of line y of an image, or the white/black 
+   frame address for an all white/black line. The lines of an image are 
+   requested in ascending order, starting from line 0 at each update stage, or
+   at each frame in line streaming mode (PV_EINK_LINE_STREAMING) */
+typedef pv_eink_frame_data_t* (* pv_eink_line_function_t) (void* image, 
+                                                            uint16 y);
+
+/* Data-type of an image that is read line by line */
+typedef struct
+{
+    pv_eink_line_function_t getLine;
+    void*                   image;
+}   pv_eink_line_source_t;
+
 /* Declarations of functions defined in pv_eink_hardware_driver.c */
 /* Power control and initialization functions */
 void             Pv_EINK_Init(void);
 pv_eink_status_t Pv_EINK_HardwarePowerOn(void);
 pv_eink_status_t Pv_EINK_HardwarePowerOff(void);
 
-/* Set refresh time factor based on the ambient temperature */
+/* Set refresh time factor based on the ambient temperature and the refresh
+   policy */
 void Pv_EINK_SetTempFactor(int8_t temperature);
+void Pv_EINK_SetPolicy(pv_eink_policy_t policy);
 
 /* Display update functions */
 void Pv_EINK_FullStageHandler(pv_eink_frame_data_t* imagePtr, 
                               pv_eink_stage_t stageNumber);
+void Pv_EINK_FullUpdate(pv_eink_frame_data_t* previousImagePtr, 
+                        pv_eink_frame_data_t* newImagePtr, bool fourStage);
+void Pv_EINK_FullUpdateLines(pv_eink_line_source_t const* previousImage,
+                             pv_eink_line_source_t const* newImage, 
+                             bool fourStage);
 void Pv_EINK_PartialStageHandler(pv_eink_frame_data_t* previousImagePtr, 
                                  pv_eink_frame_data_t* newImagePtr);
 
+/* Report the scan lines sent by the last display update */
+uint16 Pv_EINK_GetChangedRows(uint8_t const** rowBitmap);
+
+/* Report the bytes sent and the lines latched */
+void Pv_EINK_GetStatistics(pv_eink_statistics_t* statistics, bool reset);
+
+/* Report the panel that the driver is built for */
+pv_eink_panel_t const* Pv_EINK_GetPanel(void);
+
 #endif  /* PERVASIVE_EINK_HARDWARE_DRIVER_H */
 /* [] END OF FILE */
@@ -58,13 +58,18 @@
 #include "./images_and_text/screen_contents.h"
 #include <math.h>
 #include "display_task.h"
+#include "refresh_task.h"
+#include "page_cache.h"
+#include "screen_state.h"
 #include "menu_configuration.h"
 #include "touch_task.h"
 #include "uart_debug.h"
+#include "latency_trace.h"
 #include "cycfg.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "semphr.h"
 #include "GUI.h"
 
 /* Macros for temperature measurement using thermistor, which is
@@ -86,12 +91,83 @@
 /* Zero Kelvin in degree C */
 #define ABSOLUTE_ZERO       		(float)(-273.15)
 
-/* Frame buffers used by the display update functions  */
-cy_eink_frame_t	currentFrameBuffer[CY_EINK_FRAME_SIZE];
-cy_eink_frame_t	previousFrameBuffer[CY_EINK_FRAME_SIZE];
+/* Interval at which the ambient temperature is measured again to adjust the
+   E-INK refresh time */
+#define TEMPERATURE_SAMPLE_INTERVAL	(pdMS_TO_TICKS(60000u))
 
-/* Reference to the bitmap image for the startup screen */
+/* Range of the ambient temperature readings in degree Celsius. Readings are
+   clamped to the operating range of the kit */
+#define TEMPERATURE_MIN				(-40.0f)
+#define TEMPERATURE_MAX				(85.0f)
+
+/* Ambient temperature used until the first successful reading, in degree 
+   Celsius */
+#define TEMPERATURE_DEFAULT			(int8_t)(25)
+
+/* Priority and stack size of the task that measures the ambient temperature.
+   The task runs below all the tasks of the user interface */
+#define TASK_TEMPERATURE_PRIORITY	(2u)
+#define TASK_TEMPERATURE_STACK_SIZE	(configMINIMAL_STACK_SIZE * 2u)
+
+/* Time in microseconds for the thermistor circuit to settle after it has
+   been powered */
+#define THERMISTOR_SETTLE_TIME		(100u)
+
+/* Speed-contrast trade-off of the E-INK refreshes */
+#define DISPLAY_REFRESH_POLICY		(CY_EINK_POLICY_BALANCED)
+
+/* Reference to the bitmap image for the startup screen, and to the 
+   compressed startup screen with that image only */
 extern GUI_CONST_STORAGE GUI_BITMAP bmCypressLogo_1bpp;
+extern cy_eink_compressed_image_t const startupLogoImage;
+
+/* emWin function hook to access the display buffer */
+extern uint8* LCD_GetDisplayBuffer(void);
+
+/* Cursor of the main menu: area of the cursor column that is cleared, and the
+   rectangle of the arrow for the first menu item. The arrow moves down by
+   CURSOR_ITEM_SPACING lines per menu item */
+#define CURSOR_AREA_X0				(3u)
+#define CURSOR_AREA_Y0				(4u)
+#define CURSOR_AREA_X1				(18u)
+#define CURSOR_AREA_Y1				(134u)
+#define CURSOR_ARROW_Y0				(4u)
+#define CURSOR_ARROW_Y1				(26u)
+#define CURSOR_ITEM_SPACING			(35u)
+
+/* Bytes per line of the arrow bitmap, which covers the pixel columns 0 to 23 */
+#define CURSOR_ARROW_LINE_SIZE		(3u)
+
+/* Arrow bitmap of the cursor, in the pixel format of the display buffer (1 for
+   white, leftmost pixel in the most significant bit). It is the arrow that 
+   emWin draws with three lines of pen size 4, prebuilt so that it can be 
+   copied into the display buffer */
+pv_eink_frame_data_t static const cursorArrow[] =
+{
+	0xF1u, 0xFFu, 0xFFu,
+	0xF0u, 0xFFu, 0xFFu,
+	0xF0u, 0x7Fu, 0xFFu,
+	0xF0u, 0x3Fu, 0xFFu,
+	0xF0u, 0x1Fu, 0xFFu,
+	0xF0u, 0x0Fu, 0xFFu,
+	0xF1u, 0x07u, 0xFFu,
+	0xF1u, 0x83u, 0xFFu,
+	0xF1u, 0xC1u, 0xFFu,
+	0xF1u, 0xE0u, 0xFFu,
+	0xF1u, 0xF0u, 0x7Fu,
+	0xF1u, 0xF8u, 0x7Fu,
+	0xF1u, 0xF0u, 0x7Fu,
+	0xF1u, 0xE0u, 0xFFu,
+	0xF1u, 0xC1u, 0xFFu,
+	0xF1u, 0x83u, 0xFFu,
+	0xF1u, 0x07u, 0xFFu,
+	0xF0u, 0x0Fu, 0xFFu,
+	0xF0u, 0x1Fu, 0xFFu,
+	0xF0u, 0x3Fu, 0xFFu,
+	0xF0u, 0x7Fu, 0xFFu,
+	0xF0u, 0xFFu, 0xFFu,
+	0xF1u, 0xFFu, 0xFFu
+};
 
 /* Variable that stores the details of the current screen */
 screen_t  currentScreen =
@@ -101,24 +177,93 @@ screen_t  currentScreen =
     .textPage   = TEXT_PAGE_INDEX_START
 };
 
-/* emWin function hook to copy the display buffer */
-extern void LCD_CopyDisplayBuffer(uint8* destination, int count);
+/* Screen of the frame that was submitted last to the refresh task */
+screen_t static submittedScreen;
+
+/* Touch widgets that cause a screen change on each screen type, scanned by
+   the touch task. See the screen transitions in Task_Display */
+uint8_t static const screenTouchProfile[NUMBER_OF_SCREEN_TYPES] =
+{
+    (TOUCH_PROFILE_BUTTON0 | TOUCH_PROFILE_SLIDER),
+    (TOUCH_PROFILE_BUTTON1 | TOUCH_PROFILE_SLIDER)
+};
 
 /*  These static functions are not available outside this file. 
     See the respective function definitions for more details */
-void static NoScreenChange(void);
-void static MoveArrowUp(void);
-void static MoveArrowDown(void);
-void static GoToTextPage(void);
-void static GoToMainMenu(void);
-void static PreviousTextPage(void);
-void static NextTextPage(void);
+void static UpdateScreen(screen_t const* previousScreen);
+void static NoScreenChange(screen_t* screen);
+void static MoveArrowUp(screen_t* screen);
+void static MoveArrowDown(screen_t* screen);
+void static GoToTextPage(screen_t* screen);
+void static GoToMainMenu(screen_t* screen);
+void static PreviousTextPage(screen_t* screen);
+void static NextTextPage(screen_t* screen);
+void static DrawScreen(void);
+bool static IsScreenValid(screen_t const* screen);
+void static DrawMainMenu(void);
+void static ShowMainMenu(void);
+void static ShowMenuCursor(void);
+void static ShowTextPage(void);
 void static ShowStartupScreen(void);
-int8_t static ReadAmbientTemperature(void);
+void static RenderTextPage(uint8_t pageIndex);
+void static PrefetchAdjacentPages(void);
+bool static ReadAmbientTemperature(int8_t* temperature);
+void static Task_Temperature(void *pvParameters);
 
 /* Function used to register the E-INK delay call back */
 void static DelayMs(uint32_t delayInMs)  {vTaskDelay(pdMS_TO_TICKS(delayInMs));}
 
+/* Function used to register the E-INK time stamp call back */
+uint32_t static GetTimeMs(void)  {return (xTaskGetTickCount() * portTICK_PERIOD_MS);}
+
+/* Semaphore that is given by the E-INK SPI interrupt when a bulk transfer
+   has finished */
+SemaphoreHandle_t static spiTransferSemaphore;
+
+/* Functions used to register the E-INK bulk transfer call backs */
+void static WaitForSpiTransfer(void)
+{
+    xSemaphoreTake(spiTransferSemaphore, portMAX_DELAY);
+}
+void static SpiTransferComplete(void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(spiTransferSemaphore, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+/* Semaphore that is given by the refresh task when a display refresh has
+   finished */
+SemaphoreHandle_t static refreshDoneSemaphore;
+
+/* Function used to register the display refresh complete call back */
+void static RefreshComplete(cy_eink_update_t updateType)
+{
+    (void)updateType;
+    xSemaphoreGive(refreshDoneSemaphore);
+}
+
+/* Function used to register the display refresh complete call back after the
+   startup. Stores the screen on the display, so that it is restored after a
+   reset. The submitted screen is not on the display yet if a newer frame is
+   waiting to be written */
+void static StoreDisplayedScreen(cy_eink_update_t updateType)
+{
+    screen_t displayedScreen;
+    bool     refreshPending;
+    
+    (void)updateType;
+    vTaskSuspendAll();
+    refreshPending  = IsRefreshPending();
+    displayedScreen = submittedScreen;
+    xTaskResumeAll();
+    
+    if ((!refreshPending) && (!SaveScreenState(&displayedScreen)))
+    {
+        Task_DebugPrintf("Failure! : Display - screen state store", 0u);
+    }
+}
+
 /*******************************************************************************
 * Function Name: void Task_Display (void *pvParameters)
 ********************************************************************************
@@ -148,14 +293,39 @@ void Task_Display (void *pvParameters)
     /* Variable that stores the touch input received from the Touch Task */
     touch_data_t touchInput;
 
+    /* Variable that stores the screen shown before the touch inputs */
+    screen_t previousScreen;
+
+    /* Variable that stores the screen that was on the display before the 
+       reset */
+    screen_t storedScreen;
+
     /* Remove warning for unused parameter */
     (void)pvParameters ;
     
     /* Initialize emWin Graphics */
     GUI_Init();
 
-    /* Read the ambient temperature value from the thermistor circuit */
-    ambientTemperature = ReadAmbientTemperature();
+    /* Keep the rendered text pages so that revisited pages are not rendered
+       again */
+    InitPageCache(RenderTextPage);
+
+    /* Read the ambient temperature value from the thermistor circuit. The
+       default temperature is used if the readout fails */
+    (void)ReadAmbientTemperature(&ambientTemperature);
+
+    /* Block the task instead of polling while the E-INK line data is being
+       sent over SPI */
+    spiTransferSemaphore = xSemaphoreCreateBinary();
+    if(spiTransferSemaphore != NULL)
+    {
+        Cy_EINK_RegisterTransferFunctions(WaitForSpiTransfer,
+                                          SpiTransferComplete);
+    }
+
+    /* Drive each update stage for the stage time, and measure the duration
+       of the display refreshes */
+    Cy_EINK_RegisterTimeFunction(GetTimeMs);
 
     /* Initialize the E-INK display hardware with the ambient temperature 
        value and the delay function pointer */
@@ -185,12 +355,51 @@ void Task_Display (void *pvParameters)
         Task_DebugPrintf("Failure! : Display - Cy_EINK_Start API", 0u);
     }
 
-    /* Show the startup screen */
-    ShowStartupScreen();
+    /* Select the refresh policy, and measure the ambient temperature 
+       periodically so that the refresh time tracks the ambient conditions */
+    Cy_EINK_SetPolicy(DISPLAY_REFRESH_POLICY);
+    if(xTaskCreate(Task_Temperature, "Temperature task",
+                   TASK_TEMPERATURE_STACK_SIZE, NULL,
+                   TASK_TEMPERATURE_PRIORITY, NULL) != pdPASS)
+    {
+        Task_DebugPrintf("Failure! : Display - Temperature task create", 0u);
+    }
 
-    /* Keep the logo on for a specific time and then load the menu */
-    vTaskDelay(STARTUP_SCREEN_DELAY);
-    GoToMainMenu();
+    /* The E-INK display keeps the screen that was shown before the reset. 
+       Draw the frame of that screen again as the frame on the display, so 
+       that the next refresh is a partial update */
+    if (LoadScreenState(&storedScreen) && IsScreenValid(&storedScreen))
+    {
+        currentScreen = storedScreen;
+        DrawScreen();
+        SetDisplayedFrame();
+        submittedScreen = currentScreen;
+        Task_DebugPrintf("Info     : Display - screen restored", 0u);
+        
+        if (currentScreen.screen == TEXT_PAGE)
+        {
+            PrefetchAdjacentPages();
+        }
+    }
+    else
+    {
+        /* Get notified when the display refreshes have finished */
+        refreshDoneSemaphore = xSemaphoreCreateBinary();
+        RegisterRefreshCompleteFunction(RefreshComplete);
+
+        /* Show the startup screen and wait until it is on the display */
+        ShowStartupScreen();
+        xSemaphoreTake(refreshDoneSemaphore, portMAX_DELAY);
+
+        /* Keep the logo on for a specific time and then load the menu */
+        vTaskDelay(STARTUP_SCREEN_DELAY);
+        ShowMainMenu();
+    }
+
+    /* The remaining refreshes run in the background, and the screen is stored
+       each time it is on the display */
+    RegisterRefreshCompleteFunction(StoreDisplayedScreen);
+    SetTouchProfile(screenTouchProfile[currentScreen.screen]);
 
     /* Repeatedly running part of the task */
     for(;;)
@@ -202,8 +411,9 @@ void Task_Display (void *pvParameters)
         /* Touch input has been received over touchDataQ */
         if(rtosApiResult == pdTRUE)
         {
+            TraceEvent(TRACE_TOUCH_RECEIVED);
        
-        /* Function pointer that selects a screen update function based on the 
+        /* Function pointer that selects a screen transition based on the 
           current screen type and the touch input:
         _______________________________________________________________
         |                                     |                       |
@@ -221,17 +431,32 @@ void Task_Display (void *pvParameters)
         |   [TEXT_PAGE][SLIDER_FLICK_RIGHT])  |   NextTextPage        |
         |_____________________________________|_______________________|*/
             
-        static void (*ScreenUpdatePointer[NUMBER_OF_SCREEN_TYPES]
-                                         [NUMBER_OF_INPUT_TYPES]) (void) =
+        static void (* const ScreenTransition[NUMBER_OF_SCREEN_TYPES]
+                                             [NUMBER_OF_INPUT_TYPES]) 
+                                             (screen_t* screen) =
         {
             { GoToTextPage, NoScreenChange, MoveArrowUp, MoveArrowDown },
             { NoScreenChange, GoToMainMenu, PreviousTextPage,NextTextPage }
         };
 
-        	/* Call the function pointer that selects a screen update function
-            according to the touch input */     
-            (*ScreenUpdatePointer[currentScreen.screen][touchInput])();
+            /* Store the screen that is on the display */
+            previousScreen = currentScreen;
+
+        	/* Apply the screen transition of the touch input, and of all the
+            touch inputs that have been queued meanwhile. For example, three 
+            right flicks advance three text pages */
+            do
+            {
+                (*ScreenTransition[currentScreen.screen][touchInput])
+                                                            (&currentScreen);
+            }
+            while (xQueueReceive(touchDataQ, &touchInput, 0u) == pdTRUE);
 
+            /* Scan only the widgets that are meaningful on the new screen */
+            SetTouchProfile(screenTouchProfile[currentScreen.screen]);
+
+            /* Draw and refresh only the final screen */
+            UpdateScreen(&previousScreen);
         }
         /* Task has timed out and received no inputs during an interval of 
            portMAXDELAY ticks */
@@ -250,56 +475,142 @@ void Task_Display (void *pvParameters)
 *******************************************************************************/
 
 /*******************************************************************************
-* Function Name: void static UpdateDisplay(void)
+* Function Name: void static UpdateDisplay(cy_eink_update_t updateMethod)
 ********************************************************************************
 *
 * Summary: This function updates the display with the data in the display
-*            buffer.  The function first transfers the content of the EmWin
-*            display buffer to the primary EInk display buffer.  Then it calls
-*            the Cy_EINK_ShowFrame function to update the display, and then
-*            it copies the EmWin display buffer to the E-INK display cache buffer
+*            buffer. The EmWin display buffer is handed over to the refresh 
+*            task, which updates the E-INK display in the background.
 *
 * Parameters:
-*  None
+*  cy_eink_update_t updateMethod : Full update (2/4 stages), partial update or
+*                                  automatic selection
 *
 * Return:
 *  None
 *
 * Side Effects:
-*  It takes about a second to refresh the display.  This is a blocking function
-*  and only returns after the display refresh
+*  The function returns without waiting for the refresh. If the display is
+*  still refreshing, the frame replaces any frame that is waiting to be shown
 *
 *******************************************************************************/
-void static UpdateDisplay(cy_eink_update_t updateMethod, bool powerCycle)
+void static UpdateDisplay(cy_eink_update_t updateMethod)
 {
-    /* Copy the EmWin display buffer to imageBuffer*/
-    LCD_CopyDisplayBuffer(currentFrameBuffer, CY_EINK_FRAME_SIZE);
-
-    /* Turn the Orange LED on to indicate that the E-INK display is refreshing */
-    Cy_GPIO_Clr(KIT_LED1_PORT, KIT_LED1_PIN);
+    TraceEvent(TRACE_RENDER_DONE);
 
-    /* Update the EInk display */
-    Cy_EINK_ShowFrame(previousFrameBuffer, currentFrameBuffer, updateMethod,
-    				  powerCycle);
+    /* Submit the EmWin display buffer to the refresh task */
+    submittedScreen = currentScreen;
+    RefreshDisplayAsync(updateMethod);
+}
 
-    /* Turn off the Orange LED on to indicate that the E-INK refresh has finished */
-    Cy_GPIO_Set(KIT_LED1_PORT, KIT_LED1_PIN);
+/*******************************************************************************
+* Function Name: void static UpdateScreen(screen_t const* previousScreen)
+********************************************************************************
+*
+* Summary:
+*  Draws the current screen and sends it to the display. Only the final screen
+*  of the coalesced touch inputs is drawn, and nothing is drawn if that screen
+*  is already on the display.
+*
+* Parameters:
+*  screen_t const* previousScreen : Screen shown before the touch inputs
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static UpdateScreen(screen_t const* previousScreen)
+{
+    if (currentScreen.screen == MAIN_MENU)
+    {
+        /* Draw the complete main menu when coming from a text page */
+        if (previousScreen->screen != MAIN_MENU)
+        {
+            ShowMainMenu();
+        }
+        /* Otherwise only the cursor has to be moved */
+        else if (previousScreen->menuItem != currentScreen.menuItem)
+        {
+            ShowMenuCursor();
+        }
+        else
+        {
+        }
+    }
+    else
+    {
+        /* Draw the text page if another page has been selected */
+        if ((previousScreen->screen != TEXT_PAGE) ||
+            (previousScreen->menuItem != currentScreen.menuItem) ||
+            (previousScreen->textPage != currentScreen.textPage))
+        {
+            ShowTextPage();
+        }
+    }
+}
 
-    /* Copy the EmWin display buffer to the imageBuffer cache*/
-    LCD_CopyDisplayBuffer(previousFrameBuffer, CY_EINK_FRAME_SIZE);
+/*******************************************************************************
+* Function Name: void static NoScreenChange(screen_t* screen)
+********************************************************************************
+*
+* Summary:
+*  Screen transition for the touch inputs that are not used in a screen
+*
+* Parameters:
+*  screen_t* screen : Screen to be modified (unused)
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static NoScreenChange(screen_t* screen)
+{
+    (void)screen;
 }
 
 /*******************************************************************************
-* Function Name: void static NoScreenChange(void)
+* Function Name: void static GoToTextPage(screen_t* screen)
 ********************************************************************************
 *
 * Summary:
-*  Null function that is called by the "ScreenUpdatePointer" function pointer  
-*  when no screen change is required
+*  Screen transition from the main menu to the first text page of the selected
+*  menu item
 *
 * Parameters:
+*  screen_t* screen : Screen to be modified
+*
+* Return:
+*  None
+*
+* Side Effects:
 *  None
 *
+*******************************************************************************/
+void static GoToTextPage(screen_t* screen)
+{
+    /* Change the current screen type to text page */
+    screen->screen = TEXT_PAGE;
+
+    /* Re-initialize the text page index to point to the start page */
+    screen->textPage = TEXT_PAGE_INDEX_START;
+}
+
+/*******************************************************************************
+* Function Name: void static GoToMainMenu(screen_t* screen)
+********************************************************************************
+*
+* Summary:
+*  Screen transition from a text page to the main menu
+*
+* Parameters:
+*  screen_t* screen : Screen to be modified
+*
 * Return:
 *  None
 *
@@ -307,20 +618,55 @@ void static UpdateDisplay(cy_eink_update_t updateMethod, bool powerCycle)
 *  None
 *
 *******************************************************************************/
-void static NoScreenChange(void)
+void static GoToMainMenu(screen_t* screen)
 {
+    /* Change the current screen type to main menu */
+    screen->screen = MAIN_MENU;
 }
 
 /*******************************************************************************
-* Function Name: void static GoToTextPage(void)
+* Function Name: void static MoveArrowUp(screen_t* screen)
 ********************************************************************************
 *
 * Summary:
-*  Performs transition from the main menu to the text page
+*  Screen transition that moves the selection arrow of the main menu upwards
 *
 * Parameters:
+*  screen_t* screen : Screen to be modified
+*
+* Return:
 *  None
 *
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static MoveArrowUp(screen_t* screen)
+{
+    /* If the beginning of the main menu is reached, then move the arrow to the
+       final item of the main menu by selecting the maximum index */
+    if (screen->menuItem == MAIN_MENU_INDEX_START)
+    {
+        screen->menuItem = MAIN_MENU_MAX_INDEX;
+    }
+    /* Otherwise, decrement the index to move the arrow up */
+    else
+    {
+        screen->menuItem--;
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static MoveArrowDown(screen_t* screen)
+********************************************************************************
+*
+* Summary:
+*  Screen transition that moves the selection arrow of the main menu 
+*  downwards
+*
+* Parameters:
+*  screen_t* screen : Screen to be modified
+*
 * Return:
 *  None
 *
@@ -328,54 +674,91 @@ void static NoScreenChange(void)
 *  None
 *
 *******************************************************************************/
-void static GoToTextPage(void)
+void static MoveArrowDown(screen_t* screen)
 {
-    /* Variable that stores the index of the character array, which in turn 
-       stores the current text page as a string */
-    uint8_t currentPageIndex;
-    
-    /* Change the current screen type to text page */
-    currentScreen.screen = TEXT_PAGE;
+    /* If the end of the main menu is reached, then move the arrow to the
+       first item of the main menu by selecting the start index */
+    if (screen->menuItem >= MAIN_MENU_MAX_INDEX)
+    {
+        screen->menuItem = MAIN_MENU_INDEX_START;
+    }
+    /* Otherwise, increment the index to move the arrow down */
+    else
+    {
+        screen->menuItem++;
+    }
+}
 
-    /* Re-initialize the text page index to point to the start page */
-    currentScreen.textPage = TEXT_PAGE_INDEX_START;
-    
-    /* Access the index array and fetch the index of the character array that 
-      stores the current text page as a string */
-    currentPageIndex = textPageIndex[currentScreen.menuItem]
-                                    [currentScreen.textPage];
+/*******************************************************************************
+* Function Name: void static PreviousTextPage(screen_t* screen)
+********************************************************************************
+*
+* Summary:
+*  Screen transition to the previous text page
+*
+* Parameters:
+*  screen_t* screen : Screen to be modified
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static PreviousTextPage(screen_t* screen)
+{
+    /* If the start page is reached, then go to the final page by selecting the 
+       maximum index of the text pages */
+    if (screen->textPage == TEXT_PAGE_INDEX_START)
+    {
+        screen->textPage = maxTextPageIndexes[screen->menuItem];
+    }
+    /* Otherwise, select the previous page by decrementing the index */
+    else
+    {
+        screen->textPage--;
+    }
+}
 
-    /* Check if the fetched index is valid */
-    if (currentPageIndex != INVALID_PAGE_INDEX)
+/*******************************************************************************
+* Function Name: void static NextTextPage(screen_t* screen)
+********************************************************************************
+*
+* Summary:
+*  Screen transition to the next text page
+*
+* Parameters:
+*  screen_t* screen : Screen to be modified
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static NextTextPage(screen_t* screen)
+{
+    /* If the final page is reached, then go to the start page by selecting 
+       the starting index of the text pages */
+    if (screen->textPage >= maxTextPageIndexes[screen->menuItem])
     {
-    	/* Load the screen and font settings */
-    	GUI_SetFont(GUI_FONT_13B_1);
-    	GUI_SetColor(GUI_BLACK);
-    	GUI_SetBkColor(GUI_WHITE);
-    	GUI_SetTextMode(GUI_TM_NORMAL);
-    	GUI_SetTextStyle(GUI_TS_NORMAL);
-
-    	/* Clear the screen */
-    	GUI_Clear();
-
-    	/* Display string inside given margins with word wrap. Margin
-    	   coordinates are selected in such a way that 2 pixels are
-    	   left outside the margins in all 4 dimensions */
-    	GUI_RECT textMargins = {2u, 2u, 262u, 174u};
-    	GUI_DispStringInRectWrap(textPage[currentPageIndex], &textMargins,
-    							 GUI_TA_LEFT, GUI_WRAPMODE_WORD);
-
-    	/* Send the display buffer data to display*/
-    	UpdateDisplay(CY_EINK_FULL_4STAGE, true);
+        screen->textPage = TEXT_PAGE_INDEX_START;
+    }
+     /* Otherwise, select the next page by incrementing the index */
+    else
+    {
+        screen->textPage++;
     }
 }
 
 /*******************************************************************************
-* Function Name: void static GoToMainMenu(void)
+* Function Name: void static DrawMainMenu(void)
 ********************************************************************************
 *
 * Summary:
-*  Enters the main menu from the startup screen or a text page
+*  Draws the main menu with the cursor at the current menu item
 *
 * Parameters:
 *  None
@@ -387,11 +770,8 @@ void static GoToTextPage(void)
 *  None
 *
 *******************************************************************************/
-void static GoToMainMenu(void)
+void static DrawMainMenu(void)
 {
-    /* Change the current screen type to main menu */
-    currentScreen.screen = MAIN_MENU;
-    
     /* Set foreground and background color and font size */
 	GUI_SetColor(GUI_BLACK);
 	GUI_SetBkColor(GUI_WHITE);
@@ -421,17 +801,15 @@ void static GoToMainMenu(void)
 	GUI_DrawLine(5u, 5+vOff, 15u, 15+vOff);
 	GUI_DrawLine(5u, 25+vOff, 15u, 15+vOff);
 	GUI_DrawLine(5u, 5+vOff, 5u, 25+vOff);
-
-	/* Send the display buffer data to display*/
-	UpdateDisplay(CY_EINK_FULL_4STAGE, true);
 }
 
 /*******************************************************************************
-* Function Name: void static MoveArrowUp(void)
+* Function Name: void static ShowMainMenu(void)
 ********************************************************************************
 *
 * Summary:
-*  Moves the selection arrow of the main menu upwards
+*  Draws the main menu with the cursor at the current menu item and sends it 
+*  to the display
 *
 * Parameters:
 *  None
@@ -443,44 +821,22 @@ void static GoToMainMenu(void)
 *  None
 *
 *******************************************************************************/
-void static MoveArrowUp(void)
+void static ShowMainMenu(void)
 {
-    
-    /* If the beginning of the main menu is reached, then move the arrow to the
-       final item of the main menu by selecting the maximum index */
-    if (currentScreen.menuItem == MAIN_MENU_INDEX_START)
-    {
-        currentScreen.menuItem = MAIN_MENU_MAX_INDEX;
-    }
-    /* Otherwise, decrement the index to move the arrow up */
-    else
-    {
-        currentScreen.menuItem--;
-    }
-    
-	/* Clear the cursor area */
-	GUI_SetColor(GUI_WHITE);
-	GUI_FillRect(3u, 4u, 18u, 134u);
-
-	/* Calculate the vertical offset and update the cursor */
-	uint8 vOff;
-	vOff = currentScreen.menuItem*35u;
-	GUI_SetColor(GUI_BLACK);
-	GUI_SetPenSize(4);
-	GUI_DrawLine(5u, 5+vOff, 15u, 15+vOff);
-	GUI_DrawLine(5u, 25+vOff, 15u, 15+vOff);
-	GUI_DrawLine(5u, 5+vOff, 5u, 25+vOff);
+	AcquireDisplayBuffer();
+	DrawMainMenu();
 
 	/* Send the display buffer data to display*/
-	UpdateDisplay(CY_EINK_PARTIAL, true);
+	UpdateDisplay(CY_EINK_AUTO);
 }
 
 /*******************************************************************************
-* Function Name: void static MoveArrowDown(void)
+* Function Name: void static DrawScreen(void)
 ********************************************************************************
 *
 * Summary:
-*  Moves the selection arrow of the main menu downwards
+*  Draws the current screen into the emWin display buffer without sending it
+*  to the display
 *
 * Parameters:
 *  None
@@ -492,43 +848,98 @@ void static MoveArrowUp(void)
 *  None
 *
 *******************************************************************************/
-void static MoveArrowDown(void)
-{ 
-    /* If the final item of the main menu is reached, then move the arrow to the
-       beginning of the main menu by selecting the starting index */
-    if (currentScreen.menuItem >= MAIN_MENU_MAX_INDEX)
+void static DrawScreen(void)
+{
+    if (currentScreen.screen == MAIN_MENU)
     {
-        currentScreen.menuItem = MAIN_MENU_INDEX_START;
+        DrawMainMenu();
     }
-    /* Otherwise, increment the index to move the arrow down */
     else
     {
-        currentScreen.menuItem++;
+        DrawCachedPage(textPageIndex[currentScreen.menuItem]
+                                    [currentScreen.textPage]);
     }
+}
+
+/*******************************************************************************
+* Function Name: bool static IsScreenValid(screen_t const* screen)
+********************************************************************************
+*
+* Summary:
+*  Checks if a stored screen exists in the current menu structure
+*
+* Parameters:
+*  screen_t const* screen : Screen to check
+*
+* Return:
+*  bool : true if the screen can be shown
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+bool static IsScreenValid(screen_t const* screen)
+{
+    bool valid = false;
     
-	/* Clear the cursor area */
-	GUI_SetColor(GUI_WHITE);
-	GUI_FillRect(3u, 4u, 18u, 134u);
+    if (((screen->screen == MAIN_MENU) || (screen->screen == TEXT_PAGE)) &&
+        (screen->menuItem <= MAIN_MENU_MAX_INDEX) &&
+        (screen->textPage <= maxTextPageIndexes[screen->menuItem]))
+    {
+        valid = (screen->screen == MAIN_MENU) ||
+                (textPageIndex[screen->menuItem][screen->textPage] != 
+                 INVALID_PAGE_INDEX);
+    }
+    
+    return valid;
+}
 
-	/* Calculate the vertical offset and update the cursor */
-	uint8 vOff;
-	vOff = currentScreen.menuItem*35u;
-	GUI_SetColor(GUI_BLACK);
-	GUI_SetPenSize(4);
-	GUI_DrawLine(5u, 5+vOff, 15u, 15+vOff);
-	GUI_DrawLine(5u, 25+vOff, 15u, 15+vOff);
-	GUI_DrawLine(5u, 5+vOff, 5u, 25+vOff);
+/*******************************************************************************
+* Function Name: void static ShowMenuCursor(void)
+********************************************************************************
+*
+* Summary:
+*  Moves the cursor of the main menu on the display to the current menu item
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  None
+*
+*******************************************************************************/
+void static ShowMenuCursor(void)
+{
+	/* The cursor is drawn over the main menu on the display */
+	AcquireDisplayBuffer();
+	RestoreDisplayBuffer();
+
+	/* Clear the cursor area and copy the prebuilt arrow to the current menu
+	   item directly in the display buffer, instead of drawing the arrow
+	   line by line with emWin */
+	uint16_t vOff = currentScreen.menuItem * CURSOR_ITEM_SPACING;
+	GUI_Lock();
+	Cy_EINK_RasterFill(LCD_GetDisplayBuffer(), CURSOR_AREA_X0, CURSOR_AREA_Y0,
+					   CURSOR_AREA_X1, CURSOR_AREA_Y1, true);
+	Cy_EINK_RasterCopy(LCD_GetDisplayBuffer(), cursorArrow,
+					   CURSOR_ARROW_LINE_SIZE, CURSOR_AREA_X0,
+					   CURSOR_ARROW_Y0 + vOff, CURSOR_AREA_X1,
+					   CURSOR_ARROW_Y1 + vOff);
+	GUI_Unlock();
 
 	/* Send the display buffer data to display*/
-	UpdateDisplay(CY_EINK_PARTIAL, true);
+	UpdateDisplay(CY_EINK_AUTO);
 }
 
 /*******************************************************************************
-* Function Name: void static PreviousTextPage(void)
+* Function Name: void static ShowTextPage(void)
 ********************************************************************************
 *
 * Summary:
-*  Performs the transition to the previous text page
+*  Draws the current text page and sends it to the display
 *
 * Parameters:
 *  None
@@ -540,25 +951,12 @@ void static MoveArrowDown(void)
 *  None
 *
 *******************************************************************************/
-void static PreviousTextPage(void)
+void static ShowTextPage(void)
 {
-    
     /* Variable that stores the index of the character array, which in turn 
        stores the current text page as a string */
     uint8_t currentPageIndex;
     
-    /* If the start page is reached, then go to the final page by selecting the 
-       maximum index of the text pages */
-    if (currentScreen.textPage == TEXT_PAGE_INDEX_START)
-    {
-        currentScreen.textPage = maxTextPageIndexes[currentScreen.menuItem];
-    }
-    /* Otherwise, select the previous page by decrementing the index */
-    else
-    {
-        currentScreen.textPage--;
-    }
-
     /* Access the index array and fetch the index of the character array that
         stores the current text page as a string */
     currentPageIndex = textPageIndex[currentScreen.menuItem]
@@ -567,86 +965,92 @@ void static PreviousTextPage(void)
     /* Check if the fetched index is valid */
     if (currentPageIndex != INVALID_PAGE_INDEX)
     {
-		/* Load the graphics settings for text pages */
-    	GUI_RECT textMargins = {2u, 2u, 262u, 174u};
-		GUI_SetFont(GUI_FONT_13B_1);
-		GUI_SetColor(GUI_BLACK);
-		GUI_SetBkColor(GUI_WHITE);
-		GUI_SetTextMode(GUI_TM_NORMAL);
-		GUI_SetTextStyle(GUI_TS_NORMAL);
-
-		/* Clear the screen */
-		GUI_Clear();
-
-		/* Display string in middle rectangle with word wrap */
-		GUI_DispStringInRectWrap(textPage[currentPageIndex], &textMargins,
-								 GUI_TA_LEFT, GUI_WRAPMODE_WORD);
+		/* Draw the text page, from the page cache if possible */
+		AcquireDisplayBuffer();
+		DrawCachedPage(currentPageIndex);
 
 		/* Send the display buffer data to display*/
-		UpdateDisplay(CY_EINK_FULL_4STAGE, true);
+		UpdateDisplay(CY_EINK_AUTO);
+
+		/* Render the adjacent pages in the background */
+		PrefetchAdjacentPages();
     }
 }
 
 /*******************************************************************************
-* Function Name: void static NextTextPage(void)
+* Function Name: void static RenderTextPage(uint8_t pageIndex)
 ********************************************************************************
 *
 * Summary:
-*  Performs the transition to the next text page
+*  Renders a text page into the emWin display buffer. Called by the page cache
+*  when the page is not cached.
 *
 * Parameters:
-*  None
+*  uint8_t pageIndex : Index of the character array that stores the text page
 *
 * Return:
 *  None
 *
-* Side Effects:
+*******************************************************************************/
+void static RenderTextPage(uint8_t pageIndex)
+{
+	/* Display string inside given margins with word wrap. Margin
+	   coordinates are selected in such a way that 2 pixels are
+	   left outside the margins in all 4 dimensions */
+	GUI_RECT textMargins = {2u, 2u, 262u, 174u};
+
+	/* Load the screen and font settings */
+	GUI_SetFont(GUI_FONT_13B_1);
+	GUI_SetColor(GUI_BLACK);
+	GUI_SetBkColor(GUI_WHITE);
+	GUI_SetTextMode(GUI_TM_NORMAL);
+	GUI_SetTextStyle(GUI_TS_NORMAL);
+
+	/* Clear the screen */
+	GUI_Clear();
+
+	GUI_DispStringInRectWrap(textPage[pageIndex], &textMargins,
+							 GUI_TA_LEFT, GUI_WRAPMODE_WORD);
+}
+
+/*******************************************************************************
+* Function Name: void static PrefetchAdjacentPages(void)
+********************************************************************************
+*
+* Summary:
+*  Requests the next and the previous text pages of the current page to be
+*  rendered into the page cache by Task_Prefetch, so that a slider flick shows
+*  them without rendering.
+*
+* Parameters:
+*  None
+*
+* Return:
 *  None
 *
 *******************************************************************************/
-void static NextTextPage(void)
+void static PrefetchAdjacentPages(void)
 {
-    /* Variable that stores the index of the character array, which in turn 
-       stores the current text page as a string */
-    uint8_t currentPageIndex;
+    /* Page numbers of the adjacent pages, wrapped around in the same way as
+       NextTextPage and PreviousTextPage */
+    uint8_t adjacentPages[2];
+    uint8_t pageIndex;
+    uint8_t i;
     
-    /* If the final page is reached, then go to the start page by selecting 
-       the starting index of the text pages */
-    if (currentScreen.textPage >= maxTextPageIndexes[currentScreen.menuItem])
-    {
-        currentScreen.textPage = TEXT_PAGE_INDEX_START;
-    }
-     /* Otherwise, select the next page by incrementing the index */
-    else
-    {
-        currentScreen.textPage++;
-    }
-
-    /* Access the index array and fetch the index of the character array that
-        stores the current text page as a string */
-    currentPageIndex = textPageIndex[currentScreen.menuItem]
-                                    [currentScreen.textPage];
+    adjacentPages[0] = (currentScreen.textPage >= 
+                        maxTextPageIndexes[currentScreen.menuItem]) ?
+                        TEXT_PAGE_INDEX_START : (currentScreen.textPage + 1u);
+    adjacentPages[1] = (currentScreen.textPage == TEXT_PAGE_INDEX_START) ?
+                        maxTextPageIndexes[currentScreen.menuItem] :
+                        (currentScreen.textPage - 1u);
     
-    /* Check if the fetched index is valid */
-    if (currentPageIndex != INVALID_PAGE_INDEX)
+    for (i = 0u; i < 2u; i++)
     {
-		/* Load the graphics settings for text pages */
-    	GUI_RECT textMargins = {2u, 2u, 262u, 174u};
-		GUI_SetFont(GUI_FONT_13B_1);
-		GUI_SetColor(GUI_BLACK);
-		GUI_SetBkColor(GUI_WHITE);
-		GUI_SetTextMode(GUI_TM_NORMAL);
-		GUI_SetTextStyle(GUI_TS_NORMAL);
-
-		/* Clear the screen */
-		GUI_Clear();
-
-		/* Display string in middle rectangle with word wrap */
-		GUI_DispStringInRectWrap(textPage[currentPageIndex], &textMargins,
-								 GUI_TA_LEFT, GUI_WRAPMODE_WORD);
-
-		/* Send the display buffer data to display*/
-		UpdateDisplay(CY_EINK_FULL_4STAGE, true);
+        pageIndex = textPageIndex[currentScreen.menuItem][adjacentPages[i]];
+        if (pageIndex != INVALID_PAGE_INDEX)
+        {
+            RequestPrefetch(pageIndex);
+        }
     }
 }
 
@@ -655,7 +1059,9 @@ void static NextTextPage(void)
 ********************************************************************************
 *
 * Summary: This function displays the startup screen with Cypress Logo and
-*            the kit description text
+*            the kit description text. The logo is written from the 
+*            compressed image in flash while the screen is being drawn, and
+*            the text is then added with a partial update.
 *
 * Parameters:
 *  None
@@ -666,6 +1072,9 @@ void static NextTextPage(void)
 *******************************************************************************/
 void static ShowStartupScreen(void)
 {
+    ShowImageAsync(&startupLogoImage, CY_EINK_FULL_4STAGE);
+    AcquireDisplayBuffer();
+    
     /* Set foreground and background color and font size */
     GUI_SetFont(GUI_FONT_16B_1);
     GUI_SetColor(GUI_BLACK);
@@ -679,39 +1088,65 @@ void static ShowStartupScreen(void)
     GUI_SetTextAlign(GUI_TA_HCENTER);
     GUI_DispStringAt("PSoC 6 BLE PIONEER KIT", 132u, 125u);
 
-    /* Send the display buffer data to display*/
-    UpdateDisplay(CY_EINK_FULL_4STAGE, true);
+    /* Send the display buffer data to display. The logo is already on the
+       display, so only the text is written */
+    UpdateDisplay(CY_EINK_AUTO);
 }
 
 /*******************************************************************************
-* Function Name: int8_t static ReadAmbientTemperature(void)
+* Function Name: bool static ReadAmbientTemperature(int8_t* temperature)
 ********************************************************************************
 *
-* Summary: Reads the ambient temperature using thermistor
+* Summary: Reads the ambient temperature using thermistor. The ADC is
+*  initialized on the first call, and is put to deep sleep between readings.
+*  The conversion is polled, so this function must be called from a task that
+*  can wait for it.
 *
 * Parameters:
-*  None
+*  int8_t* temperature : Receives the temperature in degree Celsius, clamped to
+*                        TEMPERATURE_MIN..TEMPERATURE_MAX. The last good 
+*                        reading (or TEMPERATURE_DEFAULT) is returned if the
+*                        readout fails
 *
 * Return:
-*  int8_t : Temperature in degree Celsius
+*  bool : true if the temperature has been read
 *
 *******************************************************************************/
-int8_t static ReadAmbientTemperature(void)
+bool static ReadAmbientTemperature(int8_t* temperature)
 {
 	/* Variables used to store ADC counts, thermistor resistance and
 	the temperature */
 	int16_t countThermistor;
 	int16_t countReference;
 	float rThermistor;
-	float temperature = 0;
-	int8_t tempInt;
+	float reading;
+	bool readingValid = false;
 
 	cy_en_sar_status_t adcStatus;
 
-	/* Initialize and enable the ADC */
-	Cy_SysAnalog_Enable();
-	Cy_SAR_Init(KIT_ADC_HW, &KIT_ADC_config);
-	Cy_SAR_Enable(KIT_ADC_HW);
+	/* Last good temperature reading */
+	static int8_t lastTemperature = TEMPERATURE_DEFAULT;
+
+	/* Flag that indicates if the ADC has been initialized */
+	static bool adcInitialized = false;
+
+	/* Initialize and enable the ADC on the first reading; wake it up from 
+	   deep sleep on the following readings */
+	if(!adcInitialized)
+	{
+		Cy_SysAnalog_Enable();
+		Cy_SAR_Init(KIT_ADC_HW, &KIT_ADC_config);
+		Cy_SAR_Enable(KIT_ADC_HW);
+		adcInitialized = true;
+	}
+	else
+	{
+		Cy_SAR_Wakeup(KIT_ADC_HW);
+
+		/* Power the thermistor circuit again and let it settle */
+		Cy_GPIO_Set(KIT_SAR_A0_PORT,KIT_SAR_A0_NUM);
+		Cy_SysLib_DelayUs(THERMISTOR_SETTLE_TIME);
+	}
 
 	/* Start ADC conversion and wait for the result */
 	Cy_SAR_StartConvert(KIT_ADC_HW, CY_SAR_START_CONVERT_SINGLE_SHOT);
@@ -724,9 +1159,32 @@ int8_t static ReadAmbientTemperature(void)
 		countReference  = Cy_SAR_GetResult16(KIT_ADC_HW, 0u);
 		countThermistor = Cy_SAR_GetResult16(KIT_ADC_HW, 1u);
 
-		/* Calculate the thermistor resistance and the corresponding temperature */
-		rThermistor = (R_REFERENCE*countThermistor)/countReference;
-		temperature = (B_CONSTANT/(logf(rThermistor/R_INFINITY)))+ABSOLUTE_ZERO;
+		/* Calculate the thermistor resistance and the corresponding 
+		   temperature. Counts that give no resistance (open or shorted 
+		   thermistor) are rejected */
+		if((countThermistor > 0) && (countReference > 0))
+		{
+			rThermistor = (R_REFERENCE*countThermistor)/countReference;
+			reading = (B_CONSTANT/(logf(rThermistor/R_INFINITY)))+ABSOLUTE_ZERO;
+			readingValid = isfinite(reading);
+		}
+	}
+
+	if(readingValid)
+	{
+		/* Clamp the reading before it is converted to an integer */
+		if(reading < TEMPERATURE_MIN)
+		{
+			reading = TEMPERATURE_MIN;
+		}
+		else if(reading > TEMPERATURE_MAX)
+		{
+			reading = TEMPERATURE_MAX;
+		}
+		else
+		{
+		}
+		lastTemperature = (int8_t)reading;
 	}
 	else
 	{
@@ -741,12 +1199,47 @@ int8_t static ReadAmbientTemperature(void)
 	/* Clear the GPIO that drives the thermistor circuit's Vdd, to save power */
 	Cy_GPIO_Clr(KIT_SAR_A0_PORT,KIT_SAR_A0_NUM);
 
-	/* Return the temperature value (defaults to 0 if the temperature
-	   readout has failed) */
-	   
-	tempInt =  (int8_t)temperature;
-	
-	return tempInt;
+	/* Return the temperature value, which is the last good reading if the
+	   temperature readout has failed */
+	*temperature = lastTemperature;
+
+	return readingValid;
+}
+
+/*******************************************************************************
+* Function Name: void static Task_Temperature(void *pvParameters)
+********************************************************************************
+*
+* Summary: Task that measures the ambient temperature periodically and adjusts
+*  the E-INK refresh time accordingly. The refresh time is kept if a readout
+*  fails.
+*
+* Parameters:
+*  void *pvParameters : Task parameter defined during task creation (unused)
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void static Task_Temperature(void *pvParameters)
+{
+	/* Ambient temperature in degree Celsius */
+	int8_t ambientTemperature;
+
+	/* Remove warning for unused parameter */
+	(void)pvParameters;
+
+	/* Repeatedly running part of the task */
+	for(;;)
+	{
+		vTaskDelay(TEMPERATURE_SAMPLE_INTERVAL);
+
+		/* Perform temperature compensation of E-INK parameters */
+		if(ReadAmbientTemperature(&ambientTemperature))
+		{
+			Cy_EINK_SetTemperature(ambientTemperature);
+		}
+	}
 }
 
 /* [] END OF FILE */
@@ -55,6 +55,7 @@ Purpose     : Config / System dependent externals for GUI
 **********************************************************************
 */
 static SemaphoreHandle_t _Semaphore;
+static TaskHandle_t      _WaitingTask;
 
 /*********************************************************************
 *
@@ -107,11 +108,40 @@ void GUI_X_ExecIdle(void) {
 *                       #define GUI_OS 1
 *  needs to be in GUIConf.h
 */
-void GUI_X_InitOS(void)    { _Semaphore = xSemaphoreCreateMutex(); }
-void GUI_X_Unlock(void)    { xSemaphoreGive(_Semaphore); }
-void GUI_X_Lock(void)      { xSemaphoreTake(_Semaphore, portMAX_DELAY);  }
+void GUI_X_InitOS(void)    { _Semaphore = xSemaphoreCreateRecursiveMutex(); }
+void GUI_X_Unlock(void)    { xSemaphoreGiveRecursive(_Semaphore); }
+void GUI_X_Lock(void)      { xSemaphoreTakeRecursive(_Semaphore, portMAX_DELAY);  }
 U32  GUI_X_GetTaskId(void) { return (U32)xTaskGetCurrentTaskHandle(); }
 
+/*********************************************************************
+*
+*      Event driving (optional with multitasking)
+*
+*                 GUI_X_WaitEvent()
+*                 GUI_X_WaitEventTimed()
+*                 GUI_X_SignalEvent()
+*
+* Note:
+*   The waiting task blocks on its task notification instead of
+*   polling, and GUI_X_SignalEvent() notifies the last task that
+*   waited. The hooks are registered in GUI_X_Init().
+*/
+void GUI_X_WaitEvent(void) {
+  _WaitingTask = xTaskGetCurrentTaskHandle();
+  (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+void GUI_X_WaitEventTimed(int Period) {
+  _WaitingTask = xTaskGetCurrentTaskHandle();
+  (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Period));
+}
+
+void GUI_X_SignalEvent(void) {
+  if (_WaitingTask != NULL) {
+    xTaskNotifyGive(_WaitingTask);
+  }
+}
+
 /*********************************************************************
 *
 *      Logging: OS dependent
@@ -141,6 +171,9 @@ void GUI_X_ErrorOut(const char *s) { GUI_USE_PARA(s); }
 */
 
 void GUI_X_Init(void) {
+  GUI_SetWaitEventFunc(GUI_X_WaitEvent);
+  GUI_SetWaitEventTimedFunc(GUI_X_WaitEventTimed);
+  GUI_SetSignalEventFunc(GUI_X_SignalEvent);
 }
 
 /*************************** End of file ****************************/
@@ -52,6 +52,8 @@ Purpose     : Display configuration file for GUIDRV_Bitplains to be
 
 #include "GUIDRV_BitPlains.h"
 
+#include "../cy_cy8ckit_028_epd/pervasive_eink_configuration.h"
+
 /*********************************************************************
 *
 *       Layer configuration
@@ -61,9 +63,10 @@ Purpose     : Display configuration file for GUIDRV_Bitplains to be
 //
 // Physical display size
 //
-/* Updated with E-INK display's x and y resolutions */
-#define XSIZE_PHYS 264
-#define YSIZE_PHYS 176
+/* Updated with E-INK display's x and y resolutions, taken from the panel 
+   selected by PV_EINK_PANEL */
+#define XSIZE_PHYS PV_EINK_PANEL_WIDTH
+#define YSIZE_PHYS PV_EINK_PANEL_HEIGHT
 
 //
 // Color conversion
@@ -204,29 +207,48 @@ int LCD_X_DisplayDriver(unsigned LayerIndex, unsigned Cmd, void * pData) {
 }
 /*********************************************************************
 *
-*       LCD_CopyDisplayBuffer
+*       LCD_SwapDisplayBuffer
 *
 * Purpose:
-*   This function has been added to copy the Bitplains buffer
-*   to user memory that can be used to refresh the E-INK
+*   This function has been added to hand the Bitplains buffer over
+*   to the E-INK refresh without copying it. emWin continues drawing
+*   into the new buffer, which must be as large as the display.
+*
+*   The caller must hold the GUI lock (GUI_Lock), so that no other
+*   task draws while the plane is exchanged. Taking the lock may
+*   block, so it must not be taken while the scheduler is suspended.
+*
 * Parameter:
-*   destination - destination memory address
-*   count       - Number of bytes to be copied
-*   pData      - Pointer to a data structure.
+*   newBuffer   - Buffer that emWin draws into from now on
 *
 * Return Value:
-*   < -1 - Error
-*     -1 - The command is not handled.
-*      0 - OK.
+*   Pointer to the buffer that emWin was drawing into
 */
-void LCD_CopyDisplayBuffer(uint8* destination, int count)
+uint8* LCD_SwapDisplayBuffer(uint8* newBuffer)
 {
-	int i;
+	uint8* oldBuffer;
 	
-	/* Copy the Bitplains display buffer to user memory */
-	for(i=0; i<count; i++)
-	{
-		destination[i] = _aPlain_0[i];
-	}
+	/* Exchange the plane and pass the descriptor to the driver again */
+	oldBuffer = _VRAM_Desc.apVRAM[0];
+	_VRAM_Desc.apVRAM[0] = newBuffer;
+	LCD_SetVRAMAddrEx(0, (void *)&_VRAM_Desc);
+	
+	return oldBuffer;
+}
+/*********************************************************************
+*
+*       LCD_GetDisplayBuffer
+*
+* Purpose:
+*   This function has been added to access the Bitplains buffer
+*   that emWin is currently drawing into. The caller must hold the
+*   GUI lock if another task may exchange the buffer.
+*
+* Return Value:
+*   Pointer to the display buffer
+*/
+uint8* LCD_GetDisplayBuffer(void)
+{
+	return _VRAM_Desc.apVRAM[0];
 }
 /*************************** End of file ****************************/
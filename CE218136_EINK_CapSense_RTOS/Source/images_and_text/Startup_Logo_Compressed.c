@@ -0,0 +1,195 @@
+/******************************************************************************
+* Compressed E-INK image startupLogoImage, 264 x 176 pixels, 1730 bytes
+*
+* This file has been generated by the E-INK image converter (Host/) from
+* images/startup_logo.pbm. Do not edit.
+******************************************************************************/
+
+/* Header file includes */
+#include "./cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h"
+
+/* Packets of the image */
+uint8_t static const startupLogoImageData[] =
+{
+    0xC5u, 0xFFu, 0x02u, 0xF0u, 0x00u, 0x7Fu, 0x9Cu, 0xFFu, 0x03u, 0xFEu,
+    0x00u, 0x00u, 0x07u, 0x9Cu, 0xFFu, 0x00u, 0xF0u, 0x82u, 0x00u, 0x9Cu,
+    0xFFu, 0x00u, 0xC0u, 0x82u, 0x00u, 0x00u, 0x1Fu, 0x9Bu, 0xFFu, 0x83u,
+    0x00u, 0x00u, 0x07u, 0x9Au, 0xFFu, 0x00u, 0xFCu, 0x83u, 0x00u, 0x00u,
+    0x01u, 0x9Au, 0xFFu, 0x00u, 0xF0u, 0x84u, 0x00u, 0x9Au, 0xFFu, 0x00u,
+    0xE0u, 0x84u, 0x00u, 0x00u, 0x3Fu, 0x99u, 0xFFu, 0x00u, 0xC0u, 0x84u,
+    0x00u, 0x00u, 0x1Fu, 0x99u, 0xFFu, 0x85u, 0x00u, 0x00u, 0x0Fu, 0x98u,
+    0xFFu, 0x00u, 0xFEu, 0x85u, 0x00u, 0x00u, 0x03u, 0x98u, 0xFFu, 0x00u,
+    0xFCu, 0x85u, 0x00u, 0x00u, 0x01u, 0x98u, 0xFFu, 0x00u, 0xF8u, 0x86u,
+    0x00u, 0x98u, 0xFFu, 0x00u, 0xF0u, 0x86u, 0x00u, 0x00u, 0x7Fu, 0x97u,
+    0xFFu, 0x00u, 0xE0u, 0x86u, 0x00u, 0x00u, 0x7Fu, 0x97u, 0xFFu, 0x00u,
+    0xC0u, 0x86u, 0x00u, 0x00u, 0x3Fu, 0x97u, 0xFFu, 0x00u, 0xC0u, 0x86u,
+    0x00u, 0x00u, 0x1Fu, 0x97u, 0xFFu, 0x00u, 0x80u, 0x86u, 0x00u, 0x00u,
+    0x0Fu, 0x97u, 0xFFu, 0x87u, 0x00u, 0x00u, 0x0Fu, 0x97u, 0xFFu, 0x03u,
+    0x00u, 0x00u, 0x1Fu, 0xFFu, 0x83u, 0x00u, 0x00u, 0x07u, 0x96u, 0xFFu,
+    0x04u, 0xFEu, 0x00u, 0x00u, 0x1Fu, 0xFFu, 0x83u, 0x00u, 0x00u, 0x03u,
+    0x96u, 0xFFu, 0x02u, 0xFEu, 0x00u, 0x03u, 0x82u, 0xFFu, 0x1Du, 0xE0u,
+    0x00u, 0x00u, 0x03u, 0xFFu, 0xFFu, 0x00u, 0x7Fu, 0x81u, 0xFEu, 0x07u,
+    0x80u, 0x01u, 0xFFu, 0xC0u, 0x01u, 0xFFu, 0xE0u, 0x00u, 0x03u, 0xFFu,
+    0x00u, 0x7Fu, 0xFFu, 0x80u, 0x3Fu, 0x0Fu, 0xFCu, 0x00u, 0x03u, 0x82u,
+    0xFFu, 0x1Cu, 0xE0u, 0x00u, 0x00u, 0x01u, 0xFFu, 0xFCu, 0x00u, 0x1Fu,
+    0x80u, 0xFEu, 0x07u, 0x80u, 0x00u, 0x7Fu, 0xC0u, 0x00u, 0x7Fu, 0xE0u,
+    0x00u, 0x03u, 0xFCu, 0x00u, 0x3Fu, 0xFEu, 0x00u, 0x1Eu, 0x8Fu, 0xFCu,
+    0x07u, 0x83u, 0xFFu, 0x1Cu, 0x80u, 0x00u, 0x00u, 0x01u, 0xFFu, 0xF8u,
+    0x00u, 0x0Fu, 0xC0u, 0xFCu, 0x07u, 0x80u, 0x00u, 0x3Fu, 0xC0u, 0x00u,
+    0x1Fu, 0xE0u, 0x00u, 0x03u, 0xF8u, 0x00u, 0x0Fu, 0xFCu, 0x00u, 0x0Eu,
+    0x9Fu, 0xF8u, 0x03u, 0x83u, 0xFFu, 0x00u, 0x80u, 0x82u, 0x00u, 0x19u,
+    0xFFu, 0xF0u, 0x00u, 0x07u, 0xC0u, 0x7Cu, 0x0Fu, 0x80u, 0x00u, 0x1Fu,
+    0xC0u, 0x00u, 0x0Fu, 0xE0u, 0x00u, 0x03u, 0xF0u, 0x00u, 0x07u, 0xF8u,
+    0x00u, 0x07u, 0x0Fu, 0xF8u, 0x00u, 0x1Fu, 0x85u, 0xFFu, 0x1Au, 0xE0u,
+    0xFFu, 0xF0u, 0x00u, 0x07u, 0xC0u, 0x7Cu, 0x0Fu, 0x80u, 0x00u, 0x0Fu,
+    0xC0u, 0x00u, 0x0Fu, 0xE0u, 0x00u, 0x03u, 0xE0u, 0x00u, 0x07u, 0xF0u,
+    0x00u, 0x03u, 0xFFu, 0xF0u, 0x00u, 0x1Fu, 0x85u, 0xFFu, 0x19u, 0xE0u,
+    0xFFu, 0xE0u, 0x00u, 0x03u, 0xE0u, 0x78u, 0x0Fu, 0x80u, 0x00u, 0x0Fu,
+    0xC0u, 0x00u, 0x07u, 0xE0u, 0x00u, 0x03u, 0xE0u, 0x00u, 0x03u, 0xF0u,
+    0x00u, 0x03u, 0xFFu, 0xF0u, 0x7Fu, 0x88u, 0xFFu, 0x17u, 0xE0u, 0x3Eu,
+    0x03u, 0xE0u, 0x38u, 0x1Fu, 0x81u, 0xF8u, 0x07u, 0xC0u, 0xFCu, 0x07u,
+    0xE0u, 0x7Fu, 0xFFu, 0xE0u, 0x3Eu, 0x03u, 0xE0u, 0x3Fu, 0x01u, 0xFFu,
+    0xF0u, 0x7Fu, 0x88u, 0xFFu, 0x14u, 0xE0u, 0x7Fu, 0x03u, 0xE0u, 0x38u,
+    0x1Fu, 0x81u, 0xFCu, 0x07u, 0xC0u, 0xFEu, 0x03u, 0xE0u, 0x7Fu, 0xFFu,
+    0xC0u, 0x7Fu, 0x03u, 0xE0u, 0x3Fu, 0x01u, 0x8Bu, 0xFFu, 0x14u, 0xC0u,
+    0x7Fu, 0x03u, 0xF0u, 0x30u, 0x1Fu, 0x81u, 0xFEu, 0x07u, 0xC0u, 0xFFu,
+    0x03u, 0xE0u, 0x7Fu, 0xFFu, 0xC0u, 0x7Fu, 0x03u, 0xE0u, 0x7Fu, 0x81u,
+    0x8Bu, 0xFFu, 0x14u, 0xC0u, 0x7Fu, 0x03u, 0xF0u, 0x30u, 0x3Fu, 0x81u,
+    0xFEu, 0x07u, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0xFFu, 0xC0u, 0xFFu,
+    0x03u, 0xE0u, 0x7Fu, 0x81u, 0x89u, 0xFFu, 0x16u, 0xF8u, 0x3Fu, 0xC0u,
+    0x7Fu, 0x03u, 0xF8u, 0x10u, 0x3Fu, 0x81u, 0xFEu, 0x07u, 0xC0u, 0xFFu,
+    0x03u, 0xE0u, 0x7Fu, 0xFFu, 0xC0u, 0x7Fu, 0x03u, 0xE0u, 0x7Fu, 0x81u,
+    0x89u, 0xFFu, 0x19u, 0xF8u, 0x3Fu, 0xC0u, 0x7Fu, 0x03u, 0xF8u, 0x00u,
+    0x7Fu, 0x81u, 0xFEu, 0x07u, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0xFFu,
+    0xC0u, 0x7Fu, 0x03u, 0xE0u, 0x3Fu, 0x81u, 0xFFu, 0xE0u, 0x1Fu, 0x86u,
+    0xFFu, 0x19u, 0xFEu, 0x3Fu, 0xC0u, 0x7Fu, 0x03u, 0xF8u, 0x00u, 0x7Fu,
+    0x81u, 0xFEu, 0x07u, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0xFFu, 0xE0u,
+    0x3Fu, 0x83u, 0xE0u, 0x3Fu, 0x81u, 0xFFu, 0xC0u, 0x1Fu, 0x86u, 0xFFu,
+    0x1Au, 0xFEu, 0x3Fu, 0xC0u, 0x7Fu, 0xFFu, 0xFCu, 0x00u, 0x7Fu, 0x81u,
+    0xFEu, 0x07u, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0xFFu, 0xE0u, 0x1Fu,
+    0xFFu, 0xF0u, 0x1Fu, 0xFFu, 0xFFu, 0xC0u, 0x00u, 0x3Fu, 0x85u, 0xFFu,
+    0x1Au, 0xF0u, 0x3Fu, 0xC0u, 0x7Fu, 0xFFu, 0xFCu, 0x00u, 0xFFu, 0x81u,
+    0xFEu, 0x07u, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0xFFu, 0xE0u, 0x0Fu,
+    0xFFu, 0xF0u, 0x07u, 0xFFu, 0xFFu, 0xC0u, 0x00u, 0x3Fu, 0x85u, 0xFFu,
+    0x5Au, 0xF0u, 0x3Fu, 0xC0u, 0x7Fu, 0xFFu, 0xFCu, 0x00u, 0xFFu, 0x81u,
+    0xFEu, 0x07u, 0xC0u, 0xFEu, 0x03u, 0xE0u, 0x7Fu, 0xFFu, 0xF0u, 0x07u,
+    0xFFu, 0xF8u, 0x03u, 0xFFu, 0xFFu, 0xC0u, 0x00u, 0x07u, 0xFFu, 0x80u,
+    0x3Fu, 0xFFu, 0xFFu, 0xF8u, 0x00u, 0x1Fu, 0xC0u, 0x7Fu, 0xFFu, 0xFEu,
+    0x00u, 0xFFu, 0x81u, 0xFCu, 0x07u, 0xC0u, 0xFCu, 0x07u, 0xE0u, 0x00u,
+    0x1Fu, 0xF8u, 0x03u, 0xFFu, 0xFCu, 0x01u, 0xFFu, 0xFFu, 0xC0u, 0x00u,
+    0x07u, 0xFFu, 0x80u, 0x3Fu, 0xFFu, 0xFFu, 0xF8u, 0x00u, 0x1Fu, 0xC0u,
+    0x7Fu, 0xFFu, 0xFEu, 0x01u, 0xFFu, 0x81u, 0xF8u, 0x07u, 0xC0u, 0x00u,
+    0x07u, 0xE0u, 0x00u, 0x1Fu, 0xFCu, 0x01u, 0xFFu, 0xFEu, 0x00u, 0xFFu,
+    0xFFu, 0xC0u, 0x82u, 0x00u, 0x00u, 0x07u, 0x82u, 0xFFu, 0x19u, 0x80u,
+    0xFFu, 0xFFu, 0xC0u, 0x7Fu, 0xFFu, 0xFEu, 0x01u, 0xFFu, 0x80u, 0x00u,
+    0x0Fu, 0xC0u, 0x00u, 0x0Fu, 0xE0u, 0x00u, 0x1Fu, 0xFEu, 0x00u, 0xFFu,
+    0xFFu, 0x00u, 0x7Fu, 0xFFu, 0xC0u, 0x82u, 0x00u, 0x00u, 0x07u, 0x82u,
+    0xFFu, 0x19u, 0x80u, 0xFFu, 0xFFu, 0xC0u, 0x7Fu, 0xFFu, 0xFFu, 0x01u,
+    0xFFu, 0x80u, 0x00u, 0x0Fu, 0xC0u, 0x00u, 0x0Fu, 0xE0u, 0x00u, 0x1Fu,
+    0xFFu, 0x00u, 0x3Fu, 0xFFu, 0x80u, 0x3Fu, 0xFFu, 0xC0u, 0x83u, 0x00u,
+    0x01u, 0x1Eu, 0x00u, 0x83u, 0xFFu, 0x16u, 0xC0u, 0x7Fu, 0xFFu, 0xFFu,
+    0x03u, 0xFFu, 0x80u, 0x00u, 0x1Fu, 0xC0u, 0x00u, 0x1Fu, 0xE0u, 0x00u,
+    0x1Fu, 0xFFu, 0x80u, 0x1Fu, 0xFFu, 0xC0u, 0x0Fu, 0xFFu, 0xC0u, 0x83u,
+    0x00u, 0x01u, 0x0Fu, 0x00u, 0x83u, 0xFFu, 0x16u, 0xC0u, 0x7Fu, 0xFFu,
+    0xFFu, 0x03u, 0xFFu, 0x80u, 0x00u, 0x3Fu, 0xC0u, 0x00u, 0x3Fu, 0xE0u,
+    0x00u, 0x1Fu, 0xFFu, 0xE0u, 0x0Fu, 0xFFu, 0xE0u, 0x0Fu, 0xFFu, 0xC0u,
+    0x83u, 0x00u, 0x1Cu, 0x07u, 0x81u, 0xF8u, 0x00u, 0x00u, 0x3Fu, 0xC0u,
+    0x7Fu, 0xFFu, 0xFFu, 0x03u, 0xFFu, 0x80u, 0x00u, 0x7Fu, 0xC0u, 0x00u,
+    0x3Fu, 0xE0u, 0x7Fu, 0xFFu, 0xFFu, 0xF0u, 0x07u, 0xFFu, 0xF0u, 0x07u,
+    0xFFu, 0xC0u, 0x83u, 0x00u, 0x1Cu, 0x03u, 0xC3u, 0xF0u, 0x00u, 0x00u,
+    0x3Fu, 0xC0u, 0x7Fu, 0xFFu, 0xFFu, 0x03u, 0xFFu, 0x80u, 0x03u, 0xFFu,
+    0xC0u, 0xF0u, 0x3Fu, 0xE0u, 0x7Fu, 0xFFu, 0xFFu, 0xF8u, 0x07u, 0xFFu,
+    0xFCu, 0x03u, 0xFFu, 0xC0u, 0x83u, 0x00u, 0x1Cu, 0x01u, 0xE3u, 0xE0u,
+    0x00u, 0x00u, 0x3Fu, 0xC0u, 0x7Fu, 0xFFu, 0xFFu, 0x03u, 0xFFu, 0x81u,
+    0xFFu, 0xFFu, 0xC0u, 0xF0u, 0x3Fu, 0xE0u, 0x7Fu, 0xFFu, 0xFFu, 0xFCu,
+    0x03u, 0xFFu, 0xFEu, 0x03u, 0xFFu, 0xE0u, 0x83u, 0x00u, 0x1Cu, 0x01u,
+    0xF7u, 0xC0u, 0x00u, 0x00u, 0x3Fu, 0xC0u, 0x7Fu, 0x03u, 0xFFu, 0x03u,
+    0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u, 0xF0u, 0x1Fu, 0xE0u, 0x7Fu, 0xFFu,
+    0xFFu, 0xFEu, 0x03u, 0xFFu, 0xFFu, 0x01u, 0xFFu, 0xE0u, 0x84u, 0x00u,
+    0x1Bu, 0xFFu, 0xC0u, 0x00u, 0x00u, 0x3Fu, 0xC0u, 0x7Fu, 0x03u, 0xFFu,
+    0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u, 0xF8u, 0x1Fu, 0xE0u, 0x7Fu,
+    0xFFu, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0x01u, 0xFFu, 0xE0u, 0x84u,
+    0x00u, 0x1Bu, 0x7Fu, 0x80u, 0x00u, 0x00u, 0x3Fu, 0xC0u, 0x7Fu, 0x03u,
+    0xFFu, 0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u, 0xF8u, 0x1Fu, 0xE0u,
+    0x7Fu, 0xFFu, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0x81u, 0xFFu, 0xE0u,
+    0x84u, 0x00u, 0x00u, 0xFFu, 0x82u, 0x00u, 0x17u, 0x3Fu, 0xC0u, 0x7Fu,
+    0x03u, 0xFFu, 0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u, 0xF8u, 0x1Fu,
+    0xE0u, 0x7Fu, 0xFFu, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x7Fu, 0x81u, 0xFFu,
+    0xE0u, 0x83u, 0x00u, 0x01u, 0x01u, 0xFEu, 0x82u, 0x00u, 0x17u, 0x7Fu,
+    0xC0u, 0x7Fu, 0x03u, 0xFFu, 0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u,
+    0xFCu, 0x0Fu, 0xE0u, 0x7Fu, 0xFFu, 0xC0u, 0x7Fu, 0x03u, 0xE0u, 0x7Fu,
+    0x81u, 0xFFu, 0xF0u, 0x83u, 0x00u, 0x01u, 0x01u, 0xFEu, 0x82u, 0x00u,
+    0x17u, 0x7Fu, 0xE0u, 0x7Fu, 0x03u, 0xFFu, 0x03u, 0xFFu, 0x81u, 0xFFu,
+    0xFFu, 0xC0u, 0xFCu, 0x0Fu, 0xE0u, 0x7Fu, 0xFFu, 0xC0u, 0x7Fu, 0x03u,
+    0xE0u, 0x3Fu, 0x01u, 0xFFu, 0xF0u, 0x83u, 0x00u, 0x01u, 0x03u, 0xFCu,
+    0x82u, 0x00u, 0x17u, 0x7Fu, 0xE0u, 0x3Eu, 0x03u, 0xFFu, 0x03u, 0xFFu,
+    0x81u, 0xFFu, 0xFFu, 0xC0u, 0xFCu, 0x0Fu, 0xE0u, 0x7Fu, 0xFFu, 0xE0u,
+    0x3Eu, 0x03u, 0xE0u, 0x1Fu, 0x01u, 0xFFu, 0xF0u, 0x83u, 0x00u, 0x01u,
+    0x07u, 0xF0u, 0x82u, 0x00u, 0x17u, 0xFFu, 0xE0u, 0x00u, 0x03u, 0xFFu,
+    0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u, 0xFCu, 0x07u, 0xE0u, 0x00u,
+    0x03u, 0xE0u, 0x00u, 0x03u, 0xF0u, 0x00u, 0x03u, 0xFFu, 0xF8u, 0x83u,
+    0x00u, 0x01u, 0x0Fu, 0xE0u, 0x82u, 0x00u, 0x17u, 0xFFu, 0xF0u, 0x00u,
+    0x07u, 0xFFu, 0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u, 0xFEu, 0x07u,
+    0xE0u, 0x00u, 0x03u, 0xE0u, 0x00u, 0x07u, 0xF0u, 0x00u, 0x03u, 0xFFu,
+    0xF8u, 0x83u, 0x00u, 0x01u, 0x0Fu, 0xC0u, 0x82u, 0x00u, 0x17u, 0xFFu,
+    0xF0u, 0x00u, 0x07u, 0xFFu, 0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u,
+    0xFEu, 0x07u, 0xE0u, 0x00u, 0x03u, 0xF0u, 0x00u, 0x0Fu, 0xF8u, 0x00u,
+    0x07u, 0xFFu, 0xFCu, 0x83u, 0x00u, 0x1Cu, 0x1Fu, 0x80u, 0x00u, 0x00u,
+    0x01u, 0xFFu, 0xF8u, 0x00u, 0x0Fu, 0xFFu, 0x03u, 0xFFu, 0x81u, 0xFFu,
+    0xFFu, 0xC0u, 0xFEu, 0x07u, 0xE0u, 0x00u, 0x03u, 0xF8u, 0x00u, 0x0Fu,
+    0xFCu, 0x00u, 0x0Fu, 0xFFu, 0xFCu, 0x83u, 0x00u, 0x1Cu, 0x3Fu, 0x80u,
+    0x00u, 0x00u, 0x01u, 0xFFu, 0xFCu, 0x00u, 0x1Fu, 0xFFu, 0x03u, 0xFFu,
+    0x81u, 0xFFu, 0xFFu, 0xC0u, 0xFEu, 0x03u, 0xE0u, 0x00u, 0x03u, 0xFCu,
+    0x00u, 0x3Fu, 0xFEu, 0x00u, 0x1Fu, 0xFFu, 0xFEu, 0x83u, 0x00u, 0x00u,
+    0x7Fu, 0x82u, 0x00u, 0x18u, 0x03u, 0xFFu, 0xFFu, 0x00u, 0x7Fu, 0xFFu,
+    0x03u, 0xFFu, 0x81u, 0xFFu, 0xFFu, 0xC0u, 0xFFu, 0x03u, 0xE0u, 0x00u,
+    0x03u, 0xFFu, 0x00u, 0x7Fu, 0xFFu, 0x80u, 0x7Fu, 0xFFu, 0xFEu, 0x83u,
+    0x00u, 0x00u, 0x7Eu, 0x82u, 0x00u, 0x00u, 0x03u, 0x97u, 0xFFu, 0x83u,
+    0x00u, 0x00u, 0xFCu, 0x82u, 0x00u, 0x00u, 0x07u, 0x97u, 0xFFu, 0x82u,
+    0x00u, 0x01u, 0x01u, 0xFCu, 0x82u, 0x00u, 0x00u, 0x0Fu, 0x97u, 0xFFu,
+    0x03u, 0x80u, 0x00u, 0x00u, 0x1Fu, 0x9Cu, 0xFFu, 0x03u, 0xC0u, 0x00u,
+    0x00u, 0x1Fu, 0x9Cu, 0xFFu, 0x02u, 0xC0u, 0x00u, 0x07u, 0x9Du, 0xFFu,
+    0x02u, 0xE0u, 0x00u, 0x07u, 0x86u, 0xFFu, 0x15u, 0xE0u, 0x67u, 0x9Cu,
+    0x1Cu, 0x06u, 0x0Fu, 0x07u, 0x03u, 0x03u, 0xF9u, 0x9Cu, 0xFCu, 0x0Eu,
+    0x1Eu, 0x79u, 0xC1u, 0xC0u, 0xE0u, 0x78u, 0x73u, 0x33u, 0xABu, 0x8Au,
+    0xFFu, 0x15u, 0xE0u, 0xE3u, 0x9Cu, 0x0Cu, 0x0Eu, 0x07u, 0x03u, 0x03u,
+    0x01u, 0xF9u, 0x8Cu, 0xFCu, 0x0Cu, 0x4Eu, 0x71u, 0x88u, 0xC0u, 0x60u,
+    0x72u, 0x33u, 0x33u, 0xA3u, 0x8Au, 0xFFu, 0x17u, 0xE7u, 0xE3u, 0x1Cu,
+    0xCCu, 0xFEu, 0xE7u, 0x73u, 0x3Fu, 0x39u, 0xF9u, 0x84u, 0xFFu, 0x3Cu,
+    0xCEu, 0x31u, 0x9Cu, 0xCEu, 0x67u, 0x27u, 0x32u, 0x13u, 0xFFu, 0xFFu,
+    0xFCu, 0x85u, 0x00u, 0x1Au, 0x01u, 0xFFu, 0xFFu, 0xE0u, 0xE1u, 0x1Cu,
+    0x0Cu, 0x1Eu, 0xE7u, 0x73u, 0x07u, 0x39u, 0xF9u, 0x84u, 0xFFu, 0x3Cu,
+    0xEEu, 0x21u, 0x9Cu, 0xCCu, 0x66u, 0x67u, 0x32u, 0x13u, 0xFFu, 0xFFu,
+    0xFEu, 0x85u, 0x00u, 0x17u, 0x03u, 0xFFu, 0xFFu, 0xE0u, 0xE0u, 0x1Cu,
+    0x0Cu, 0x0Eu, 0xE7u, 0x73u, 0x03u, 0x39u, 0xF9u, 0x90u, 0xFFu, 0x3Cu,
+    0xEEu, 0x01u, 0x9Cu, 0xC0u, 0xE0u, 0x67u, 0x38u, 0x07u, 0x82u, 0xFFu,
+    0x85u, 0x00u, 0x17u, 0x0Fu, 0xFFu, 0xFFu, 0xE7u, 0xE4u, 0x1Cu, 0xCCu,
+    0xFEu, 0xE7u, 0x73u, 0x3Fu, 0x39u, 0xF9u, 0x90u, 0xFFu, 0x3Cu, 0xEEu,
+    0x09u, 0x9Cu, 0xC9u, 0xE4u, 0xE7u, 0x38u, 0xC7u, 0x82u, 0xFFu, 0x00u,
+    0xC0u, 0x84u, 0x00u, 0x17u, 0x1Fu, 0xFFu, 0xFFu, 0xE7u, 0xE4u, 0x9Cu,
+    0xCCu, 0xFEu, 0xE7u, 0x73u, 0x3Fu, 0x39u, 0xF9u, 0x98u, 0xFFu, 0x3Cu,
+    0xCEu, 0x49u, 0x9Cu, 0xCCu, 0xE6u, 0x73u, 0x38u, 0xC7u, 0x82u, 0xFFu,
+    0x00u, 0xE0u, 0x84u, 0x00u, 0x17u, 0x3Fu, 0xFFu, 0xFFu, 0xE0u, 0x67u,
+    0x9Cu, 0x0Cu, 0x0Eu, 0x07u, 0x03u, 0x03u, 0x01u, 0xF9u, 0x9Cu, 0xFFu,
+    0x3Cu, 0x0Eu, 0x79u, 0xC1u, 0xCCu, 0xE6u, 0x70u, 0x38u, 0xC7u, 0x82u,
+    0xFFu, 0x00u, 0xF0u, 0x84u, 0x00u, 0x82u, 0xFFu, 0x14u, 0xE0u, 0x67u,
+    0x9Cu, 0x1Eu, 0x0Eu, 0x0Fu, 0x0Fu, 0x03u, 0x87u, 0xF9u, 0x9Cu, 0xFFu,
+    0x3Eu, 0x1Eu, 0xF9u, 0xE3u, 0xCEu, 0x67u, 0x38u, 0x7Du, 0xEFu, 0x82u,
+    0xFFu, 0x00u, 0xFCu, 0x83u, 0x00u, 0x00u, 0x01u, 0x9Bu, 0xFFu, 0x83u,
+    0x00u, 0x00u, 0x07u, 0x9Bu, 0xFFu, 0x00u, 0xC0u, 0x82u, 0x00u, 0x00u,
+    0x1Fu, 0x9Bu, 0xFFu, 0x00u, 0xF0u, 0x82u, 0x00u, 0x9Cu, 0xFFu, 0x03u,
+    0xFEu, 0x00u, 0x00u, 0x07u, 0x9Du, 0xFFu, 0x02u, 0xF0u, 0x00u, 0x7Fu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+    0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xB7u, 0xFFu
+};
+
+/* Compressed image */
+cy_eink_compressed_image_t const startupLogoImage =
+{
+    startupLogoImageData, (uint16_t)sizeof(startupLogoImageData), NULL
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,213 @@
+/******************************************************************************
+* File Name: latency_trace.c
+*
+* Version: 1.00
+*
+* Description: This file contains the functions that record and print the
+*              latency trace
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* See latency_trace.h header for options to enable or disable the latency 
+* trace
+*******************************************************************************/
+
+/* Header file includes */
+#include "latency_trace.h"
+
+#if (LATENCY_TRACE_ENABLE)
+
+/* Number of time stamp counts per microsecond */
+#define TRACE_COUNTS_PER_US     (SystemCoreClock / 1000000u)
+
+/* Data-type of an entry of the trace. The sequence number is written last, so
+   that entries that are being written are not printed */
+typedef struct
+{
+    uint32_t        time;
+    trace_event_t   event;
+    volatile uint32_t sequence;
+}   trace_entry_t;
+
+/* Ring buffer of the trace, the sequence number of the next entry to be 
+   written and of the next entry to be printed */
+trace_entry_t static traceBuffer[TRACE_BUFFER_SIZE];
+uint32_t static volatile traceWriteSequence = 0u;
+uint32_t static traceReadSequence = 0u;
+
+/* Time stamp of the last event printed, so that the latency of the first 
+   event of a dump is measured from the last event of the previous dump */
+uint32_t static tracePreviousTime;
+bool static tracePreviousValid = false;
+
+/* Names of the events, in the order of trace_event_t */
+char const static * const traceEventName[TRACE_EVENT_COUNT] =
+{
+    "scan complete",
+    "gesture decoded",
+    "touch sent",
+    "touch received",
+    "render done",
+    "refresh start",
+    "refresh end"
+};
+
+/*******************************************************************************
+* Function Name: void InitTrace(void)
+********************************************************************************
+* Summary:
+*  Starts the CPU cycle counter used as the time stamp of the events
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void InitTrace(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*******************************************************************************
+* Function Name: uint32_t GetTraceTime(void)
+********************************************************************************
+* Summary:
+*  Returns the current time stamp
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t : CPU cycle count
+*
+*******************************************************************************/
+uint32_t GetTraceTime(void)
+{
+    return (DWT->CYCCNT);
+}
+
+/*******************************************************************************
+* Function Name: void RecordTraceEvent(trace_event_t event, uint32_t time)
+********************************************************************************
+* Summary:
+*  Stores an event in the ring buffer. The entry is reserved with exclusive
+*  accesses, so events can be recorded from any task or ISR without locking.
+*  The oldest entries are overwritten if the trace is not printed.
+*
+* Parameters:
+*  trace_event_t event : Event to be recorded
+*  uint32_t time       : Time stamp of the event
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void RecordTraceEvent(trace_event_t event, uint32_t time)
+{
+    uint32_t sequence;
+    trace_entry_t* entry;
+
+    /* Reserve the next entry */
+    do
+    {
+        sequence = __LDREXW((uint32_t*)&traceWriteSequence);
+    }
+    while (__STREXW(sequence + 1u, (uint32_t*)&traceWriteSequence) != 0u);
+
+    entry = &traceBuffer[sequence & (TRACE_BUFFER_SIZE - 1u)];
+    entry->time  = time;
+    entry->event = event;
+    entry->sequence = sequence;
+}
+
+/*******************************************************************************
+* Function Name: void DumpTraceEvents(void)
+********************************************************************************
+* Summary:
+*  Prints the events recorded since the last dump, with the time of each event
+*  and the time elapsed since the previous event in microseconds. Uses 
+*  DebugPrintf, so it must only be called from the task that owns the UART
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void DumpTraceEvents(void)
+{
+    uint32_t writeSequence = traceWriteSequence;
+    trace_entry_t* entry;
+
+    /* Skip the entries that have been overwritten */
+    if ((writeSequence - traceReadSequence) > TRACE_BUFFER_SIZE)
+    {
+        DebugPrintf("Trace    : %"PRIu32" events lost \r\n",
+                    writeSequence - traceReadSequence - TRACE_BUFFER_SIZE);
+        traceReadSequence = writeSequence - TRACE_BUFFER_SIZE;
+    }
+
+    for (; traceReadSequence != writeSequence; traceReadSequence++)
+    {
+        entry = &traceBuffer[traceReadSequence & (TRACE_BUFFER_SIZE - 1u)];
+
+        /* Skip the entries that are still being written or have been 
+           overwritten meanwhile */
+        if (entry->sequence != traceReadSequence)
+        {
+            continue;
+        }
+
+        DebugPrintf("Trace    : %-16s %10"PRIu32" us +%10"PRIu32" us \r\n",
+                    traceEventName[entry->event],
+                    entry->time / TRACE_COUNTS_PER_US,
+                    tracePreviousValid ? 
+                    ((entry->time - tracePreviousTime) / TRACE_COUNTS_PER_US) :
+                    0u);
+        tracePreviousTime = entry->time;
+        tracePreviousValid = true;
+    }
+}
+
+#endif /* LATENCY_TRACE_ENABLE */
+
+/* [] END OF FILE */
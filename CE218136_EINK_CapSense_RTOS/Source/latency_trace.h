@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name: latency_trace.h
+*
+* Version: 1.00
+*
+* Description: This file contains the macros that are used for latency 
+*              tracing
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*                      CY8CKIT-028-EPD E-INK Display Shield
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* This file contains the macros that record the time of the events between a
+* touch and the end of the E-INK refresh that it causes. The events are stored
+* in a ring buffer and printed over UART by the debug task, which is the only
+* task that uses the UART. Each line of the dump shows the time of the event 
+* and the time elapsed since the previous event, which is the latency of that
+* stage. Host/trace_histogram.py groups the events of a captured log per touch
+* and prints a latency histogram of each stage.
+*
+* Tracing requires UART based debug; see uart_debug.h header for the settings
+* of the serial port terminal emulator.
+*******************************************************************************/
+
+/* Include guard */
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+/* Header file includes */
+#include "uart_debug.h"
+
+/* (true) enables latency tracing and (false) disables it. Note that enabling
+   tracing makes the debug task wake up periodically to print the trace */
+#define LATENCY_TRACE_ENABLE    (false)
+
+/* Events recorded by the latency trace */
+typedef enum
+{
+    TRACE_SCAN_COMPLETE,
+    TRACE_GESTURE_DECODED,
+    TRACE_TOUCH_SENT,
+    TRACE_TOUCH_RECEIVED,
+    TRACE_RENDER_DONE,
+    TRACE_REFRESH_START,
+    TRACE_REFRESH_END,
+    TRACE_EVENT_COUNT
+}   trace_event_t;
+
+#if (LATENCY_TRACE_ENABLE)
+
+#if !(UART_DEBUG_ENABLE)
+    #error "Latency tracing requires UART based debug (UART_DEBUG_ENABLE)"
+#endif
+
+    /* Number of events stored in the ring buffer. Must be a power of 2 */
+    #define TRACE_BUFFER_SIZE   (128u)
+
+    /* Starts the time stamp counter */
+    #define TraceInit()                 (InitTrace())
+    /* Returns the current time stamp */
+    #define TraceTime()                 (GetTraceTime())
+    /* Records an event with the current time stamp */
+    #define TraceEvent(event)           (RecordTraceEvent(event, GetTraceTime()))
+    /* Records an event with a time stamp read earlier with TraceTime() */
+    #define TraceEventAt(event, time)   (RecordTraceEvent(event, time))
+    /* Prints the events recorded since the last dump. Not thread-safe with 
+       other UART output: only called from the debug task */
+    #define TraceDump()                 (DumpTraceEvents())
+
+    /* Functions used by the tracing macros */
+    void     InitTrace(void);
+    uint32_t GetTraceTime(void);
+    void     RecordTraceEvent(trace_event_t event, uint32_t time);
+    void     DumpTraceEvents(void);
+
+/* Declaration of empty or default value macros if tracing is not enabled for
+   efficient code generation */
+#else
+    #define TraceInit()
+    #define TraceTime()                 (0u)
+    #define TraceEvent(event)
+    #define TraceEventAt(event, time)   ((void)(time))
+    #define TraceDump()
+
+#endif /* LATENCY_TRACE_ENABLE */
+
+#endif /* LATENCY_TRACE_H */
+/* [] END OF FILE */
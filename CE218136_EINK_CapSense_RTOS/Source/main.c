@@ -64,18 +64,26 @@
 #include "cycfg.h"
 #include "touch_task.h"
 #include "display_task.h"
+#include "refresh_task.h"
+#include "page_cache.h"
 #include "uart_debug.h"
+#include "latency_trace.h"
 
 /* Priorities of user tasks in this project */
 #define TASK_TOUCH_PRIORITY         (10u)
 #define TASK_DISPLAY_PRIORITY       (5u)
+#define TASK_REFRESH_PRIORITY       (4u)
+#define TASK_PREFETCH_PRIORITY      (3u)
 
 /* Stack sizes of user tasks in this project */
 #define TASK_DISPLAY_STACK_SIZE     (1536u)
 #define TASK_TOUCH_STACK_SIZE       (configMINIMAL_STACK_SIZE)
+#define TASK_REFRESH_STACK_SIZE     (configMINIMAL_STACK_SIZE * 2u)
+#define TASK_PREFETCH_STACK_SIZE    (768u)
 
 /* Queue lengths of message queues used in this project */
-#define TOUCH_ELEMENT_QUEUE_LEN     (1u)
+#define TOUCH_ELEMENT_QUEUE_LEN     (8u)
+#define PREFETCH_REQUEST_QUEUE_LEN  (2u)
 
 /* API to initialize system components */
 void InitializeSystem(void);
@@ -104,6 +112,8 @@ int main()
 	/* Create the queues. See the respective data-types for details of queue
        contents */
     touchDataQ = xQueueCreate(TOUCH_ELEMENT_QUEUE_LEN, sizeof(touch_data_t));
+    prefetchRequestQ = xQueueCreate(PREFETCH_REQUEST_QUEUE_LEN, 
+                                    sizeof(uint8_t));
 
     /* Create the user tasks. See the respective Task definition for more
        details of these tasks */
@@ -111,11 +121,19 @@ int main()
                 NULL, TASK_TOUCH_PRIORITY, NULL);
     xTaskCreate(Task_Display, "Display task", TASK_DISPLAY_STACK_SIZE,
                 NULL, TASK_DISPLAY_PRIORITY, NULL);
+    xTaskCreate(Task_Refresh, "Refresh task", TASK_REFRESH_STACK_SIZE,
+                NULL, TASK_REFRESH_PRIORITY, NULL);
+    xTaskCreate(Task_Prefetch, "Prefetch task", TASK_PREFETCH_STACK_SIZE,
+                NULL, TASK_PREFETCH_PRIORITY, NULL);
 
     /* Initialize thread-safe debug message printing. See uart_debug.h header file
        to enable / disable this feature */
     Task_DebugInit();
 
+    /* Start the time stamps of the latency trace. See latency_trace.h header
+       file to enable / disable this feature */
+    TraceInit();
+
     /* Start the RTOS scheduler. This function should never return */
     vTaskStartScheduler();
 
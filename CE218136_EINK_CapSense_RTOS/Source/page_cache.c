@@ -0,0 +1,316 @@
+/******************************************************************************
+* File Name: page_cache.c
+*
+* Version: 1.00
+*
+* Description: This file contains the cache of rendered text pages used by
+*              the display task
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*                      CY8CKIT-028-EPD E-INK Display Shield
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+/*******************************************************************************
+* This file contains the cache of rendered text pages. Rendering a text page
+* with emWin runs the word wrap and rasterizes every glyph of the page. The 
+* cache keeps the rendered frames of the most recently used pages, so that a
+* revisited page is copied to the emWin display buffer without rendering it
+* again. The least recently used page is replaced when the cache is full.
+*
+* Pages can also be rendered in advance (prefetched) into the cache without
+* affecting the emWin display buffer. Task_Prefetch renders the requested pages
+* in the background while Task_Display drives the display. The cache and the
+* emWin display buffer are shared by both tasks, so they are only accessed
+* while the emWin lock is held.
+*******************************************************************************/
+
+/* Header file includes */
+#include "page_cache.h"
+#include "GUI.h"
+#include <string.h>
+
+/* Queue handle for requesting prefetched pages */
+QueueHandle_t prefetchRequestQ;
+
+/* Data-type of a cache entry: the rendered frame, the page stored in it and
+   the time of its last use */
+typedef struct
+{
+    cy_eink_frame_t frame[CY_EINK_FRAME_SIZE];
+    uint8_t         pageIndex;
+    uint32_t        lastUsed;
+}   page_cache_entry_t;
+
+/* Cache entries */
+page_cache_entry_t static pageCache[PAGE_CACHE_ENTRIES];
+
+/* Counter used to order the entries by their last use */
+uint32_t static useCounter = 0u;
+
+/* Function that renders a page with emWin */
+page_render_function_t static renderPage = NULL;
+
+/* emWin function hooks to access and exchange the display buffer */
+extern uint8* LCD_GetDisplayBuffer(void);
+extern uint8* LCD_SwapDisplayBuffer(uint8* newBuffer);
+
+/*  These static functions are not available outside this file. 
+    See the respective function definitions for more details */
+page_cache_entry_t static* FindCachedPage(uint8_t pageIndex);
+page_cache_entry_t static* ReplaceCachedPage(uint8_t pageIndex);
+
+/*******************************************************************************
+* Function Name: void InitPageCache(page_render_function_t renderFunction)
+********************************************************************************
+* Summary:
+*  Empties the page cache and registers the function that renders a page 
+*  with emWin
+*
+* Parameters:
+*  page_render_function_t renderFunction : Function that draws a complete 
+*                                          page into the emWin display buffer
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void InitPageCache(page_render_function_t renderFunction)
+{
+    uint8_t i;
+    
+    for (i = 0u; i < PAGE_CACHE_ENTRIES; i++)
+    {
+        pageCache[i].pageIndex = PAGE_CACHE_EMPTY;
+        pageCache[i].lastUsed  = 0u;
+    }
+    
+    renderPage = renderFunction;
+}
+
+/*******************************************************************************
+* Function Name: void DrawCachedPage(uint8_t pageIndex)
+********************************************************************************
+* Summary:
+*  Draws a page into the emWin display buffer. A cached page is copied from
+*  the cache; otherwise the page is rendered with emWin and added to the cache.
+*
+* Parameters:
+*  uint8_t pageIndex : Index of the page to draw
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void DrawCachedPage(uint8_t pageIndex)
+{
+    page_cache_entry_t* entry;
+    
+    GUI_Lock();
+    entry = FindCachedPage(pageIndex);
+    if (entry != NULL)
+    {
+        /* Skip emWin: copy the rendered page */
+        memcpy(LCD_GetDisplayBuffer(), entry->frame, CY_EINK_FRAME_SIZE);
+    }
+    else
+    {
+        /* Render the page and keep a copy of it */
+        renderPage(pageIndex);
+        entry = ReplaceCachedPage(pageIndex);
+        memcpy(entry->frame, LCD_GetDisplayBuffer(), CY_EINK_FRAME_SIZE);
+    }
+    
+    /* Mark the page as the most recently used */
+    entry->lastUsed = ++useCounter;
+    GUI_Unlock();
+}
+
+/*******************************************************************************
+* Function Name: void PrefetchPage(uint8_t pageIndex)
+********************************************************************************
+* Summary:
+*  Renders a page into the cache if it is not already cached. The page is 
+*  rendered directly into its cache entry, so the emWin display buffer is not 
+*  modified.
+*
+* Parameters:
+*  uint8_t pageIndex : Index of the page to prefetch
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  The least recently used page is removed from the cache if the cache is full
+*
+*******************************************************************************/
+void PrefetchPage(uint8_t pageIndex)
+{
+    page_cache_entry_t* entry;
+    uint8*              displayBuffer;
+    
+    /* The entry is assigned and rendered under the same lock, so that the
+       other task never finds a partially rendered page */
+    GUI_Lock();
+    if (FindCachedPage(pageIndex) == NULL)
+    {
+        entry = ReplaceCachedPage(pageIndex);
+        
+        /* Let emWin draw into the cache entry, and then restore the display
+           buffer */
+        displayBuffer = LCD_SwapDisplayBuffer(entry->frame);
+        renderPage(pageIndex);
+        LCD_SwapDisplayBuffer(displayBuffer);
+    }
+    GUI_Unlock();
+}
+
+/*******************************************************************************
+* Function Name: void RequestPrefetch(uint8_t pageIndex)
+********************************************************************************
+* Summary:
+*  Requests Task_Prefetch to render a page into the cache. The request is 
+*  dropped if the request queue is full.
+*
+* Parameters:
+*  uint8_t pageIndex : Index of the page to prefetch
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void RequestPrefetch(uint8_t pageIndex)
+{
+    xQueueSend(prefetchRequestQ, &pageIndex, 0u);
+}
+
+/*******************************************************************************
+* Function Name: void Task_Prefetch (void *pvParameters)
+********************************************************************************
+* Summary:
+*  Task that renders the requested pages into the cache. This task runs at a
+*  lower priority than Task_Display, so pages are rendered only while 
+*  Task_Display is waiting for a touch input or for the display refresh.
+*
+* Parameters:
+*  void* pvParameters : Not used
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Task_Prefetch (void *pvParameters)
+{
+    uint8_t pageIndex;
+    
+    /* Remove warning for unused parameter */
+    (void)pvParameters ;
+    
+    /* Repeatedly running part of the task */
+    for(;;)
+    {
+        /* Block until a page has been requested */
+        if (xQueueReceive(prefetchRequestQ, &pageIndex, portMAX_DELAY) == 
+            pdTRUE)
+        {
+            PrefetchPage(pageIndex);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: page_cache_entry_t static* FindCachedPage(uint8_t pageIndex)
+********************************************************************************
+* Summary:
+*  Looks up a page in the cache
+*
+* Parameters:
+*  uint8_t pageIndex : Index of the page
+*
+* Return:
+*  page_cache_entry_t* : Cache entry of the page, or NULL if it isn't cached
+*
+*******************************************************************************/
+page_cache_entry_t static* FindCachedPage(uint8_t pageIndex)
+{
+    page_cache_entry_t* entry = NULL;
+    uint8_t i;
+    
+    for (i = 0u; i < PAGE_CACHE_ENTRIES; i++)
+    {
+        if (pageCache[i].pageIndex == pageIndex)
+        {
+            entry = &pageCache[i];
+            break;
+        }
+    }
+    
+    return entry;
+}
+
+/*******************************************************************************
+* Function Name: page_cache_entry_t static* ReplaceCachedPage(
+*                                                       uint8_t pageIndex)
+********************************************************************************
+* Summary:
+*  Selects the least recently used cache entry, or an empty one, to store a 
+*  new page
+*
+* Parameters:
+*  uint8_t pageIndex : Index of the new page
+*
+* Return:
+*  page_cache_entry_t* : Cache entry assigned to the page
+*
+*******************************************************************************/
+page_cache_entry_t static* ReplaceCachedPage(uint8_t pageIndex)
+{
+    page_cache_entry_t* entry = &pageCache[0];
+    uint8_t i;
+    
+    /* Empty entries have never been used, so they are selected first */
+    for (i = 1u; i < PAGE_CACHE_ENTRIES; i++)
+    {
+        if (pageCache[i].lastUsed < entry->lastUsed)
+        {
+            entry = &pageCache[i];
+        }
+    }
+    
+    entry->pageIndex = pageIndex;
+    entry->lastUsed  = ++useCounter;
+    
+    return entry;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name: page_cache.h
+*
+* Version: 1.00
+*
+* Description: This file is the public interface of page_cache.c source file
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*                      CY8CKIT-028-EPD E-INK Display Shield
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* This file contains the declaration of the functions used to draw text pages
+* from the cache of rendered pages
+*******************************************************************************/
+
+/* Include guard */
+#ifndef PAGE_CACHE_H
+#define PAGE_CACHE_H
+
+/* Header file includes */
+#include "./cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* RAM used to store the rendered pages, and the resulting number of pages in
+   the cache */
+#define PAGE_CACHE_RAM_BUDGET   (uint32_t)(24u * 1024u)
+#define PAGE_CACHE_ENTRIES      (uint8_t)(PAGE_CACHE_RAM_BUDGET / \
+                                          CY_EINK_FRAME_SIZE)
+
+/* Page index of an empty cache entry */
+#define PAGE_CACHE_EMPTY        (uint8_t)(0xFFu)
+
+/* Function prototype that draws a complete page into the emWin display 
+   buffer */
+typedef void (* page_render_function_t) (uint8_t pageIndex);
+
+/* Empty the cache and register the function that renders the pages */
+void InitPageCache(page_render_function_t renderFunction);
+
+/* Draw a page into the emWin display buffer, from the cache if possible */
+void DrawCachedPage(uint8_t pageIndex);
+
+/* Render a page into the cache without drawing it */
+void PrefetchPage(uint8_t pageIndex);
+
+/* Queue handle for requesting prefetched pages */
+extern QueueHandle_t prefetchRequestQ;
+
+/* Request a page to be rendered into the cache by Task_Prefetch */
+void RequestPrefetch(uint8_t pageIndex);
+
+/* Task_Prefetch renders the requested pages into the cache in the 
+   background */
+void Task_Prefetch(void *pvParameters);
+
+#endif /* PAGE_CACHE_H */
+/* [] END OF FILE */
@@ -0,0 +1,643 @@
+/******************************************************************************
+* File Name: refresh_task.c
+*
+* Version: 1.00
+*
+* Description: This file contains the task that writes frames to the E-INK
+*              display in the background
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*                      CY8CKIT-028-EPD E-INK Display Shield
+*
+******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+/*******************************************************************************
+* This file contains the task that refreshes the E-INK display with the frames
+* submitted by the display task. A frame is submitted with RefreshDisplayAsync,
+* which returns immediately so that the display task can keep processing touch
+* inputs while the display is being refreshed. If more frames are submitted 
+* while a refresh is in progress, only the latest one is shown once the
+* refresh has finished.
+*
+* Frames are never copied on submission. The emWin display buffer itself is
+* handed over to this task, and AcquireDisplayBuffer gives it back for drawing
+* the next frame. A frame that has not been picked up yet is taken back and
+* drawn over, which replaces it; otherwise emWin is given a free buffer, which
+* only receives a copy of the submitted frame when the next frame is drawn over
+* it (see RestoreDisplayBuffer). The emWin display buffer and two frame buffers
+* cover the frame on the display, the frame being written and the frame being
+* drawn, which is the same SRAM as the emWin buffer and the two copies made
+* before the asynchronous refresh.
+*
+* A compressed image in flash can also be written with ShowImageAsync, before
+* any frame is submitted. The image is written ahead of the pending frame, and
+* is decoded into the frame on the display so that the next frame can be a
+* partial update.
+*
+* The display stays powered between refreshes that follow each other within
+* REFRESH_POWER_IDLE_TIME, so a burst of screen changes runs the power on and 
+* power off sequences only once. The display is powered off when no frame has
+* been submitted during that time.
+*******************************************************************************/
+
+/* Header file includes */
+#include "refresh_task.h"
+#include "uart_debug.h"
+#include "latency_trace.h"
+#include "cycfg.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "GUI.h"
+#include <string.h>
+
+/* Number of frame buffers in addition to the emWin display buffer: together
+   they hold the frame on the display, the frame being written to the display
+   and the frame being drawn */
+#define NUMBER_OF_FRAME_BUFFERS     (2u)
+#define NUMBER_OF_FRAMES            (NUMBER_OF_FRAME_BUFFERS + 1u)
+
+/* Frame buffers used by the display update functions */
+cy_eink_frame_t static  frameBuffers[NUMBER_OF_FRAME_BUFFERS]
+                                    [CY_EINK_FRAME_SIZE];
+
+/* All the frames, including the emWin display buffer, which is added when
+   the first frame is drawn */
+cy_eink_frame_t static* frames[NUMBER_OF_FRAMES] =
+{
+    frameBuffers[0], frameBuffers[1], NULL
+};
+
+/* Frame roles. The frames are exchanged by swapping these pointers. The 
+   current frame is NULL when no refresh is in progress, and the pending frame
+   is always the frame in the emWin display buffer */
+cy_eink_frame_t static* pendingFrame  = NULL;
+cy_eink_frame_t static* currentFrame  = NULL;
+cy_eink_frame_t static* previousFrame = frameBuffers[0];
+
+/* Buffer that emWin is drawing into, the frame that was submitted last, and
+   the flag that indicates that the drawing buffer does not hold that frame */
+cy_eink_frame_t static* drawFrame      = NULL;
+cy_eink_frame_t static* submittedFrame = NULL;
+bool static             drawFrameStale = false;
+
+/* Update type of the pending frame, and the flag that indicates that a frame 
+   has been submitted but not yet picked up by the refresh task */
+cy_eink_update_t static pendingUpdate;
+bool static             framePending = false;
+
+/* Compressed image that is waiting to be written before the pending frame,
+   and its update type */
+cy_eink_compressed_image_t const static* pendingImage = NULL;
+cy_eink_update_t static pendingImageUpdate;
+
+/* Flag that indicates that the pending frame has been taken back to be drawn
+   over, and the update type that it was submitted with */
+bool static             frameReclaimed = false;
+cy_eink_update_t static reclaimedUpdate;
+
+/* Flag that indicates that the display is powered. The display task powers
+   the display on to detect it, and it is powered off after the idle time like
+   after a refresh */
+bool static             displayPowered = true;
+
+/* Handle of the refresh task, used to notify it of new frames */
+TaskHandle_t static     refreshTaskHandle = NULL;
+
+/* Function called when a refresh has finished */
+refresh_complete_function_t static refreshComplete = NULL;
+
+/* emWin function hooks to access and exchange the display buffer */
+extern uint8* LCD_GetDisplayBuffer(void);
+extern uint8* LCD_SwapDisplayBuffer(uint8* newBuffer);
+
+/*  These static functions are not available outside this file. 
+    See the respective function definitions for more details */
+cy_eink_update_t static MergeUpdateTypes(cy_eink_update_t pendingType,
+                                         cy_eink_update_t newType);
+void static InitDisplayBuffer(void);
+void static WriteImage(cy_eink_compressed_image_t const* image,
+                       cy_eink_update_t updateType);
+
+/*******************************************************************************
+* Function Name: void Task_Refresh (void *pvParameters)
+********************************************************************************
+* Summary:
+*  Task that writes the latest submitted frame to the E-INK display, using the
+*  frame that is currently on the display as the previous frame. A pending
+*  compressed image is written first.
+*
+* Parameters:
+*  void *pvParameters : Task parameter defined during task creation (unused)                            
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Task_Refresh (void *pvParameters)
+{
+    /* Variables that store the details of the frame being written */
+    cy_eink_update_t updateType = CY_EINK_FULL_4STAGE;
+    bool             refreshRequested;
+    
+    /* Compressed image being written, or NULL when a frame is written */
+    cy_eink_compressed_image_t const* image;
+    
+    /* Remove warning for unused parameter */
+    (void)pvParameters ;
+    
+    /* Store the task handle so that new frames can notify this task */
+    refreshTaskHandle = xTaskGetCurrentTaskHandle();
+    
+    /* Repeatedly running part of the task */
+    for(;;)
+    {
+        /* Pick up the pending image or else the pending frame, if any. The
+           scheduler is suspended so that the frame is not being submitted or
+           taken back while the frames are exchanged */
+        vTaskSuspendAll();
+        image            = pendingImage;
+        pendingImage     = NULL;
+        refreshRequested = (image != NULL) || framePending;
+        if (image != NULL)
+        {
+            updateType   = pendingImageUpdate;
+        }
+        else if (framePending)
+        {
+            currentFrame = pendingFrame;
+            updateType   = pendingUpdate;
+            framePending = false;
+        }
+        else
+        {
+        }
+        xTaskResumeAll();
+        
+        /* Block until a new frame has been submitted. The display is powered 
+           off if no frame has been submitted during the idle time */
+        if (!refreshRequested)
+        {
+            if (!displayPowered)
+            {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            else if (ulTaskNotifyTake(pdTRUE, REFRESH_POWER_IDLE_TIME) == 0u)
+            {
+                Cy_EINK_Power(CY_EINK_OFF);
+                displayPowered = false;
+            }
+            else
+            {
+            }
+            continue;
+        }
+        
+        /* Start a power session if the display has been powered off */
+        if (!displayPowered)
+        {
+            if (Cy_EINK_Power(CY_EINK_ON) != CY_EINK_SUCCESS)
+            {
+                Task_DebugPrintf("Failure! : Display - E-INK display power on",
+                                 0u);
+            }
+            displayPowered = true;
+        }
+        
+        /* Turn the Orange LED on to indicate that the E-INK display is 
+           refreshing */
+        Cy_GPIO_Clr(KIT_LED1_PORT, KIT_LED1_PIN);
+        
+        /* Update the E-INK display */
+        TraceEvent(TRACE_REFRESH_START);
+        if (image != NULL)
+        {
+            WriteImage(image, updateType);
+        }
+        else
+        {
+            Cy_EINK_ShowFrame(previousFrame, currentFrame, updateType, false);
+        }
+        TraceEvent(TRACE_REFRESH_END);
+        
+        /* Turn off the Orange LED on to indicate that the E-INK refresh has 
+           finished */
+        Cy_GPIO_Set(KIT_LED1_PORT, KIT_LED1_PIN);
+        
+        /* The image has been decoded into the frame on the display, and is 
+           not reported as a refresh of a submitted frame */
+        if (image != NULL)
+        {
+            continue;
+        }
+        
+        /* The frame that has been written is now the frame on the display,
+           and the frame that was on the display is free */
+        vTaskSuspendAll();
+        previousFrame = currentFrame;
+        currentFrame  = NULL;
+        xTaskResumeAll();
+        
+        /* Notify that the refresh has finished */
+        if (refreshComplete != NULL)
+        {
+            refreshComplete(updateType);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: void RefreshDisplayAsync(cy_eink_update_t updateType)
+********************************************************************************
+* Summary:
+*  Submits the frame in the emWin display buffer to be written to the E-INK 
+*  display and returns without waiting for the refresh. The display buffer is
+*  handed over without copying; call AcquireDisplayBuffer before drawing the
+*  next frame.
+*
+*  If the frame replaces a frame that was taken back before it was written,
+*  the update types are combined so that a full update is not downgraded to a
+*  partial update.
+*
+*  This function must be called from the task that uses emWin.
+*
+* Parameters:
+*  cy_eink_update_t updateType     : Full update (2/4 stages), partial update or
+*                                    automatic selection
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void RefreshDisplayAsync(cy_eink_update_t updateType)
+{
+    InitDisplayBuffer();
+    
+    /* Combine the update types of the replaced frame and the new frame */
+    if (frameReclaimed)
+    {
+        updateType = MergeUpdateTypes(reclaimedUpdate, updateType);
+    }
+    
+    /* Hand the drawing buffer over while the refresh task can't pick up the
+       pending frame */
+    vTaskSuspendAll();
+    pendingFrame   = drawFrame;
+    pendingUpdate  = updateType;
+    framePending   = true;
+    frameReclaimed = false;
+    xTaskResumeAll();
+    
+    /* The drawing buffer holds the submitted frame */
+    drawFrameStale = false;
+    
+    /* Wake up the refresh task */
+    if (refreshTaskHandle != NULL)
+    {
+        xTaskNotifyGive(refreshTaskHandle);
+    }
+}
+
+/*******************************************************************************
+* Function Name: void ShowImageAsync(cy_eink_compressed_image_t const* image,
+*                                    cy_eink_update_t updateType)
+********************************************************************************
+* Summary:
+*  Submits a compressed image to be written to the E-INK display and returns
+*  without waiting for the refresh. The image is written before the pending 
+*  frame, with a full update (see Cy_EINK_ShowCompressedImage), and becomes 
+*  the frame on the display. The function registered with 
+*  RegisterRefreshCompleteFunction is not called for the image.
+*
+*  This function must be called from the task that uses emWin, before any 
+*  frame is submitted.
+*
+* Parameters:
+*  cy_eink_compressed_image_t const* image : Image, which must remain valid 
+*                                            until it has been written
+*  cy_eink_update_t updateType             : Full update (2/4 stages), or
+*                                            automatic selection
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ShowImageAsync(cy_eink_compressed_image_t const* image,
+                    cy_eink_update_t updateType)
+{
+    vTaskSuspendAll();
+    pendingImage       = image;
+    pendingImageUpdate = updateType;
+    xTaskResumeAll();
+    
+    /* Wake up the refresh task */
+    if (refreshTaskHandle != NULL)
+    {
+        xTaskNotifyGive(refreshTaskHandle);
+    }
+}
+
+/*******************************************************************************
+* Function Name: void AcquireDisplayBuffer(void)
+********************************************************************************
+* Summary:
+*  Makes the emWin display buffer available for drawing the next frame. If the
+*  submitted frame has not been picked up by the refresh task, it is taken 
+*  back: the next frame is drawn over it and replaces it when it is submitted.
+*  Otherwise, emWin is given the free frame buffer if the refresh task is using
+*  the display buffer. The next frame must be submitted with 
+*  RefreshDisplayAsync once it has been drawn.
+*
+*  This function must be called from the task that uses emWin.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AcquireDisplayBuffer(void)
+{
+    cy_eink_frame_t* freeFrame = NULL;
+    uint8_t          i;
+    
+    InitDisplayBuffer();
+    
+    /* Take the pending frame back, or select a frame that is neither on the 
+       display nor being written. The refresh task can't pick up or release
+       frames meanwhile */
+    vTaskSuspendAll();
+    if (framePending)
+    {
+        framePending    = false;
+        frameReclaimed  = true;
+        reclaimedUpdate = pendingUpdate;
+    }
+    else if ((drawFrame == currentFrame) || (drawFrame == previousFrame))
+    {
+        for (i = 0u; i < NUMBER_OF_FRAMES; i++)
+        {
+            if ((frames[i] != currentFrame) && (frames[i] != previousFrame) &&
+                (frames[i] != drawFrame))
+            {
+                freeFrame = frames[i];
+            }
+        }
+    }
+    else
+    {
+    }
+    xTaskResumeAll();
+    
+    /* emWin draws into the free frame, which holds an older frame until it 
+       is restored */
+    if (freeFrame != NULL)
+    {
+        GUI_Lock();
+        submittedFrame = LCD_SwapDisplayBuffer(freeFrame);
+        GUI_Unlock();
+        drawFrame      = freeFrame;
+        drawFrameStale = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: void RestoreDisplayBuffer(void)
+********************************************************************************
+* Summary:
+*  Copies the frame that was submitted last into the emWin display buffer. This
+*  is only required before drawing over the submitted frame; screens that clear
+*  the display first need no copy. The copy is done once per submitted frame,
+*  and not at all if the submitted frame has been taken back. Must be called
+*  after AcquireDisplayBuffer.
+*
+*  This function must be called from the task that uses emWin.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Side Effects:
+*  The submitted frame is not modified by the refresh task, so it can be read
+*  while the display is refreshing
+*
+*******************************************************************************/
+void RestoreDisplayBuffer(void)
+{
+    if (drawFrameStale)
+    {
+        memcpy(drawFrame, submittedFrame, CY_EINK_FRAME_SIZE);
+        drawFrameStale = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: void RegisterRefreshCompleteFunction(
+*                               refresh_complete_function_t completeFunction)
+********************************************************************************
+* Summary:
+*  Registers the function that is called from the refresh task each time a 
+*  display refresh has finished
+*
+* Parameters:
+*  refresh_complete_function_t : Function pointer, or NULL to remove it
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void RegisterRefreshCompleteFunction(refresh_complete_function_t 
+                                     completeFunction)
+{
+    refreshComplete = completeFunction;
+}
+
+/*******************************************************************************
+* Function Name: bool IsRefreshPending(void)
+********************************************************************************
+* Summary:
+*  Checks if a submitted frame is waiting to be written to the display. A
+*  frame that has been taken back to be drawn over is still waiting.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool : true if a frame is waiting to be written
+*
+*******************************************************************************/
+bool IsRefreshPending(void)
+{
+    return (framePending || frameReclaimed);
+}
+
+/*******************************************************************************
+* Function Name: void SetDisplayedFrame(void)
+********************************************************************************
+* Summary:
+*  Copies the frame in the emWin display buffer as the frame that is on the 
+*  display, without refreshing the display. This is used after a reset when 
+*  the display still shows a known frame, so that the next refresh can be a
+*  partial update.
+*
+*  This function must be called from the task that uses emWin, before any 
+*  frame is submitted.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SetDisplayedFrame(void)
+{
+    InitDisplayBuffer();
+    memcpy(previousFrame, drawFrame, CY_EINK_FRAME_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: void static WriteImage(cy_eink_compressed_image_t const* image,
+*                                       cy_eink_update_t updateType)
+********************************************************************************
+* Summary:
+*  Writes a compressed image over the frame on the display, and decodes the 
+*  image into that frame. The frame on the display is not read by the display
+*  task before a frame has been submitted.
+*
+* Parameters:
+*  cy_eink_compressed_image_t const* image : Image to be written
+*  cy_eink_update_t updateType             : Full update (2/4 stages), or
+*                                            automatic selection
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void static WriteImage(cy_eink_compressed_image_t const* image,
+                       cy_eink_update_t updateType)
+{
+    /* The frame on the display, described as an image without data */
+    cy_eink_compressed_image_t const displayedImage = {NULL, 0u, previousFrame};
+    cy_eink_image_decoder_t decoder;
+    uint16_t line;
+    
+    if (Cy_EINK_ShowCompressedImage(&displayedImage, image, updateType, false)
+        != CY_EINK_SUCCESS)
+    {
+        Task_DebugPrintf("Failure! : Display - compressed image", 0u);
+    }
+    
+    Cy_EINK_StartImageDecoder(&decoder, image);
+    for (line = 0u; line < CY_EINK_LINE_COUNT; line++)
+    {
+        (void)Cy_EINK_DecodeImageLine(&decoder,
+                                      &previousFrame[line * CY_EINK_LINE_SIZE]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: void static InitDisplayBuffer(void)
+********************************************************************************
+* Summary:
+*  Adds the emWin display buffer to the frames on the first call. emWin must 
+*  have been initialized.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void static InitDisplayBuffer(void)
+{
+    if (drawFrame == NULL)
+    {
+        /* The lock makes sure that the buffer is not read while a page is
+           being prefetched into the page cache */
+        GUI_Lock();
+        drawFrame = LCD_GetDisplayBuffer();
+        GUI_Unlock();
+        frames[NUMBER_OF_FRAME_BUFFERS] = drawFrame;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cy_eink_update_t static MergeUpdateTypes(
+*                   cy_eink_update_t pendingType, cy_eink_update_t newType)
+********************************************************************************
+* Summary:
+*  Selects the update type of two coalesced frames. The update that removes
+*  more ghosting is selected: 4 stage full, 2 stage full, automatic selection,
+*  then partial.
+*
+* Parameters:
+*  cy_eink_update_t pendingType : Update type of the replaced frame
+*  cy_eink_update_t newType     : Update type of the new frame
+*
+* Return:
+*  cy_eink_update_t : Update type of the combined frame
+*
+*******************************************************************************/
+cy_eink_update_t static MergeUpdateTypes(cy_eink_update_t pendingType,
+                                         cy_eink_update_t newType)
+{
+    cy_eink_update_t mergedType;
+    
+    if ((pendingType == CY_EINK_FULL_4STAGE) ||
+        (newType == CY_EINK_FULL_4STAGE))
+    {
+        mergedType = CY_EINK_FULL_4STAGE;
+    }
+    else if ((pendingType == CY_EINK_FULL_2STAGE) ||
+             (newType == CY_EINK_FULL_2STAGE))
+    {
+        mergedType = CY_EINK_FULL_2STAGE;
+    }
+    else if ((pendingType == CY_EINK_AUTO) ||
+             (newType == CY_EINK_AUTO))
+    {
+        mergedType = CY_EINK_AUTO;
+    }
+    else
+    {
+        mergedType = CY_EINK_PARTIAL;
+    }
+    
+    return mergedType;
+}
+
+/* [] END OF FILE */
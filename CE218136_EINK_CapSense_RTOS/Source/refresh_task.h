@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: refresh_task.h
+*
+* Version: 1.00
+*
+* Description: This file is the public interface of refresh_task.c source file
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*                      CY8CKIT-028-EPD E-INK Display Shield
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/******************************************************************************
+* This file contains the declaration of the task and functions used for 
+* asynchronous E-INK display refreshes
+*******************************************************************************/
+
+/* Include guard */
+#ifndef REFRESH_TASK_H
+#define REFRESH_TASK_H
+
+/* Header file includes */
+#include "./cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h"
+#include "FreeRTOS.h"
+
+/* Time that the display stays powered after a refresh, waiting for the next
+   frame. Set to 0 to power the display off after each refresh */
+#ifndef REFRESH_POWER_IDLE_TIME
+#define REFRESH_POWER_IDLE_TIME     (pdMS_TO_TICKS(3000u))
+#endif
+
+/* Callback function prototype that is called when a display refresh has
+   finished */
+typedef void (* refresh_complete_function_t) (cy_eink_update_t updateType);
+
+/* Task_Refresh writes the submitted frames to the E-INK display */
+void Task_Refresh(void *pvParameters);
+
+/* Submit the emWin display buffer to be shown on the display, without 
+   waiting for the refresh */
+void RefreshDisplayAsync(cy_eink_update_t updateType);
+
+/* Submit a compressed image to be shown on the display before the first 
+   frame, without waiting for the refresh */
+void ShowImageAsync(cy_eink_compressed_image_t const* image,
+                    cy_eink_update_t updateType);
+
+/* Make the emWin display buffer available for drawing the next frame */
+void AcquireDisplayBuffer(void);
+
+/* Restore the submitted frame in the emWin display buffer before drawing over
+   it */
+void RestoreDisplayBuffer(void);
+
+/* Register the function that is called when a display refresh has finished */
+void RegisterRefreshCompleteFunction(refresh_complete_function_t 
+                                     completeFunction);
+
+/* Check if a submitted frame is waiting to be written */
+bool IsRefreshPending(void);
+
+/* Set the emWin display buffer as the frame that is on the display */
+void SetDisplayedFrame(void);
+
+#endif /* REFRESH_TASK_H */
+/* [] END OF FILE */
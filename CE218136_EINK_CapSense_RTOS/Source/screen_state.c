@@ -0,0 +1,235 @@
+/******************************************************************************
+* File Name: screen_state.c
+*
+* Version: 1.00
+*
+* Description: This file contains the functions used to keep the screen shown
+*              on the display across resets
+*
+* Related Document: CE218136_EINK_CapSense_RTOS.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*                      CY8CKIT-028-EPD E-INK Display Shield
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+/*******************************************************************************
+* This file stores the screen that is on the E-INK display in the Emulated 
+* EEPROM flash region. The E-INK display keeps its image without power, so 
+* after a reset the display task can restore the screen, draw its frame again
+* and continue with partial updates instead of showing the startup screen.
+*
+* The frame itself is not stored: it is drawn from the screen state, so one 
+* flash row per screen change is written instead of the 12 rows of a frame. 
+* Each record carries a sequence number and a CRC. The rows are written in turn
+* and the valid record with the highest sequence number is the current one, so
+* a reset during a flash write falls back to the previous record.
+*******************************************************************************/
+
+/* Header file includes */
+#include "screen_state.h"
+#include "cy_pdl.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Signature of a screen state record. The low byte is the version of the 
+   screen layout; change it when the screen contents change, so that the 
+   stored screens are discarded */
+#define SCREEN_STATE_SIGNATURE  (uint32_t)(0x53435201u)
+
+/* CRC-32 (IEEE 802.3) parameters */
+#define CRC_POLYNOMIAL          (uint32_t)(0xEDB88320u)
+#define CRC_SEED                (uint32_t)(0xFFFFFFFFu)
+
+/* Data-type of a screen state record, stored at the start of a flash row */
+typedef struct
+{
+    uint32_t    signature;
+    uint32_t    sequence;
+    screen_t    screen;
+    uint32_t    crc;
+}   screen_state_record_t;
+
+/* Flash rows that store the records, placed in the Emulated EEPROM region */
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+uint8_t static const screenStateRows[SCREEN_STATE_ROWS][CY_FLASH_SIZEOF_ROW] =
+                                                                     {{0u}};
+
+/* RAM image of the row being written */
+uint32_t static rowBuffer[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+
+/* Last stored record and the row that holds it */
+screen_state_record_t static lastRecord;
+uint8_t static               lastRow = SCREEN_STATE_ROWS - 1u;
+
+/*  These static functions are not available outside this file. 
+    See the respective function definitions for more details */
+uint32_t static ComputeRecordCrc(screen_state_record_t const* record);
+
+/*******************************************************************************
+* Function Name: bool LoadScreenState(screen_t* screen)
+********************************************************************************
+* Summary:
+*  Reads the last stored screen state. This function must be called once
+*  before SaveScreenState.
+*
+* Parameters:
+*  screen_t* screen : Receives the stored screen
+*
+* Return:
+*  bool : true if a valid screen state has been found
+*
+*******************************************************************************/
+bool LoadScreenState(screen_t* screen)
+{
+    screen_state_record_t record;
+    bool    found = false;
+    uint8_t row;
+    
+    memset(&lastRecord, 0, sizeof(lastRecord));
+    
+    for (row = 0u; row < SCREEN_STATE_ROWS; row++)
+    {
+        memcpy(&record, screenStateRows[row], sizeof(record));
+        
+        /* Keep the valid record with the highest sequence number */
+        if ((record.signature == SCREEN_STATE_SIGNATURE) &&
+            (record.crc == ComputeRecordCrc(&record)) &&
+            ((!found) || ((int32_t)(record.sequence - lastRecord.sequence) 
+                          > 0)))
+        {
+            lastRecord = record;
+            lastRow    = row;
+            found      = true;
+        }
+    }
+    
+    if (found)
+    {
+        *screen = lastRecord.screen;
+    }
+    
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: bool SaveScreenState(screen_t const* screen)
+********************************************************************************
+* Summary:
+*  Stores the screen state in the next flash row. Nothing is written if the 
+*  screen is the stored one.
+*
+* Parameters:
+*  screen_t const* screen : Screen that is on the display
+*
+* Return:
+*  bool : true if the screen state is stored
+*
+* Side Effects:
+*  The CPU is blocked while the flash row is written
+*
+*******************************************************************************/
+bool SaveScreenState(screen_t const* screen)
+{
+    screen_state_record_t record;
+    bool    stored = true;
+    uint8_t row;
+    
+    if ((lastRecord.signature != SCREEN_STATE_SIGNATURE) ||
+        (lastRecord.screen.screen != screen->screen) ||
+        (lastRecord.screen.menuItem != screen->menuItem) ||
+        (lastRecord.screen.textPage != screen->textPage))
+    {
+        /* Build the record. The padding of the screen is cleared so that the
+           CRC does not depend on it */
+        memset(&record, 0, sizeof(record));
+        record.signature       = SCREEN_STATE_SIGNATURE;
+        record.sequence        = lastRecord.sequence + 1u;
+        record.screen.screen   = screen->screen;
+        record.screen.menuItem = screen->menuItem;
+        record.screen.textPage = screen->textPage;
+        record.crc             = ComputeRecordCrc(&record);
+        
+        memset(rowBuffer, 0, sizeof(rowBuffer));
+        memcpy(rowBuffer, &record, sizeof(record));
+        
+        /* Write the row after the one holding the last record */
+        row = (lastRow + 1u) % SCREEN_STATE_ROWS;
+        if (Cy_Flash_WriteRow((uint32_t)screenStateRows[row], rowBuffer) ==
+            CY_FLASH_DRV_SUCCESS)
+        {
+            lastRecord = record;
+            lastRow    = row;
+        }
+        else
+        {
+            stored = false;
+        }
+    }
+    
+    return stored;
+}
+
+/*******************************************************************************
+* Function Name: uint32_t static ComputeRecordCrc(
+*                                   screen_state_record_t const* record)
+********************************************************************************
+* Summary:
+*  Calculates the CRC-32 of a record, excluding its CRC field
+*
+* Parameters:
+*  screen_state_record_t const* record : Record
+*
+* Return:
+*  uint32_t : CRC of the record
+*
+*******************************************************************************/
+uint32_t static ComputeRecordCrc(screen_state_record_t const* record)
+{
+    uint8_t const* data = (uint8_t const*)record;
+    uint32_t crc = CRC_SEED;
+    uint32_t i;
+    uint8_t  bit;
+    
+    for (i = 0u; i < offsetof(screen_state_record_t, crc); i++)
+    {
+        crc ^= data[i];
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (crc >> 1u) ^ (CRC_POLYNOMIAL & (0u - (crc & 1u)));
+        }
+    }
+    
+    return ~crc;
+}
+
+/* [] END OF FILE */
@@ -47,16 +47,22 @@
 /* Header file includes */
 #include "touch_task.h"
 #include "uart_debug.h"
+#include "latency_trace.h"
 #include "task.h" 
 #include "cy_pdl.h"
 #include "cy_capsense.h"
 #include "cycfg.h"
 #include "cycfg_capsense.h"
 
-/* Scanning interval of 10ms is used to get 100 scans per second */
-#define TOUCH_SCAN_INTERVAL  (pdMS_TO_TICKS(10u))
-/* Gesture time increment at each scan interval */
-#define GESTURE_TIME_INCREMENT  (10u)
+/* Scanning interval of 10ms is used to get 100 scans per second while a 
+   finger is present, and for TOUCH_ACTIVE_TIMEOUT after it has been removed */
+#define TOUCH_ACTIVE_SCAN_INTERVAL  (pdMS_TO_TICKS(10u))
+#define TOUCH_ACTIVE_TIMEOUT        (pdMS_TO_TICKS(1000u))
+/* Scanning interval of 50ms is used when no finger has been detected for 
+   TOUCH_ACTIVE_TIMEOUT */
+#define TOUCH_IDLE_SCAN_INTERVAL    (pdMS_TO_TICKS(50u))
+/* Maximum time to wait for the end of a scan */
+#define TOUCH_SCAN_TIMEOUT          (pdMS_TO_TICKS(20u))
 
 /* Macros used for gesture detection. See the function header of
    Cy_CapSense_DecodeWidgetGestures for the details of each
@@ -67,9 +73,37 @@
 /* Queue handle used for touch data */
 QueueHandle_t touchDataQ;
 
+/* Handle of Task_Touch, notified by the CapSense ISR at the end of a scan */
+TaskHandle_t static touchTaskHandle;
+
+/* Widgets scanned by Task_Touch, published with SetTouchProfile */
+uint8_t static volatile touchProfile = TOUCH_PROFILE_ALL;
+
+/* Datatype that links a widget of the touch profile to its CapSense widget */
+typedef struct
+{
+    uint8_t     profileMask;
+    uint32_t    widgetId;
+}   touch_widget_t;
+
+/* Widgets that can be selected in the touch profile */
+static const touch_widget_t touchWidgets[] =
+{
+    { TOUCH_PROFILE_BUTTON0, CY_CAPSENSE_BUTTON0_WDGT_ID },
+    { TOUCH_PROFILE_BUTTON1, CY_CAPSENSE_BUTTON1_WDGT_ID },
+    { TOUCH_PROFILE_SLIDER,  CY_CAPSENSE_LINEARSLIDER0_WDGT_ID }
+};
+#define TOUCH_WIDGET_COUNT  (sizeof(touchWidgets) / sizeof(touchWidgets[0]))
+
 /* CapSense ISR */
 static void CapSense_Interrupt(void);
 
+/* Scans and processes the widgets of a touch profile */
+static bool ScanTouchProfile(uint8_t profile, uint8_t newWidgets);
+
+/* Checks if a widget of a touch profile is active */
+static bool IsProfileActive(uint8_t profile);
+
 /* CapSense ISR configuration parameters */
 const cy_stc_sysint_t CapSense_ISR_cfg =
 {
@@ -96,12 +130,29 @@ void Task_Touch(void *pvParameters)
     /* Local variables used for touch and gesture detection */
     touch_data_t previousTouchData = NO_TOUCH;
     touch_data_t currentTouchData;
-    uint32_t gestureTimestamp = 0;
     uint32_t gestureStatus;
 
+    /* Widgets scanned in this cycle and in the previous cycle */
+    uint8_t profile;
+    uint8_t previousProfile = TOUCH_PROFILE_ALL;
+
+    /* Time stamps of the last scan started, of the end of the last scan and 
+       of the last time a finger was present, and the current scan interval */
+    TickType_t lastScanStart;
+    TickType_t scanTime;
+    TickType_t lastTouchTime;
+    TickType_t scanInterval;
+
+    /* Trace time stamps of the end of the scan and of the gesture decoding */
+    uint32_t scanTraceTime;
+    uint32_t decodeTraceTime;
+
     /* Remove warning for unused parameter */
     (void)pvParameters ;
 
+    /* The CapSense ISR notifies this task when a scan is complete */
+    touchTaskHandle = xTaskGetCurrentTaskHandle();
+
 	/*Initialize CapSense Data structures */
 	Cy_CapSense_Init(&cy_capsense_context);
 
@@ -113,26 +164,51 @@ void Task_Touch(void *pvParameters)
 	/* Start CapSense block and perform first scan to set up sensor baselines */
 	Cy_CapSense_Enable(&cy_capsense_context);
 
+    /* Discard the notifications of the scans performed by Cy_CapSense_Enable */
+    (void)ulTaskNotifyTake(pdTRUE, 0u);
+
+    /* Scan fast from startup */
+    lastScanStart = xTaskGetTickCount();
+    lastTouchTime = lastScanStart;
+
     /* Repeatedly running part of the task */
     for(;;)
     {
-        /* Check if CapSense is busy with a previous scan */
-        if(CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
+        /* Read the widgets that are meaningful on the current screen */
+        profile = touchProfile;
+
+        /* Scan and process the widgets of the profile. The widgets that were
+           not scanned in the previous cycle restart from a new baseline */
+        if (ScanTouchProfile(profile, (uint8_t)(profile & ~previousProfile)))
         {
-            /* Process all widgets and read touch information */
-            Cy_CapSense_ProcessAllWidgets(&cy_capsense_context);
-            gestureStatus = Cy_CapSense_DecodeWidgetGestures(
+            previousProfile = profile;
+
+            /* Gestures are timed with the time stamp of the scan */
+            scanTraceTime = TraceTime();
+            scanTime = xTaskGetTickCount();
+            Cy_CapSense_SetGestureTimestamp(
+                                (uint32_t)(scanTime * portTICK_PERIOD_MS),
+                                &cy_capsense_context);
+
+            /* Decode the slider gestures if the slider is scanned */
+            gestureStatus = 0u;
+            if ((profile & TOUCH_PROFILE_SLIDER) != 0u)
+            {
+                gestureStatus = Cy_CapSense_DecodeWidgetGestures(
             						CY_CAPSENSE_LINEARSLIDER0_WDGT_ID,
 									&cy_capsense_context);
+            }
 
             /* Button0 is active */
-            if(Cy_CapSense_IsWidgetActive(CY_CAPSENSE_BUTTON0_WDGT_ID,
+            if(((profile & TOUCH_PROFILE_BUTTON0) != 0u) &&
+               Cy_CapSense_IsWidgetActive(CY_CAPSENSE_BUTTON0_WDGT_ID,
             							  &cy_capsense_context))
             {
                     currentTouchData = BUTTON0_TOUCHED;
             }
             /* Button1 is active */
-            else if (Cy_CapSense_IsWidgetActive (CY_CAPSENSE_BUTTON1_WDGT_ID,
+            else if (((profile & TOUCH_PROFILE_BUTTON1) != 0u) &&
+                     Cy_CapSense_IsWidgetActive (CY_CAPSENSE_BUTTON1_WDGT_ID,
             									&cy_capsense_context))
             {
             	currentTouchData = BUTTON1_TOUCHED;
@@ -151,9 +227,13 @@ void Task_Touch(void *pvParameters)
             {
             	currentTouchData = NO_TOUCH;
             }
+            decodeTraceTime = TraceTime();
 
-            /* Start the next CapSense scan */
-            Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
+            /* Keep scanning fast while a finger is present */
+            if (IsProfileActive(profile))
+            {
+                lastTouchTime = scanTime;
+            }
 
             /* Check if there is any data to be sent */
             if(currentTouchData != previousTouchData)
@@ -162,19 +242,139 @@ void Task_Touch(void *pvParameters)
 
             	if(currentTouchData != NO_TOUCH)
             	{
-            		/* Send the processed touch data */
-            		xQueueOverwrite(touchDataQ, &currentTouchData);
+            		/* Trace the scan that detected the input */
+            		TraceEventAt(TRACE_SCAN_COMPLETE, scanTraceTime);
+            		TraceEventAt(TRACE_GESTURE_DECODED, decodeTraceTime);
+
+            		/* Send the processed touch data. The display task combines
+            		   the queued inputs; an input is dropped only if the queue
+            		   is full */
+            		xQueueSend(touchDataQ, &currentTouchData, 0u);
+            		TraceEvent(TRACE_TOUCH_SENT);
             	}
           }
         }
 
-        /* Increment the gesture time stamp */
-        gestureTimestamp += GESTURE_TIME_INCREMENT;
-        Cy_CapSense_SetGestureTimestamp(gestureTimestamp, &cy_capsense_context);
+        /* Scan fast while a finger is present or has been removed recently,
+           and slowly when the widgets are idle */
+        if ((xTaskGetTickCount() - lastTouchTime) < TOUCH_ACTIVE_TIMEOUT)
+        {
+            scanInterval = TOUCH_ACTIVE_SCAN_INTERVAL;
+        }
+        else
+        {
+            scanInterval = TOUCH_IDLE_SCAN_INTERVAL;
+        }
 
         /* Block until next scan interval */
-        vTaskDelay(TOUCH_SCAN_INTERVAL);
+        vTaskDelayUntil(&lastScanStart, scanInterval);
+    }
+}
+
+/*******************************************************************************
+* Function Name: void SetTouchProfile(uint8_t profile)
+********************************************************************************
+*
+* Summary:
+*  Selects the widgets that are scanned by Task_Touch. The inputs of the other
+*  widgets are not detected
+*
+* Parameters:
+*  uint8_t profile : Combination of the TOUCH_PROFILE_X widget masks
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SetTouchProfile(uint8_t profile)
+{
+    touchProfile = profile;
+}
+
+/*******************************************************************************
+* Function Name: static bool ScanTouchProfile(uint8_t profile, 
+*                                             uint8_t newWidgets)
+********************************************************************************
+*
+* Summary:
+*  Scans the widgets of a touch profile one after the other, and processes 
+*  each widget when the CapSense ISR notifies the end of its scan
+*
+* Parameters:
+*  uint8_t profile    : Widgets to be scanned
+*  uint8_t newWidgets : Widgets whose baseline is initialized from this scan
+*
+* Return:
+*  bool               : "true" if all the widgets have been scanned
+*
+*******************************************************************************/
+static bool ScanTouchProfile(uint8_t profile, uint8_t newWidgets)
+{
+    uint32_t widget;
+
+    for (widget = 0u; widget < TOUCH_WIDGET_COUNT; widget++)
+    {
+        if ((profile & touchWidgets[widget].profileMask) == 0u)
+        {
+            continue;
+        }
+
+        /* Start the scan of the widget and wait until the CapSense ISR 
+           notifies the end of the scan */
+        Cy_CapSense_ScanWidget(touchWidgets[widget].widgetId,
+                               &cy_capsense_context);
+        if ((ulTaskNotifyTake(pdTRUE, TOUCH_SCAN_TIMEOUT) == 0u) ||
+            (CY_CAPSENSE_NOT_BUSY != Cy_CapSense_IsBusy(&cy_capsense_context)))
+        {
+            return false;
+        }
+
+        /* The baseline of a widget that has not been scanned recently is 
+           out of date */
+        if ((newWidgets & touchWidgets[widget].profileMask) != 0u)
+        {
+            Cy_CapSense_InitializeWidgetBaseline(touchWidgets[widget].widgetId,
+                                                 &cy_capsense_context);
+        }
+
+        /* Read the touch information of the widget */
+        Cy_CapSense_ProcessWidget(touchWidgets[widget].widgetId,
+                                  &cy_capsense_context);
     }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: static bool IsProfileActive(uint8_t profile)
+********************************************************************************
+*
+* Summary:
+*  Checks if a finger is present on a widget of a touch profile
+*
+* Parameters:
+*  uint8_t profile : Widgets to be checked
+*
+* Return:
+*  bool            : "true" if a widget is active
+*
+*******************************************************************************/
+static bool IsProfileActive(uint8_t profile)
+{
+    uint32_t widget;
+    bool active = false;
+
+    for (widget = 0u; widget < TOUCH_WIDGET_COUNT; widget++)
+    {
+        if (((profile & touchWidgets[widget].profileMask) != 0u) &&
+            (Cy_CapSense_IsWidgetActive(touchWidgets[widget].widgetId,
+                                        &cy_capsense_context) != 0u))
+        {
+            active = true;
+        }
+    }
+
+    return active;
 }
 
 /*******************************************************************************
@@ -182,7 +382,8 @@ void Task_Touch(void *pvParameters)
 ********************************************************************************
 *
 * Summary:
-*  CapSense interrupt service routine
+*  CapSense interrupt service routine. Notifies Task_Touch when the scan of 
+*  all widgets is complete
 *
 * Parameters:
 *  None
@@ -193,7 +394,16 @@ void Task_Touch(void *pvParameters)
 *******************************************************************************/
 static void CapSense_Interrupt(void)
 {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
     Cy_CapSense_InterruptHandler(CSD0, &cy_capsense_context);
+
+    /* Notify the task at the end of the scan */
+    if(CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
+    {
+        vTaskNotifyGiveFromISR(touchTaskHandle, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
 }
 
 /* [] END OF FILE */
@@ -64,6 +64,15 @@ typedef enum
     
 }   touch_data_t; 
 
+/* Widget masks of the touch profile, which selects the widgets scanned by
+   Task_Touch */
+#define TOUCH_PROFILE_BUTTON0   (uint8_t)(0x01u)
+#define TOUCH_PROFILE_BUTTON1   (uint8_t)(0x02u)
+#define TOUCH_PROFILE_SLIDER    (uint8_t)(0x04u)
+#define TOUCH_PROFILE_ALL       (uint8_t)(TOUCH_PROFILE_BUTTON0 |              \
+                                          TOUCH_PROFILE_BUTTON1 |              \
+                                          TOUCH_PROFILE_SLIDER)
+
 /* Queue handle for sending touch data */
 extern QueueHandle_t touchDataQ;
 
@@ -71,5 +80,8 @@ extern QueueHandle_t touchDataQ;
    required */    
 void Task_Touch(void *pvParameters);    
 
+/* Selects the widgets that are meaningful on the current screen */
+void SetTouchProfile(uint8_t profile);
+
 #endif /* TOUCH_TASK_H */
 /* [] END OF FILE */
@@ -48,9 +48,19 @@
 
 /* Header file includes */
 #include "uart_debug.h"
+#include "latency_trace.h"
 
 #if (UART_DEBUG_ENABLE)
 
+/* Time the debug task waits for a message. If latency tracing is enabled, the
+   task prints the trace each time it wakes up, so that the UART is only used
+   by this task */
+#if (LATENCY_TRACE_ENABLE)
+    #define DEBUG_RECEIVE_TIMEOUT   (pdMS_TO_TICKS(500u))
+#else
+    #define DEBUG_RECEIVE_TIMEOUT   (portMAX_DELAY)
+#endif /* LATENCY_TRACE_ENABLE */
+
 /* Queue handle for debug message Queue */       
 QueueHandle_t debugMessageQ;
 
@@ -60,7 +70,8 @@ cy_stc_scb_uart_context_t KIT_UART_context;
 * Function Name: void Task_Debug(void *pvParameters)
 ********************************************************************************
 * Summary:
-*  Task that prints a debug message via UART STDIO
+*  Task that prints a debug message via UART STDIO, and the latency trace if
+*  it is enabled
 *
 * Parameters:
 *  void *pvParameters : Task parameter defined during task creation (unused)                            
@@ -86,7 +97,7 @@ void Task_Debug(void *pvParameters)
         /* Block until a message to printed has been received over 
            debugMessageQ */
         rtosApiResult = xQueueReceive(debugMessageQ, &dataToPrint,
-                                      portMAX_DELAY);
+                                      DEBUG_RECEIVE_TIMEOUT);
         
         /* Message has been received from debugMessageQ */
         if(rtosApiResult == pdTRUE)
@@ -104,6 +115,9 @@ void Task_Debug(void *pvParameters)
                 DebugPrintf("%s \r\n", dataToPrint.stringPointer);
             }
         }    
+        
+        /* Print the latency trace recorded since the last dump */
+        TraceDump();
     }
 }
 
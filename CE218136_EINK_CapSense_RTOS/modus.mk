@@ -88,6 +88,8 @@ CY_APP_CM4_SOURCE = \
 	Source/cy_cy8ckit_028_epd/cy_cy8ckit_028_epd.h \
 	Source/cy_cy8ckit_028_epd/cy_eink_psoc_interface.c \
 	Source/cy_cy8ckit_028_epd/cy_eink_psoc_interface.h \
+	Source/cy_cy8ckit_028_epd/cy_eink_raster.c \
+	Source/cy_cy8ckit_028_epd/cy_eink_raster.h \
 	Source/cy_cy8ckit_028_epd/pervasive_eink_configuration.h \
 	Source/cy_cy8ckit_028_epd/pervasive_eink_hardware_driver.c \
 	Source/cy_cy8ckit_028_epd/pervasive_eink_hardware_driver.h \
@@ -96,12 +98,21 @@ CY_APP_CM4_SOURCE = \
 	Source/emWin_config/LCDConf.c \
 	Source/emWin_config/LCDConf.h \
 	Source/images_and_text/Cypress_Logo_1bpp.c \
+	Source/images_and_text/Startup_Logo_Compressed.c \
 	Source/images_and_text/screen_contents.c \
 	Source/images_and_text/screen_contents.h \
 	Source/FreeRTOSConfig.h \
 	Source/display_task.c \
 	Source/display_task.h \
+	Source/latency_trace.c \
+	Source/latency_trace.h \
 	Source/main.c \
+	Source/refresh_task.c \
+	Source/refresh_task.h \
+	Source/page_cache.c \
+	Source/page_cache.h \
+	Source/screen_state.c \
+	Source/screen_state.h \
 	Source/menu_configuration.h \
 	Source/stdio_user.c \
 	Source/stdio_user.h \
@@ -162,14 +173,14 @@ CY_MAINAPP_CM0P_SWCOMP_USED = \
 #
 CY_MAINAPP_SWCOMP_USED= \
     $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/emWin/code/drivers/BitPlains \
-    $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/emWin/code/include/nosnts_softfp \
+    $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/emWin/code/include/osnts_softfp \
     $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/rtos/FreeRTOS/10.0.1/Source \
     $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/capsense/softfp \
     $(CY_PSOC_LIB_COMP_BASE)/utilities/retarget_io \
 
 CY_MAINAPP_SWCOMP_EXT = \
     $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/emWin/code/drivers/BitPlains/config \
-    $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/emWin/code/config/nos/ \
+    $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/emWin/code/config/os/ \
     $(CY_PSOC_LIB_COMP_MIDDLEWARE_BASE)/rtos/FreeRTOS/10.0.1/Source/portable \
     $(CY_PSOC_LIB_COMP_BASE)/utilities/retarget_io/user \
 
@@ -0,0 +1,425 @@
+/******************************************************************************
+* File Name: ftl_test.c
+*
+* Version: 1.0
+*
+* Description:
+* 	This file contains the power-cut and write amplification test of the flash
+* 	translation layer, run on the NOR flash model of the host build.
+*
+* 	The test writes versions of random logical pages, and remembers the last
+* 	version acknowledged for each page. When power cuts are enabled, the power
+* 	is cut during a random program or erase operation, sometimes during the
+* 	remount itself. After each remount every page must read as its last
+* 	acknowledged version, except the page being written during the cut, which
+* 	may also read as the new version. The test then reports the write
+* 	amplification and the wear range of the blocks.
+*
+* 	Usage: ftl_test [writes] [cut interval] [pattern] [seed]
+* 	The power is cut on average every cut interval / 2 program and erase
+* 	operations, 0 disables the power cuts. The pattern of the logical pages is
+* 	uniform, hot (90% of the writes on 10% of the pages) or sequential (every
+* 	page written once, then the hot pattern). The program returns a non-zero
+* 	exit code if the test fails.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include "cycfg_qspi_memslot.h"
+#include "ftl.h"
+#include "nor_flash_model.h"
+
+
+/***************************************************************************
+* Global constants
+***************************************************************************/
+#define DEFAULT_WRITES			(100000ul)
+#define HOT_PAGES				(FTL_LOGICAL_PAGES / 10u)
+#define HOT_PERCENT				(90u)
+
+/* One remount in MOUNT_CUT_RATIO is cut too, within its first operations */
+#define MOUNT_CUT_RATIO			(4)
+#define MOUNT_CUT_OPERATIONS	(8)
+
+#define NO_PAGE					(0xFFFFFFFFul)
+#define ERASED_VERSION			(0u)
+
+typedef enum
+{
+	PATTERN_UNIFORM,
+	PATTERN_HOT,
+	PATTERN_SEQUENTIAL,
+	PATTERN_UNKNOWN
+} write_pattern_t;
+
+
+/***************************************************************************
+* Global variables
+***************************************************************************/
+cy_stc_smif_context_t KIT_QSPI_context;
+
+/* Last version acknowledged by FtlWrite() for each logical page */
+static uint32_t ackedVersion[FTL_LOGICAL_PAGES];
+
+/* Page and version of the write in progress */
+static uint32_t writtenPage = NO_PAGE;
+static uint32_t writtenVersion = ERASED_VERSION;
+
+/* Statistics of the FTL summed over the mounts */
+static uint64_t hostWrites = 0u;
+static uint64_t flashWrites = 0u;
+static uint64_t erases = 0u;
+
+static char const * const patternNames[PATTERN_UNKNOWN] = {"uniform", "hot", "sequential"};
+
+/* Mounts of the FTL, including the ones interrupted by a power cut */
+static uint32_t mounts = 0u;
+
+/* Targets of the power cuts during the writes and during the remounts */
+static jmp_buf powerCut;
+static jmp_buf mountPowerCut;
+
+
+/*******************************************************************************
+* Function Name: FillPage
+****************************************************************************//**
+*
+* Fills the data of a version of a logical page. Each version has its own data,
+* and the erased version reads as erased memory.
+*
+*******************************************************************************/
+static void FillPage(uint8_t data[], uint32_t logicalPage, uint32_t version)
+{
+	uint32_t seed = (logicalPage * 2654435761ul) ^ (version * 40503ul);
+	uint32_t index;
+
+	for(index = 0u; index < FTL_PAGE_DATA_SIZE; index++)
+	{
+		seed = (seed * 1103515245ul) + 12345ul;
+		data[index] = (ERASED_VERSION == version) ? 0xFFu : (uint8_t)(seed >> 24u);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: AddStats
+****************************************************************************//**
+*
+* Adds the statistics of the current mount to the totals.
+*
+*******************************************************************************/
+static void AddStats(void)
+{
+	ftl_stats_t stats;
+
+	FtlGetStats(&stats);
+	hostWrites += stats.hostWrites;
+	flashWrites += stats.flashWrites;
+	erases += stats.erases;
+}
+
+
+/*******************************************************************************
+* Function Name: VerifyPages
+****************************************************************************//**
+*
+* Checks that every logical page reads as its last acknowledged version. The
+* page written during a power cut may read as the new version, which is then
+* acknowledged.
+*
+*******************************************************************************/
+static bool VerifyPages(void)
+{
+	uint8_t data[FTL_PAGE_DATA_SIZE];
+	uint8_t expected[FTL_PAGE_DATA_SIZE];
+	uint32_t logicalPage;
+	bool isValid = true;
+
+	for(logicalPage = 0u; isValid && (logicalPage < FTL_LOGICAL_PAGES); logicalPage++)
+	{
+		if(CY_SMIF_SUCCESS != FtlRead(logicalPage, data))
+		{
+			printf("FAIL: reading logical page %lu\n", (unsigned long)logicalPage);
+			isValid = false;
+			break;
+		}
+
+		FillPage(expected, logicalPage, ackedVersion[logicalPage]);
+		if(0 == memcmp(data, expected, FTL_PAGE_DATA_SIZE))
+		{
+			continue;
+		}
+
+		if(logicalPage == writtenPage)
+		{
+			FillPage(expected, logicalPage, writtenVersion);
+			if(0 == memcmp(data, expected, FTL_PAGE_DATA_SIZE))
+			{
+				ackedVersion[logicalPage] = writtenVersion;
+				continue;
+			}
+		}
+
+		printf("FAIL: logical page %lu does not hold version %lu\n",
+				(unsigned long)logicalPage, (unsigned long)ackedVersion[logicalPage]);
+		isValid = false;
+	}
+
+	writtenPage = NO_PAGE;
+
+	return isValid;
+}
+
+
+/*******************************************************************************
+* Function Name: Remount
+****************************************************************************//**
+*
+* Remounts the FTL after a power cut, possibly cutting the power again during
+* the mount, and verifies the pages.
+*
+*******************************************************************************/
+static bool Remount(uint32_t cutInterval)
+{
+	cy_en_smif_status_t status;
+
+	AddStats();
+
+	if((0u != cutInterval) && (0 == (rand() % MOUNT_CUT_RATIO)))
+	{
+		if(0 == setjmp(mountPowerCut))
+		{
+			NorModel_SetPowerCut(rand() % MOUNT_CUT_OPERATIONS, &mountPowerCut);
+			mounts++;
+			(void)FtlMount(smifMemConfigs[0]);
+		}
+
+		AddStats();
+	}
+
+	NorModel_SetPowerCut(-1, NULL);
+	mounts++;
+	status = FtlMount(smifMemConfigs[0]);
+	if(CY_SMIF_SUCCESS != status)
+	{
+		printf("FAIL: remount, status %d\n", (int)status);
+	}
+
+	return (CY_SMIF_SUCCESS == status) && VerifyPages();
+}
+
+
+/*******************************************************************************
+* Function Name: ParsePattern
+****************************************************************************//**
+*
+* Returns the write pattern of the given name, or PATTERN_UNKNOWN.
+*
+*******************************************************************************/
+static write_pattern_t ParsePattern(char const *name)
+{
+	write_pattern_t pattern = PATTERN_UNIFORM;
+
+	while((PATTERN_UNKNOWN != pattern) && (0 != strcmp(name, patternNames[pattern])))
+	{
+		pattern++;
+	}
+
+	return pattern;
+}
+
+
+/*******************************************************************************
+* Function Name: NextPage
+****************************************************************************//**
+*
+* Returns the logical page of the next write.
+*
+*******************************************************************************/
+static uint32_t NextPage(write_pattern_t pattern, uint32_t writes)
+{
+	uint32_t logicalPage;
+
+	if((PATTERN_SEQUENTIAL == pattern) && (writes < FTL_LOGICAL_PAGES))
+	{
+		logicalPage = writes;
+	}
+	else if((PATTERN_UNIFORM != pattern) && (((uint32_t)rand() % 100u) < HOT_PERCENT))
+	{
+		logicalPage = (uint32_t)rand() % HOT_PAGES;
+	}
+	else
+	{
+		logicalPage = (uint32_t)rand() % FTL_LOGICAL_PAGES;
+	}
+
+	return logicalPage;
+}
+
+
+/*******************************************************************************
+* Function Name: WritePages
+****************************************************************************//**
+*
+* Writes the given number of pages, remounting the FTL after each power cut.
+* Returns false if a write or a remount fails.
+*
+*******************************************************************************/
+static bool WritePages(write_pattern_t pattern, uint32_t writeCount, uint32_t cutInterval)
+{
+	uint8_t data[FTL_PAGE_DATA_SIZE];
+	volatile uint32_t writes = 0u;
+	volatile uint32_t version = ERASED_VERSION + 1u;
+	volatile bool isValid = true;
+	uint32_t logicalPage;
+
+	/* A power cut during a write comes back here */
+	if(0 != setjmp(powerCut))
+	{
+		isValid = Remount(cutInterval);
+	}
+
+	while(isValid && (writes < writeCount))
+	{
+		if(0u != cutInterval)
+		{
+			NorModel_SetPowerCut(rand() % cutInterval, &powerCut);
+		}
+
+		logicalPage = NextPage(pattern, writes);
+		writtenPage = logicalPage;
+		writtenVersion = version;
+		FillPage(data, logicalPage, version);
+
+		if(CY_SMIF_SUCCESS != FtlWrite(logicalPage, data))
+		{
+			printf("FAIL: write %lu\n", (unsigned long)writes);
+			isValid = false;
+		}
+		else
+		{
+			NorModel_SetPowerCut(-1, NULL);
+			ackedVersion[logicalPage] = version;
+			writtenPage = NO_PAGE;
+			version++;
+			writes++;
+		}
+	}
+
+	NorModel_SetPowerCut(-1, NULL);
+
+	return isValid;
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the test with the parameters of the command line.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+	uint32_t writeCount = (argc > 1) ? strtoul(argv[1], NULL, 0) : DEFAULT_WRITES;
+	uint32_t cutInterval = (argc > 2) ? strtoul(argv[2], NULL, 0) : 0u;
+	write_pattern_t pattern = (argc > 3) ? ParsePattern(argv[3]) : PATTERN_UNIFORM;
+	nor_model_stats_t modelStats;
+	ftl_stats_t stats;
+	bool isValid;
+
+	if(PATTERN_UNKNOWN == pattern)
+	{
+		printf("Unknown pattern %s\n", argv[3]);
+		return 2;
+	}
+
+	srand((argc > 4) ? (unsigned int)strtoul(argv[4], NULL, 0) : 1u);
+
+	printf("FTL test: %lu blocks, %lu logical pages, %lu writes, %s pattern, ",
+			(unsigned long)FTL_NUM_BLOCKS, (unsigned long)FTL_LOGICAL_PAGES,
+			(unsigned long)writeCount, patternNames[pattern]);
+	if(0u != cutInterval)
+	{
+		printf("power cut every %lu operations on average\n", (unsigned long)(cutInterval / 2u));
+	}
+	else
+	{
+		printf("no power cut\n");
+	}
+
+	/* The FTL region starts with foreign content */
+	NorModel_Fill(FTL_BASE_ADDRESS, FTL_NUM_BLOCKS * FTL_BLOCK_SIZE, 0x5Au);
+	mounts++;
+	if(CY_SMIF_SUCCESS != FtlMount(smifMemConfigs[0]))
+	{
+		printf("FAIL: first mount\n");
+		return 1;
+	}
+
+	isValid = WritePages(pattern, writeCount, cutInterval);
+
+	if(isValid)
+	{
+		AddStats();
+		mounts++;
+		isValid = VerifyPages() && (CY_SMIF_SUCCESS == FtlMount(smifMemConfigs[0])) && VerifyPages();
+	}
+
+	NorModel_GetStats(&modelStats, false);
+	if(0u != modelStats.protocolErrors)
+	{
+		printf("FAIL: %lu commands ignored by the memory\n", (unsigned long)modelStats.protocolErrors);
+		isValid = false;
+	}
+
+	if(isValid)
+	{
+		FtlGetStats(&stats);
+		printf("%lu writes, %lu mounts, %lu power cuts, %.1f s of memory time\n",
+				(unsigned long)writeCount, (unsigned long)mounts, (unsigned long)modelStats.powerCuts,
+				(double)modelStats.time / 1e6);
+		printf("Host writes %llu, flash writes %llu, erases %llu, write amplification %.2f\n",
+				(unsigned long long)hostWrites, (unsigned long long)flashWrites,
+				(unsigned long long)erases, (double)flashWrites / (double)hostWrites);
+		printf("Erase counts %lu..%lu\n",
+				(unsigned long)stats.minEraseCount, (unsigned long)stats.maxEraseCount);
+		printf("PASS\n");
+	}
+
+	return isValid ? 0 : 1;
+}
+
@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name: cy_pdl.h
+*
+* Version: 1.0
+*
+* Description:
+* 	Host replacement of the Peripheral Driver Library header. It declares the
+* 	subset of the SMIF driver used by smif_mem.c and ftl.c, which is
+* 	implemented by the NOR flash model (nor_flash_model.c).
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#ifndef HOST_CY_PDL_H
+#define HOST_CY_PDL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/***************************************************************************
+* Data Types
+***************************************************************************/
+typedef enum
+{
+	CY_SMIF_SUCCESS = 0,
+	CY_SMIF_CMD_FIFO_FULL,
+	CY_SMIF_EXCEED_TIMEOUT,
+	CY_SMIF_NO_QE_BIT,
+	CY_SMIF_BAD_PARAM,
+	CY_SMIF_NO_SFDP_SUPPORT
+} cy_en_smif_status_t;
+
+typedef enum
+{
+	CY_SMIF_STARTED = 0,
+	CY_SMIF_SEND_CMPLT,
+	CY_SMIF_SEND_BUSY,
+	CY_SMIF_REC_CMPLT,
+	CY_SMIF_REC_BUSY
+} cy_en_smif_txfr_status_t;
+
+typedef enum
+{
+	CY_SMIF_WIDTH_SINGLE = 0,
+	CY_SMIF_WIDTH_DUAL,
+	CY_SMIF_WIDTH_QUAD,
+	CY_SMIF_WIDTH_OCTAL
+} cy_en_smif_txfr_width_t;
+
+#define CY_SMIF_TX_NOT_LAST_BYTE	(0u)
+#define CY_SMIF_TX_LAST_BYTE		(1u)
+
+typedef void (*cy_smif_event_cb_t)(uint32_t event);
+
+typedef struct
+{
+	uint32_t command;
+} cy_stc_smif_mem_cmd_t;
+
+/* Fields of the memory device configuration used by smif_mem.c */
+typedef struct
+{
+	uint32_t numOfAddrBytes;
+	uint32_t memSize;
+	cy_stc_smif_mem_cmd_t *readStsRegQeCmd;
+	uint32_t stsRegQuadEnableMask;
+	uint32_t eraseSize;
+	uint32_t programSize;
+	uint32_t eraseTime;			/* ms */
+	uint32_t chipEraseTime;		/* ms */
+	uint32_t programTime;		/* us */
+} cy_stc_smif_mem_device_cfg_t;
+
+typedef struct
+{
+	uint32_t slaveSelect;
+	uint32_t dataSelect;
+	uint32_t flags;
+	cy_stc_smif_mem_device_cfg_t *deviceCfg;
+	uint32_t baseAddress;
+	uint32_t memMappedSize;
+} cy_stc_smif_mem_config_t;
+
+typedef struct
+{
+	uint32_t txfrStatus;
+} cy_stc_smif_context_t;
+
+typedef struct
+{
+	uint32_t id;
+} SMIF_Type;
+
+
+/***************************************************************************
+* Function Prototypes
+***************************************************************************/
+void Cy_SysLib_Delay(uint32_t milliseconds);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base);
+uint32_t Cy_SMIF_GetTxfrStatus(SMIF_Type const *base, cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_TransmitCommand(SMIF_Type *base, uint8_t cmd, cy_en_smif_txfr_width_t cmdTxfrWidth,
+							uint8_t const cmdParam[], uint32_t paramSize, cy_en_smif_txfr_width_t paramTxfrWidth,
+							uint32_t slaveSelect, uint32_t completeTxfr, cy_stc_smif_context_t const *context);
+
+bool Cy_SMIF_Memslot_IsBusy(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice, cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdReadSts(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							uint8_t *status, uint8_t command, cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdWriteEnable(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_QuadEnable(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+							cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdRead(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							uint8_t const *addr, uint8_t *readBuff, uint32_t size, cy_smif_event_cb_t cmdCmpltCb,
+							cy_stc_smif_context_t *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdProgram(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							uint8_t const *addr, uint8_t *writeBuff, uint32_t size, cy_smif_event_cb_t cmdCmpltCb,
+							cy_stc_smif_context_t *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdSectorErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+							uint8_t const *sectorAddr, cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdChipErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+							cy_stc_smif_context_t const *context);
+
+#endif /* HOST_CY_PDL_H */
+
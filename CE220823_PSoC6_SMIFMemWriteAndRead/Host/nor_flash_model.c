@@ -0,0 +1,759 @@
+/******************************************************************************
+* File Name: nor_flash_model.c
+*
+* Version: 1.0
+*
+* Description:
+* 	This file contains the NOR flash model used by the host build. It replaces
+* 	the SMIF driver functions used by smif_mem.c and emulates the S25FL512S of
+* 	the kit: programming only clears bits, a program wraps within its page,
+* 	and the read, program and erase operations take simulated time, which the
+* 	delay functions advance.
+*
+* 	A power cut can be scheduled on a program or erase operation. The operation
+* 	is then left partially done, as on a real memory, and the model jumps back
+* 	to the caller, which remounts the flash translation layer.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "cycfg.h"
+#include "cycfg_qspi_memslot.h"
+#include "nor_flash_model.h"
+
+
+/***************************************************************************
+* Local constants
+***************************************************************************/
+#define NOR_MODEL_CMD_READ_STS1		(0x05u)		/* Status register 1 */
+#define NOR_MODEL_CMD_READ_CFG		(0x35u)		/* Configuration register */
+#define NOR_MODEL_CMD_SUSPEND		(0x75u)
+#define NOR_MODEL_CMD_RESUME		(0x7Au)
+
+#define NOR_MODEL_STS_WIP			(0x01u)		/* Write in progress */
+#define NOR_MODEL_STS_WEL			(0x02u)		/* Write enable latch */
+#define NOR_MODEL_CFG_QUAD			(0x02u)		/* Quad enable */
+
+#define NOR_MODEL_NO_SECTOR			(0xFFFFFFFFul)
+
+/* Bytes partially programmed by a power cut */
+#define NOR_MODEL_CUT_PARTIAL_SIZE	(16u)
+
+
+/***************************************************************************
+* Global variables
+***************************************************************************/
+SMIF_Type NorModelSmif;
+
+static cy_stc_smif_mem_cmd_t norModelReadCfgCmd =
+{
+	.command = NOR_MODEL_CMD_READ_CFG
+};
+
+static cy_stc_smif_mem_device_cfg_t norModelDeviceCfg =
+{
+	.numOfAddrBytes = 3u,
+	.memSize = NOR_MODEL_MEMORY_SIZE,
+	.readStsRegQeCmd = &norModelReadCfgCmd,
+	.stsRegQuadEnableMask = NOR_MODEL_CFG_QUAD,
+	.eraseSize = NOR_MODEL_SECTOR_SIZE,
+	.programSize = NOR_MODEL_PAGE_SIZE,
+	.eraseTime = NOR_MODEL_ERASE_TIME / 1000u,
+	.chipEraseTime = NOR_MODEL_CHIP_ERASE_TIME / 1000u,
+	.programTime = NOR_MODEL_PROGRAM_TIME
+};
+
+static cy_stc_smif_mem_config_t norModelMemConfig =
+{
+	.slaveSelect = 0u,
+	.dataSelect = 0u,
+	.flags = 0u,
+	.deviceCfg = &norModelDeviceCfg,
+	.baseAddress = 0x18000000ul,
+	.memMappedSize = 0x10000ul
+};
+
+const cy_stc_smif_mem_config_t* const smifMemConfigs[CY_SMIF_DEVICE_NUM] =
+{
+	&norModelMemConfig
+};
+
+static uint8_t memory[NOR_MODEL_MEMORY_SIZE];
+static nor_model_stats_t modelStats;
+
+/* State of the memory */
+static uint64_t busyUntil = 0u;			/* End of the current operation */
+static bool writeEnabled = false;
+static uint32_t erasingSector = NOR_MODEL_NO_SECTOR;	/* Sector erase in progress */
+static uint32_t suspendedSector = NOR_MODEL_NO_SECTOR;
+static uint64_t suspendedTime = 0u;		/* Time left to the suspended erase */
+
+/* Transfer in progress on the SMIF block */
+static cy_smif_event_cb_t transferCallback = NULL;
+static uint32_t transferEvent = 0u;
+static uint64_t transferEnd = 0u;
+static cy_stc_smif_context_t *transferContext = NULL;
+
+/* Power cut */
+static int32_t cutCountdown = -1;
+static jmp_buf *cutTarget = NULL;
+
+
+/*******************************************************************************
+* Function Name: Advance
+****************************************************************************//**
+*
+* Advances the simulated time, and completes the transfer in progress when its
+* end is reached.
+*
+* \param time
+* Time in microseconds.
+*
+*******************************************************************************/
+static void Advance(uint64_t time)
+{
+	cy_smif_event_cb_t callback = transferCallback;
+
+	modelStats.time += time;
+
+	if((NULL != callback) && (modelStats.time >= transferEnd))
+	{
+		transferCallback = NULL;
+		transferContext->txfrStatus = transferEvent;
+		callback(transferEvent);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: IsBusy
+****************************************************************************//**
+*
+* Returns true if a program or erase operation is in progress.
+*
+*******************************************************************************/
+static bool IsBusy(void)
+{
+	return (modelStats.time < busyUntil);
+}
+
+
+/*******************************************************************************
+* Function Name: DecodeAddress
+****************************************************************************//**
+*
+* Returns the address sent with a command, MSB first.
+*
+*******************************************************************************/
+static uint32_t DecodeAddress(cy_stc_smif_mem_config_t const *memDevice, uint8_t const *addr)
+{
+	uint32_t address = 0u;
+	uint32_t index;
+
+	for(index = 0u; index < memDevice->deviceCfg->numOfAddrBytes; index++)
+	{
+		address = (address << 8u) | addr[index];
+	}
+
+	return address % NOR_MODEL_MEMORY_SIZE;
+}
+
+
+/*******************************************************************************
+* Function Name: StartTransfer
+****************************************************************************//**
+*
+* Starts a read or program transfer, which completes after the time taken by
+* its data at the quad rate.
+*
+*******************************************************************************/
+static void StartTransfer(uint32_t size, uint32_t event, cy_smif_event_cb_t callback, cy_stc_smif_context_t *context)
+{
+	transferEnd = modelStats.time + 1u + (size / NOR_MODEL_BYTES_PER_US);
+	transferEvent = event;
+	transferContext = context;
+	context->txfrStatus = (CY_SMIF_REC_CMPLT == event) ? CY_SMIF_REC_BUSY : CY_SMIF_SEND_BUSY;
+
+	/* The PDL reports the completion through the callback only when there is
+	 * one, but the status is always updated
+	 */
+	transferCallback = callback;
+	if(NULL == callback)
+	{
+		context->txfrStatus = event;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: IsCutDue
+****************************************************************************//**
+*
+* Counts a program or erase operation, and returns true if the power is cut
+* during it.
+*
+*******************************************************************************/
+static bool IsCutDue(void)
+{
+	bool isDue = false;
+
+	if(cutCountdown >= 0)
+	{
+		isDue = (0 == cutCountdown);
+		cutCountdown--;
+	}
+
+	return isDue;
+}
+
+
+/*******************************************************************************
+* Function Name: CutPower
+****************************************************************************//**
+*
+* Jumps back to the target of the power cut. The memory stops where the cut
+* left it.
+*
+*******************************************************************************/
+static void CutPower(void)
+{
+	modelStats.powerCuts++;
+	NorModel_PowerCycle();
+	longjmp(*cutTarget, 1);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysLib_Delay
+****************************************************************************//**
+*
+* Advances the simulated time by the given number of milliseconds.
+*
+*******************************************************************************/
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+	Advance((uint64_t)milliseconds * 1000u);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysLib_DelayUs
+****************************************************************************//**
+*
+* Advances the simulated time by the given number of microseconds.
+*
+*******************************************************************************/
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+	Advance(microseconds);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_BusyCheck
+****************************************************************************//**
+*
+* Commands are sent at once by the emulated SMIF block.
+*
+*******************************************************************************/
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base)
+{
+	(void)base;
+
+	return false;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_GetTxfrStatus
+****************************************************************************//**
+*
+* Returns the status of the last read or program transfer.
+*
+*******************************************************************************/
+uint32_t Cy_SMIF_GetTxfrStatus(SMIF_Type const *base, cy_stc_smif_context_t const *context)
+{
+	(void)base;
+
+	return context->txfrStatus;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_TransmitCommand
+****************************************************************************//**
+*
+* Emulates the erase suspend and resume commands. The memory ignores them when
+* there is no erase to suspend or resume.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_TransmitCommand(SMIF_Type *base, uint8_t cmd, cy_en_smif_txfr_width_t cmdTxfrWidth,
+							uint8_t const cmdParam[], uint32_t paramSize, cy_en_smif_txfr_width_t paramTxfrWidth,
+							uint32_t slaveSelect, uint32_t completeTxfr, cy_stc_smif_context_t const *context)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+	(void)base;
+	(void)cmdTxfrWidth;
+	(void)cmdParam;
+	(void)paramSize;
+	(void)paramTxfrWidth;
+	(void)slaveSelect;
+	(void)completeTxfr;
+	(void)context;
+
+	Advance(1u);
+
+	if(NOR_MODEL_CMD_SUSPEND == cmd)
+	{
+		if(IsBusy() && (NOR_MODEL_NO_SECTOR != erasingSector))
+		{
+			suspendedSector = erasingSector;
+			suspendedTime = busyUntil - modelStats.time;
+			busyUntil = modelStats.time + NOR_MODEL_SUSPEND_TIME;
+			erasingSector = NOR_MODEL_NO_SECTOR;
+			modelStats.suspends++;
+		}
+	}
+	else if(NOR_MODEL_CMD_RESUME == cmd)
+	{
+		if(!IsBusy() && (NOR_MODEL_NO_SECTOR != suspendedSector))
+		{
+			busyUntil = modelStats.time + suspendedTime;
+			erasingSector = suspendedSector;
+			suspendedSector = NOR_MODEL_NO_SECTOR;
+		}
+	}
+	else
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_IsBusy
+****************************************************************************//**
+*
+* Polls the status register of the memory.
+*
+*******************************************************************************/
+bool Cy_SMIF_Memslot_IsBusy(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice, cy_stc_smif_context_t const *context)
+{
+	(void)base;
+	(void)memDevice;
+	(void)context;
+
+	Advance(1u);
+
+	return IsBusy();
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_CmdReadSts
+****************************************************************************//**
+*
+* Reads the status register or the configuration register. Quad mode is always
+* enabled.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdReadSts(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							uint8_t *status, uint8_t command, cy_stc_smif_context_t const *context)
+{
+	cy_en_smif_status_t result = CY_SMIF_SUCCESS;
+
+	(void)base;
+	(void)memDevice;
+	(void)context;
+
+	Advance(1u);
+
+	if(NOR_MODEL_CMD_READ_CFG == command)
+	{
+		*status = NOR_MODEL_CFG_QUAD;
+	}
+	else if(NOR_MODEL_CMD_READ_STS1 == command)
+	{
+		*status = (IsBusy() ? NOR_MODEL_STS_WIP : 0u) | (writeEnabled ? NOR_MODEL_STS_WEL : 0u);
+	}
+	else
+	{
+		result = CY_SMIF_BAD_PARAM;
+	}
+
+	return result;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_CmdWriteEnable
+****************************************************************************//**
+*
+* Sets the write enable latch, which allows the next program or erase.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdWriteEnable(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							cy_stc_smif_context_t const *context)
+{
+	(void)base;
+	(void)memDevice;
+	(void)context;
+
+	Advance(1u);
+
+	if(IsBusy())
+	{
+		modelStats.protocolErrors++;
+	}
+	else
+	{
+		writeEnabled = true;
+	}
+
+	return CY_SMIF_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_QuadEnable
+****************************************************************************//**
+*
+* Quad mode is always enabled in the model.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_QuadEnable(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+							cy_stc_smif_context_t const *context)
+{
+	(void)base;
+	(void)memDevice;
+	(void)context;
+
+	writeEnabled = false;
+
+	return CY_SMIF_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_CmdRead
+****************************************************************************//**
+*
+* Reads the memory. Reading while a program or erase is in progress, or from
+* the sector of a suspended erase, returns undefined data.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdRead(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							uint8_t const *addr, uint8_t *readBuff, uint32_t size, cy_smif_event_cb_t cmdCmpltCb,
+							cy_stc_smif_context_t *context)
+{
+	uint32_t address = DecodeAddress(memDevice, addr);
+	uint32_t index;
+
+	(void)base;
+
+	if(IsBusy() || ((NOR_MODEL_NO_SECTOR != suspendedSector) &&
+	   ((address / NOR_MODEL_SECTOR_SIZE) <= suspendedSector) &&
+	   (((address + size - 1u) / NOR_MODEL_SECTOR_SIZE) >= suspendedSector)))
+	{
+		modelStats.protocolErrors++;
+		for(index = 0u; index < size; index++)
+		{
+			readBuff[index] = (uint8_t)rand();
+		}
+	}
+	else
+	{
+		for(index = 0u; index < size; index++)
+		{
+			readBuff[index] = memory[(address + index) % NOR_MODEL_MEMORY_SIZE];
+		}
+	}
+
+	StartTransfer(size, CY_SMIF_REC_CMPLT, cmdCmpltCb, context);
+
+	return CY_SMIF_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_CmdProgram
+****************************************************************************//**
+*
+* Programs up to a page. The address wraps to the start of the page when the
+* data runs past its end. The memory programs the data in order, so a power cut
+* leaves the start of the data programmed, a few bytes partially programmed and
+* the rest of the page unchanged.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdProgram(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+							uint8_t const *addr, uint8_t *writeBuff, uint32_t size, cy_smif_event_cb_t cmdCmpltCb,
+							cy_stc_smif_context_t *context)
+{
+	uint32_t address = DecodeAddress(memDevice, addr);
+	uint32_t page = address - (address % NOR_MODEL_PAGE_SIZE);
+	uint32_t offset = address - page;
+	uint32_t index;
+	uint32_t cutOffset = size;
+
+	(void)base;
+
+	if(IsBusy() || !writeEnabled || ((offset + size) > NOR_MODEL_PAGE_SIZE) ||
+	   ((page / NOR_MODEL_SECTOR_SIZE) == suspendedSector))
+	{
+		modelStats.protocolErrors++;
+	}
+
+	if(!IsBusy() && writeEnabled)
+	{
+		if(IsCutDue())
+		{
+			cutOffset = (uint32_t)rand() % size;
+		}
+
+		for(index = 0u; index < size; index++)
+		{
+			uint8_t data = writeBuff[index];
+
+			if(index >= (cutOffset + NOR_MODEL_CUT_PARTIAL_SIZE))
+			{
+				data = 0xFFu;
+			}
+			else if(index >= cutOffset)
+			{
+				/* Only some of the bits are programmed */
+				data |= (uint8_t)rand();
+			}
+
+			memory[page + ((offset + index) % NOR_MODEL_PAGE_SIZE)] &= data;
+		}
+
+		if(cutOffset < size)
+		{
+			CutPower();
+		}
+
+		writeEnabled = false;
+		erasingSector = NOR_MODEL_NO_SECTOR;
+		modelStats.programs++;
+		StartTransfer(size, CY_SMIF_SEND_CMPLT, cmdCmpltCb, context);
+		busyUntil = transferEnd + ((NOR_MODEL_PROGRAM_TIME * size) / NOR_MODEL_PAGE_SIZE);
+	}
+
+	return CY_SMIF_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_CmdSectorErase
+****************************************************************************//**
+*
+* Erases a sector. A power cut leaves it partially erased, or with random data.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdSectorErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+							uint8_t const *sectorAddr, cy_stc_smif_context_t const *context)
+{
+	uint32_t sector = DecodeAddress(memDevice, sectorAddr) / NOR_MODEL_SECTOR_SIZE;
+	uint8_t *data = &memory[sector * NOR_MODEL_SECTOR_SIZE];
+	uint32_t index;
+
+	(void)base;
+	(void)context;
+
+	Advance(1u);
+
+	if(IsBusy() || !writeEnabled || (NOR_MODEL_NO_SECTOR != suspendedSector))
+	{
+		modelStats.protocolErrors++;
+	}
+	else if(IsCutDue())
+	{
+		/* Most of the sector is erased, or most of it is left as it was */
+		bool mostlyErased = (0 != (rand() % 2));
+
+		for(index = 0u; index < NOR_MODEL_SECTOR_SIZE; index++)
+		{
+			uint32_t draw = (uint32_t)rand() % 4u;
+
+			if((mostlyErased && (0u != draw)) || (!mostlyErased && (0u == draw)))
+			{
+				data[index] = 0xFFu;
+			}
+			else if(1u == draw)
+			{
+				data[index] = (uint8_t)rand();
+			}
+		}
+
+		CutPower();
+	}
+	else
+	{
+		memset(data, 0xFF, NOR_MODEL_SECTOR_SIZE);
+		writeEnabled = false;
+		erasingSector = sector;
+		busyUntil = modelStats.time + NOR_MODEL_ERASE_TIME;
+		modelStats.erases++;
+	}
+
+	return CY_SMIF_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_CmdChipErase
+****************************************************************************//**
+*
+* Erases the whole memory. It is not interrupted by power cuts, and cannot be
+* suspended.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdChipErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+							cy_stc_smif_context_t const *context)
+{
+	(void)base;
+	(void)memDevice;
+	(void)context;
+
+	Advance(1u);
+
+	if(IsBusy() || !writeEnabled || (NOR_MODEL_NO_SECTOR != suspendedSector))
+	{
+		modelStats.protocolErrors++;
+	}
+	else
+	{
+		memset(memory, 0xFF, NOR_MODEL_MEMORY_SIZE);
+		writeEnabled = false;
+		erasingSector = NOR_MODEL_NO_SECTOR;
+		busyUntil = modelStats.time + NOR_MODEL_CHIP_ERASE_TIME;
+		modelStats.erases++;
+	}
+
+	return CY_SMIF_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: NorModel_Fill
+****************************************************************************//**
+*
+* Fills a range of the memory, e.g. with foreign content before a mount.
+*
+* \param address
+* Start of the range.
+*
+* \param size
+* Size of the range in bytes.
+*
+* \param value
+* Value of the bytes.
+*
+*******************************************************************************/
+void NorModel_Fill(uint32_t address, uint32_t size, uint8_t value)
+{
+	memset(&memory[address], value, size);
+}
+
+
+/*******************************************************************************
+* Function Name: NorModel_SetPowerCut
+****************************************************************************//**
+*
+* Schedules a power cut. The power is cut during a program or erase operation,
+* and the model then jumps to the target with longjmp().
+*
+* \param operations
+* Number of program and erase operations completed before the cut. A negative
+* number cancels the power cut.
+*
+* \param target
+* Jump buffer set by setjmp().
+*
+*******************************************************************************/
+void NorModel_SetPowerCut(int32_t operations, jmp_buf *target)
+{
+	cutCountdown = operations;
+	cutTarget = target;
+}
+
+
+/*******************************************************************************
+* Function Name: NorModel_PowerCycle
+****************************************************************************//**
+*
+* Stops the operation in progress and resets the state of the memory, as a
+* power on reset does. The content of the memory is kept.
+*
+*******************************************************************************/
+void NorModel_PowerCycle(void)
+{
+	busyUntil = modelStats.time;
+	writeEnabled = false;
+	erasingSector = NOR_MODEL_NO_SECTOR;
+	suspendedSector = NOR_MODEL_NO_SECTOR;
+	transferCallback = NULL;
+	cutCountdown = -1;
+}
+
+
+/*******************************************************************************
+* Function Name: NorModel_GetStats
+****************************************************************************//**
+*
+* Returns the activity counters of the model.
+*
+* \param stats
+* Receives the counters.
+*
+* \param reset
+* Clears the counters, except the simulated time.
+*
+*******************************************************************************/
+void NorModel_GetStats(nor_model_stats_t *stats, bool reset)
+{
+	uint64_t time = modelStats.time;
+
+	*stats = modelStats;
+
+	if(reset)
+	{
+		memset(&modelStats, 0, sizeof(modelStats));
+		modelStats.time = time;
+	}
+}
+
@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name: nor_flash_model.h
+*
+* Version: 1.0
+*
+* Description:
+* 	This file contains the interface of the NOR flash model used by the host
+* 	build. The model emulates the S25FL512S of the kit behind the SMIF driver
+* 	functions used by smif_mem.c, and can cut the power in the middle of a
+* 	program or erase operation.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#ifndef HOST_NOR_FLASH_MODEL_H
+#define HOST_NOR_FLASH_MODEL_H
+
+#include <setjmp.h>
+#include "cy_pdl.h"
+
+
+/***************************************************************************
+* Global Constants
+***************************************************************************/
+/* Geometry of the S25FL512S */
+#define NOR_MODEL_MEMORY_SIZE		(0x04000000ul)
+#define NOR_MODEL_SECTOR_SIZE		(0x00040000ul)
+#define NOR_MODEL_PAGE_SIZE			(512u)
+
+/* Operation times, in microseconds: the times of the memory slot configuration
+ * for the program and erase operations, and the typical suspend latency
+ */
+#define NOR_MODEL_PROGRAM_TIME		(340ul)		/* One page */
+#define NOR_MODEL_ERASE_TIME		(520000ul)	/* One sector */
+#define NOR_MODEL_CHIP_ERASE_TIME	(134000000ul)
+#define NOR_MODEL_SUSPEND_TIME		(20ul)
+
+/* Quad read and program transfers */
+#define NOR_MODEL_BYTES_PER_US		(25ul)
+
+
+/***************************************************************************
+* Data Types
+***************************************************************************/
+/* Activity counters of the model */
+typedef struct
+{
+	uint32_t programs;			/* Page programs completed */
+	uint32_t erases;			/* Sector and chip erases started */
+	uint32_t suspends;			/* Erases suspended */
+	uint32_t powerCuts;			/* Operations interrupted by a power cut */
+	uint32_t protocolErrors;	/* Commands the memory would ignore: sent
+								   while busy or without a write enable,
+								   programs past the end of a page, reads of a
+								   sector whose erase is suspended */
+	uint64_t time;				/* Simulated time, in us */
+} nor_model_stats_t;
+
+
+/***************************************************************************
+* Function Prototypes
+***************************************************************************/
+void NorModel_Fill(uint32_t address, uint32_t size, uint8_t value);
+void NorModel_SetPowerCut(int32_t operations, jmp_buf *target);
+void NorModel_PowerCycle(void);
+void NorModel_GetStats(nor_model_stats_t *stats, bool reset);
+
+#endif /* HOST_NOR_FLASH_MODEL_H */
+
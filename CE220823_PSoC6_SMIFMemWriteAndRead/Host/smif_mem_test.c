@@ -0,0 +1,728 @@
+/******************************************************************************
+* File Name: smif_mem_test.c
+*
+* Version: 1.0
+*
+* Description:
+* 	This file contains the test and the benchmark of the memory functions of
+* 	smif_mem.c, run on the NOR flash model of the host build.
+*
+* 	WriteMemoryRange() writes random data at aligned and unaligned addresses,
+* 	into erased sectors and into sectors it erases on demand. The test checks
+* 	the program and erase operations issued and reads the sectors back, then
+* 	reports the write rate in the simulated time of the model, which uses the
+* 	typical program and erase times of the S25FL512S.
+*
+* 	A range of sectors is then erased in the background, while another sector
+* 	is read with ReadMemoryDuringErase(). The test checks the data read, that
+* 	reads of the sector being erased are rejected, that an erase suspended by
+* 	continuous reads still progresses, and that a chip erase is never
+* 	suspended. It reports the erase times and the read latency.
+*
+* 	Usage: smif_mem_test
+* 	The program returns a non-zero exit code if the test fails.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cycfg_qspi_memslot.h"
+#include "smif_mem.h"
+#include "nor_flash_model.h"
+
+
+/***************************************************************************
+* Global constants
+***************************************************************************/
+/* Largest span of sectors a write case covers */
+#define MAX_SPAN_SIZE			(4ul * NOR_MODEL_SECTOR_SIZE)
+
+/* Content of the sectors before a write that erases them */
+#define FOREIGN_BYTE			(0x5Au)
+
+typedef struct
+{
+	char const *name;
+	uint32_t address;
+	uint32_t size;
+	bool eraseSectors;
+} write_case_t;
+
+/* Address of the writes, at a sector boundary. The unaligned erase case starts
+ * in the last pages of the first sector and continues in the second sector.
+ */
+#define WRITE_BASE				(0x00400000ul)
+
+static write_case_t const writeCases[] =
+{
+	{"aligned",			WRITE_BASE,				0x10000ul,			false},
+	{"unaligned",		WRITE_BASE + 77u,		0x10000ul + 123u,	false},
+	{"short unaligned",	WRITE_BASE + 1000u,		100u,				false},
+	{"erase aligned",	WRITE_BASE,				0x80000ul,			true},
+	{"erase unaligned",	WRITE_BASE + 0x3D04Dul,	0x8000ul + 123u,	true}
+};
+
+#define WRITE_CASES				(sizeof(writeCases) / sizeof(writeCases[0]))
+
+/* Range erased in the background, and the sector read during the erase */
+#define ERASE_BASE				(0x00800000ul)
+#define ERASE_SIZE				(3ul * NOR_MODEL_SECTOR_SIZE)
+#define READ_BASE				(ERASE_BASE + ERASE_SIZE)
+
+/* Reads during the background erase: one read of READ_SIZE bytes every
+ * READ_INTERVAL
+ */
+#define READ_SIZE				(256u)
+#define READ_INTERVAL			(1000u)		/* microseconds */
+
+/* Interval between the calls of ProcessErase() during a chip erase */
+#define CHIP_ERASE_POLL_INTERVAL	(10u)	/* milliseconds */
+
+/* Transfers with registered wait functions: a read, and a write of
+ * WAIT_PAGES pages
+ */
+#define WAIT_BASE				(0x00C00000ul)
+#define WAIT_READ_SIZE			(4096u)
+#define WAIT_PAGES				(2u)
+
+
+/***************************************************************************
+* Global variables
+***************************************************************************/
+cy_stc_smif_context_t KIT_QSPI_context;
+
+/* Data written, expected memory content and content read back */
+static uint8_t writeData[MAX_SPAN_SIZE];
+static uint8_t expected[MAX_SPAN_SIZE];
+static uint8_t readBack[MAX_SPAN_SIZE];
+
+/* Calls of the registered wait functions */
+static uint32_t eventWaits;
+static uint32_t eventTimeout;
+static uint32_t delays;
+static uint32_t maxDelay;
+static bool staleEvent;
+static volatile bool isEvent;
+
+
+/*******************************************************************************
+* Function Name: SectorStart
+****************************************************************************//**
+*
+* Returns the address of the sector that contains the given address.
+*
+*******************************************************************************/
+static uint32_t SectorStart(uint32_t address)
+{
+	return address - (address % NOR_MODEL_SECTOR_SIZE);
+}
+
+
+/*******************************************************************************
+* Function Name: Now
+****************************************************************************//**
+*
+* Returns the simulated time, in microseconds.
+*
+*******************************************************************************/
+static uint64_t Now(void)
+{
+	nor_model_stats_t modelStats;
+
+	NorModel_GetStats(&modelStats, false);
+
+	return modelStats.time;
+}
+
+
+/*******************************************************************************
+* Function Name: ElapsedUs
+****************************************************************************//**
+*
+* Returns the simulated time since the given time stamp, in microseconds.
+*
+*******************************************************************************/
+static uint64_t ElapsedUs(uint64_t startTime)
+{
+	return Now() - startTime;
+}
+
+
+/*******************************************************************************
+* Function Name: TestWrite
+****************************************************************************//**
+*
+* Writes random data with WriteMemoryRange(), and checks the program and erase
+* operations, the content of the sectors around the data and the data read back.
+* Prints the time taken and the write rate.
+*
+*******************************************************************************/
+static bool TestWrite(cy_stc_smif_mem_config_t const *memConfig, write_case_t const *testCase)
+{
+	uint32_t spanStart = SectorStart(testCase->address);
+	uint32_t spanEnd = SectorStart(testCase->address + testCase->size - 1u) + NOR_MODEL_SECTOR_SIZE;
+	uint32_t spanSize = spanEnd - spanStart;
+	uint32_t offset = testCase->address - spanStart;
+	uint32_t expectedPages = ((testCase->address + testCase->size - 1u) / NOR_MODEL_PAGE_SIZE) -
+								(testCase->address / NOR_MODEL_PAGE_SIZE) + 1u;
+	uint32_t expectedErases = 0u;
+	nor_model_stats_t modelStats;
+	cy_en_smif_status_t status;
+	uint64_t timeUs;
+	uint32_t index;
+	bool isValid = true;
+
+	for(index = 0u; index < testCase->size; index++)
+	{
+		writeData[index] = (uint8_t)rand();
+	}
+
+	/* The sectors the write erases hold foreign content, the rest of the span
+	 * is erased
+	 */
+	NorModel_Fill(spanStart, spanSize, 0xFFu);
+	if(testCase->eraseSectors)
+	{
+		for(index = offset; index < (offset + testCase->size); index++)
+		{
+			if(0u == (index % NOR_MODEL_SECTOR_SIZE))
+			{
+				NorModel_Fill(spanStart + index, NOR_MODEL_SECTOR_SIZE, FOREIGN_BYTE);
+				expectedErases++;
+			}
+		}
+	}
+	memset(expected, 0xFF, spanSize);
+	memcpy(&expected[offset], writeData, testCase->size);
+
+	NorModel_GetStats(&modelStats, true);
+	status = WriteMemoryRange(memConfig, testCase->address, writeData, testCase->size, testCase->eraseSectors);
+	timeUs = ElapsedUs(modelStats.time);
+	NorModel_GetStats(&modelStats, true);
+
+	if(CY_SMIF_SUCCESS != status)
+	{
+		printf("FAIL: %s write, status 0x%lx\n", testCase->name, (unsigned long)status);
+		isValid = false;
+	}
+	else if((expectedPages != modelStats.programs) || (expectedErases != modelStats.erases))
+	{
+		printf("FAIL: %s write, %lu programs and %lu erases instead of %lu and %lu\n", testCase->name,
+				(unsigned long)modelStats.programs, (unsigned long)modelStats.erases,
+				(unsigned long)expectedPages, (unsigned long)expectedErases);
+		isValid = false;
+	}
+	else if((CY_SMIF_SUCCESS != ReadMemoryRange(memConfig, spanStart, readBack, spanSize)) ||
+			(0 != memcmp(readBack, expected, spanSize)))
+	{
+		printf("FAIL: %s write, the data read back differs\n", testCase->name);
+		isValid = false;
+	}
+	else
+	{
+		printf("%-18s 0x%08lx %8lu %6lu %6lu %9.1f %7.2f\n", testCase->name,
+				(unsigned long)testCase->address, (unsigned long)testCase->size,
+				(unsigned long)modelStats.programs, (unsigned long)modelStats.erases,
+				(double)timeUs / 1000.0, (double)testCase->size / (double)timeUs);
+	}
+
+	return isValid;
+}
+
+
+/*******************************************************************************
+* Function Name: TestWriteParameters
+****************************************************************************//**
+*
+* Checks that a write past the end of the memory is rejected without any
+* program operation.
+*
+*******************************************************************************/
+static bool TestWriteParameters(cy_stc_smif_mem_config_t const *memConfig)
+{
+	nor_model_stats_t modelStats;
+	cy_en_smif_status_t status;
+
+	NorModel_GetStats(&modelStats, true);
+	status = WriteMemoryRange(memConfig, NOR_MODEL_MEMORY_SIZE - 100u, writeData, 101u, false);
+	NorModel_GetStats(&modelStats, true);
+
+	if((CY_SMIF_BAD_PARAM != status) || (0u != modelStats.programs))
+	{
+		printf("FAIL: write past the end of the memory, status 0x%lx, %lu programs\n",
+				(unsigned long)status, (unsigned long)modelStats.programs);
+	}
+
+	return (CY_SMIF_BAD_PARAM == status) && (0u == modelStats.programs);
+}
+
+
+/*******************************************************************************
+* Function Name: IsRangeErased
+****************************************************************************//**
+*
+* Reads a range back and returns true if it is erased.
+*
+*******************************************************************************/
+static bool IsRangeErased(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint32_t size)
+{
+	bool isErased = (CY_SMIF_SUCCESS == ReadMemoryRange(memConfig, address, readBack, size));
+	uint32_t index;
+
+	for(index = 0u; isErased && (index < size); index++)
+	{
+		isErased = (0xFFu == readBack[index]);
+	}
+
+	return isErased;
+}
+
+
+/*******************************************************************************
+* Function Name: TestBackgroundErase
+****************************************************************************//**
+*
+* Erases a range of sectors with EraseMemoryRange(), then again in the
+* background with StartEraseMemoryRange() and ProcessErase(), reading another
+* sector with ReadMemoryDuringErase() every READ_INTERVAL. Checks the data read
+* during the erase, that the reads of the sector being erased are rejected, and
+* that the range is erased. Prints the erase times and the read latency.
+*
+*******************************************************************************/
+static bool TestBackgroundErase(cy_stc_smif_mem_config_t const *memConfig)
+{
+	nor_model_stats_t modelStats;
+	cy_en_smif_status_t status;
+	uint64_t blockingUs;
+	uint64_t backgroundUs;
+	uint64_t startTime;
+	uint64_t startRead;
+	uint64_t readUs;
+	uint64_t maxReadUs = 0u;
+	uint64_t totalReadUs = 0u;
+	uint32_t reads = 0u;
+	uint32_t offset;
+	uint32_t index;
+	bool isValid = true;
+
+	/* Blocking erase of the range */
+	NorModel_Fill(ERASE_BASE, ERASE_SIZE, FOREIGN_BYTE);
+	NorModel_GetStats(&modelStats, true);
+	status = EraseMemoryRange(memConfig, ERASE_BASE, ERASE_SIZE);
+	blockingUs = ElapsedUs(modelStats.time);
+	if((CY_SMIF_SUCCESS != status) || !IsRangeErased(memConfig, ERASE_BASE, ERASE_SIZE))
+	{
+		printf("FAIL: blocking erase, status 0x%lx\n", (unsigned long)status);
+		isValid = false;
+	}
+
+	/* The sector read during the erase holds random data */
+	for(index = 0u; index < NOR_MODEL_SECTOR_SIZE; index++)
+	{
+		writeData[index] = (uint8_t)rand();
+	}
+	NorModel_Fill(ERASE_BASE, ERASE_SIZE, FOREIGN_BYTE);
+	status = WriteMemoryRange(memConfig, READ_BASE, writeData, NOR_MODEL_SECTOR_SIZE, true);
+
+	/* Background erase of the range */
+	NorModel_GetStats(&modelStats, true);
+	startTime = modelStats.time;
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = StartEraseMemoryRange(memConfig, ERASE_BASE, ERASE_SIZE);
+	}
+	if(CY_SMIF_SUCCESS != status)
+	{
+		printf("FAIL: start of the background erase, status 0x%lx\n", (unsigned long)status);
+		isValid = false;
+	}
+
+	/* The first sector is being erased: reads of it, also across its start, are
+	 * rejected, and a second erase cannot be started. The next sector is not
+	 * erased yet.
+	 */
+	if(isValid &&
+	   ((CY_SMIF_BAD_PARAM != ReadMemoryDuringErase(memConfig, ERASE_BASE + 1000u, readBack, 16u)) ||
+		(CY_SMIF_BAD_PARAM != ReadMemoryDuringErase(memConfig, ERASE_BASE - 8u, readBack, 16u)) ||
+		(CY_SMIF_BAD_PARAM != StartEraseMemoryRange(memConfig, READ_BASE, NOR_MODEL_SECTOR_SIZE))))
+	{
+		printf("FAIL: read of the sector being erased, or second erase, accepted\n");
+		isValid = false;
+	}
+	if(isValid &&
+	   ((CY_SMIF_SUCCESS != ReadMemoryDuringErase(memConfig, ERASE_BASE + NOR_MODEL_SECTOR_SIZE, readBack, 16u)) ||
+		(FOREIGN_BYTE != readBack[0]) || (FOREIGN_BYTE != readBack[15])))
+	{
+		printf("FAIL: read of the next sector during the erase\n");
+		isValid = false;
+	}
+
+	while(isValid && IsEraseInProgress())
+	{
+		Cy_SysLib_DelayUs(READ_INTERVAL);
+
+		offset = (uint32_t)rand() % (NOR_MODEL_SECTOR_SIZE - READ_SIZE);
+		startRead = Now();
+		status = ReadMemoryDuringErase(memConfig, READ_BASE + offset, readBack, READ_SIZE);
+		readUs = ElapsedUs(startRead);
+
+		if((CY_SMIF_SUCCESS != status) || (0 != memcmp(readBack, &writeData[offset], READ_SIZE)))
+		{
+			printf("FAIL: read during the erase, status 0x%lx\n", (unsigned long)status);
+			isValid = false;
+		}
+		else if(CY_SMIF_SUCCESS != ProcessErase(memConfig))
+		{
+			printf("FAIL: background erase\n");
+			isValid = false;
+		}
+		else
+		{
+			reads++;
+			totalReadUs += readUs;
+			maxReadUs = (readUs > maxReadUs) ? readUs : maxReadUs;
+		}
+	}
+	backgroundUs = ElapsedUs(startTime);
+	NorModel_GetStats(&modelStats, true);
+
+	if(isValid && !IsRangeErased(memConfig, ERASE_BASE, ERASE_SIZE))
+	{
+		printf("FAIL: range not erased by the background erase\n");
+		isValid = false;
+	}
+	if(isValid && ((ERASE_SIZE / NOR_MODEL_SECTOR_SIZE) != modelStats.erases))
+	{
+		printf("FAIL: %lu sector erases\n", (unsigned long)modelStats.erases);
+		isValid = false;
+	}
+
+	if(isValid)
+	{
+		printf("Erase of %lu sectors: %.1f ms blocking, %.1f ms in the background with %lu reads of %u bytes\n",
+				(unsigned long)(ERASE_SIZE / NOR_MODEL_SECTOR_SIZE), (double)blockingUs / 1000.0,
+				(double)backgroundUs / 1000.0, (unsigned long)reads, (unsigned int)READ_SIZE);
+		printf("Read latency during the erase: %.0f us on average, %lu us max, %lu suspends\n",
+				(double)totalReadUs / (double)reads, (unsigned long)maxReadUs, (unsigned long)modelStats.suspends);
+	}
+
+	return isValid;
+}
+
+
+/*******************************************************************************
+* Function Name: TestEraseProgress
+****************************************************************************//**
+*
+* Reads continuously during the erase of a sector, so that the erase is
+* suspended again as soon as it is resumed. The erase must still complete, since
+* each resume lets it run for MEMORY_MIN_RESUME_TIME: the number of suspends is
+* bounded by the erase time divided by MEMORY_MIN_RESUME_TIME.
+*
+*******************************************************************************/
+static bool TestEraseProgress(cy_stc_smif_mem_config_t const *memConfig)
+{
+	uint32_t maxSuspends = (NOR_MODEL_ERASE_TIME / MEMORY_MIN_RESUME_TIME) + 1u;
+	nor_model_stats_t modelStats;
+	cy_en_smif_status_t status;
+	uint64_t eraseUs;
+	uint32_t reads = 0u;
+	bool isValid = true;
+
+	NorModel_Fill(ERASE_BASE, NOR_MODEL_SECTOR_SIZE, FOREIGN_BYTE);
+	NorModel_GetStats(&modelStats, true);
+	status = StartEraseMemoryRange(memConfig, ERASE_BASE, NOR_MODEL_SECTOR_SIZE);
+
+	while((CY_SMIF_SUCCESS == status) && IsEraseInProgress() && (reads <= maxSuspends))
+	{
+		status = ReadMemoryDuringErase(memConfig, READ_BASE, readBack, READ_SIZE);
+		reads++;
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			status = ProcessErase(memConfig);
+		}
+	}
+	eraseUs = ElapsedUs(modelStats.time);
+	NorModel_GetStats(&modelStats, true);
+
+	if((CY_SMIF_SUCCESS != status) || IsEraseInProgress() || (modelStats.suspends > maxSuspends) ||
+	   !IsRangeErased(memConfig, ERASE_BASE, NOR_MODEL_SECTOR_SIZE))
+	{
+		printf("FAIL: erase under continuous reads, status 0x%lx, %lu suspends\n",
+				(unsigned long)status, (unsigned long)modelStats.suspends);
+		isValid = false;
+	}
+	else
+	{
+		printf("Erase of 1 sector under continuous reads: %.1f ms, %lu reads, %lu suspends (max %lu)\n",
+				(double)eraseUs / 1000.0, (unsigned long)reads, (unsigned long)modelStats.suspends,
+				(unsigned long)maxSuspends);
+	}
+
+	return isValid;
+}
+
+
+/*******************************************************************************
+* Function Name: TestChipErase
+****************************************************************************//**
+*
+* Erases the whole memory in the background. A chip erase cannot be suspended:
+* SuspendErase() and the reads during the erase return CY_SMIF_BAD_PARAM.
+*
+*******************************************************************************/
+static bool TestChipErase(cy_stc_smif_mem_config_t const *memConfig)
+{
+	nor_model_stats_t modelStats;
+	cy_en_smif_status_t status;
+	uint64_t eraseUs;
+	bool isValid = true;
+
+	NorModel_Fill(ERASE_BASE, ERASE_SIZE, FOREIGN_BYTE);
+	NorModel_GetStats(&modelStats, true);
+	status = StartEraseMemoryRange(memConfig, 0u, NOR_MODEL_MEMORY_SIZE);
+
+	if((CY_SMIF_SUCCESS != status) ||
+	   (CY_SMIF_BAD_PARAM != SuspendErase(memConfig)) ||
+	   (CY_SMIF_BAD_PARAM != ReadMemoryDuringErase(memConfig, READ_BASE, readBack, READ_SIZE)))
+	{
+		printf("FAIL: chip erase suspended, status 0x%lx\n", (unsigned long)status);
+		isValid = false;
+	}
+
+	while((CY_SMIF_SUCCESS == status) && IsEraseInProgress())
+	{
+		Cy_SysLib_Delay(CHIP_ERASE_POLL_INTERVAL);
+		status = ProcessErase(memConfig);
+	}
+	eraseUs = ElapsedUs(modelStats.time);
+	NorModel_GetStats(&modelStats, true);
+
+	if(isValid && ((CY_SMIF_SUCCESS != status) || (1u != modelStats.erases) ||
+	   (eraseUs < NOR_MODEL_CHIP_ERASE_TIME) || !IsRangeErased(memConfig, ERASE_BASE, ERASE_SIZE)))
+	{
+		printf("FAIL: chip erase, status 0x%lx, %lu erases\n", (unsigned long)status, (unsigned long)modelStats.erases);
+		isValid = false;
+	}
+	else if(isValid)
+	{
+		printf("Chip erase: %.1f s, not suspended\n", (double)eraseUs / 1e6);
+	}
+	else
+	{
+		/* Failure reported */
+	}
+
+	return isValid;
+}
+
+
+/*******************************************************************************
+* Function Name: HostDelay
+****************************************************************************//**
+*
+* Registered wait function, counts the delays between the busy checks.
+*
+*******************************************************************************/
+static void HostDelay(uint32_t waitUs)
+{
+	delays++;
+	maxDelay = (waitUs > maxDelay) ? waitUs : maxDelay;
+	Cy_SysLib_DelayUs((uint16_t)waitUs);
+}
+
+
+/*******************************************************************************
+* Function Name: HostEventWait
+****************************************************************************//**
+*
+* Registered event wait function, blocks like a task on a semaphore given by
+* the event function. When staleEvent is set, returns right away as for the
+* event of an earlier transfer.
+*
+*******************************************************************************/
+static bool HostEventWait(uint32_t timeoutUs)
+{
+	uint32_t elapsed = 0u;
+	bool wasEvent;
+
+	eventWaits++;
+	eventTimeout = timeoutUs;
+
+	if(staleEvent)
+	{
+		staleEvent = false;
+		wasEvent = true;
+	}
+	else
+	{
+		while((!isEvent) && (elapsed < timeoutUs))
+		{
+			Cy_SysLib_DelayUs(1u);
+			elapsed++;
+		}
+		wasEvent = isEvent;
+		isEvent = false;
+	}
+
+	return wasEvent;
+}
+
+
+/*******************************************************************************
+* Function Name: HostEvent
+****************************************************************************//**
+*
+* Registered event function, gives the event HostEventWait() waits for.
+*
+*******************************************************************************/
+static void HostEvent(uint32_t event)
+{
+	(void)event;
+	isEvent = true;
+}
+
+
+/*******************************************************************************
+* Function Name: TestWaitFunctions
+****************************************************************************//**
+*
+* Reads and writes with registered wait functions. Each transfer is waited for
+* by one call of the event wait function with the whole transfer timeout, plus
+* one call for an event of an earlier transfer. The busy checks of the program
+* operations use the wait function.
+*
+*******************************************************************************/
+static bool TestWaitFunctions(cy_stc_smif_mem_config_t const *memConfig)
+{
+	cy_en_smif_status_t status;
+	uint32_t readWaits;
+	uint32_t staleWaits;
+	uint32_t index;
+	bool isValid;
+
+	RegisterMemoryEventFunction(HostEvent);
+	RegisterMemoryWaitFunction(HostDelay, HostEventWait);
+
+	status = ReadMemoryRange(memConfig, WAIT_BASE, readBack, WAIT_READ_SIZE);
+	readWaits = eventWaits;
+	isValid = (CY_SMIF_SUCCESS == status) && (1u == readWaits) &&
+			  ((SMIF_TRANSFER_TIMEOUT + WAIT_READ_SIZE) == eventTimeout) && (0u == delays);
+
+	staleEvent = true;
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = ReadMemoryRange(memConfig, WAIT_BASE, readBack, READ_SIZE);
+	}
+	staleWaits = eventWaits - readWaits;
+	isValid = isValid && (CY_SMIF_SUCCESS == status) && (2u == staleWaits);
+
+	for(index = 0u; index < (WAIT_PAGES * NOR_MODEL_PAGE_SIZE); index++)
+	{
+		writeData[index] = (uint8_t)rand();
+	}
+	eventWaits = 0u;
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = WriteMemoryRange(memConfig, WAIT_BASE, writeData, WAIT_PAGES * NOR_MODEL_PAGE_SIZE, false);
+	}
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = ReadMemoryRange(memConfig, WAIT_BASE, readBack, WAIT_PAGES * NOR_MODEL_PAGE_SIZE);
+	}
+	isValid = isValid && (CY_SMIF_SUCCESS == status) && ((WAIT_PAGES + 1u) == eventWaits) &&
+			  (0u != delays) && (maxDelay <= MEMORY_MAX_POLL_INTERVAL) &&
+			  (0 == memcmp(readBack, writeData, WAIT_PAGES * NOR_MODEL_PAGE_SIZE));
+
+	RegisterMemoryWaitFunction(NULL, NULL);
+	RegisterMemoryEventFunction(NULL);
+
+	if(isValid)
+	{
+		printf("Registered waits: 1 event wait per transfer, %lu delays of up to %lu us for %u page programs\n",
+			   (unsigned long)delays, (unsigned long)maxDelay, WAIT_PAGES);
+	}
+	else
+	{
+		printf("FAIL: registered waits, status 0x%lx, %lu read waits, %lu waits with a stale event, %lu write waits\n",
+			   (unsigned long)status, (unsigned long)readWaits, (unsigned long)staleWaits, (unsigned long)eventWaits);
+	}
+
+	return isValid;
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests and prints the write rates, in MB/s of simulated time.
+*
+*******************************************************************************/
+int main(void)
+{
+	cy_stc_smif_mem_config_t const *memConfig = smifMemConfigs[0];
+	nor_model_stats_t modelStats;
+	bool isValid = true;
+	uint32_t index;
+
+	srand(1u);
+
+	printf("SMIF memory test: writes and background erases on the NOR flash model\n");
+	printf("%-18s %10s %8s %6s %6s %9s %7s\n", "write", "address", "bytes", "pages", "erases", "ms", "MB/s");
+	for(index = 0u; index < WRITE_CASES; index++)
+	{
+		isValid = TestWrite(memConfig, &writeCases[index]) && isValid;
+	}
+	isValid = TestWriteParameters(memConfig) && isValid;
+
+	printf("\n");
+	isValid = TestBackgroundErase(memConfig) && isValid;
+	isValid = TestEraseProgress(memConfig) && isValid;
+	isValid = TestChipErase(memConfig) && isValid;
+	isValid = TestWaitFunctions(memConfig) && isValid;
+
+	NorModel_GetStats(&modelStats, false);
+	if(0u != modelStats.protocolErrors)
+	{
+		printf("FAIL: %lu commands ignored by the memory\n", (unsigned long)modelStats.protocolErrors);
+		isValid = false;
+	}
+
+	printf("%s\n", isValid ? "PASS" : "FAIL");
+
+	return isValid ? 0 : 1;
+}
+
@@ -0,0 +1,912 @@
+/******************************************************************************
+* File Name: ftl.c
+*
+* Version: 1.0
+*
+* Description:
+* 	This file contains a log-structured flash translation layer. Logical pages
+* 	are never written in place: every write programs the next free page of the
+* 	active block, and a mapping table in RAM tracks where each logical page is.
+* 	The garbage collection copies the valid pages of a used block before
+* 	erasing it, and levels the wear of the blocks.
+*
+* 	Each page carries a tag with its logical page number, a sequence number and
+* 	CRCs, programmed together with the data, so the table is rebuilt from the
+* 	memory on mount and a write interrupted by a power loss is either kept
+* 	whole or dropped.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "ftl.h"
+#include "smif_mem.h"
+
+
+/***************************************************************************
+* Local constants
+***************************************************************************/
+#define FTL_BLOCK_MAGIC			(0x314C5446ul)	/* "FTL1" */
+#define FTL_OBSOLETE_OFFSET		(16u)			/* Obsolete marker in the first page */
+#define FTL_UNMAPPED			(0xFFFFu)
+#define FTL_NO_BLOCK			(0xFFFFFFFFul)
+#define FTL_CRC_POLYNOMIAL		(0xEDB88320ul)	/* CRC-32, reflected */
+#define FTL_CRC_SEED			(0xFFFFFFFFul)
+#define FTL_ERASED_BYTE			(0xFFu)
+
+#if ((FTL_NUM_BLOCKS * FTL_PAGES_PER_BLOCK) > FTL_UNMAPPED) || (FTL_SPARE_BLOCKS < 1u) || (FTL_NUM_BLOCKS <= FTL_SPARE_BLOCKS)
+#error "Unsupported FTL_NUM_BLOCKS or FTL_SPARE_BLOCKS"
+#endif
+
+
+/***************************************************************************
+* Data Types
+***************************************************************************/
+/* Tag at the start of every data page */
+typedef struct
+{
+	uint32_t logicalPage;		/* Logical page stored in the page */
+	uint32_t sequence;			/* Write order of the page, the newest copy wins */
+	uint32_t dataCrc;			/* CRC of the data of the page */
+	uint32_t tagCrc;			/* CRC of the fields above */
+} ftl_tag_t;
+
+/* Header at the start of the first page of a block */
+typedef struct
+{
+	uint32_t magic;				/* FTL_BLOCK_MAGIC */
+	uint32_t eraseCount;		/* Times the block was erased */
+	uint32_t reserved;
+	uint32_t crc;				/* CRC of the fields above */
+} ftl_header_t;
+
+typedef enum
+{
+	BLOCK_DIRTY,				/* To be erased before use */
+	BLOCK_FREE,					/* Erased, with a header */
+	BLOCK_ACTIVE,				/* Being written */
+	BLOCK_USED					/* Written */
+} ftl_block_state_t;
+
+
+/***************************************************************************
+* Global variables
+***************************************************************************/
+static cy_stc_smif_mem_config_t const *ftlMemConfig = NULL;
+
+/* Physical page of each logical page */
+static uint16_t pageMap[FTL_LOGICAL_PAGES];
+
+/* State, number of valid pages and erase count of each block */
+static ftl_block_state_t blockState[FTL_NUM_BLOCKS];
+static uint16_t validPages[FTL_NUM_BLOCKS];
+static uint32_t eraseCount[FTL_NUM_BLOCKS];
+
+static uint32_t activeBlock = FTL_NO_BLOCK;
+static uint32_t writePage = 0u;			/* Next page to program in the active block */
+static uint32_t availableBlocks = 0u;	/* Free and dirty blocks */
+static uint32_t nextSequence = 0u;
+static bool collecting = false;			/* The garbage collection is copying pages */
+static cy_en_smif_status_t MakeSpace(void);
+
+static ftl_stats_t ftlStats;
+
+/* Page being programmed, and page being copied by the garbage collection */
+static uint8_t pageBuffer[FTL_PAGE_SIZE];
+static uint8_t copyBuffer[FTL_PAGE_SIZE];
+
+
+/*******************************************************************************
+* Function Name: ComputeCrc
+****************************************************************************//**
+*
+* Computes the CRC-32 of a buffer.
+*
+* \param data
+* The data to compute the CRC of.
+*
+* \param size
+* The size of data.
+*
+* \return The CRC.
+*
+*******************************************************************************/
+static uint32_t ComputeCrc(uint8_t const data[], uint32_t size)
+{
+	uint32_t crc = FTL_CRC_SEED;
+	uint32_t index;
+	uint32_t bit;
+
+	for(index = 0u; index < size; index++)
+	{
+		crc ^= data[index];
+
+		for(bit = 0u; bit < 8u; bit++)
+		{
+			crc = (0u != (crc & 1u)) ? ((crc >> 1u) ^ FTL_CRC_POLYNOMIAL) : (crc >> 1u);
+		}
+	}
+
+	return ~crc;
+}
+
+
+/*******************************************************************************
+* Function Name: IsErased
+****************************************************************************//**
+*
+* Checks whether a buffer read from the memory is erased.
+*
+* \param data
+* The data to check.
+*
+* \param size
+* The size of data.
+*
+* \return true if all the bytes are erased.
+*
+*******************************************************************************/
+static bool IsErased(uint8_t const data[], uint32_t size)
+{
+	uint32_t index = 0u;
+
+	while((index < size) && (FTL_ERASED_BYTE == data[index]))
+	{
+		index++;
+	}
+
+	return (index == size);
+}
+
+
+/*******************************************************************************
+* Function Name: PageAddress
+****************************************************************************//**
+*
+* Returns the address in the memory of a physical page.
+*
+* \param page
+* The physical page, counted from the first page of the first block.
+*
+* \return The address of the page.
+*
+*******************************************************************************/
+static uint32_t PageAddress(uint32_t page)
+{
+	return FTL_BASE_ADDRESS + (page * FTL_PAGE_SIZE);
+}
+
+
+/*******************************************************************************
+* Function Name: ReadTag
+****************************************************************************//**
+*
+* Reads the tag of a physical page.
+*
+* \param page
+* The physical page.
+*
+* \param tag
+* Receives the tag.
+*
+* \param isValid
+* Receives true if the CRC of the tag matches.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t ReadTag(uint32_t page, ftl_tag_t *tag, bool *isValid)
+{
+	cy_en_smif_status_t status;
+
+	status = ReadMemoryRange(ftlMemConfig, PageAddress(page), (uint8_t *)tag, FTL_TAG_SIZE);
+
+	*isValid = (CY_SMIF_SUCCESS == status) &&
+			   (tag->tagCrc == ComputeCrc((uint8_t const *)tag, offsetof(ftl_tag_t, tagCrc)));
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: IsNewer
+****************************************************************************//**
+*
+* Compares two sequence numbers, allowing them to wrap around.
+*
+* \return true if sequence is newer than reference.
+*
+*******************************************************************************/
+static bool IsNewer(uint32_t sequence, uint32_t reference)
+{
+	return ((int32_t)(sequence - reference) > 0);
+}
+
+
+/*******************************************************************************
+* Function Name: PrepareBlock
+****************************************************************************//**
+*
+* Erases a block and writes its header. The block is first marked obsolete so
+* that a block whose erase was interrupted is erased again on mount, even if
+* its header survived.
+*
+* \param block
+* The block to prepare.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t PrepareBlock(uint32_t block)
+{
+	cy_en_smif_status_t status;
+	uint32_t address = PageAddress(block * FTL_PAGES_PER_BLOCK);
+	ftl_header_t header;
+
+	memset(pageBuffer, 0, FTL_TAG_SIZE);
+	status = WriteMemoryRange(ftlMemConfig, address + FTL_OBSOLETE_OFFSET, pageBuffer, FTL_TAG_SIZE, false);
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = EraseMemoryRange(ftlMemConfig, address, FTL_BLOCK_SIZE);
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		eraseCount[block]++;
+		ftlStats.erases++;
+
+		header.magic = FTL_BLOCK_MAGIC;
+		header.eraseCount = eraseCount[block];
+		header.reserved = 0u;
+		header.crc = ComputeCrc((uint8_t const *)&header, offsetof(ftl_header_t, crc));
+		status = WriteMemoryRange(ftlMemConfig, address, (uint8_t *)&header, sizeof(header), false);
+		ftlStats.flashWrites++;
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		blockState[block] = BLOCK_FREE;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: TakeBlock
+****************************************************************************//**
+*
+* Makes the least erased free block the active block. A dirty block is taken
+* and prepared if there is no free block.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t TakeBlock(void)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t block = FTL_NO_BLOCK;
+	uint32_t index;
+
+	for(index = 0u; index < FTL_NUM_BLOCKS; index++)
+	{
+		if((BLOCK_FREE == blockState[index]) &&
+		   ((FTL_NO_BLOCK == block) || (eraseCount[index] < eraseCount[block])))
+		{
+			block = index;
+		}
+	}
+
+	for(index = 0u; (FTL_NO_BLOCK == block) && (index < FTL_NUM_BLOCKS); index++)
+	{
+		if(BLOCK_DIRTY == blockState[index])
+		{
+			block = index;
+			status = PrepareBlock(block);
+		}
+	}
+
+	if(FTL_NO_BLOCK == block)
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		blockState[block] = BLOCK_ACTIVE;
+		validPages[block] = 0u;
+		activeBlock = block;
+		writePage = 1u;
+		availableBlocks--;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: SelectVictim
+****************************************************************************//**
+*
+* Selects the used block to collect: the one with the fewest valid pages, or
+* periodically the least erased one when the wear of the blocks is uneven, so
+* that blocks holding data that never changes are also cycled. Only blocks
+* whose valid pages fit in the space left are considered.
+*
+* \return The block to collect, or FTL_NO_BLOCK if no block fits.
+*
+*******************************************************************************/
+static uint32_t SelectVictim(void)
+{
+	uint32_t victim = FTL_NO_BLOCK;
+	uint32_t leastErased = FTL_NO_BLOCK;
+	uint32_t minErase = eraseCount[0];
+	uint32_t maxErase = eraseCount[0];
+	uint32_t space = availableBlocks * FTL_DATA_PAGES_PER_BLOCK;
+	uint32_t block;
+
+	if(FTL_NO_BLOCK != activeBlock)
+	{
+		space += FTL_PAGES_PER_BLOCK - writePage;
+	}
+
+	for(block = 0u; block < FTL_NUM_BLOCKS; block++)
+	{
+		if(eraseCount[block] < minErase)
+		{
+			minErase = eraseCount[block];
+		}
+
+		if(eraseCount[block] > maxErase)
+		{
+			maxErase = eraseCount[block];
+		}
+
+		if((BLOCK_USED == blockState[block]) && (validPages[block] <= space))
+		{
+			if((FTL_NO_BLOCK == victim) || (validPages[block] < validPages[victim]))
+			{
+				victim = block;
+			}
+
+			if((FTL_NO_BLOCK == leastErased) || (eraseCount[block] < eraseCount[leastErased]))
+			{
+				leastErased = block;
+			}
+		}
+	}
+
+	if((0u == (ftlStats.garbageCollections % FTL_WEAR_LEVEL_PERIOD)) &&
+	   ((maxErase - minErase) > FTL_WEAR_LEVEL_THRESHOLD))
+	{
+		victim = leastErased;
+	}
+
+	return victim;
+}
+
+
+/*******************************************************************************
+* Function Name: ProgramPage
+****************************************************************************//**
+*
+* Programs a logical page in the next page of the active block and maps it
+* there. The active block must have a free page.
+*
+* \param logicalPage
+* The logical page to program.
+*
+* \param data
+* FTL_PAGE_DATA_SIZE bytes of data.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t ProgramPage(uint32_t logicalPage, uint8_t const data[])
+{
+	cy_en_smif_status_t status;
+	uint32_t page = (activeBlock * FTL_PAGES_PER_BLOCK) + writePage;
+	ftl_tag_t tag;
+
+	tag.logicalPage = logicalPage;
+	tag.sequence = nextSequence++;
+	tag.dataCrc = ComputeCrc(data, FTL_PAGE_DATA_SIZE);
+	tag.tagCrc = ComputeCrc((uint8_t const *)&tag, offsetof(ftl_tag_t, tagCrc));
+
+	memcpy(pageBuffer, &tag, FTL_TAG_SIZE);
+	memcpy(&pageBuffer[FTL_TAG_SIZE], data, FTL_PAGE_DATA_SIZE);
+
+	/* A page failing to program is skipped */
+	writePage++;
+	status = WriteMemoryRange(ftlMemConfig, PageAddress(page), pageBuffer, FTL_PAGE_SIZE, false);
+	ftlStats.flashWrites++;
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		if(FTL_UNMAPPED != pageMap[logicalPage])
+		{
+			validPages[pageMap[logicalPage] / FTL_PAGES_PER_BLOCK]--;
+		}
+
+		pageMap[logicalPage] = (uint16_t)page;
+		validPages[activeBlock]++;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: CollectGarbage
+****************************************************************************//**
+*
+* Copies the valid pages of a used block to a free block, then erases the
+* used block. The copies are newer than the originals, so a power loss at any
+* point leaves one valid copy of each page.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t CollectGarbage(void)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t victim = SelectVictim();
+	uint32_t page;
+	ftl_tag_t tag;
+	bool isValid;
+
+	if(FTL_NO_BLOCK == victim)
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	collecting = true;
+
+	for(page = victim * FTL_PAGES_PER_BLOCK;
+		(CY_SMIF_SUCCESS == status) && (0u != validPages[victim]) && (page < ((victim + 1u) * FTL_PAGES_PER_BLOCK));
+		page++)
+	{
+		status = ReadTag(page, &tag, &isValid);
+
+		if((CY_SMIF_SUCCESS == status) && isValid &&
+		   (tag.logicalPage < FTL_LOGICAL_PAGES) && (page == pageMap[tag.logicalPage]))
+		{
+			status = ReadMemoryRange(ftlMemConfig, PageAddress(page) + FTL_TAG_SIZE, copyBuffer, FTL_PAGE_DATA_SIZE);
+
+			if(CY_SMIF_SUCCESS == status)
+			{
+				status = MakeSpace();
+			}
+
+			if(CY_SMIF_SUCCESS == status)
+			{
+				status = ProgramPage(tag.logicalPage, copyBuffer);
+			}
+		}
+	}
+
+	collecting = false;
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		ftlStats.garbageCollections++;
+		status = PrepareBlock(victim);
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		availableBlocks++;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: MakeSpace
+****************************************************************************//**
+*
+* Makes sure the active block has a free page, collecting garbage when only
+* the block reserved for the garbage collection is left.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t MakeSpace(void)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+	while((CY_SMIF_SUCCESS == status) &&
+		  ((FTL_NO_BLOCK == activeBlock) || (FTL_PAGES_PER_BLOCK <= writePage)))
+	{
+		if(FTL_NO_BLOCK != activeBlock)
+		{
+			blockState[activeBlock] = BLOCK_USED;
+			activeBlock = FTL_NO_BLOCK;
+		}
+
+		if(collecting || (1u < availableBlocks))
+		{
+			status = TakeBlock();
+		}
+		else
+		{
+			status = CollectGarbage();
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: ScanBlock
+****************************************************************************//**
+*
+* Reads the header and the page tags of a block on mount, and maps the newest
+* valid copy of each logical page found.
+*
+* \param block
+* The block to scan.
+*
+* \param lastPage
+* Receives the last page of the block that is not erased, or 0.
+*
+* \param lastSequence
+* Receives the newest sequence number found in the block.
+*
+* \param hasSequence
+* Receives true if the block holds a valid page.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t ScanBlock(uint32_t block, uint32_t *lastPage, uint32_t *lastSequence, bool *hasSequence)
+{
+	cy_en_smif_status_t status;
+	uint32_t first = block * FTL_PAGES_PER_BLOCK;
+	uint32_t page;
+	ftl_header_t header;
+	ftl_tag_t tag;
+	ftl_tag_t mapped;
+	bool isValid;
+	bool isMappedValid;
+
+	*lastPage = 0u;
+	*hasSequence = false;
+	validPages[block] = 0u;
+
+	status = ReadMemoryRange(ftlMemConfig, PageAddress(first), copyBuffer, FTL_OBSOLETE_OFFSET + FTL_TAG_SIZE);
+	memcpy(&header, copyBuffer, sizeof(header));
+
+	if((CY_SMIF_SUCCESS == status) && (FTL_BLOCK_MAGIC == header.magic) &&
+	   (header.crc == ComputeCrc((uint8_t const *)&header, offsetof(ftl_header_t, crc))) &&
+	   IsErased(&copyBuffer[FTL_OBSOLETE_OFFSET], FTL_TAG_SIZE))
+	{
+		blockState[block] = BLOCK_FREE;
+		eraseCount[block] = header.eraseCount;
+	}
+	else
+	{
+		blockState[block] = BLOCK_DIRTY;
+	}
+
+	for(page = first + 1u; (CY_SMIF_SUCCESS == status) && (BLOCK_FREE == blockState[block]) &&
+		(page < (first + FTL_PAGES_PER_BLOCK)); page++)
+	{
+		status = ReadTag(page, &tag, &isValid);
+
+		if((CY_SMIF_SUCCESS == status) && !IsErased((uint8_t const *)&tag, FTL_TAG_SIZE))
+		{
+			*lastPage = page - first;
+		}
+
+		if((CY_SMIF_SUCCESS == status) && isValid && (tag.logicalPage < FTL_LOGICAL_PAGES))
+		{
+			status = ReadMemoryRange(ftlMemConfig, PageAddress(page) + FTL_TAG_SIZE, copyBuffer, FTL_PAGE_DATA_SIZE);
+			isValid = (tag.dataCrc == ComputeCrc(copyBuffer, FTL_PAGE_DATA_SIZE));
+		}
+		else
+		{
+			isValid = false;
+		}
+
+		if((CY_SMIF_SUCCESS == status) && isValid)
+		{
+			if(!*hasSequence || IsNewer(tag.sequence, *lastSequence))
+			{
+				*lastSequence = tag.sequence;
+				*hasSequence = true;
+			}
+
+			isMappedValid = false;
+
+			if(FTL_UNMAPPED != pageMap[tag.logicalPage])
+			{
+				status = ReadTag(pageMap[tag.logicalPage], &mapped, &isMappedValid);
+			}
+
+			if((CY_SMIF_SUCCESS == status) && (!isMappedValid || IsNewer(tag.sequence, mapped.sequence)))
+			{
+				if(FTL_UNMAPPED != pageMap[tag.logicalPage])
+				{
+					validPages[pageMap[tag.logicalPage] / FTL_PAGES_PER_BLOCK]--;
+				}
+
+				pageMap[tag.logicalPage] = (uint16_t)page;
+				validPages[block]++;
+			}
+		}
+	}
+
+	if((CY_SMIF_SUCCESS == status) && (0u != *lastPage))
+	{
+		blockState[block] = BLOCK_USED;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: FtlMount
+****************************************************************************//**
+*
+* Rebuilds the mapping table from the memory. Blocks that hold no valid header
+* are erased when they are needed, so an empty or foreign memory region is
+* formatted on the fly. Must be called before the other functions of this
+* module.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - The memory geometry does not match the FTL_* settings.
+*
+*******************************************************************************/
+cy_en_smif_status_t FtlMount(cy_stc_smif_mem_config_t const *memConfig)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t lastPage[FTL_NUM_BLOCKS];
+	uint32_t blockSequence = 0u;
+	uint32_t lastSequence = 0u;
+	bool hasSequence;
+	uint32_t maxErase = 0u;
+	uint32_t block;
+
+	ftlMemConfig = NULL;
+
+	if((FTL_PAGE_SIZE != memConfig->deviceCfg->programSize) ||
+	   (FTL_BLOCK_SIZE != memConfig->deviceCfg->eraseSize) ||
+	   (0u != (FTL_BASE_ADDRESS % FTL_BLOCK_SIZE)) ||
+	   ((FTL_BASE_ADDRESS + (FTL_NUM_BLOCKS * FTL_BLOCK_SIZE)) > memConfig->deviceCfg->memSize))
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		ftlMemConfig = memConfig;
+		memset(pageMap, 0xFF, sizeof(pageMap));
+		memset(&ftlStats, 0, sizeof(ftlStats));
+		activeBlock = FTL_NO_BLOCK;
+		availableBlocks = 0u;
+		collecting = false;
+	}
+
+	for(block = 0u; (CY_SMIF_SUCCESS == status) && (block < FTL_NUM_BLOCKS); block++)
+	{
+		status = ScanBlock(block, &lastPage[block], &blockSequence, &hasSequence);
+
+		/* The block holding the newest page was the active block */
+		if(hasSequence && ((FTL_NO_BLOCK == activeBlock) || IsNewer(blockSequence, lastSequence)))
+		{
+			activeBlock = block;
+			lastSequence = blockSequence;
+		}
+
+		if((BLOCK_DIRTY != blockState[block]) && (eraseCount[block] > maxErase))
+		{
+			maxErase = eraseCount[block];
+		}
+	}
+
+	for(block = 0u; (CY_SMIF_SUCCESS == status) && (block < FTL_NUM_BLOCKS); block++)
+	{
+		/* The erase count of a block whose erase was interrupted is lost */
+		if(BLOCK_DIRTY == blockState[block])
+		{
+			eraseCount[block] = maxErase;
+		}
+
+		if(BLOCK_USED != blockState[block])
+		{
+			availableBlocks++;
+		}
+	}
+
+	if((CY_SMIF_SUCCESS == status) && (FTL_NO_BLOCK != activeBlock))
+	{
+		nextSequence = lastSequence + 1u;
+		blockState[activeBlock] = BLOCK_ACTIVE;
+		writePage = lastPage[activeBlock] + 1u;
+
+		/* A page partially programmed without its tag is skipped */
+		while((CY_SMIF_SUCCESS == status) && (writePage < FTL_PAGES_PER_BLOCK))
+		{
+			status = ReadMemoryRange(ftlMemConfig, PageAddress((activeBlock * FTL_PAGES_PER_BLOCK) + writePage), copyBuffer, FTL_PAGE_SIZE);
+
+			if(IsErased(copyBuffer, FTL_PAGE_SIZE))
+			{
+				break;
+			}
+
+			writePage++;
+		}
+	}
+
+	/* A garbage collection interrupted by a power loss used the block reserved
+	 * for it: finish it in the space left in the active block.
+	 */
+	while((CY_SMIF_SUCCESS == status) && (0u == availableBlocks))
+	{
+		status = CollectGarbage();
+	}
+
+	if(CY_SMIF_SUCCESS != status)
+	{
+		ftlMemConfig = NULL;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: FtlRead
+****************************************************************************//**
+*
+* Reads a logical page. A page that was never written reads as erased.
+*
+* \param logicalPage
+* The logical page to read, below FTL_LOGICAL_PAGES.
+*
+* \param data
+* Receives FTL_PAGE_DATA_SIZE bytes of data.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - The page does not exist or the FTL is not mounted.
+*
+*******************************************************************************/
+cy_en_smif_status_t FtlRead(uint32_t logicalPage, uint8_t data[])
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+	if((NULL == ftlMemConfig) || (logicalPage >= FTL_LOGICAL_PAGES))
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+	else if(FTL_UNMAPPED == pageMap[logicalPage])
+	{
+		memset(data, FTL_ERASED_BYTE, FTL_PAGE_DATA_SIZE);
+	}
+	else
+	{
+		status = ReadMemoryRange(ftlMemConfig, PageAddress(pageMap[logicalPage]) + FTL_TAG_SIZE, data, FTL_PAGE_DATA_SIZE);
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: FtlWrite
+****************************************************************************//**
+*
+* Writes a logical page. The previous data of the page is kept until the write
+* completes, so after a power loss the page holds either the previous or the
+* new data.
+*
+* \param logicalPage
+* The logical page to write, below FTL_LOGICAL_PAGES.
+*
+* \param data
+* FTL_PAGE_DATA_SIZE bytes of data.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - The page does not exist or the FTL is not mounted.
+*
+*******************************************************************************/
+cy_en_smif_status_t FtlWrite(uint32_t logicalPage, uint8_t const data[])
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+	if((NULL == ftlMemConfig) || (logicalPage >= FTL_LOGICAL_PAGES))
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = MakeSpace();
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = ProgramPage(logicalPage, data);
+		ftlStats.hostWrites++;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: FtlGetStats
+****************************************************************************//**
+*
+* Returns the write and erase statistics since the last mount, and the wear of
+* the blocks.
+*
+* \param stats
+* Receives the statistics.
+*
+*******************************************************************************/
+void FtlGetStats(ftl_stats_t *stats)
+{
+	uint32_t block;
+
+	*stats = ftlStats;
+	stats->minEraseCount = eraseCount[0];
+	stats->maxEraseCount = eraseCount[0];
+
+	for(block = 1u; block < FTL_NUM_BLOCKS; block++)
+	{
+		if(eraseCount[block] < stats->minEraseCount)
+		{
+			stats->minEraseCount = eraseCount[block];
+		}
+
+		if(eraseCount[block] > stats->maxEraseCount)
+		{
+			stats->maxEraseCount = eraseCount[block];
+		}
+	}
+
+	if(0u != stats->hostWrites)
+	{
+		stats->writeAmplification = (stats->flashWrites * 100u) / stats->hostWrites;
+	}
+}
+
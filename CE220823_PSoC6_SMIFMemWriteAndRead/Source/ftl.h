@@ -0,0 +1,120 @@
+/******************************************************************************
+* File Name: ftl.h
+*
+* Version: 1.0
+*
+* Description:
+* 	This is the public interface header for ftl.c. This file contains the
+* 	functions of a log-structured flash translation layer that stores pages of
+* 	data in a region of the external memory.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FTL_H
+#define SOURCE_FTL_H
+
+#include "cy_pdl.h"
+
+
+/***************************************************************************
+* Global Constants
+***************************************************************************/
+/* Region of the external memory used by the flash translation layer. The first
+ * sector is left to the memory test of main.c.
+ */
+#ifndef FTL_BASE_ADDRESS
+#define FTL_BASE_ADDRESS			(0x00040000ul)
+#endif
+#ifndef FTL_NUM_BLOCKS
+#define FTL_NUM_BLOCKS				(16u)		/* Up to 127 */
+#endif
+
+/* Blocks left out of the logical capacity. One is kept free for the garbage
+ * collection, the others lower the write amplification: about 2.5 for random
+ * writes with 4 of 16 blocks spare, and 7 with 2.
+ */
+#ifndef FTL_SPARE_BLOCKS
+#define FTL_SPARE_BLOCKS			(4u)
+#endif
+
+/* A block is an erase sector and a page is a program page of the memory */
+#define FTL_PAGE_SIZE				(512u)
+#define FTL_BLOCK_SIZE				(0x00040000ul)
+#define FTL_PAGES_PER_BLOCK			(FTL_BLOCK_SIZE / FTL_PAGE_SIZE)
+
+/* Each page starts with a tag that identifies its data. The first page of a
+ * block holds the block header.
+ */
+#define FTL_TAG_SIZE				(16u)
+#define FTL_PAGE_DATA_SIZE			(FTL_PAGE_SIZE - FTL_TAG_SIZE)
+#define FTL_DATA_PAGES_PER_BLOCK	(FTL_PAGES_PER_BLOCK - 1u)
+
+/* Number of logical pages that can be stored */
+#define FTL_LOGICAL_PAGES			((FTL_NUM_BLOCKS - FTL_SPARE_BLOCKS) * FTL_DATA_PAGES_PER_BLOCK)
+
+/* Static wear leveling: every FTL_WEAR_LEVEL_PERIOD garbage collections, the
+ * least erased block in use is collected if the erase counts of the blocks
+ * differ by more than FTL_WEAR_LEVEL_THRESHOLD.
+ */
+#define FTL_WEAR_LEVEL_PERIOD		(8u)
+#define FTL_WEAR_LEVEL_THRESHOLD	(32u)
+
+
+/***************************************************************************
+* Data Types
+***************************************************************************/
+/* Statistics since the last mount */
+typedef struct
+{
+	uint32_t hostWrites;			/* Pages written by FtlWrite() */
+	uint32_t flashWrites;			/* Pages programmed, including the copies of
+									   the garbage collection and the headers */
+	uint32_t erases;				/* Blocks erased */
+	uint32_t garbageCollections;	/* Blocks collected */
+	uint32_t minEraseCount;			/* Lowest erase count of the blocks */
+	uint32_t maxEraseCount;			/* Highest erase count of the blocks */
+	uint32_t writeAmplification;	/* flashWrites / hostWrites, in 1/100 */
+} ftl_stats_t;
+
+
+/***************************************************************************
+* Function Prototypes
+***************************************************************************/
+cy_en_smif_status_t FtlMount(cy_stc_smif_mem_config_t const *memConfig);
+cy_en_smif_status_t FtlRead(uint32_t logicalPage, uint8_t data[]);
+cy_en_smif_status_t FtlWrite(uint32_t logicalPage, uint8_t const data[]);
+void FtlGetStats(ftl_stats_t *stats);
+
+#endif /* SOURCE_FTL_H */
+
+
@@ -46,6 +46,7 @@
 #include "cycfg.h"
 #include "cycfg_qspi_memslot.h"
 #include "smif_mem.h"
+#include "ftl.h"
 #include "stdio.h"
 #include "string.h"
 
@@ -59,6 +60,7 @@
 #define MAX_ADDRESS_SIZE    	(4u)      /* Memory address size */
 #define NUM_BYTES_PER_LINE		(16u)	  /* Used when array of data is printed on the console */
 #define LED_TOGGLE_DELAY_MSEC	(1000u)	  /* LED blink delay */
+#define FTL_DEMO_PAGE			(0u)	  /* Logical page holding the reset count */
 
 
 /***************************************************************************
@@ -143,7 +145,7 @@ void PrintArray(char *message, uint8_t *buf, uint32_t size)
 *
 * Initializes UART for console output and SMIF for interfacing an external
 * memory, performs erase followed by write, verifies the written data by reading
-* it back.
+* it back. Then updates a reset count stored through the flash translation layer.
 *
 *******************************************************************************/
 int main(void)
@@ -274,6 +276,43 @@ int main(void)
     CheckStatus("Read data does not match with written data. Read/Write operation failed.",
     		memcmp(txBuffer, rxBuffer, PACKET_SIZE));
 
+    /* The flash translation layer keeps a reset count in a logical page. The
+     * page is rewritten on each reset, to another physical page each time.
+     */
+    printf("\n5. Mounting the flash translation layer.\n");
+    smifStatus = FtlMount(smifMemConfigs[0]);
+    CheckStatus("Mounting the flash translation layer failed", smifStatus);
+
+    uint8_t ftlTxBuffer[FTL_PAGE_DATA_SIZE];
+    uint8_t ftlRxBuffer[FTL_PAGE_DATA_SIZE];
+    uint32_t resetCount;
+
+    smifStatus = FtlRead(FTL_DEMO_PAGE, ftlRxBuffer);
+    CheckStatus("Reading the logical page failed", smifStatus);
+    memcpy(&resetCount, ftlRxBuffer, sizeof(resetCount));
+    resetCount = (0xFFFFFFFFul == resetCount) ? 0u : (resetCount + 1u); /* Erased on the first run */
+    printf("Reset count: %lu\n", resetCount);
+
+    printf("\n6. Writing the reset count to logical page %u and reading it back.\n", FTL_DEMO_PAGE);
+    for(uint32_t index = 0; index < FTL_PAGE_DATA_SIZE; index++)
+    {
+        ftlTxBuffer[index] = (uint8_t) ((index + resetCount) & 0xFF);
+    }
+    memcpy(ftlTxBuffer, &resetCount, sizeof(resetCount));
+
+    smifStatus = FtlWrite(FTL_DEMO_PAGE, ftlTxBuffer);
+    CheckStatus("Writing the logical page failed", smifStatus);
+    smifStatus = FtlRead(FTL_DEMO_PAGE, ftlRxBuffer);
+    CheckStatus("Reading the logical page failed", smifStatus);
+    CheckStatus("Read logical page does not match with written data.",
+    		memcmp(ftlTxBuffer, ftlRxBuffer, FTL_PAGE_DATA_SIZE));
+
+    ftl_stats_t ftlStats;
+    FtlGetStats(&ftlStats);
+    printf("Pages written: %lu, pages programmed: %lu, blocks erased: %lu, erase counts: %lu..%lu\n",
+    		ftlStats.hostWrites, ftlStats.flashWrites, ftlStats.erases,
+    		ftlStats.minEraseCount, ftlStats.maxEraseCount);
+
     printf("\n================================================================================\n");
     printf("\nSUCCESS: Read data matches with written data!\n");
     printf("\n================================================================================\n");
@@ -49,22 +49,98 @@
 /***************************************************************************
 * Global Constants
 ***************************************************************************/
-/* Set it high enough for the sector erase operation to complete */
-#define MEMORY_BUSY_CHECK_RETRIES	(750ul)
+/* Set it high enough for the sector erase operation to complete. Used when
+ * the operation the memory is busy with is not known.
+ */
+#define MEMORY_BUSY_TIMEOUT			(750000ul)	/* microseconds */
 
-/* Timeout used in polling of the transfer status of SMIF block */
+/* Timeout of an operation with a known cycle time, as a multiple of the max
+ * cycle time given in the memory device configuration.
+ */
+#define MEMORY_BUSY_TIMEOUT_FACTOR	(2ul)
+
+/* The first busy check of an operation is done after 1/8 of its max cycle time,
+ * then the interval between the checks doubles up to the max interval.
+ */
+#define MEMORY_FIRST_POLL_DIVIDER	(8ul)
+#define MEMORY_MIN_POLL_INTERVAL	(10ul)		/* microseconds */
+#define MEMORY_MAX_POLL_INTERVAL	(1000ul) 	/* microseconds */
+
+/* Timeout used in waiting for the transfer completion of SMIF block. It is
+ * extended by 1 us per byte transferred, i.e. for rates down to 1 MB/s.
+ */
 #define SMIF_TRANSFER_TIMEOUT		(1000ul) 	/* microseconds */
 
+/* Interval between the checks of the transfer completion of SMIF block by the
+ * default event wait function
+ */
+#define SMIF_TRANSFER_POLL_INTERVAL	(1ul) 		/* microseconds */
+
+/* Max number of address bytes of a memory command */
+#define MEMORY_MAX_ADDRESS_SIZE		(4u)
+
+/* Max size of data received by one read command of SMIF block */
+#define SMIF_MAX_RX_SIZE			(65536ul)	/* bytes */
+
+/* Erase suspend and resume commands of the S25FL512S. The memory device
+ * configuration does not describe them.
+ */
+#define MEMORY_CMD_ERASE_SUSPEND	(0x75u)
+#define MEMORY_CMD_ERASE_RESUME		(0x7Au)
+
+/* Max time from an erase suspend until the memory accepts reads */
+#define MEMORY_SUSPEND_TIME			(45ul)		/* microseconds */
+
+/* Time an erase runs after a resume before it can be suspended again, so that
+ * it keeps progressing when it is suspended often
+ */
+#define MEMORY_MIN_RESUME_TIME		(100ul)		/* microseconds */
+
+
+/***************************************************************************
+* Data Types
+***************************************************************************/
+/* Waits for the given time in microseconds between two busy checks of the
+ * memory. The default is a busy wait with Cy_SysLib_DelayUs(). An RTOS
+ * application can register a function that delays the calling task instead,
+ * and busy waits for times shorter than the tick period.
+ */
+typedef void (*smif_mem_wait_function_t)(uint32_t waitUs);
+
+/* Waits until the event function is called or the given timeout in
+ * microseconds expires, and returns true when the event function was called.
+ * The default polls the transfer status every SMIF_TRANSFER_POLL_INTERVAL. An
+ * RTOS application can register a function that blocks the calling task on a
+ * semaphore given by the event function.
+ */
+typedef bool (*smif_mem_event_wait_function_t)(uint32_t timeoutUs);
+
+/* Called from the SMIF interrupt when a read or program transfer started by
+ * this module completes. The event is CY_SMIF_REC_CMPLT or CY_SMIF_SEND_CMPLT.
+ */
+typedef void (*smif_mem_event_function_t)(uint32_t event);
+
 
 /***************************************************************************
 * Function Prototypes
 ***************************************************************************/
+void RegisterMemoryWaitFunction(smif_mem_wait_function_t waitFunction, smif_mem_event_wait_function_t eventWaitFunction);
+void RegisterMemoryEventFunction(smif_mem_event_function_t eventFunction);
 cy_en_smif_status_t IsMemoryReady(cy_stc_smif_mem_config_t const *memConfig);
 cy_en_smif_status_t IsQuadEnabled(cy_stc_smif_mem_config_t const *memConfig, bool *isQuadEnabled);
 cy_en_smif_status_t EnableQuadMode(cy_stc_smif_mem_config_t const *memConfig);
 cy_en_smif_status_t ReadMemory(cy_stc_smif_mem_config_t const *memConfig, uint8_t address[], uint8_t rxBuffer[], uint32_t rxSize);
 cy_en_smif_status_t WriteMemory(cy_stc_smif_mem_config_t const *memConfig, uint8_t address[], uint8_t txBuffer[], uint32_t txSize);
 cy_en_smif_status_t EraseMemory(cy_stc_smif_mem_config_t const *memConfig, uint8_t address[]);
+cy_en_smif_status_t ReadMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint8_t rxBuffer[], uint32_t rxSize);
+cy_en_smif_status_t EraseMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint32_t size);
+cy_en_smif_status_t StartEraseMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint32_t size);
+cy_en_smif_status_t ProcessErase(cy_stc_smif_mem_config_t const *memConfig);
+bool IsEraseInProgress(void);
+cy_en_smif_status_t SuspendErase(cy_stc_smif_mem_config_t const *memConfig);
+cy_en_smif_status_t ResumeErase(cy_stc_smif_mem_config_t const *memConfig);
+cy_en_smif_status_t ReadMemoryDuringErase(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint8_t rxBuffer[], uint32_t rxSize);
+cy_en_smif_status_t WriteMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint8_t txBuffer[], uint32_t txSize, bool eraseSectors);
 
 #endif /* SOURCE_SMIF_MEM_H */
 
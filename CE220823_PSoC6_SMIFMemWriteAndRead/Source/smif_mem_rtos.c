@@ -0,0 +1,161 @@
+/******************************************************************************
+* File Name: smif_mem_rtos.c
+*
+* Version: 1.0
+*
+* Description:
+* 	This file contains the wait functions of smif_mem.c for FreeRTOS
+* 	applications. A task waiting for a read or program transfer blocks on a
+* 	semaphore given by the SMIF interrupt, and a task waiting for a program or
+* 	erase operation is delayed between the busy checks of the memory, so that
+* 	other tasks run meanwhile. The file is not part of this example, which does
+* 	not use an RTOS; add it with FreeRTOS to the sources of an application.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "smif_mem.h"
+#include "smif_mem_rtos.h"
+
+
+/***************************************************************************
+* Global variables
+***************************************************************************/
+/* Given by the SMIF interrupt when a read or program transfer completes */
+static SemaphoreHandle_t transferSemaphore = NULL;
+
+
+/*******************************************************************************
+* Function Name: RtosDelay
+****************************************************************************//**
+*
+* Wait function of the memory operations. Delays the calling task for at least
+* the given time, or busy waits for times shorter than the tick period.
+*
+* \param waitUs
+* Time to wait in microseconds.
+*
+*******************************************************************************/
+static void RtosDelay(uint32_t waitUs)
+{
+	TickType_t ticks = (TickType_t)(((uint64_t)waitUs * configTICK_RATE_HZ) / 1000000u);
+
+	if(0u == ticks)
+	{
+		Cy_SysLib_DelayUs((uint16_t)waitUs);
+	}
+	else
+	{
+		/* The first tick can come right away */
+		vTaskDelay(ticks + 1u);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: RtosEventWait
+****************************************************************************//**
+*
+* Event wait function of the transfers. Blocks the calling task until the SMIF
+* interrupt gives the semaphore or the timeout expires.
+*
+* \param timeoutUs
+* Time to give up after, in microseconds.
+*
+* \return True when the semaphore was given.
+*
+*******************************************************************************/
+static bool RtosEventWait(uint32_t timeoutUs)
+{
+	/* Rounded up, plus the first tick that can come right away */
+	TickType_t ticks = (TickType_t)((((uint64_t)timeoutUs * configTICK_RATE_HZ) + 999999u) / 1000000u) + 1u;
+
+	return (pdTRUE == xSemaphoreTake(transferSemaphore, ticks));
+}
+
+
+/*******************************************************************************
+* Function Name: RtosEvent
+****************************************************************************//**
+*
+* Event function of the transfers, called from the SMIF interrupt. Gives the
+* semaphore the waiting task blocks on.
+*
+* \param event
+* CY_SMIF_REC_CMPLT or CY_SMIF_SEND_CMPLT.
+*
+*******************************************************************************/
+static void RtosEvent(uint32_t event)
+{
+	BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+	(void)event;
+	xSemaphoreGiveFromISR(transferSemaphore, &higherPriorityTaskWoken);
+	portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+
+/*******************************************************************************
+* Function Name: InitMemoryRtosWait
+****************************************************************************//**
+*
+* Creates the semaphore of the transfers and registers the FreeRTOS wait and
+* event functions with smif_mem.c. Call it once before the first memory
+* operation. The priority of the SMIF interrupt must allow FreeRTOS API calls,
+* i.e. be numerically equal to or greater than
+* configMAX_SYSCALL_INTERRUPT_PRIORITY. The memory operations must be called
+* from a single task.
+*
+* \return True when the functions are registered, false when the semaphore
+* cannot be created.
+*
+*******************************************************************************/
+bool InitMemoryRtosWait(void)
+{
+	if(NULL == transferSemaphore)
+	{
+		transferSemaphore = xSemaphoreCreateBinary();
+	}
+
+	if(NULL != transferSemaphore)
+	{
+		RegisterMemoryEventFunction(RtosEvent);
+		RegisterMemoryWaitFunction(RtosDelay, RtosEventWait);
+	}
+
+	return (NULL != transferSemaphore);
+}
+
+
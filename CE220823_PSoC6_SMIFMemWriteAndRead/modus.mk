@@ -87,6 +87,8 @@ CY_APP_CM4_SOURCE = \
 	Source/stdio_user.h\
 	Source/smif_mem.c\
 	Source/smif_mem.h\
+	Source/ftl.c\
+	Source/ftl.h\
 	readme.txt
 
 #
@@ -84,6 +84,7 @@
 #include "cycfg.h"
 #include "cycfg_qspi_memslot.h"
 #include "smif_mem.h"
+#include "smif_bulk_read.h"
 #include <stdio.h>
 
 /***************************************************************************
@@ -95,6 +96,7 @@
 #define SMIF_PRIORITY           (1u)      /* SMIF interrupt priority */
 #define BYTES_PER_LINE		    (8u)
 #define TEST_DATA				(0xBA) 	  /* Data to be written to external memory */
+#define BULK_READ_SIZE			(4096u)   /* Size of the DMA read of the XIP region */
 
 /***************************************************************************
 * Global string that is placed in external memory
@@ -107,6 +109,9 @@ const char hiWord[] CY_SECTION(".cy_xip") = "\r\n\rHello from the external strin
 cy_stc_scb_uart_context_t UARTContext;
 cy_stc_smif_context_t SMIFContext;
 
+/* Destination of the DMA read of the XIP region */
+uint8_t bulkBuffer[BULK_READ_SIZE];
+
 /*******************************************************************************
 * Function Name: SMIF_Interrupt_User
 ********************************************************************************
@@ -240,6 +245,10 @@ int main(void)
     SMIF_Status = Cy_SMIF_Memslot_Init(SMIF_HW, (cy_stc_smif_block_config_t *) &smifBlockConfig, &SMIFContext);
     CheckStatus("SMIF memory slot initialization failed", SMIF_Status);
 
+    /* Prepare the DMA channel used by bulk reads */
+    SMIF_Status = InitBulkRead(smifMemConfigs[0]);
+    CheckStatus("Bulk read initialization failed", SMIF_Status);
+
     bool isQuadEnabled = false;
     SMIF_Status = IsQuadEnabled(smifMemConfigs[0], &isQuadEnabled);
     CheckStatus("Checking QE bit failed", SMIF_Status);
@@ -314,6 +323,20 @@ int main(void)
 	/* Print by calling function which lives in external memory */
 	PrintFromExternalMemory("\n\rHello from the external function\n\r");
 
+	/* Read the start of the XIP region with DMA into two buffers */
+	bulk_read_segment_t segments[] =
+	{
+		{ &bulkBuffer[0], BULK_READ_SIZE / 2u },
+		{ &bulkBuffer[BULK_READ_SIZE / 2u], BULK_READ_SIZE / 2u }
+	};
+	bulk_read_stats_t bulkStats;
+
+	SMIF_Status = ReadMemoryBulk(smifMemConfigs[0], 0u, segments, 2u);
+	CheckStatus("Bulk reading memory failed", SMIF_Status);
+	GetBulkReadStats(&bulkStats);
+	printf("\n\r5. Read %lu bytes with %s at %lu.%03lu MB/s\n\r", bulkStats.bytes,
+		   bulkStats.usedDma ? "DMA" : "read commands", bulkStats.kBytesPerSec / 1000u, bulkStats.kBytesPerSec % 1000u);
+
     for(;;)
     {
     	/* Loop forever */
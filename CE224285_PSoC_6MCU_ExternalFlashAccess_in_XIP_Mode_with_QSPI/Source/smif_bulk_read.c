@@ -0,0 +1,572 @@
+/******************************************************************************
+* File Name: smif_bulk_read.c
+*
+* Version: 1.0
+*
+* Description:
+* 	This file contains functions to read large blocks of the external memory,
+* 	such as assets and firmware images, into a list of buffers. Reads inside the
+* 	memory-mapped (XIP) region are done by a chain of DataWire descriptors
+* 	that copy from the memory-mapped address space, so that the SMIF block
+* 	fetches the data with the quad read command of the memory configuration and
+* 	the CPU only starts the transfer. The memory is kept in continuous read
+* 	mode during the transfer, so that the SMIF block sends each read without
+* 	the command byte. The region covers the first 16 MB of the memory, all
+* 	that the 3-byte addresses of the memory configuration reach.
+* 	Reads outside of this region, or with a memory configuration that is not
+* 	memory-mapped, fall back to read commands serviced by the SMIF interrupt.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#include "smif_bulk_read.h"
+#include "smif_mem.h"
+#include "cycfg.h"
+
+
+/***************************************************************************
+* Global constants
+***************************************************************************/
+/* A chain holds up to 4 descriptors per destination buffer: the bytes up to a
+ * word boundary, the rows of 256 words, the rest of the words and the last
+ * bytes. Buffers larger than 256 KB take several chains.
+ */
+#define BULK_READ_MAX_DESCRIPTORS	(4u * BULK_READ_MAX_SEGMENTS)
+
+/* Max number of elements of the X and Y loops of a DataWire descriptor */
+#define DMA_MAX_LOOP_COUNT			(256ul)
+
+
+/***************************************************************************
+* Global variables
+***************************************************************************/
+/* All the functions in this module use the following context variable */
+extern cy_stc_smif_context_t SMIFContext;
+
+static cy_stc_dma_descriptor_t descriptors[BULK_READ_MAX_DESCRIPTORS];
+static bulk_read_stats_t lastStats;
+
+
+/*******************************************************************************
+* Function Name: EnterContinuousRead
+****************************************************************************//**
+*
+* Puts the memory in continuous read mode and sets up the memory mode of the
+* SMIF block to send the reads without the command byte. The memory enters
+* the mode with a one-byte read command whose mode bits are
+* BULK_READ_CONTINUOUS_MODE. Call it in the normal mode of the SMIF block.
+* Nothing is done when the read command of the memory has no mode bits.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* An address of the memory to read.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t EnterContinuousRead(cy_stc_smif_mem_config_t const *memConfig, uint32_t address)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	cy_stc_smif_mem_cmd_t const *readCmd = memConfig->deviceCfg->readCmd;
+
+	if(CY_SMIF_NO_COMMAND_OR_MODE != readCmd->mode)
+	{
+		cy_stc_smif_mem_cmd_t continuousCmd = *readCmd;
+		cy_stc_smif_mem_device_cfg_t continuousDevice = *memConfig->deviceCfg;
+		cy_stc_smif_mem_config_t continuousConfig = *memConfig;
+		uint8_t data;
+
+		continuousCmd.mode = BULK_READ_CONTINUOUS_MODE;
+		continuousDevice.readCmd = &continuousCmd;
+		continuousConfig.deviceCfg = &continuousDevice;
+
+		status = ReadMemoryRange(&continuousConfig, address, &data, 1u);
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			SMIF_DEVICE_Type volatile *device = Cy_SMIF_GetDeviceBySlot(SMIF_HW, memConfig->slaveSelect);
+
+			device->RD_CMD_CTL &= ~SMIF_DEVICE_RD_CMD_CTL_PRESENT_Msk;
+			device->RD_MODE_CTL = _CLR_SET_FLD32U(device->RD_MODE_CTL, SMIF_DEVICE_RD_MODE_CTL_CODE, BULK_READ_CONTINUOUS_MODE);
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: ExitContinuousRead
+****************************************************************************//**
+*
+* Restores the read command of the memory mode of the SMIF block and releases
+* the memory from continuous read mode with a mode bit reset: the command and
+* address bytes are sent with all the data lines high, which the memory takes
+* for an address and mode bits that end the mode. Outside of continuous read
+* mode the memory takes the same bytes for the mode bit reset command, which
+* does nothing. Call it in the normal mode of the SMIF block.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t ExitContinuousRead(cy_stc_smif_mem_config_t const *memConfig)
+{
+	cy_en_smif_status_t status;
+	cy_stc_smif_mem_cmd_t const *readCmd = memConfig->deviceCfg->readCmd;
+	uint8_t const resetAddress[MEMORY_MAX_ADDRESS_SIZE] =
+	{
+		BULK_READ_MODE_BIT_RESET, BULK_READ_MODE_BIT_RESET, BULK_READ_MODE_BIT_RESET, BULK_READ_MODE_BIT_RESET
+	};
+
+	if(CY_SMIF_NO_COMMAND_OR_MODE != readCmd->mode)
+	{
+		SMIF_DEVICE_Type volatile *device = Cy_SMIF_GetDeviceBySlot(SMIF_HW, memConfig->slaveSelect);
+
+		device->RD_CMD_CTL |= SMIF_DEVICE_RD_CMD_CTL_PRESENT_Msk;
+		device->RD_MODE_CTL = _CLR_SET_FLD32U(device->RD_MODE_CTL, SMIF_DEVICE_RD_MODE_CTL_CODE, readCmd->mode);
+	}
+
+	while(Cy_SMIF_BusyCheck(SMIF_HW))
+	{
+		/* Wait until a transfer of the memory mode completes */
+	}
+
+	/* Enough clocks for the address and the mode bits */
+	status = Cy_SMIF_TransmitCommand(SMIF_HW, BULK_READ_MODE_BIT_RESET, CY_SMIF_WIDTH_QUAD,
+									 resetAddress, memConfig->deviceCfg->numOfAddrBytes, CY_SMIF_WIDTH_QUAD,
+									 memConfig->slaveSelect, CY_SMIF_TX_LAST_BYTE, &SMIFContext);
+
+	while(Cy_SMIF_BusyCheck(SMIF_HW))
+	{
+		/* Wait until the SMIF block has sent the mode bit reset */
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: InitBulkRead
+****************************************************************************//**
+*
+* Initializes the DataWire channel used by the bulk reads and the cycle counter
+* used to measure them. The memory is released from continuous read mode, in
+* case a reset happened during a bulk read. Call it once after
+* Cy_SMIF_Memslot_Init() and before the first bulk read or any other command.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+cy_en_smif_status_t InitBulkRead(cy_stc_smif_mem_config_t const *memConfig)
+{
+	cy_stc_dma_channel_config_t channelConfig =
+	{
+		.descriptor  = &descriptors[0],
+		.preemptable = false,
+		.priority    = 3u,
+		.enable      = false,
+		.bufferable  = false
+	};
+
+	Cy_DMA_Channel_Init(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL, &channelConfig);
+	Cy_DMA_Enable(BULK_READ_DMA_HW);
+
+	/* Enable the cycle counter of the DWT unit */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	return ExitContinuousRead(memConfig);
+}
+
+
+/*******************************************************************************
+* Function Name: AddDescriptor
+****************************************************************************//**
+*
+* Sets up the next descriptor of the chain to copy the largest part of a
+* segment that a single descriptor can copy. Words are copied when both
+* addresses are word aligned. When both addresses have the same offset in a
+* word, the bytes up to the word boundary are copied first, so that the rest
+* of the segment is copied in words. Otherwise bytes are copied.
+*
+* \param index
+* Index of the descriptor to set up.
+*
+* \param src
+* Address to copy from.
+*
+* \param dst
+* Address to copy to.
+*
+* \param size
+* Size of data left in the segment.
+*
+* \return Size of data the descriptor copies.
+*
+*******************************************************************************/
+static uint32_t AddDescriptor(uint32_t index, uint8_t const *src, uint8_t *dst, uint32_t size)
+{
+	bool isWord = (0u == (((uint32_t)src | (uint32_t)dst) & 3u)) && (size >= 4u);
+	uint32_t elementSize = isWord ? 4u : 1u;
+	uint32_t elements = size / elementSize;
+	uint32_t yCount;
+
+	if((!isWord) && (0u == (((uint32_t)src ^ (uint32_t)dst) & 3u)) && (size >= 4u))
+	{
+		/* Bytes up to the word boundary */
+		elements = 4u - ((uint32_t)src & 3u);
+	}
+
+	yCount = elements / DMA_MAX_LOOP_COUNT;
+
+	cy_stc_dma_descriptor_config_t config =
+	{
+		.retrigger       = CY_DMA_RETRIG_IM,
+		.interruptType   = CY_DMA_DESCR_CHAIN,
+		.triggerOutType  = CY_DMA_DESCR_CHAIN,
+		.channelState    = CY_DMA_CHANNEL_ENABLED,
+		.triggerInType   = CY_DMA_DESCR_CHAIN,
+		.dataSize        = isWord ? CY_DMA_WORD : CY_DMA_BYTE,
+		.srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+		.dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+		.srcAddress      = (void *)src,
+		.dstAddress      = (void *)dst,
+		.srcXincrement   = 1,
+		.dstXincrement   = 1,
+		.nextDescriptor  = NULL
+	};
+
+	if(0u != yCount)
+	{
+		/* Rows of 256 elements */
+		yCount = (yCount > DMA_MAX_LOOP_COUNT) ? DMA_MAX_LOOP_COUNT : yCount;
+		elements = yCount * DMA_MAX_LOOP_COUNT;
+
+		config.descriptorType = CY_DMA_2D_TRANSFER;
+		config.xCount         = DMA_MAX_LOOP_COUNT;
+		config.srcYincrement  = (int32_t)DMA_MAX_LOOP_COUNT;
+		config.dstYincrement  = (int32_t)DMA_MAX_LOOP_COUNT;
+		config.yCount         = yCount;
+	}
+	else
+	{
+		config.descriptorType = CY_DMA_1D_TRANSFER;
+		config.xCount         = elements;
+	}
+
+	Cy_DMA_Descriptor_Init(&descriptors[index], &config);
+
+	if(0u != index)
+	{
+		Cy_DMA_Descriptor_SetNextDescriptor(&descriptors[index - 1u], &descriptors[index]);
+	}
+
+	return (elements * elementSize);
+}
+
+
+/*******************************************************************************
+* Function Name: RunDescriptors
+****************************************************************************//**
+*
+* Starts the chain of the descriptors set up and blocks until it completes or
+* timeout occurs.
+*
+* \param numDescriptors
+* Number of descriptors of the chain.
+*
+* \param size
+* Size of data the chain copies.
+*
+* \return Status of the operation.
+* CY_SMIF_SUCCESS        - The chain is complete.
+* CY_SMIF_BAD_PARAM      - The DataWire reported an error.
+* CY_SMIF_EXCEED_TIMEOUT - Timeout occurred.
+*
+*******************************************************************************/
+static cy_en_smif_status_t RunDescriptors(uint32_t numDescriptors, uint32_t size)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t elapsed = 0u;
+
+	/* The channel is disabled after the last descriptor */
+	Cy_DMA_Descriptor_SetChannelState(&descriptors[numDescriptors - 1u], CY_DMA_CHANNEL_DISABLED);
+
+	Cy_DMA_Channel_ClearInterrupt(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL);
+	Cy_DMA_Channel_SetDescriptor(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL, &descriptors[0]);
+	Cy_DMA_Channel_Enable(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL);
+	(void)Cy_TrigMux_SwTrigger(BULK_READ_DMA_TRIGGER, CY_TRIGGER_TWO_CYCLES);
+
+	while((0u == (Cy_DMA_Channel_GetInterruptStatus(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL) & CY_DMA_INTR_MASK)) &&
+		  (elapsed < (BULK_READ_TIMEOUT + size)))
+	{
+		Cy_SysLib_DelayUs(1u);
+		elapsed++;
+	}
+
+	if(0u == (Cy_DMA_Channel_GetInterruptStatus(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL) & CY_DMA_INTR_MASK))
+	{
+		Cy_DMA_Channel_Disable(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL);
+		status = CY_SMIF_EXCEED_TIMEOUT;
+	}
+	else if(CY_DMA_INTR_CAUSE_COMPLETION != Cy_DMA_Channel_GetStatus(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL))
+	{
+		Cy_DMA_Channel_Disable(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL);
+		status = CY_SMIF_BAD_PARAM;
+	}
+	else
+	{
+		/* The chain is complete */
+	}
+
+	Cy_DMA_Channel_ClearInterrupt(BULK_READ_DMA_HW, BULK_READ_DMA_CHANNEL);
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: ReadMappedMemory
+****************************************************************************//**
+*
+* Reads the memory-mapped region with chains of DataWire descriptors and blocks
+* until all the data is read or timeout occurs. A chain takes up to four
+* descriptors per segment; segments larger than a chain can copy are read by
+* several chains in turn.
+*
+* \param src
+* Memory-mapped address to read from.
+*
+* \param segments
+* The buffers for storing the read data, filled in order.
+*
+* \param numSegments
+* Number of segments.
+*
+* \return Status of the operation.
+* CY_SMIF_SUCCESS        - The data is read.
+* CY_SMIF_BAD_PARAM      - The DataWire reported an error.
+* CY_SMIF_EXCEED_TIMEOUT - Timeout occurred.
+*
+*******************************************************************************/
+static cy_en_smif_status_t ReadMappedMemory(uint8_t const *src, bulk_read_segment_t const segments[], uint32_t numSegments)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t numDescriptors = 0u;
+	uint32_t chainSize = 0u;
+
+	for(uint32_t index = 0u; (index < numSegments) && (CY_SMIF_SUCCESS == status); index++)
+	{
+		uint32_t offset = 0u;
+
+		while((offset < segments[index].size) && (CY_SMIF_SUCCESS == status))
+		{
+			uint32_t copied = AddDescriptor(numDescriptors, &src[offset], &segments[index].buffer[offset], segments[index].size - offset);
+
+			offset += copied;
+			chainSize += copied;
+			numDescriptors++;
+
+			if(BULK_READ_MAX_DESCRIPTORS == numDescriptors)
+			{
+				/* The chain is full, copy what it holds before continuing */
+				status = RunDescriptors(numDescriptors, chainSize);
+				numDescriptors = 0u;
+				chainSize = 0u;
+			}
+		}
+
+		src += segments[index].size;
+	}
+
+	if((CY_SMIF_SUCCESS == status) && (0u != numDescriptors))
+	{
+		status = RunDescriptors(numDescriptors, chainSize);
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: ReadMemoryBulk
+****************************************************************************//**
+*
+* Reads consecutive data of the external memory into a list of buffers and
+* blocks until all the data is read or timeout occurs. When the data lies in
+* the memory-mapped region, it is read with DMA in the memory mode of the SMIF
+* block, otherwise with read commands in the normal mode. With 3-byte addresses
+* the region is limited to the first 16 MB of the memory, which is all the
+* memory the configuration can address; a larger region needs a 4-byte address
+* read command (0xEC) and a memory configuration with 4 address bytes. The
+* region must be a power of 2 aligned to the base address. The memory is in
+* continuous read mode only during the DMA transfer. The SMIF block is
+* left in the mode it was in. A sector erase running in the background is
+* suspended during the read; the sector being erased cannot be read. The memory
+* slot must be initialized with Cy_SMIF_Memslot_Init() and InitBulkRead() must
+* be called before.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* The address to read data from.
+*
+* \param segments
+* The buffers for storing the read data, filled in order.
+*
+* \param numSegments
+* Number of segments, up to BULK_READ_MAX_SEGMENTS.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+cy_en_smif_status_t ReadMemoryBulk(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, bulk_read_segment_t const segments[], uint32_t numSegments)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	cy_en_smif_mode_t mode = Cy_SMIF_GetMode(SMIF_HW);
+	uint32_t size = 0u;
+	uint32_t start;
+
+	if(numSegments > BULK_READ_MAX_SEGMENTS)
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	for(uint32_t index = 0u; (index < numSegments) && (CY_SMIF_SUCCESS == status); index++)
+	{
+		if(segments[index].size > (memConfig->deviceCfg->memSize - size))
+		{
+			status = CY_SMIF_BAD_PARAM;
+		}
+		else
+		{
+			size += segments[index].size;
+		}
+	}
+
+	lastStats.bytes = 0u;
+	lastStats.usedDma = (0u != (memConfig->flags & CY_SMIF_FLAG_MEMORY_MAPPED)) &&
+						(address <= memConfig->memMappedSize) && (size <= (memConfig->memMappedSize - address));
+	start = DWT->CYCCNT;
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		/* The erase commands are sent in the normal mode */
+		Cy_SMIF_SetMode(SMIF_HW, CY_SMIF_NORMAL);
+		status = SuspendErase(memConfig);
+	}
+
+	if((CY_SMIF_SUCCESS == status) && lastStats.usedDma)
+	{
+		status = EnterContinuousRead(memConfig, address);
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			Cy_SMIF_SetMode(SMIF_HW, CY_SMIF_MEMORY);
+			status = ReadMappedMemory((uint8_t const *)(memConfig->baseAddress + address), segments, numSegments);
+			Cy_SMIF_SetMode(SMIF_HW, CY_SMIF_NORMAL);
+		}
+
+		/* The memory must leave continuous read mode before the next command */
+		if(CY_SMIF_SUCCESS == status)
+		{
+			status = ExitContinuousRead(memConfig);
+		}
+		else
+		{
+			(void)ExitContinuousRead(memConfig);
+		}
+	}
+	else if(CY_SMIF_SUCCESS == status)
+	{
+		for(uint32_t index = 0u; (index < numSegments) && (CY_SMIF_SUCCESS == status); index++)
+		{
+			status = ReadMemoryRange(memConfig, address, segments[index].buffer, segments[index].size);
+			address += segments[index].size;
+		}
+	}
+	else
+	{
+		/* Bad parameters, or the erase cannot be suspended */
+	}
+
+	Cy_SMIF_SetMode(SMIF_HW, CY_SMIF_NORMAL);
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = ResumeErase(memConfig);
+	}
+	else
+	{
+		(void)ResumeErase(memConfig);
+	}
+
+	Cy_SMIF_SetMode(SMIF_HW, mode);
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		lastStats.bytes = size;
+		lastStats.cycles = DWT->CYCCNT - start;
+		lastStats.kBytesPerSec = (0u != lastStats.cycles) ?
+			(uint32_t)(((uint64_t)size * (SystemCoreClock / 1000u)) / lastStats.cycles) : 0u;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: GetBulkReadStats
+****************************************************************************//**
+*
+* Reports the size, the duration and the throughput of the last successful bulk
+* read. The size is 0 when the last bulk read failed.
+*
+* \param stats
+* Returns the statistics of the last bulk read.
+*
+*******************************************************************************/
+void GetBulkReadStats(bulk_read_stats_t *stats)
+{
+	*stats = lastStats;
+}
+
+
@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name: smif_bulk_read.h
+*
+* Version: 1.0
+*
+* Description:
+* 	This is the public interface header for smif_bulk_read.c. This file contains
+* 	the functions to read large blocks of the external memory with DMA into a
+* 	list of buffers.
+*
+*******************************************************************************
+* Copyright (2019), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions.  Therefore, you may use this Software only as
+* provided in the license agreement accompanying the software package from which
+* you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source code
+* solely for use in connection with Cypress’s integrated circuit products.  Any
+* reproduction, modification, translation, compilation, or representation of
+* this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does not
+* authorize its products for use in any products where a malfunction or failure
+* of the Cypress product may reasonably be expected to result in significant
+* property damage, injury or death ("High Risk Product"). By including Cypress's
+* product in a High Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so agrees to indemnify Cypress
+* against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SMIF_BULK_READ_H
+#define SOURCE_SMIF_BULK_READ_H
+
+#include "cy_pdl.h"
+
+
+/***************************************************************************
+* Global Constants
+***************************************************************************/
+/* DataWire channel used for the bulk reads and its software trigger */
+#define BULK_READ_DMA_HW			(DW1)
+#define BULK_READ_DMA_CHANNEL		(15u)
+#define BULK_READ_DMA_TRIGGER		(TRIG1_OUT_CPUSS_DW1_TR_IN15)
+
+/* Max number of destination buffers of a bulk read */
+#define BULK_READ_MAX_SEGMENTS		(8u)
+
+/* Timeout of a bulk read, extended by 1 us per byte read */
+#define BULK_READ_TIMEOUT			(1000ul) 	/* microseconds */
+
+/* Mode bits of the read command that keep the S25FL512S in continuous read
+ * mode: the reads that follow are sent without the command byte
+ */
+#define BULK_READ_CONTINUOUS_MODE	(0xA0u)
+
+/* Mode bit reset: all the data lines high for the command and address bytes */
+#define BULK_READ_MODE_BIT_RESET	(0xFFu)
+
+
+/***************************************************************************
+* Data Types
+***************************************************************************/
+/* Destination buffer of a part of a bulk read */
+typedef struct
+{
+	uint8_t *buffer;	/* Buffer for storing the read data */
+	uint32_t size;		/* Size of data to read into the buffer */
+} bulk_read_segment_t;
+
+/* Result of the last bulk read */
+typedef struct
+{
+	uint32_t bytes;			/* Size of data read */
+	uint32_t cycles;		/* CPU cycles the read took */
+	uint32_t kBytesPerSec;	/* Achieved throughput in kB/s */
+	bool usedDma;			/* Read with DMA (true) or by read commands (false) */
+} bulk_read_stats_t;
+
+
+/***************************************************************************
+* Function Prototypes
+***************************************************************************/
+cy_en_smif_status_t InitBulkRead(cy_stc_smif_mem_config_t const *memConfig);
+cy_en_smif_status_t ReadMemoryBulk(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, bulk_read_segment_t const segments[], uint32_t numSegments);
+void GetBulkReadStats(bulk_read_stats_t *stats);
+
+#endif /* SOURCE_SMIF_BULK_READ_H */
+
+
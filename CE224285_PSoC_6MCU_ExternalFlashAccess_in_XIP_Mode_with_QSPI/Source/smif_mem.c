@@ -53,38 +53,229 @@
 extern cy_stc_smif_context_t SMIFContext;
 
 
+/* Waits used while a transfer or a memory operation is in progress */
+static void DelayUs(uint32_t waitUs);
+static bool PollTransferComplete(uint32_t timeoutUs);
+static smif_mem_wait_function_t memoryWait = DelayUs;
+static smif_mem_event_wait_function_t memoryEventWait = PollTransferComplete;
+static smif_mem_event_function_t memoryEvent = NULL;
+
+/* Set by the SMIF interrupt when the current read or program transfer is done */
+static volatile bool transferComplete = false;
+
+/* State of the erase running in the background */
+typedef enum
+{
+	ERASE_IDLE,			/* No erase in progress */
+	ERASE_RUNNING,		/* The memory is erasing, or the next erase is due */
+	ERASE_SUSPENDED		/* The current erase is suspended */
+} erase_state_t;
+
+static erase_state_t eraseState = ERASE_IDLE;
+static bool eraseChip = false;		/* The current erase is a chip erase */
+static uint32_t eraseCurrent = 0u;	/* Address of the sector being erased */
+static uint32_t eraseNext = 0u;		/* Address of the next sector to erase */
+static uint32_t eraseEnd = 0u;		/* End of the range to erase */
+
+
+/*******************************************************************************
+* Function Name: DelayUs
+****************************************************************************//**
+*
+* Default wait function, busy waits for the given time.
+*
+* \param waitUs
+* Time to wait in microseconds, up to MEMORY_MAX_POLL_INTERVAL.
+*
+*******************************************************************************/
+static void DelayUs(uint32_t waitUs)
+{
+	Cy_SysLib_DelayUs((uint16_t)waitUs);
+}
+
+
+/*******************************************************************************
+* Function Name: PollTransferComplete
+****************************************************************************//**
+*
+* Default event wait function, busy waits until the current transfer completes
+* or timeout occurs.
+*
+* \param timeoutUs
+* Time to give up after, in microseconds.
+*
+* \return True when the transfer completed.
+*
+*******************************************************************************/
+static bool PollTransferComplete(uint32_t timeoutUs)
+{
+	uint32_t elapsed = 0u;
+
+	while((!transferComplete) && (elapsed < timeoutUs))
+	{
+		Cy_SysLib_DelayUs((uint16_t)SMIF_TRANSFER_POLL_INTERVAL);
+		elapsed += SMIF_TRANSFER_POLL_INTERVAL;
+	}
+
+	return transferComplete;
+}
+
+
+/*******************************************************************************
+* Function Name: RegisterMemoryWaitFunction
+****************************************************************************//**
+*
+* Registers the functions used to wait while a transfer or a memory operation
+* is in progress. An RTOS application registers functions that block the
+* calling task, so that other tasks run during transfers and during long erase
+* and program operations. See smif_mem_rtos.c for FreeRTOS.
+*
+* \param waitFunction
+* Function waiting for the given number of microseconds between the busy
+* checks of the memory. NULL restores the default busy wait.
+*
+* \param eventWaitFunction
+* Function waiting up to the given number of microseconds for the event
+* function to be called at the end of a transfer. NULL restores the default
+* polling of the transfer status.
+*
+*******************************************************************************/
+void RegisterMemoryWaitFunction(smif_mem_wait_function_t waitFunction, smif_mem_event_wait_function_t eventWaitFunction)
+{
+	memoryWait = (NULL != waitFunction) ? waitFunction : DelayUs;
+	memoryEventWait = (NULL != eventWaitFunction) ? eventWaitFunction : PollTransferComplete;
+}
+
+
+/*******************************************************************************
+* Function Name: RegisterMemoryEventFunction
+****************************************************************************//**
+*
+* Registers the function called from the SMIF interrupt when a read or program
+* transfer completes, e.g. to wake up the task blocked in the wait function.
+*
+* \param eventFunction
+* Function called with the completion event, or NULL.
+*
+*******************************************************************************/
+void RegisterMemoryEventFunction(smif_mem_event_function_t eventFunction)
+{
+	memoryEvent = eventFunction;
+}
+
+
+/*******************************************************************************
+* Function Name: TransferComplete
+****************************************************************************//**
+*
+* Transfer completion callback of Cy_SMIF_Memslot_CmdRead() and
+* Cy_SMIF_Memslot_CmdProgram(), called from the SMIF interrupt.
+*
+* \param event
+* CY_SMIF_REC_CMPLT or CY_SMIF_SEND_CMPLT.
+*
+*******************************************************************************/
+static void TransferComplete(uint32_t event)
+{
+	transferComplete = true;
+
+	if(NULL != memoryEvent)
+	{
+		memoryEvent(event);
+	}
+}
+
+
 /*******************************************************************************
-* Function Name: PollTransferStatus
+* Function Name: WaitTransferComplete
 ****************************************************************************//**
 *
-* Polls the SMIF block until the transfer status equals the expected value or
-* timeout occurs.
+* Waits until the SMIF block signals the completion of the current transfer or
+* timeout occurs. The event wait function blocks for the whole timeout and
+* returns as soon as the event function is called.
 *
-* \param transferStatus
-* Transfer status value to be checked.
+* \param size
+* The size of data transferred.
 *
 * \return Status of the operation.
 * CY_SMIF_SUCCESS 	     - SMIF block has completed the transfer
 * CY_SMIF_EXCEED_TIMEOUT - Timeout occurred.
 *
 *******************************************************************************/
-static cy_en_smif_status_t PollTransferStatus(cy_en_smif_txfr_status_t transferStatus)
+static cy_en_smif_status_t WaitTransferComplete(uint32_t size)
 {
-	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
-	uint32_t timeout = SMIF_TRANSFER_TIMEOUT;
+	bool isEvent = true;
 
-	while (((uint32_t)transferStatus != Cy_SMIF_GetTxfrStatus(SMIF_HW, &SMIFContext)) && ( timeout > 0u))
+	/* The event of an earlier transfer that timed out can end a wait early */
+	while((!transferComplete) && isEvent)
 	{
-		Cy_SysLib_DelayUs(CY_SMIF_WAIT_1_UNIT);
-		timeout--;
+		isEvent = memoryEventWait(SMIF_TRANSFER_TIMEOUT + size);
 	}
 
-	if((uint32_t)transferStatus != Cy_SMIF_GetTxfrStatus(SMIF_HW, &SMIFContext))
+	return (transferComplete ? CY_SMIF_SUCCESS : CY_SMIF_EXCEED_TIMEOUT);
+}
+
+
+/*******************************************************************************
+* Function Name: WaitMemoryReady
+****************************************************************************//**
+*
+* Polls the memory device until it is ready to accept new commands or timeout
+* occurs. The first check is done right away. The following checks start at 1/8
+* of the max cycle time of the operation, and the interval doubles up to 1/4 of
+* it, so that completion is seen shortly after the device finishes. When the
+* cycle time is unknown (0), the interval backs off from the min interval.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param maxTimeUs
+* Max cycle time of the operation in progress, in microseconds, or 0.
+*
+* \param timeoutUs
+* Time to give up after, in microseconds.
+*
+* \return Status of the operation.
+* CY_SMIF_SUCCESS 	     - Memory is ready to accept new commands.
+* CY_SMIF_EXCEED_TIMEOUT - Memory is busy.
+*
+*******************************************************************************/
+static cy_en_smif_status_t WaitMemoryReady(cy_stc_smif_mem_config_t const *memConfig, uint32_t maxTimeUs, uint32_t timeoutUs)
+{
+	uint32_t elapsed = 0u;
+	uint32_t interval = maxTimeUs / MEMORY_FIRST_POLL_DIVIDER;
+	uint32_t maxInterval = MEMORY_MAX_POLL_INTERVAL;
+	bool isBusy;
+
+	if((0u != maxTimeUs) && ((maxTimeUs / 4u) < maxInterval))
 	{
-		status = CY_SMIF_EXCEED_TIMEOUT;
+		maxInterval = ((maxTimeUs / 4u) > MEMORY_MIN_POLL_INTERVAL) ? (maxTimeUs / 4u) : MEMORY_MIN_POLL_INTERVAL;
 	}
 
-	return status;
+	isBusy = Cy_SMIF_Memslot_IsBusy(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, &SMIFContext);
+
+	while(isBusy && (elapsed < timeoutUs))
+	{
+		if(interval < MEMORY_MIN_POLL_INTERVAL)
+		{
+			interval = MEMORY_MIN_POLL_INTERVAL;
+		}
+		else if(interval > maxInterval)
+		{
+			interval = maxInterval;
+		}
+		else
+		{
+			/* Keep the interval */
+		}
+		memoryWait(interval);
+		elapsed += interval;
+		interval *= 2u;
+
+		isBusy = Cy_SMIF_Memslot_IsBusy(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, &SMIFContext);
+	}
+
+	return (isBusy ? CY_SMIF_EXCEED_TIMEOUT : CY_SMIF_SUCCESS);
 }
 
 
@@ -93,7 +284,7 @@ static cy_en_smif_status_t PollTransferStatus(cy_en_smif_txfr_status_t transferS
 ****************************************************************************//**
 *
 * Polls the memory device to check whether it is ready to accept new commands or
-* not until either it is ready or the retries have exceeded the limit.
+* not until either it is ready or the timeout has expired.
 *
 * \param memConfig
 * memory device configuration
@@ -105,17 +296,7 @@ static cy_en_smif_status_t PollTransferStatus(cy_en_smif_txfr_status_t transferS
 *******************************************************************************/
 cy_en_smif_status_t IsMemoryReady(cy_stc_smif_mem_config_t const *memConfig)
 {
-	uint32_t retries = 0;
-	bool isBusy;
-
-	do
-	{
-		isBusy = Cy_SMIF_Memslot_IsBusy(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, &SMIFContext);
-		Cy_SysLib_Delay(CY_SMIF_WAIT_1_UNIT);
-		retries++;
-	}while(isBusy && (retries < MEMORY_BUSY_CHECK_RETRIES));
-
-	return (isBusy ? CY_SMIF_EXCEED_TIMEOUT : CY_SMIF_SUCCESS);
+	return WaitMemoryReady(memConfig, 0u, MEMORY_BUSY_TIMEOUT);
 }
 
 
@@ -216,12 +397,15 @@ cy_en_smif_status_t EnableQuadMode(cy_stc_smif_mem_config_t const *memConfig)
 *******************************************************************************/
 cy_en_smif_status_t ReadMemory(cy_stc_smif_mem_config_t const *memConfig, uint8_t address[], uint8_t rxBuffer[], uint32_t rxSize)
 {
-    cy_en_smif_status_t status = Cy_SMIF_Memslot_CmdRead(SMIF_HW, memConfig, address, rxBuffer, rxSize, NULL, &SMIFContext);
+    cy_en_smif_status_t status;
+
+    transferComplete = false;
+    status = Cy_SMIF_Memslot_CmdRead(SMIF_HW, memConfig, address, rxBuffer, rxSize, TransferComplete, &SMIFContext);
 
     if(CY_SMIF_SUCCESS == status)
 	{
     	/* Wait until the SMIF block completes receiving data */
-    	status = PollTransferStatus(CY_SMIF_REC_CMPLT);
+    	status = WaitTransferComplete(rxSize);
 	}
 
     return status;
@@ -232,7 +416,8 @@ cy_en_smif_status_t ReadMemory(cy_stc_smif_mem_config_t const *memConfig, uint8_
 * Function Name: WriteMemory
 ********************************************************************************
 *
-* This function writes data to the external memory.
+* This function writes data to the external memory and blocks until the device
+* completes the page program or timeout occurs.
 *
 * \param memConfig
 * Memory device configuration
@@ -255,17 +440,20 @@ cy_en_smif_status_t WriteMemory(cy_stc_smif_mem_config_t const *memConfig, uint8
 
     if(CY_SMIF_SUCCESS == status)
     {
-		status = Cy_SMIF_Memslot_CmdProgram(SMIF_HW, memConfig, address, txBuffer, txSize, NULL, &SMIFContext);
+		uint32_t programTime = memConfig->deviceCfg->programTime; /* microseconds */
+
+		transferComplete = false;
+		status = Cy_SMIF_Memslot_CmdProgram(SMIF_HW, memConfig, address, txBuffer, txSize, TransferComplete, &SMIFContext);
 
 		if(CY_SMIF_SUCCESS == status)
 		{
 			/* Wait until the SMIF block completes transmitting data */
-			status = PollTransferStatus(CY_SMIF_SEND_CMPLT);
+			status = WaitTransferComplete(txSize);
 
 			if(CY_SMIF_SUCCESS == status)
 			{
 				/* Wait until the write operation is completed or timeout occurs */
-				status = IsMemoryReady(memConfig);
+				status = WaitMemoryReady(memConfig, programTime, programTime * MEMORY_BUSY_TIMEOUT_FACTOR);
 			}
 		}
     }
@@ -295,12 +483,14 @@ cy_en_smif_status_t EraseMemory(cy_stc_smif_mem_config_t const *memConfig, uint8
 
     if(CY_SMIF_SUCCESS == status)
     {
+		uint32_t eraseTime = memConfig->deviceCfg->eraseTime * 1000ul; /* microseconds */
+
 		status = Cy_SMIF_Memslot_CmdSectorErase(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, address, &SMIFContext);
 
 		if(CY_SMIF_SUCCESS == status)
 		{
 			/* Wait until the erase operation is completed or timeout occurs. */
-			status = IsMemoryReady(memConfig);
+			status = WaitMemoryReady(memConfig, eraseTime, eraseTime * MEMORY_BUSY_TIMEOUT_FACTOR);
 		}
     }
 
@@ -308,3 +498,534 @@ cy_en_smif_status_t EraseMemory(cy_stc_smif_mem_config_t const *memConfig, uint8
 }
 
 
+/*******************************************************************************
+* Function Name: SetMemoryAddress
+****************************************************************************//**
+*
+* Converts an address to the byte array passed to the memory commands, MSB
+* first, using the number of address bytes of the memory device.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* The address to convert.
+*
+* \param addressBytes
+* The buffer for the address bytes, MEMORY_MAX_ADDRESS_SIZE bytes long.
+*
+*******************************************************************************/
+static void SetMemoryAddress(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint8_t addressBytes[])
+{
+	uint32_t numOfAddrBytes = memConfig->deviceCfg->numOfAddrBytes;
+
+	for(uint32_t index = 0; index < numOfAddrBytes; index++)
+	{
+		addressBytes[index] = (uint8_t)(address >> (8u * (numOfAddrBytes - 1u - index)));
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: ReadMemoryRange
+****************************************************************************//**
+*
+* This function reads data of any length from any address of the external
+* memory. The data is read with as few read commands as the SMIF block allows.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* The address to read data from.
+*
+* \param rxBuffer
+* The buffer for storing the read data.
+*
+* \param rxSize
+* The size of data to read.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - The data does not fit in the memory.
+*
+*******************************************************************************/
+cy_en_smif_status_t ReadMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint8_t rxBuffer[], uint32_t rxSize)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t memSize = memConfig->deviceCfg->memSize;
+	uint8_t addressBytes[MEMORY_MAX_ADDRESS_SIZE];
+	uint32_t offset = 0u;
+
+	if((address > memSize) || (rxSize > (memSize - address)))
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	while((CY_SMIF_SUCCESS == status) && (offset < rxSize))
+	{
+		uint32_t readBytes = rxSize - offset;
+
+		if(readBytes > SMIF_MAX_RX_SIZE)
+		{
+			readBytes = SMIF_MAX_RX_SIZE;
+		}
+
+		SetMemoryAddress(memConfig, address, addressBytes);
+		status = ReadMemory(memConfig, addressBytes, &rxBuffer[offset], readBytes);
+
+		address += readBytes;
+		offset += readBytes;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: WriteMemoryRange
+********************************************************************************
+*
+* This function writes data of any length at any address of the external
+* memory. The data is split on the program page boundaries, and each page is
+* written with a write enable, a page program and a wait for the device to
+* complete the program, so that no program command wraps around in a page.
+*
+* When the sectors are erased on demand, a sector is erased when the write
+* reaches its first byte. The data in front of the address in the first sector
+* is kept, so this part of the sector must already be erased, e.g. by a previous
+* write that ended there.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* The address to write data at.
+*
+* \param txBuffer
+* Buffer holding the data to write in the external memory.
+*
+* \param txSize
+* The size of data to write.
+*
+* \param eraseSectors
+* Erase the sectors the write enters (true) or not (false).
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - The data does not fit in the memory.
+*
+*******************************************************************************/
+cy_en_smif_status_t WriteMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint8_t txBuffer[], uint32_t txSize, bool eraseSectors)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t pageSize = memConfig->deviceCfg->programSize;
+	uint32_t sectorSize = memConfig->deviceCfg->eraseSize;
+	uint32_t memSize = memConfig->deviceCfg->memSize;
+	uint8_t addressBytes[MEMORY_MAX_ADDRESS_SIZE];
+	uint32_t offset = 0u;
+
+	if((address > memSize) || (txSize > (memSize - address)))
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	while((CY_SMIF_SUCCESS == status) && (offset < txSize))
+	{
+		/* Program up to the end of the page of the address */
+		uint32_t pageBytes = pageSize - (address % pageSize);
+
+		if(pageBytes > (txSize - offset))
+		{
+			pageBytes = txSize - offset;
+		}
+
+		SetMemoryAddress(memConfig, address, addressBytes);
+
+		if(eraseSectors && (0u == (address % sectorSize)))
+		{
+			status = EraseMemory(memConfig, addressBytes);
+		}
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			status = WriteMemory(memConfig, addressBytes, &txBuffer[offset], pageBytes);
+		}
+
+		address += pageBytes;
+		offset += pageBytes;
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: IssueErase
+****************************************************************************//**
+*
+* Starts erasing the whole memory or the sector at the given address, and
+* returns without waiting for the erase to complete.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param chip
+* Erase the whole memory (true) or a sector (false).
+*
+* \param address
+* The address of the sector to erase.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t IssueErase(cy_stc_smif_mem_config_t const *memConfig, bool chip, uint32_t address)
+{
+	uint8_t addressBytes[MEMORY_MAX_ADDRESS_SIZE];
+	cy_en_smif_status_t status = Cy_SMIF_Memslot_CmdWriteEnable(SMIF_HW, memConfig, &SMIFContext);
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		if(chip)
+		{
+			status = Cy_SMIF_Memslot_CmdChipErase(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, &SMIFContext);
+		}
+		else
+		{
+			SetMemoryAddress(memConfig, address, addressBytes);
+			status = Cy_SMIF_Memslot_CmdSectorErase(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, addressBytes, &SMIFContext);
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: TransmitEraseCommand
+****************************************************************************//**
+*
+* Sends an erase suspend or resume command to the memory device.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param command
+* MEMORY_CMD_ERASE_SUSPEND or MEMORY_CMD_ERASE_RESUME.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+static cy_en_smif_status_t TransmitEraseCommand(cy_stc_smif_mem_config_t const *memConfig, uint8_t command)
+{
+	cy_en_smif_status_t status = Cy_SMIF_TransmitCommand(SMIF_HW, command, CY_SMIF_WIDTH_SINGLE, NULL, 0u,
+							CY_SMIF_WIDTH_SINGLE, memConfig->slaveSelect, CY_SMIF_TX_LAST_BYTE, &SMIFContext);
+
+	while(Cy_SMIF_BusyCheck(SMIF_HW))
+	{
+		/* Wait until the SMIF block has sent the command */
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: StartEraseMemoryRange
+********************************************************************************
+*
+* Starts erasing a range of the external memory in the background. The range
+* is erased with the largest erase the memory device supports for it: a chip
+* erase when the range is the whole memory, sector erases otherwise. The first
+* erase is started here, the following ones by ProcessErase().
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* The address of the range, aligned to the sector size.
+*
+* \param size
+* The size of the range, a multiple of the sector size.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - The range is not made of whole sectors of the memory, or
+*                     an erase is already in progress.
+*
+*******************************************************************************/
+cy_en_smif_status_t StartEraseMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint32_t size)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t sectorSize = memConfig->deviceCfg->eraseSize;
+	uint32_t memSize = memConfig->deviceCfg->memSize;
+
+	if((ERASE_IDLE != eraseState) || (address > memSize) || (size > (memSize - address)) ||
+	   (0u != (address % sectorSize)) || (0u != (size % sectorSize)))
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+	else if(0u != size)
+	{
+		eraseChip = (0u == address) && (memSize == size);
+		eraseCurrent = address;
+		eraseNext = eraseChip ? memSize : (address + sectorSize);
+		eraseEnd = address + size;
+
+		status = IssueErase(memConfig, eraseChip, address);
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			eraseState = ERASE_RUNNING;
+		}
+	}
+	else
+	{
+		/* Nothing to erase */
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: ProcessErase
+********************************************************************************
+*
+* Advances the erase running in the background without blocking: when the
+* memory has completed the current erase, the next sector erase is started or
+* the erase of the range is finished. Call it periodically until
+* IsEraseInProgress() returns false.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \return Status of the operation. See cy_en_smif_status_t. The erase of the
+* range is abandoned when an erase cannot be started.
+*
+*******************************************************************************/
+cy_en_smif_status_t ProcessErase(cy_stc_smif_mem_config_t const *memConfig)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+	if((ERASE_RUNNING == eraseState) &&
+	   !Cy_SMIF_Memslot_IsBusy(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, &SMIFContext))
+	{
+		if(eraseNext < eraseEnd)
+		{
+			eraseCurrent = eraseNext;
+			eraseNext += memConfig->deviceCfg->eraseSize;
+
+			status = IssueErase(memConfig, false, eraseCurrent);
+
+			if(CY_SMIF_SUCCESS != status)
+			{
+				eraseState = ERASE_IDLE;
+			}
+		}
+		else
+		{
+			eraseState = ERASE_IDLE;
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: IsEraseInProgress
+********************************************************************************
+*
+* Reports whether an erase started by StartEraseMemoryRange() is in progress,
+* including while it is suspended.
+*
+* \return true while the range is not completely erased.
+*
+*******************************************************************************/
+bool IsEraseInProgress(void)
+{
+	return (ERASE_IDLE != eraseState);
+}
+
+
+/*******************************************************************************
+* Function Name: EraseMemoryRange
+********************************************************************************
+*
+* Erases a range of the external memory with the largest erases the memory
+* device supports for it, and blocks until the range is erased or timeout
+* occurs. See StartEraseMemoryRange().
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* The address of the range, aligned to the sector size.
+*
+* \param size
+* The size of the range, a multiple of the sector size.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+cy_en_smif_status_t EraseMemoryRange(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint32_t size)
+{
+	cy_en_smif_status_t status = StartEraseMemoryRange(memConfig, address, size);
+
+	while((CY_SMIF_SUCCESS == status) && IsEraseInProgress())
+	{
+		uint32_t eraseTime = (eraseChip ? memConfig->deviceCfg->chipEraseTime : memConfig->deviceCfg->eraseTime) * 1000ul; /* microseconds */
+
+		/* Wait until the current erase is completed or timeout occurs */
+		status = WaitMemoryReady(memConfig, eraseTime, eraseTime * MEMORY_BUSY_TIMEOUT_FACTOR);
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			status = ProcessErase(memConfig);
+		}
+		else
+		{
+			eraseState = ERASE_IDLE;
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: SuspendErase
+********************************************************************************
+*
+* Suspends the sector erase running in the background, so that the memory can
+* be read, also in the memory mode (XIP), except for the sector being erased.
+* Does nothing when the memory is not erasing.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - A chip erase is running, it cannot be suspended.
+*
+*******************************************************************************/
+cy_en_smif_status_t SuspendErase(cy_stc_smif_mem_config_t const *memConfig)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+	if((ERASE_RUNNING == eraseState) &&
+	   Cy_SMIF_Memslot_IsBusy(SMIF_HW, (cy_stc_smif_mem_config_t* )memConfig, &SMIFContext))
+	{
+		if(eraseChip)
+		{
+			status = CY_SMIF_BAD_PARAM;
+		}
+		else
+		{
+			status = TransmitEraseCommand(memConfig, MEMORY_CMD_ERASE_SUSPEND);
+
+			if(CY_SMIF_SUCCESS == status)
+			{
+				/* The memory is ready for reads once the erase is suspended */
+				status = WaitMemoryReady(memConfig, MEMORY_SUSPEND_TIME, MEMORY_SUSPEND_TIME * MEMORY_BUSY_TIMEOUT_FACTOR);
+			}
+
+			if(CY_SMIF_SUCCESS == status)
+			{
+				eraseState = ERASE_SUSPENDED;
+			}
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: ResumeErase
+********************************************************************************
+*
+* Resumes the erase suspended by SuspendErase(), and lets it run for
+* MEMORY_MIN_RESUME_TIME before returning, so that it progresses even when it is
+* suspended again right away. Does nothing when no erase is suspended.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+*
+*******************************************************************************/
+cy_en_smif_status_t ResumeErase(cy_stc_smif_mem_config_t const *memConfig)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+	if(ERASE_SUSPENDED == eraseState)
+	{
+		status = TransmitEraseCommand(memConfig, MEMORY_CMD_ERASE_RESUME);
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			eraseState = ERASE_RUNNING;
+			memoryWait(MEMORY_MIN_RESUME_TIME);
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+* Function Name: ReadMemoryDuringErase
+********************************************************************************
+*
+* Reads data from the external memory while an erase may be running in the
+* background. The erase is suspended for the read and resumed afterwards, so
+* that the read waits for tens of microseconds instead of the rest of the erase.
+*
+* \param memConfig
+* Memory device configuration
+*
+* \param address
+* The address to read data from.
+*
+* \param rxBuffer
+* The buffer for storing the read data.
+*
+* \param rxSize
+* The size of data to read.
+*
+* \return Status of the operation. See cy_en_smif_status_t.
+* CY_SMIF_BAD_PARAM - The data is in the sector being erased, or a chip erase is
+*                     running.
+*
+*******************************************************************************/
+cy_en_smif_status_t ReadMemoryDuringErase(cy_stc_smif_mem_config_t const *memConfig, uint32_t address, uint8_t rxBuffer[], uint32_t rxSize)
+{
+	cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+	uint32_t sectorSize = memConfig->deviceCfg->eraseSize;
+
+	if(IsEraseInProgress() && (address < (eraseCurrent + sectorSize)) && ((address + rxSize) > eraseCurrent))
+	{
+		status = CY_SMIF_BAD_PARAM;
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = SuspendErase(memConfig);
+	}
+
+	if(CY_SMIF_SUCCESS == status)
+	{
+		status = ReadMemoryRange(memConfig, address, rxBuffer, rxSize);
+
+		if(CY_SMIF_SUCCESS == status)
+		{
+			status = ResumeErase(memConfig);
+		}
+		else
+		{
+			(void)ResumeErase(memConfig);
+		}
+	}
+
+	return status;
+}
+
+
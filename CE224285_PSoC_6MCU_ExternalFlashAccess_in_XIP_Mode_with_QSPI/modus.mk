@@ -92,6 +92,8 @@ CY_APP_CM4_SOURCE = 	\
 	Source/main.c       \
     Source/smif_mem.c   \
     Source/smif_mem.h   \
+    Source/smif_bulk_read.c   \
+    Source/smif_bulk_read.h   \
     setup_readme.txt    \
 
 #